@@ -12,6 +12,7 @@
 #include "include/core/SkString.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkAAClip.h"
+#include "src/core/SkRasterClip.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // This bench tests out AA/BW clipping via canvas' clipPath and clipRect calls
@@ -22,15 +23,18 @@ class AAClipBench : public Benchmark {
     SkRect   fDrawRect;
     bool     fDoPath;
     bool     fDoAA;
+    bool     fAnalytic;
 
 public:
-    AAClipBench(bool doPath, bool doAA)
+    AAClipBench(bool doPath, bool doAA, bool analytic = true)
         : fDoPath(doPath)
-        , fDoAA(doAA) {
+        , fDoAA(doAA)
+        , fAnalytic(analytic) {
 
-        fName.printf("aaclip_%s_%s",
+        fName.printf("aaclip_%s_%s%s",
                      doPath ? "path" : "rect",
-                     doAA ? "AA" : "BW");
+                     doAA ? "AA" : "BW",
+                     analytic ? "" : "_mask");
 
         fClipRect.setLTRB(10.5f, 10.5f, 50.5f, 50.5f);
         fClipPath.addRoundRect(fClipRect, SkIntToScalar(10), SkIntToScalar(10));
@@ -46,6 +50,8 @@ protected:
         SkPaint paint;
         this->setupPaint(&paint);
 
+        const bool useAnalytic = gSkUseAnalyticAAClip;
+        gSkUseAnalyticAAClip = fAnalytic;
         for (int i = 0; i < loops; ++i) {
             // jostle the clip regions each time to prevent caching
             fClipRect.offset((i % 2) == 0 ? SkIntToScalar(10) : SkIntToScalar(-10), 0);
@@ -75,6 +81,7 @@ protected:
 #endif
             canvas->restore();
         }
+        gSkUseAnalyticAAClip = useAnalytic;
     }
 private:
     using INHERITED = Benchmark;
@@ -251,5 +258,6 @@ DEF_BENCH(return new AAClipBench(false, false);)
 DEF_BENCH(return new AAClipBench(false, true);)
 DEF_BENCH(return new AAClipBench(true, false);)
 DEF_BENCH(return new AAClipBench(true, true);)
+DEF_BENCH(return new AAClipBench(true, true, false);)
 DEF_BENCH(return new NestedAAClipBench(false);)
 DEF_BENCH(return new NestedAAClipBench(true);)
@@ -84,6 +84,9 @@ public:
     // Replaces the GrRecordingContext's dmsaaStats() with a single frame of this benchmark.
     virtual bool getDMSAAStats(GrRecordingContext*) { return false; }
 
+    // Results other than time, such as output sizes, that are reported next to the times.
+    virtual void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) {}
+
     // Count of units (pixels, whatever) being exercised, to scale timing by.
     int getUnits() const { return fUnits; }
 
@@ -9,6 +9,7 @@
 #include "bench/BigPath.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkPath.h"
+#include "src/core/SkScan.h"
 #include "tools/ToolUtils.h"
 
 enum Align {
@@ -25,13 +26,18 @@ class BigPathBench : public Benchmark {
     SkString    fName;
     Align       fAlign;
     bool        fRound;
+    bool        fAccumulation;
 
 public:
-    BigPathBench(Align align, bool round) : fAlign(align), fRound(round) {
+    BigPathBench(Align align, bool round, bool accumulation = false)
+            : fAlign(align), fRound(round), fAccumulation(accumulation) {
         fName.printf("bigpath_%s", gAlignName[fAlign]);
         if (round) {
             fName.append("_round");
         }
+        if (accumulation) {
+            fName.append("_accumulation");
+        }
     }
 
 protected:
@@ -67,9 +73,12 @@ protected:
                 break;
         }
 
+        const bool useAccumulation = gSkUseAccumulationAA;
+        gSkUseAccumulationAA = useAccumulation || fAccumulation;
         for (int i = 0; i < loops; i++) {
             canvas->drawPath(fPath, paint);
         }
+        gSkUseAccumulationAA = useAccumulation;
     }
 
 private:
@@ -83,3 +92,7 @@ DEF_BENCH( return new BigPathBench(kRight_Align,    false); )
 DEF_BENCH( return new BigPathBench(kLeft_Align,     true); )
 DEF_BENCH( return new BigPathBench(kMiddle_Align,   true); )
 DEF_BENCH( return new BigPathBench(kRight_Align,    true); )
+
+DEF_BENCH( return new BigPathBench(kLeft_Align,     false, true); )
+DEF_BENCH( return new BigPathBench(kMiddle_Align,   false, true); )
+DEF_BENCH( return new BigPathBench(kRight_Align,    false, true); )
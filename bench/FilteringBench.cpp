@@ -17,6 +17,9 @@ public:
     FilteringBench(SkFilterMode fm, SkMipmapMode mm) : fSampling(fm, mm) {
         fName.printf("samplingoptions_filter_%d_mipmap_%d", (int)fm, (int)mm);
     }
+    FilteringBench(SkCubicResampler cubic, const char* name) : fSampling(cubic) {
+        fName.printf("samplingoptions_cubic_%s", name);
+    }
 
 protected:
     const char* onGetName() override {
@@ -61,3 +64,6 @@ DEF_BENCH( return new FilteringBench(SkFilterMode::kLinear,  SkMipmapMode::kNone
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kLinear); )
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kNearest); )
 DEF_BENCH( return new FilteringBench(SkFilterMode::kNearest, SkMipmapMode::kNone); )
+
+DEF_BENCH( return new FilteringBench(SkCubicResampler::Mitchell(),   "mitchell"); )
+DEF_BENCH( return new FilteringBench(SkCubicResampler::CatmullRom(), "catmullrom"); )
@@ -11,6 +11,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
+#include "include/private/base/SkTPin.h"
 #include "src/base/SkRandom.h"
 
 enum Flags {
@@ -213,6 +214,65 @@ private:
     using INHERITED = HairlinePathBench;
 };
 
+// A dense line chart: a random walk with a point every other pixel.
+class ChartPathBench : public HairlinePathBench {
+public:
+    ChartPathBench(Flags flags) : INHERITED(flags) {}
+
+    void appendName(SkString* name) override {
+        name->append("chart");
+    }
+    void makePath(SkPath* path) override {
+        SkRandom rand;
+        SkScalar y = 40;
+        path->moveTo(0, y);
+        for (int i = 1; i <= 100; ++i) {
+            y = SkTPin(y + rand.nextSScalar1() * 8, 0.f, 80.f);
+            path->lineTo(SkIntToScalar(2 * i), y);
+        }
+    }
+private:
+    using INHERITED = HairlinePathBench;
+};
+
+// A hairline chart across a 4K device, so the batcher has up to 16K tiles to track. With few
+// points it touches few of them, so setting up the tiles dominates.
+class DeviceChartPathBench : public Benchmark {
+public:
+    DeviceChartPathBench(int points) : fPoints(points) {
+        fName.printf("path_hairline_device_chart_%d", points);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+    SkIPoint onGetSize() override { return {4096, 4096}; }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkScalar y = 2048;
+        fPath.moveTo(0, y);
+        for (int i = 1; i < fPoints; ++i) {
+            y = SkTPin(y + rand.nextSScalar1() * 4096 / fPoints * 4, 0.f, 4096.f);
+            fPath.lineTo(4096.f * i / (fPoints - 1), y);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setStyle(SkPaint::kStroke_Style);
+        paint.setAntiAlias(true);
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, paint);
+        }
+    }
+
+private:
+    SkString fName;
+    SkPath   fPath;
+    int      fPoints;
+};
+
 // FLAG00 - no AA, small
 // FLAG01 - no AA, small
 // FLAG10 - AA, big
@@ -238,3 +298,11 @@ DEF_BENCH( return new CubicPathBench(FLAGS00); )
 DEF_BENCH( return new CubicPathBench(FLAGS01); )
 DEF_BENCH( return new CubicPathBench(FLAGS10); )
 DEF_BENCH( return new CubicPathBench(FLAGS11); )
+
+DEF_BENCH( return new ChartPathBench(FLAGS00); )
+DEF_BENCH( return new ChartPathBench(FLAGS01); )
+DEF_BENCH( return new ChartPathBench(FLAGS10); )
+DEF_BENCH( return new ChartPathBench(FLAGS11); )
+
+DEF_BENCH( return new DeviceChartPathBench(16); )
+DEF_BENCH( return new DeviceChartPathBench(4096); )
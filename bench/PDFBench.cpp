@@ -10,6 +10,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkData.h"
 #include "include/core/SkExecutor.h"
+#include "include/core/SkFont.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkPixmap.h"
 #include "include/core/SkStream.h"
@@ -155,36 +156,152 @@ private:
 };
 
 /** Test calling DEFLATE on a 78k PDF command stream. Used for measuring
-    alternate zlib settings, usage, and library versions. */
+    alternate zlib settings, usage, and library versions. The random and flat
+    inputs stand in for already-compressed data and for solid-color images,
+    which SkPDF::Metadata::fAdaptiveCompression stores or compresses quickly.
+    Reports the size of the written stream next to the time. */
 class PDFCompressionBench : public Benchmark {
 public:
-    PDFCompressionBench() {}
+    enum class Input { kCommandStream, kRandom, kFlat };
+    using Level = SkPDF::Metadata::CompressionLevel;
+
+    PDFCompressionBench(Input input, bool adaptive, Level level = Level::Default)
+            : fInput(input), fAdaptive(adaptive), fLevel(level) {
+        static const char* kInputNames[] = {"", "_random", "_flat"};
+        fName.printf("PDFCompression%s%s",
+                     kInputNames[(int)input], adaptive ? "_adaptive" : "");
+        if (level != Level::Default) {
+            fName.appendf("_level%d", (int)level);
+        }
+    }
     ~PDFCompressionBench() override {}
 
 protected:
-    const char* onGetName() override { return "PDFCompression"; }
+    const char* onGetName() override { return fName.c_str(); }
     bool isSuitableFor(Backend backend) override {
         return backend == kNonRendering_Backend;
     }
     void onDelayedSetup() override {
-        fAsset = GetResourceAsStream("pdf_command_stream.txt");
+        static constexpr size_t kSize = 128 * 1024;
+        switch (fInput) {
+            case Input::kCommandStream:
+                fAsset = GetResourceAsStream("pdf_command_stream.txt");
+                break;
+            case Input::kRandom: {
+                SkRandom random;
+                sk_sp<SkData> data = SkData::MakeUninitialized(kSize);
+                uint8_t* bytes = static_cast<uint8_t*>(data->writable_data());
+                for (size_t i = 0; i < kSize; ++i) {
+                    bytes[i] = SkToU8(random.nextBits(8));
+                }
+                fAsset = SkMemoryStream::Make(std::move(data));
+                break;
+            }
+            case Input::kFlat: {
+                static const uint8_t kPixel[3] = {0x40, 0x80, 0xC0};
+                sk_sp<SkData> data = SkData::MakeUninitialized(kSize);
+                uint8_t* bytes = static_cast<uint8_t*>(data->writable_data());
+                for (size_t i = 0; i < kSize; ++i) {
+                    bytes[i] = kPixel[i % 3];
+                }
+                fAsset = SkMemoryStream::Make(std::move(data));
+                break;
+            }
+        }
+        if (fAsset) {
+            SkDynamicMemoryWStream wStream;
+            this->writeStream(&wStream);
+            fOutputBytes = wStream.bytesWritten();
+        }
     }
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(fAsset);
         if (!fAsset) { return; }
         while (loops-- > 0) {
             SkNullWStream wStream;
-            SkPDFDocument doc(&wStream, SkPDF::Metadata());
-            doc.beginPage(256, 256);
-            (void)SkPDFStreamOut(nullptr, fAsset->duplicate(),
-                                 &doc, SkPDFSteamCompressionEnabled::Yes);
+            this->writeStream(&wStream);
        }
     }
+    void getStats(SkTArray<SkString>* keys, SkTArray<double>* values) override {
+        if (fAsset) {
+            keys->push_back(SkString("input_bytes"));
+            values->push_back((double)fAsset->getLength());
+            keys->push_back(SkString("output_bytes"));
+            values->push_back((double)fOutputBytes);
+        }
+    }
 
 private:
+    // Writes a document holding just fAsset's stream, which is most of the document's bytes.
+    void writeStream(SkWStream* wStream) const {
+        SkPDF::Metadata metadata;
+        metadata.fCompressionLevel = fLevel;
+        metadata.fAdaptiveCompression = fAdaptive;
+        SkPDFDocument doc(wStream, metadata);
+        doc.beginPage(256, 256);
+        (void)SkPDFStreamOut(nullptr, fAsset->duplicate(),
+                             &doc, SkPDFSteamCompressionEnabled::Yes);
+    }
+
+    Input fInput;
+    bool fAdaptive;
+    Level fLevel;
+    size_t fOutputBytes = 0;
+    SkString fName;
     std::unique_ptr<SkStreamAsset> fAsset;
 };
 
+/** Write a batch of small documents that all embed the same logo and text, as a service
+    generating many PDFs would, optionally sharing an SkPDF::ResourceCache between them. */
+class PDFBatchBench : public Benchmark {
+public:
+    explicit PDFBatchBench(bool useCache) : fUseCache(useCache) {}
+
+protected:
+    const char* onGetName() override {
+        return fUseCache ? "PDFBatch_cached" : "PDFBatch";
+    }
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+    void onDelayedSetup() override {
+        sk_sp<SkImage> img(GetResourceAsImage("images/color_wheel.png"));
+        if (img) {
+            // As above, make the document encode the pixels itself.
+            SkAutoPixmapStorage pixmap;
+            pixmap.alloc(SkImageInfo::MakeN32Premul(img->dimensions()));
+            if (img->readPixels(nullptr, pixmap, 0, 0)) {
+                fImage = SkImage::MakeRasterCopy(pixmap);
+            }
+        }
+    }
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fImage) {
+            return;
+        }
+        static constexpr int kDocuments = 10;
+        SkFont font;
+        while (loops-- > 0) {
+            sk_sp<SkPDF::ResourceCache> cache = fUseCache ? SkPDF::ResourceCache::Make()
+                                                          : nullptr;
+            SkPDF::Metadata metadata;
+            metadata.fResourceCache = cache.get();
+            for (int i = 0; i < kDocuments; ++i) {
+                SkNullWStream nullStream;
+                auto doc = SkPDF::MakeDocument(&nullStream, metadata);
+                SkCanvas* canvas = doc->beginPage(612, 792);
+                canvas->drawImage(fImage, 72, 72);
+                canvas->drawString("Invoice", 72, 400, font, SkPaint());
+                doc->close();
+            }
+        }
+    }
+
+private:
+    bool fUseCache;
+    sk_sp<SkImage> fImage;
+};
+
 struct PDFColorComponentBench : public Benchmark {
     bool isSuitableFor(Backend b) override {
         return b == kNonRendering_Backend;
@@ -306,7 +423,18 @@ struct PDFClipPathBenchmark : public Benchmark {
 }  // namespace
 DEF_BENCH(return new PDFImageBench;)
 DEF_BENCH(return new PDFJpegImageBench;)
-DEF_BENCH(return new PDFCompressionBench;)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kCommandStream, false);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kCommandStream, true);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kCommandStream, false,
+                                         PDFCompressionBench::Level::LowButFast);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kCommandStream, false,
+                                         PDFCompressionBench::Level::HighButSlow);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kRandom, false);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kRandom, true);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kFlat, false);)
+DEF_BENCH(return new PDFCompressionBench(PDFCompressionBench::Input::kFlat, true);)
+DEF_BENCH(return new PDFBatchBench(false);)
+DEF_BENCH(return new PDFBatchBench(true);)
 DEF_BENCH(return new PDFColorComponentBench;)
 DEF_BENCH(return new PDFShaderBench;)
 DEF_BENCH(return new WritePDFTextBenchmark;)
@@ -11,6 +11,7 @@
 #include "include/core/SkColorPriv.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPathBuilder.h"
 #include "include/core/SkPathUtils.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkString.h"
@@ -20,6 +21,9 @@
 
 #include "src/core/SkDraw.h"
 #include "src/core/SkMatrixPriv.h"
+#include "src/core/SkScan.h"
+
+#include <vector>
 
 using namespace skia_private;
 
@@ -1009,6 +1013,130 @@ private:
 };
 DEF_BENCH( return new ConicBench_TinyError; )
 
+// A filled chart of a long random walk, like a plot of a million samples, drawn with or without
+// splitting its scan conversion into bands on the default executor (see --threads).
+class BandedChartPathBench : public Benchmark {
+public:
+    BandedChartPathBench(bool banded) : fBanded(banded) {
+        fName.printf("path_chart_aa_%s", banded ? "banded" : "serial");
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kRaster_Backend; }
+    SkIPoint onGetSize() override { return {1024, 768}; }
+
+    void onDelayedSetup() override {
+        constexpr int kPoints = 1 << 18;
+        SkRandom rand;
+        SkScalar y = 384;
+        fPath.moveTo(0, 768);
+        for (int i = 0; i < kPoints; ++i) {
+            y = SkTPin(y + rand.nextSScalar1() * 8, 0.f, 768.f);
+            fPath.lineTo(1024.f * i / kPoints, y);
+        }
+        fPath.lineTo(1024, 768);
+        fPath.close();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        const bool useBanded = gSkUseBandedAA;
+        gSkUseBandedAA = fBanded;
+        for (int i = 0; i < loops; ++i) {
+            canvas->drawPath(fPath, paint);
+        }
+        gSkUseBandedAA = useBanded;
+    }
+
+private:
+    SkString fName;
+    SkPath fPath;
+    bool fBanded;
+};
+DEF_BENCH( return new BandedChartPathBench(false); )
+DEF_BENCH( return new BandedChartPathBench(true); )
+
+// Builds a 1M-point polyline and asks for its bounds, through each way of adding lines.
+class PolylineBuildBench : public Benchmark {
+public:
+    enum class Mode {
+        kPathLineTo,
+        kBuilderLineTo,
+        kBuilderPolylineTo,
+        kBuilderAllocPolylineTo,
+    };
+
+    PolylineBuildBench(Mode mode) : fMode(mode) {
+        static const char* kNames[] = {"path_lineTo", "builder_lineTo", "builder_polylineTo",
+                                       "builder_allocPolylineTo"};
+        fName.printf("path_polyline_1M_%s", kNames[(int)mode]);
+    }
+
+protected:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        constexpr int kPoints = 1 << 20;
+        SkRandom rand;
+        fPts.resize(kPoints);
+        for (SkPoint& pt : fPts) {
+            pt = {rand.nextRangeF(0, 1024), rand.nextRangeF(0, 768)};
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        const int count = SkToInt(fPts.size());
+        for (int i = 0; i < loops; ++i) {
+            SkPath path;
+            switch (fMode) {
+                case Mode::kPathLineTo:
+                    path.moveTo(0, 0);
+                    for (const SkPoint& pt : fPts) {
+                        path.lineTo(pt);
+                    }
+                    break;
+                case Mode::kBuilderLineTo: {
+                    SkPathBuilder builder;
+                    builder.moveTo(0, 0);
+                    for (const SkPoint& pt : fPts) {
+                        builder.lineTo(pt);
+                    }
+                    path = builder.detach();
+                    break;
+                }
+                case Mode::kBuilderPolylineTo:
+                    path = SkPathBuilder().moveTo(0, 0).polylineTo(fPts.data(), count).detach();
+                    break;
+                case Mode::kBuilderAllocPolylineTo: {
+                    SkPathBuilder builder;
+                    builder.moveTo(0, 0);
+                    SkPoint* dst = builder.allocPolylineTo(count);
+                    for (int j = 0; j < count; ++j) {
+                        dst[j] = fPts[j];
+                    }
+                    path = builder.detach();
+                    break;
+                }
+            }
+            if (path.getBounds().isEmpty()) {
+                SK_ABORT("bounds should not be empty.");
+            }
+        }
+    }
+
+private:
+    SkString fName;
+    Mode fMode;
+    std::vector<SkPoint> fPts;
+};
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::Mode::kPathLineTo); )
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::Mode::kBuilderLineTo); )
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::Mode::kBuilderPolylineTo); )
+DEF_BENCH( return new PolylineBuildBench(PolylineBuildBench::Mode::kBuilderAllocPolylineTo); )
+
 ///////////////////////////////////////////////////////////////////////////////
 
 static void rand_conic(SkConic* conic, SkRandom& rand) {
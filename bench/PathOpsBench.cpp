@@ -13,6 +13,8 @@
 #include "include/private/base/SkTArray.h"
 #include "src/base/SkRandom.h"
 
+#include <memory>
+
 class PathOpsBench : public Benchmark {
     SkString    fName;
     SkPath      fPath1, fPath2;
@@ -78,8 +80,60 @@ protected:
 private:
     using INHERITED = Benchmark;
 };
+
+// Performs small operations like PathOpsBench's, with or without a reusable context.
+class PathOpsContextBench : public Benchmark {
+    SkString    fName;
+    SkPath      fPath1, fPath2;
+    SkPathOp    fOp;
+    bool        fUseContext;
+    std::unique_ptr<SkPathOpsContext> fContext;
+
+public:
+    PathOpsContextBench(const char suffix[], SkPathOp op, bool useContext)
+            : fOp(op), fUseContext(useContext) {
+        fName.printf("pathops_%s_%s", suffix, useContext ? "context" : "nocontext");
+
+        fPath1.addOval({-10, -20, 10, 20});
+        fPath1.addCircle(8, 0, 6);
+        fPath2.addOval({-20, -10, 20, 10});
+        fPath2.addCircle(0, 8, 6);
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    void onDelayedSetup() override {
+        fContext = std::make_unique<SkPathOpsContext>();
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            for (int j = 0; j < 1000; ++j) {
+                SkPath result;
+                if (fUseContext) {
+                    fContext->op(fPath1, fPath2, fOp, &result);
+                } else {
+                    Op(fPath1, fPath2, fOp, &result);
+                }
+            }
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+
 DEF_BENCH( return new PathOpsBench("sect", kIntersect_SkPathOp); )
 DEF_BENCH( return new PathOpsBench("join", kUnion_SkPathOp); )
+DEF_BENCH( return new PathOpsContextBench("join", kUnion_SkPathOp, false); )
+DEF_BENCH( return new PathOpsContextBench("join", kUnion_SkPathOp, true); )
 
 static SkPath makerects() {
     SkRandom rand;
@@ -94,6 +148,68 @@ static SkPath makerects() {
 }
 DEF_BENCH( return new PathOpsSimplifyBench("rects", makerects()); )
 
+// A closed polygon with many edges that wanders back over itself, like a traced outline.
+static SkPath makepolygon() {
+    SkRandom rand;
+    SkPath path;
+    path.moveTo(0, 0);
+    for (int i = 0; i < 2000; ++i) {
+        SkScalar angle = i * (2 * SK_ScalarPI / 2000);
+        SkScalar radius = 100 + rand.nextSScalar1() * 20;
+        path.lineTo(radius * SkScalarCos(angle * 3), radius * SkScalarSin(angle * 2));
+    }
+    path.close();
+    return path;
+}
+DEF_BENCH( return new PathOpsSimplifyBench("polygon", makepolygon()); )
+
+// Unions many overlapping concave shapes, like the buildings in a map tile.
+class PathOpsBuilderUnionBench : public Benchmark {
+    SkTArray<SkPath> fPaths;
+
+public:
+    PathOpsBuilderUnionBench() {
+        SkRandom rand;
+        for (int i = 0; i < 256; ++i) {
+            SkScalar cx = rand.nextUScalar1() * 400,
+                     cy = rand.nextUScalar1() * 400;
+            SkPath star;
+            for (int p = 0; p < 10; ++p) {
+                SkScalar angle = p * (SK_ScalarPI / 5);
+                SkScalar radius = p & 1 ? 10 : 25;
+                SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+                p ? star.lineTo(pt) : star.moveTo(pt);
+            }
+            star.close();
+            fPaths.push_back(star);
+        }
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+protected:
+    const char* onGetName() override {
+        return "pathops_builder_union_stars";
+    }
+
+    void onDraw(int loops, SkCanvas* canvas) override {
+        for (int i = 0; i < loops; i++) {
+            SkOpBuilder builder;
+            for (const SkPath& path : fPaths) {
+                builder.add(path, kUnion_SkPathOp);
+            }
+            SkPath result;
+            builder.resolve(&result);
+        }
+    }
+
+private:
+    using INHERITED = Benchmark;
+};
+DEF_BENCH( return new PathOpsBuilderUnionBench(); )
+
 #include "include/core/SkPathBuilder.h"
 
 template <size_t N> struct ArrayPath {
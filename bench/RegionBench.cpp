@@ -119,6 +119,7 @@ private:
 ///////////////////////////////////////////////////////////////////////////////
 
 #define SMALL   16
+#define LARGE   256
 
 DEF_BENCH(return new RegionBench(SMALL, union_proc, "union");)
 DEF_BENCH(return new RegionBench(SMALL, sect_proc, "intersect");)
@@ -129,3 +130,11 @@ DEF_BENCH(return new RegionBench(SMALL, containsrect_proc, "containsrect");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrgn_proc, "intersectsrgn");)
 DEF_BENCH(return new RegionBench(SMALL, sectsrect_proc, "intersectsrect");)
 DEF_BENCH(return new RegionBench(SMALL, containsxy_proc, "containsxy");)
+
+// Many spans, each with many intervals.
+DEF_BENCH(return new RegionBench(LARGE, union_proc, "union");)
+DEF_BENCH(return new RegionBench(LARGE, sect_proc, "intersect");)
+DEF_BENCH(return new RegionBench(LARGE, diff_proc, "difference");)
+DEF_BENCH(return new RegionBench(LARGE, containsrect_proc, "containsrect");)
+DEF_BENCH(return new RegionBench(LARGE, sectsrect_proc, "intersectsrect");)
+DEF_BENCH(return new RegionBench(LARGE, containsxy_proc, "containsxy");)
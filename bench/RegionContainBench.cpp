@@ -25,21 +25,20 @@ public:
     enum {
         W = 200,
         H = 200,
-        COUNT = 10,
     };
 
-    SkIRect randrect(SkRandom& rand, int i) {
+    SkIRect randrect(SkRandom& rand, int i, int count) {
         int w = rand.nextU() % W;
-        return SkIRect::MakeXYWH(0, i*H/COUNT, w, H/COUNT);
+        return SkIRect::MakeXYWH(0, i*H/count, w, H/count);
     }
 
-    RegionContainBench(Proc proc, const char name[])  {
+    RegionContainBench(Proc proc, const char name[], int count = 10)  {
         fProc = proc;
         fName.printf("region_contains_%s", name);
 
         SkRandom rand;
-        for (int i = 0; i < COUNT; i++) {
-            fA.op(randrect(rand, i), SkRegion::kXOR_Op);
+        for (int i = 0; i < count; i++) {
+            fA.op(randrect(rand, i, count), SkRegion::kXOR_Op);
         }
 
         fB.setRect({0, 0, H, W});
@@ -65,3 +64,4 @@ private:
 };
 
 DEF_BENCH(return new RegionContainBench(sect_proc, "sect");)
+DEF_BENCH(return new RegionContainBench(sect_proc, "sect_100", 100);)
@@ -0,0 +1,93 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "bench/Benchmark.h"
+#include "include/core/SkBitmap.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkSamplingOptions.h"
+#include "include/core/SkString.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkResample.h"
+
+#include <memory>
+
+// Scales a 1024x1024 image to (or by) the given size: with SkResample run serially or with its
+// bands on a thread pool, or with SkPixmap::scalePixels() and the equivalent cubic, as a baseline.
+// The pool only helps on a machine with cores to spare; compare "threaded" with "serial" there.
+class ResampleBench : public Benchmark {
+public:
+    enum class Method { kScalePixels, kResample, kResampleThreaded };
+
+    ResampleBench(Method method, SkResample::Filter filter, int dstSize)
+            : fMethod(method), fFilter(filter), fDstSize(dstSize) {
+        static const char* kMethods[] = {"scalePixels", "serial", "threaded"};
+        static const char* kFilters[] = {"mitchell", "catmullrom", "lanczos3"};
+        fName.printf("resample_%s_%s_1024_to_%d",
+                     kMethods[(int)method], kFilters[(int)filter], dstSize);
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override { return backend == kNonRendering_Backend; }
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        fSrc.allocN32Pixels(1024, 1024);
+        for (int y = 0; y < fSrc.height(); ++y) {
+            for (int x = 0; x < fSrc.width(); ++x) {
+                *fSrc.getAddr32(x, y) = rand.nextU() | 0xFF000000;
+            }
+        }
+        fDst.allocN32Pixels(fDstSize, fDstSize);
+        if (fMethod == Method::kResampleThreaded) {
+            fPool = SkExecutor::MakeFIFOThreadPool();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkResample::Options options;
+        options.fFilter   = fFilter;
+        options.fExecutor = fPool.get();
+
+        const SkCubicResampler cubic = fFilter == SkResample::Filter::kCatmullRom
+                                               ? SkCubicResampler::CatmullRom()
+                                               : SkCubicResampler::Mitchell();
+        for (int i = 0; i < loops; ++i) {
+            if (fMethod == Method::kScalePixels) {
+                fSrc.pixmap().scalePixels(fDst.pixmap(), SkSamplingOptions(cubic));
+            } else {
+                SkResample::Scale(fSrc.pixmap(), fDst.pixmap(), options);
+            }
+        }
+    }
+
+private:
+    Method                      fMethod;
+    SkResample::Filter          fFilter;
+    int                         fDstSize;
+    SkString                    fName;
+    SkBitmap                    fSrc,
+                                fDst;
+    std::unique_ptr<SkExecutor> fPool;
+};
+
+using M = ResampleBench::Method;
+using F = SkResample::Filter;
+
+DEF_BENCH(return new ResampleBench(M::kScalePixels,      F::kMitchell,   256);)
+DEF_BENCH(return new ResampleBench(M::kResample,         F::kMitchell,   256);)
+DEF_BENCH(return new ResampleBench(M::kResampleThreaded, F::kMitchell,   256);)
+DEF_BENCH(return new ResampleBench(M::kResample,         F::kLanczos3,   256);)
+DEF_BENCH(return new ResampleBench(M::kResampleThreaded, F::kLanczos3,   256);)
+
+DEF_BENCH(return new ResampleBench(M::kScalePixels,      F::kMitchell,   100);)
+DEF_BENCH(return new ResampleBench(M::kResample,         F::kMitchell,   100);)
+
+DEF_BENCH(return new ResampleBench(M::kScalePixels,      F::kCatmullRom, 1536);)
+DEF_BENCH(return new ResampleBench(M::kResample,         F::kCatmullRom, 1536);)
+DEF_BENCH(return new ResampleBench(M::kResampleThreaded, F::kCatmullRom, 1536);)
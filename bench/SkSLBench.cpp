@@ -8,16 +8,34 @@
 #include "bench/ResultsWriter.h"
 #include "bench/SkSLBench.h"
 #include "include/core/SkCanvas.h"
+#include "include/core/SkData.h"
+#include "include/core/SkPaint.h"
+#include "include/core/SkSurface.h"
+#include "include/core/SkSurfaceProps.h"
+#include "include/effects/SkRuntimeEffect.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkEffectPriv.h"
+#include "src/core/SkRasterPipeline.h"
 #include "src/gpu/ganesh/GrCaps.h"
 #include "src/gpu/ganesh/GrRecordingContextPriv.h"
 #include "src/gpu/ganesh/mock/GrMockCaps.h"
+#include "src/shaders/SkShaderBase.h"
 #include "src/sksl/SkSLCompiler.h"
 #include "src/sksl/SkSLModuleLoader.h"
 #include "src/sksl/SkSLParser.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
+#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
 #include "src/sksl/ir/SkSLProgram.h"
+#include "src/utils/SkOSPath.h"
+#include "tools/Resources.h"
 
 #include <regex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "src/sksl/generated/sksl_shared.minified.sksl"
 #include "src/sksl/generated/sksl_compute.minified.sksl"
@@ -51,6 +69,122 @@ protected:
 
 DEF_BENCH(return new SkSLCompilerStartupBench();)
 
+// Makes a set of runtime shaders, as a service might at startup, optionally from a warm
+// SkRuntimeEffect::PersistentCache.
+class SkSLRuntimeEffectStartupBench : public Benchmark {
+public:
+    explicit SkSLRuntimeEffectStartupBench(bool persistentCache)
+            : fName(persistentCache ? "sksl_runtime_effect_startup_cached"
+                                    : "sksl_runtime_effect_startup")
+            , fUsePersistentCache(persistentCache) {}
+
+protected:
+    const char* onGetName() override {
+        return fName;
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        for (int i = 0; i < kEffectCount; ++i) {
+            fSources.push_back(SkStringPrintf(R"(
+                uniform shader child;
+                uniform half4 color;
+                uniform float2 scale;
+                half4 blur(float2 p) {
+                    half4 sum = half4(0);
+                    for (int i = -2; i <= 2; ++i) {
+                        sum += child.eval(p + float2(i, %d));
+                    }
+                    return sum / 5;
+                }
+                half4 main(float2 p) {
+                    half4 c = blur(p * scale);
+                    return mix(c, color, saturate(length(p) / %d.0));
+                }
+            )", i, i + 1));
+        }
+        if (fUsePersistentCache) {
+            SkRuntimeEffect::SetPersistentCache(&fCache);
+            for (const SkString& source : fSources) {
+                SkRuntimeEffect::MakeForShader(source);
+            }
+            SkRuntimeEffect::SetPersistentCache(nullptr);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (fUsePersistentCache) {
+            SkRuntimeEffect::SetPersistentCache(&fCache);
+        }
+        for (int i = 0; i < loops; i++) {
+            for (const SkString& source : fSources) {
+                SkRuntimeEffect::MakeForShader(source);
+            }
+        }
+        SkRuntimeEffect::SetPersistentCache(nullptr);
+    }
+
+private:
+    class MemoryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            for (const auto& [k, data] : fEntries) {
+                if (k->equals(&key)) {
+                    return data;
+                }
+            }
+            return nullptr;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            fEntries.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                                SkData::MakeWithCopy(data.data(), data.size())});
+        }
+
+    private:
+        std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> fEntries;
+    };
+
+    static constexpr int kEffectCount = 16;
+
+    const char* fName;
+    bool fUsePersistentCache;
+    std::vector<SkString> fSources;
+    MemoryCache fCache;
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*persistentCache=*/false);)
+DEF_BENCH(return new SkSLRuntimeEffectStartupBench(/*persistentCache=*/true);)
+
+// Makes the first runtime shader in a process: the SkSL modules it depends on are unloaded before
+// each one, so every iteration pays for loading them again.
+class SkSLRuntimeEffectColdStartBench : public Benchmark {
+protected:
+    const char* onGetName() override {
+        return "sksl_runtime_effect_cold_start";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            SkSL::ModuleLoader::Get().unloadModules();
+            SkRuntimeEffect::MakeForShader(SkString(R"(
+                uniform half4 color;
+                half4 main(float2 p) {
+                    return mix(color, half4(1), saturate(length(p) / 100));
+                }
+            )"));
+        }
+    }
+};
+
+DEF_BENCH(return new SkSLRuntimeEffectColdStartBench;)
+
 enum class Output {
     kNone,
     kGLSL,
@@ -465,6 +599,205 @@ void main()
 
 COMPILER_BENCH(tiny, "void main() { sk_FragColor = half4(1); }");
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Runtime shaders from resources/sksl that the Raster Pipeline backend supports, and that don't
+// depend on child effects.
+#define SKSL_RP_BENCH_SHADERS(M)                \
+    M("runtime/LoopFloat.rts")                  \
+    M("runtime/LoopInt.rts")                    \
+    M("runtime/RecursiveComparison_Vectors.rts") \
+    M("shared/Matrices.sksl")                   \
+    M("shared/VectorScalarMath.sksl")
+
+// Names a result for the shader at `path`, e.g. "sksl_rp_LoopInt_unfused".
+static std::string sksl_rp_bench_name(const char* prefix, const char* path, bool fuseStages) {
+    std::string name = SkOSPath::Basename(path).c_str();
+    return prefix + name.substr(0, name.find('.')) + (fuseStages ? "" : "_unfused");
+}
+
+static bool append_sksl_raster_pipeline(const char* path, bool fuseStages, SkArenaAlloc* alloc,
+                                        SkRasterPipeline* pipeline,
+                                        SkRasterPipeline_MemoryCtx* dst) {
+    sk_sp<SkData> data = GetResourceAsData(SkStringPrintf("sksl/%s", path).c_str());
+    if (!data) {
+        return false;
+    }
+    std::string src(static_cast<const char*>(data->data()), data->size());
+    SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Default());
+    SkSL::ProgramSettings settings;
+    settings.fMaxVersionAllowed = SkSL::Version::k300;
+    std::unique_ptr<SkSL::Program> program =
+            compiler.convertProgram(SkSL::ProgramKind::kRuntimeShader, src, settings);
+    if (!program) {
+        return false;
+    }
+    const SkSL::FunctionDeclaration* main = program->getFunction("main");
+    if (!main) {
+        return false;
+    }
+
+    // The fusions happen as the program is built and as its stages are appended.
+    const bool wasFusingStages = SkSL::RP::gFuseStages;
+    SkSL::RP::gFuseStages = fuseStages;
+    std::unique_ptr<SkSL::RP::Program> rpProgram =
+            SkSL::MakeRasterPipelineProgram(*program, *main->definition());
+    bool success = false;
+    if (rpProgram) {
+        std::unique_ptr<SkSL::UniformInfo> uniformInfo = program->getUniformInfo();
+        size_t numUniforms = 0;
+        for (const SkSL::UniformInfo::Uniform& uniform : uniformInfo->fUniforms) {
+            numUniforms += uniform.fColumns * uniform.fRows;
+        }
+        float* uniforms = alloc->makeArray<float>(numUniforms);
+        pipeline->append(SkRasterPipelineOp::seed_shader);
+        success = rpProgram->appendStages(pipeline, alloc, /*callbacks=*/nullptr,
+                                          SkSpan(uniforms, numUniforms));
+        pipeline->append(SkRasterPipelineOp::store_8888, dst);
+    }
+    SkSL::RP::gFuseStages = wasFusingStages;
+    return success;
+}
+
+// Runs a runtime shader over a block of pixels with the Raster Pipeline backend, with or without
+// the code generator's stage fusions.
+class SkSLRasterPipelineBench : public Benchmark {
+public:
+    SkSLRasterPipelineBench(const char* path, bool fuseStages)
+            : fPath(path)
+            , fFuseStages(fuseStages)
+            , fName(sksl_rp_bench_name("sksl_rp_", path, fuseStages)) {}
+
+protected:
+    const char* onGetName() override {
+        return fName.c_str();
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        SkRasterPipeline_MemoryCtx dst = {fPixels, kWidth};
+        fDst = dst;
+        SkRasterPipeline pipeline(&fAlloc);
+        if (append_sksl_raster_pipeline(fPath, fFuseStages, &fAlloc, &pipeline, &fDst)) {
+            fRun = pipeline.compile();
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        if (!fRun) {
+            return;
+        }
+        for (int i = 0; i < loops; i++) {
+            fRun(0, 0, kWidth, kHeight);
+        }
+    }
+
+private:
+    static constexpr int kWidth = 64;
+    static constexpr int kHeight = 16;
+
+    const char* fPath;
+    bool fFuseStages;
+    std::string fName;
+    SkSTArenaAlloc<4096> fAlloc;
+    uint32_t fPixels[kWidth * kHeight];
+    SkRasterPipeline_MemoryCtx fDst;
+    std::function<void(size_t, size_t, size_t, size_t)> fRun;
+};
+
+#define RP_BENCH(path)                                                        \
+    DEF_BENCH(return new SkSLRasterPipelineBench(path, /*fuseStages=*/true);) \
+    DEF_BENCH(return new SkSLRasterPipelineBench(path, /*fuseStages=*/false);)
+SKSL_RP_BENCH_SHADERS(RP_BENCH)
+#undef RP_BENCH
+
+// A runtime shader like the ones that draw UI elements, where most of the work depends only on
+// uniforms that don't change from frame to frame.
+static sk_sp<SkShader> make_uniform_heavy_shader(bool specializeUniforms) {
+    static constexpr char kSource[] = R"(
+        layout(color) uniform half4 fillColor;
+        layout(color) uniform half4 strokeColor;
+        uniform float2 center;
+        uniform float radius, strokeWidth, softness;
+        uniform int style;  // 0: fill, 1: stroke, 2: fill and stroke
+        uniform float2x2 gradient;
+
+        half4 main(float2 p) {
+            float d = length(p - center) - radius;
+            half4 color = half4(0);
+            if (style != 1) {
+                half t = half(saturate(dot(gradient * (p - center), float2(1)) / radius));
+                color = fillColor * (1 - 0.25 * t) * half(saturate(0.5 - d / softness));
+            }
+            if (style != 0) {
+                float strokeDistance = abs(d) - strokeWidth * 0.5;
+                color = mix(color, strokeColor, half(saturate(0.5 - strokeDistance / softness)));
+            }
+            return color;
+        }
+    )";
+
+    SkRuntimeEffect::Options options;
+    options.specializeUniforms = specializeUniforms;
+    auto [effect, error] = SkRuntimeEffect::MakeForShader(SkString(kSource), options);
+    if (!effect) {
+        SkDEBUGFAILF("%s", error.c_str());
+        return nullptr;
+    }
+
+    SkRuntimeShaderBuilder builder(effect);
+    builder.uniform("fillColor") = SkV4{0.25f, 0.5f, 1, 1};
+    builder.uniform("strokeColor") = SkV4{0, 0, 0, 1};
+    builder.uniform("center") = SkV2{128, 128};
+    builder.uniform("radius") = 96.0f;
+    builder.uniform("strokeWidth") = 2.0f;
+    builder.uniform("softness") = 1.0f;
+    builder.uniform("style") = 0;
+    builder.uniform("gradient") = SkV4{1, 0, 0, 1};
+    return builder.makeShader();
+}
+
+// Draws a runtime shader whose uniforms never change, with and without specializing its raster
+// program for them.
+class SkSLSpecializeUniformsBench : public Benchmark {
+public:
+    SkSLSpecializeUniformsBench(bool specializeUniforms)
+            : fSpecializeUniforms(specializeUniforms) {}
+
+protected:
+    const char* onGetName() override {
+        return fSpecializeUniforms ? "sksl_rp_uniforms_specialized" : "sksl_rp_uniforms";
+    }
+
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    void onDelayedSetup() override {
+        fSurface = SkSurface::MakeRasterN32Premul(kSize, kSize);
+        fPaint.setShader(make_uniform_heavy_shader(fSpecializeUniforms));
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        for (int i = 0; i < loops; i++) {
+            fSurface->getCanvas()->drawPaint(fPaint);
+        }
+    }
+
+private:
+    static constexpr int kSize = 256;
+
+    bool fSpecializeUniforms;
+    sk_sp<SkSurface> fSurface;
+    SkPaint fPaint;
+};
+
+DEF_BENCH(return new SkSLSpecializeUniformsBench(/*specializeUniforms=*/false);)
+DEF_BENCH(return new SkSLSpecializeUniformsBench(/*specializeUniforms=*/true);)
+
 #if defined(SK_BUILD_FOR_UNIX)
 
 #include <malloc.h>
@@ -499,7 +832,29 @@ static void bench(NanoJSONResultsWriter* log, const char* name, int bytes) {
     log->endObject();                // test
 }
 
-// These benchmarks aren't timed, they produce memory usage statistics. They run standalone, and
+static void bench_stages(NanoJSONResultsWriter* log, const char* name, int stages) {
+    SkDEBUGCODE(SkDebugf("%s: %d stages\n", name, stages);)
+    log->beginObject(name);            // test
+    log->beginObject("meta");          //   config
+    log->appendS32("stages", stages);  //     sub_result
+    log->endObject();                  //   config
+    log->endObject();                  // test
+}
+
+// Reports how many Raster Pipeline stages a shader needs, with and without stage fusion.
+static void bench_raster_pipeline_stages(NanoJSONResultsWriter* log, const char* path) {
+    for (bool fuseStages : {true, false}) {
+        SkSTArenaAlloc<4096> alloc;
+        SkRasterPipeline pipeline(&alloc);
+        SkRasterPipeline_MemoryCtx dst = {nullptr, 0};
+        if (append_sksl_raster_pipeline(path, fuseStages, &alloc, &pipeline, &dst)) {
+            std::string name = sksl_rp_bench_name("sksl_rp_stages_", path, fuseStages);
+            bench_stages(log, name.c_str(), pipeline.getNumStages());
+        }
+    }
+}
+
+// These benchmarks aren't timed, they produce memory usage and stage count statistics. They run standalone, and
 // directly add their results to the nanobench log.
 void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
     // Heap used by a default compiler (with no modules loaded)
@@ -567,12 +922,35 @@ void RunSkSLModuleBenchmarks(NanoJSONResultsWriter* log) {
 
     int compilerComputeBinarySize = std::size(SKSL_MINIFIED_sksl_compute);
     bench(log, "sksl_binary_size_compute", compilerComputeBinarySize);
+
+    // Report the Raster Pipeline stage counts of the runtime shaders benchmarked above.
+#define RP_BENCH_STAGES(path) bench_raster_pipeline_stages(log, path);
+    SKSL_RP_BENCH_SHADERS(RP_BENCH_STAGES)
+#undef RP_BENCH_STAGES
+
+    // ... and of the shader drawn by SkSLSpecializeUniformsBench, with and without specialization.
+    for (bool specializeUniforms : {false, true}) {
+        SkSTArenaAlloc<4096> alloc;
+        SkRasterPipeline pipeline(&alloc);
+        SkPaint paint;
+        SkSurfaceProps props;
+        SkStageRec rec = {&pipeline, &alloc, kN32_SkColorType, nullptr, paint, props};
+        sk_sp<SkShader> shader = make_uniform_heavy_shader(specializeUniforms);
+        if (shader && as_SB(shader)->appendRootStages(rec, SkMatrix::I())) {
+            bench_stages(log,
+                         specializeUniforms ? "sksl_rp_stages_uniforms_specialized"
+                                            : "sksl_rp_stages_uniforms",
+                         pipeline.getNumStages());
+        }
+    }
 }
 
 class SkSLModuleLoaderBench : public Benchmark {
 public:
-    SkSLModuleLoaderBench(const char* name, std::vector<SkSL::ProgramKind> moduleList)
-            : fName(name), fModuleList(std::move(moduleList)) {}
+    SkSLModuleLoaderBench(const char* name,
+                          std::vector<SkSL::ProgramKind> moduleList,
+                          bool threaded = false)
+            : fName(name), fModuleList(std::move(moduleList)), fThreaded(threaded) {}
 
     const char* onGetName() override {
         return fName;
@@ -593,6 +971,20 @@ public:
     void onDraw(int loops, SkCanvas*) override {
         SkASSERT(loops == 1);
         GrShaderCaps caps;
+        if (fThreaded) {
+            // Each module (and any of its parents not yet loaded) is loaded on a thread of its own.
+            std::vector<std::thread> threads;
+            for (SkSL::ProgramKind kind : fModuleList) {
+                threads.emplace_back([&caps, kind]() {
+                    SkSL::Compiler compiler(&caps);
+                    compiler.moduleForProgramKind(kind);
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            return;
+        }
         SkSL::Compiler compiler(&caps);
         for (SkSL::ProgramKind kind : fModuleList) {
             compiler.moduleForProgramKind(kind);
@@ -601,6 +993,7 @@ public:
 
     const char* fName;
     std::vector<SkSL::ProgramKind> fModuleList;
+    bool fThreaded;
 };
 
 DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
@@ -616,6 +1009,16 @@ DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh",
                                                    SkSL::ProgramKind::kCompute,
                                            });)
 
+DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_ganesh_threaded",
+                                           {
+                                                   SkSL::ProgramKind::kVertex,
+                                                   SkSL::ProgramKind::kFragment,
+                                                   SkSL::ProgramKind::kRuntimeShader,
+                                                   SkSL::ProgramKind::kPrivateRuntimeShader,
+                                                   SkSL::ProgramKind::kCompute,
+                                           },
+                                           /*threaded=*/true);)
+
 DEF_BENCH(return new SkSLModuleLoaderBench("sksl_module_loader_graphite",
                                            {
                                                    SkSL::ProgramKind::kVertex,
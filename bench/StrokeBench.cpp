@@ -11,6 +11,7 @@
 #include "include/core/SkPathUtils.h"
 #include "include/core/SkString.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkStroke.h"
 
 class StrokeBench : public Benchmark {
 public:
@@ -118,3 +119,58 @@ DEF_BENCH(return new StrokeBench(line_path_maker(), paint_maker(), "line_.25", .
 DEF_BENCH(return new StrokeBench(quad_path_maker(), paint_maker(), "quad_.25", .25f);)
 DEF_BENCH(return new StrokeBench(conic_path_maker(), paint_maker(), "conic_.25", .25f);)
 DEF_BENCH(return new StrokeBench(cubic_path_maker(), paint_maker(), "cubic_.25", .25f);)
+
+///////////////////////////////////////////////////////////////////////////////
+
+// Strokes a long polyline with and without SkStroke's line-only fast path.
+class PolylineStrokeBench : public Benchmark {
+public:
+    PolylineStrokeBench(SkPaint::Join join, SkPaint::Cap cap, bool usePolylineStroker)
+            : fJoin(join), fCap(cap), fUsePolylineStroker(usePolylineStroker) {
+        fName.printf("build_stroke_polyline_%d_%d_%s",
+                     join, cap, usePolylineStroker ? "fast" : "general");
+    }
+
+protected:
+    bool isSuitableFor(Backend backend) override {
+        return backend == kNonRendering_Backend;
+    }
+
+    const char* onGetName() override { return fName.c_str(); }
+
+    void onDelayedSetup() override {
+        SkRandom rand;
+        SkPoint pt = {0, 0};
+        fPath.moveTo(pt);
+        for (int i = 0; i < 20000; ++i) {
+            pt += {rand.nextSScalar1() * 4, rand.nextSScalar1() * 4};
+            fPath.lineTo(pt);
+        }
+    }
+
+    void onDraw(int loops, SkCanvas*) override {
+        SkStroke stroker;
+        stroker.setWidth(3);
+        stroker.setJoin(fJoin);
+        stroker.setCap(fCap);
+        stroker.setUsePolylineStroker(fUsePolylineStroker);
+        for (int i = 0; i < loops; ++i) {
+            SkPath result;
+            stroker.strokePath(fPath, &result);
+        }
+    }
+
+private:
+    SkPath          fPath;
+    SkString        fName;
+    SkPaint::Join   fJoin;
+    SkPaint::Cap    fCap;
+    bool            fUsePolylineStroker;
+};
+
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kMiter_Join, SkPaint::kButt_Cap, true);)
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kMiter_Join, SkPaint::kButt_Cap, false);)
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kRound_Join, SkPaint::kRound_Cap, true);)
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kRound_Join, SkPaint::kRound_Cap, false);)
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kBevel_Join, SkPaint::kSquare_Cap, true);)
+DEF_BENCH(return new PolylineStrokeBench(SkPaint::kBevel_Join, SkPaint::kSquare_Cap, false);)
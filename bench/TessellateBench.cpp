@@ -184,6 +184,54 @@ DEF_PATH_TESS_BENCH(wangs_formula_cubic_log2_affine, make_cubic_path(18),
     benchmark_wangs_formula_cubic_log2(fMatrix, fPath);
 }
 
+// Evaluates Wang's formula on the cubics of a path, either one at a time or through the batch API.
+class WangsFormulaCubicP4Bench : public Benchmark {
+public:
+    WangsFormulaCubicP4Bench(bool batch) : fBatch(batch) {
+        fName.printf("tessellate_wangs_formula_cubic_p4%s", batch ? "_batch" : "");
+    }
+
+private:
+    const char* onGetName() override { return fName.c_str(); }
+    bool isSuitableFor(Backend backend) final { return backend == kNonRendering_Backend; }
+
+    void onDelayedSetup() override {
+        SkPath path = make_cubic_path(18);
+        for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
+            if (verb == SkPathVerb::kCubic) {
+                fPts.insert(fPts.end(), pts, pts + 4);
+            }
+        }
+        fP4.resize(fPts.size() / 4);
+    }
+
+    void onDraw(int loops, SkCanvas*) final {
+        wangs_formula::VectorXform xform(gAlmostIdentity);
+        int count = fP4.size();
+        for (int i = 0; i < loops; ++i) {
+            if (fBatch) {
+                wangs_formula::cubic_p4(4, fPts.data(), count, fP4.data(), xform);
+            } else {
+                for (int j = 0; j < count; ++j) {
+                    fP4[j] = wangs_formula::cubic_p4(4, fPts.data() + j*4, xform);
+                }
+            }
+        }
+        // Don't let the compiler optimize away wangs_formula::cubic_p4.
+        if (fP4[0] < 0) {
+            SK_ABORT("p4 should be >= 0.");
+        }
+    }
+
+    SkString fName;
+    const bool fBatch;
+    std::vector<SkPoint> fPts;
+    std::vector<float> fP4;
+};
+
+DEF_BENCH(return new WangsFormulaCubicP4Bench(false);)
+DEF_BENCH(return new WangsFormulaCubicP4Bench(true);)
+
 static void benchmark_wangs_formula_conic(const SkMatrix& matrix, const SkPath& path) {
     int sum = 0;
     wangs_formula::VectorXform xform(matrix);
@@ -8,9 +8,11 @@
 #include "bench/Benchmark.h"
 #include "include/core/SkPath.h"
 #include "src/base/SkArenaAlloc.h"
+#include "src/core/SkResourceCache.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include <vector>
 
 using namespace skia_private;
@@ -110,6 +112,25 @@ public:
 
 DEF_BENCH( return new PathToTrianglesBench(); );
 
+// Compare with PathToTrianglesBench: after the first loop every path is found in the cache, so
+// this measures the cost of a lookup and a copy of the triangles.
+class PathToTrianglesCachedBench : public TriangulatorBenchmark {
+public:
+    PathToTrianglesCachedBench() : TriangulatorBenchmark("PathToTrianglesCached") {}
+
+    void doLoop() override {
+        for (const SkPath& path : fPaths) {
+            bool isLinear;
+            GrTriangulatorCache::PathToTriangles(path, kTigerTolerance, SkRect::MakeEmpty(), this,
+                                                 &isLinear, &fCache);
+        }
+    }
+
+    SkResourceCache fCache{64 * 1024 * 1024};
+};
+
+DEF_BENCH( return new PathToTrianglesCachedBench(); );
+
 class TriangulateInnerFanBench : public TriangulatorBenchmark {
 public:
     TriangulateInnerFanBench() : TriangulatorBenchmark("TriangulateInnerFan") {}
@@ -36,6 +36,7 @@
 #include "src/base/SkLeanWindows.h"
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkRasterPipelineProfiler.h"
 #include "src/core/SkTaskGroup.h"
 #include "src/core/SkTraceEvent.h"
 #include "src/utils/SkJSONWriter.h"
@@ -155,6 +156,10 @@ static DEFINE_string(benchType,  "",
 
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_bool(rpProfile, false,
+                   "Profile every stage of every SkRasterPipeline (slowing them down), writing the "
+                   "counts and cycles of each bench's timed runs to --outResultsFile and to trace "
+                   "counters.");
 static DEFINE_bool(skvm, false, "sets gUseSkVMBlitter");
 static DEFINE_bool(jit, true, "JIT SkVM?");
 static DEFINE_bool(dylib, false, "JIT via dylib (much slower compile but easier to debug/profile)");
@@ -1425,6 +1430,7 @@ int main(int argc, char** argv) {
 
     gSkForceRasterPipelineBlitter     = FLAGS_forceRasterPipelineHP || FLAGS_forceRasterPipeline;
     gForceHighPrecisionRasterPipeline = FLAGS_forceRasterPipelineHP;
+    SkRasterPipelineProfiler::SetEnabled(FLAGS_rpProfile);
     gUseSkVMBlitter = FLAGS_skvm;
     gSkVMAllowJIT = FLAGS_jit;
     gSkVMJITViaDylib = FLAGS_dylib;
@@ -1502,6 +1508,11 @@ int main(int argc, char** argv) {
                 } while (now_ms() < stop);
             }
 
+            if (FLAGS_rpProfile) {
+                // Only profile the timed runs.
+                SkRasterPipelineProfiler::Reset();
+            }
+
             if (FLAGS_ms) {
                 samples.clear();
                 auto stop = now_ms() + FLAGS_ms;
@@ -1537,6 +1548,14 @@ int main(int argc, char** argv) {
                 }
             }
 
+            // The bench's own stats go in the JSON and follow its name on the console.
+            SkString benchStats;
+            int firstStat = keys.size();
+            bench->getStats(&keys, &values);
+            for (int j = firstStat; j < keys.size(); j++) {
+                benchStats.appendf("\t%s=%g", keys[j].c_str(), values[j]);
+            }
+
             bench->perCanvasPostDraw(canvas);
 
             if (Benchmark::kNonRendering_Backend != target->config.backend &&
@@ -1569,12 +1588,17 @@ int main(int argc, char** argv) {
             log.endArray(); // samples
             benchStream.fillCurrentMetrics(log);
             if (!keys.empty()) {
-                // dump to json, only SKPBench currently returns valid keys / values
+                // dump to json; the GPU stats only come from SKPBench
                 SkASSERT(keys.size() == values.size());
                 for (int j = 0; j < keys.size(); j++) {
                     log.appendMetric(keys[j].c_str(), values[j]);
                 }
             }
+            if (FLAGS_rpProfile) {
+                log.appendName("rp_profile");
+                SkRasterPipelineProfiler::Dump(&log);
+                SkRasterPipelineProfiler::EmitTraceCounters();
+            }
 
             log.endObject(); // config
 
@@ -1600,8 +1624,9 @@ int main(int argc, char** argv) {
                 if (stddev_percent >  5) mark = "?";
                 if (stddev_percent > 10) mark = "!";
 
-                SkDebugf("%10.2f %s\t%s\t%s\n",
-                         stats.median*1e3, mark, bench->getUniqueName(), config);
+                SkDebugf("%10.2f %s\t%s\t%s%s\n",
+                         stats.median*1e3, mark, bench->getUniqueName(), config,
+                         benchStats.c_str());
             } else if (FLAGS_csv) {
                 const double stddev_percent =
                     sk_ieee_double_divide(100 * sqrt(stats.var), stats.mean);
@@ -1617,7 +1642,7 @@ int main(int argc, char** argv) {
             } else {
                 const double stddev_percent =
                     sk_ieee_double_divide(100 * sqrt(stats.var), stats.mean);
-                SkDebugf("%4d/%-4dMB\t%d\t%s\t%s\t%s\t%s\t%.0f%%\t%s\t%s\t%s\n"
+                SkDebugf("%4d/%-4dMB\t%d\t%s\t%s\t%s\t%s\t%.0f%%\t%s\t%s\t%s%s\n"
                         , sk_tools::getCurrResidentSetSizeMB()
                         , sk_tools::getMaxResidentSetSizeMB()
                         , loops
@@ -1629,6 +1654,7 @@ int main(int argc, char** argv) {
                         , FLAGS_ms ? to_string(samples.size()).c_str() : stats.plot.c_str()
                         , config
                         , bench->getUniqueName()
+                        , benchStats.c_str()
                         );
             }
 
@@ -22,8 +22,10 @@
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkMD5.h"
 #include "src/core/SkOSFile.h"
+#include "src/core/SkRasterPipelineProfiler.h"
 #include "src/core/SkTHash.h"
 #include "src/core/SkTaskGroup.h"
+#include "src/utils/SkJSONWriter.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
 #include "tests/TestHarness.h"
@@ -101,6 +103,9 @@ static DEFINE_int(shard,  0, "Which shard do I run?");
 static DEFINE_string(mskps, "", "Directory to read mskps from, or a single mskp file.");
 static DEFINE_bool(forceRasterPipeline, false, "sets gSkForceRasterPipelineBlitter");
 static DEFINE_bool(forceRasterPipelineHP, false, "sets gSkForceRasterPipelineBlitter and gForceHighPrecisionRasterPipeline");
+static DEFINE_string(rpProfile, "",
+                     "If set, profile every stage of every SkRasterPipeline, and write their counts "
+                     "and cycles to this JSON file (and to trace counters) when done.");
 static DEFINE_bool(skvm, false, "sets gUseSkVMBlitter");
 static DEFINE_bool(jit,  true,  "sets gSkVMAllowJIT");
 static DEFINE_bool(dylib, false, "JIT via dylib (much slower compile but easier to debug/profile)");
@@ -252,6 +257,21 @@ static void dump_json() {
     }
 }
 
+static void dump_rp_profile() {
+    if (FLAGS_rpProfile.isEmpty()) {
+        return;
+    }
+    SkFILEWStream stream(FLAGS_rpProfile[0]);
+    if (!stream.isValid()) {
+        info("Couldn't open %s to write the SkRasterPipeline profile.\n", FLAGS_rpProfile[0]);
+        return;
+    }
+    SkJSONWriter writer(&stream, SkJSONWriter::Mode::kPretty);
+    SkRasterPipelineProfiler::Dump(&writer);
+    writer.flush();
+    SkRasterPipelineProfiler::EmitTraceCounters();
+}
+
 // We use a spinlock to make locking this in a signal handler _somewhat_ safe.
 static SkSpinlock*        gMutex = new SkSpinlock;
 static int                gPending;
@@ -1566,6 +1586,7 @@ int main(int argc, char** argv) {
     gSkVMAllowJIT                     = FLAGS_jit;
     gSkVMJITViaDylib                  = FLAGS_dylib;
     gSkBlobAsSlugTesting              = FLAGS_blobAsSlugTesting;
+    SkRasterPipelineProfiler::SetEnabled(!FLAGS_rpProfile.isEmpty());
 
     // The bots like having a verbose.log to upload, so always touch the file even if --verbose.
     if (!FLAGS_writePath.isEmpty()) {
@@ -1655,6 +1676,7 @@ int main(int argc, char** argv) {
     SkASSERT(gPending == 0);
     // Make sure we've flushed all our results to disk.
     dump_json();
+    dump_rp_profile();
 
     if (!gFailures->empty()) {
         info("Failures:\n");
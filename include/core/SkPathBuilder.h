@@ -80,6 +80,18 @@ public:
         return this->polylineTo(list.begin(), SkToInt(list.size()));
     }
 
+    // Append 'count' lineTo(...) and return their points for the caller to fill in, so a polyline
+    // can be generated straight into the builder's storage, which detach() then hands to the path
+    // without copying. The points are only valid until the builder is next modified.
+    SkPoint* allocPolylineTo(int count);
+
+    // Append verbs with their points and conic weights, read as in SkPath::Make(). The verbs
+    // must be a legal sequence on their own: each contour begins with a move. If they are not, or
+    // there are too few points or weights, the builder is left unchanged.
+    SkPathBuilder& addSegments(const SkPoint pts[],  int pointCount,
+                               const uint8_t verbs[], int verbCount,
+                               const SkScalar weights[], int weightCount);
+
     // Relative versions of segments, relative to the previous position.
 
     SkPathBuilder& rLineTo(SkPoint pt);
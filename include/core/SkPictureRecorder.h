@@ -22,6 +22,7 @@ namespace android {
 
 class SkCanvas;
 class SkDrawable;
+class SkPathRefInterner;
 class SkPictureRecord;
 class SkRecord;
 class SkRecorder;
@@ -55,6 +56,13 @@ public:
     */
     SkCanvas* getRecordingCanvas();
 
+    /** If true, paths recorded after the next beginRecording() that have the same verbs, points,
+        and conic weights as a path recorded earlier in that recording share its storage, even if
+        they were built separately. This saves memory when the same geometry is drawn many times,
+        at the cost of hashing each newly seen path. Defaults to false.
+    */
+    void setInternPaths(bool internPaths) { fInternPaths = internPaths; }
+
     /**
      *  Signal that the caller is done recording. This invalidates the canvas returned by
      *  beginRecording/getRecordingCanvas. Ownership of the object is passed to the caller, who
@@ -103,9 +111,11 @@ private:
     void partialReplay(SkCanvas* canvas) const;
 
     bool                        fActivelyRecording;
+    bool                        fInternPaths = false;
     SkRect                      fCullRect;
     sk_sp<SkBBoxHierarchy>      fBBH;
     std::unique_ptr<SkRecorder> fRecorder;
+    std::unique_ptr<SkPathRefInterner> fPathInterner;
     sk_sp<SkRecord>             fRecord;
 
     SkPictureRecorder(SkPictureRecorder&&) = delete;
@@ -9,6 +9,7 @@
 
 #include "include/core/SkColor.h"
 #include "include/core/SkMilestone.h"
+#include "include/core/SkRefCnt.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkString.h"
 #include "include/core/SkTime.h"
@@ -63,6 +64,33 @@ struct StructureElementNode {
     SkString fLang;
 };
 
+/** A cache of encoded images and font subsets that several documents can
+    share, so that an image or a subset of a font that many documents embed
+    is only encoded or subset once. Entries are keyed by image (its unique ID
+    or, failing that, its content), by typeface and glyph set, and by the
+    encoding settings in the Metadata of the document that created them.
+
+    A cache may be used by documents on many threads at once. Once it holds
+    byteLimit bytes of data it stops growing, and later resources are
+    encoded by each document as usual.
+
+    Experimental.
+*/
+class SK_API ResourceCache : public SkRefCnt {
+public:
+    static sk_sp<ResourceCache> Make(size_t byteLimit = 64 * 1024 * 1024);
+
+    /** Bytes of encoded image and font data held by the cache. */
+    virtual size_t bytesUsed() const = 0;
+
+    /** Number of images and font subsets that were found in the cache
+        instead of being encoded again. */
+    virtual int hitCount() const = 0;
+
+protected:
+    ResourceCache() = default;
+};
+
 /** Optional metadata to be passed into the PDF factory function.
 */
 struct Metadata {
@@ -154,6 +182,25 @@ struct Metadata {
         HighButSlow = 9,
     } fCompressionLevel = CompressionLevel::Default;
 
+    /** If true, sample each stream before compressing it. Streams that look
+        incompressible (such as already-compressed font or image data) are
+        stored uncompressed, and highly repetitive streams (such as flat
+        images) are compressed at CompressionLevel::LowButFast, which is much
+        faster and nearly as small for that kind of data. Has no effect if
+        fCompressionLevel is None.
+
+        Experimental.
+    */
+    bool fAdaptiveCompression = false;
+
+    /** An optional cache of encoded resources shared with other documents.
+        The caller should retain ownership. If this is nullptr, every image
+        and font is encoded by this document.
+
+        Experimental.
+    */
+    ResourceCache* fResourceCache = nullptr;
+
     /** Preferred Subsetter. Only respected if both are compiled in.
 
         The Sfntly subsetter is deprecated.
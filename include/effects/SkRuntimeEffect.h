@@ -30,6 +30,7 @@
 #include "include/sksl/SkSLVersion.h"
 
 class GrRecordingContext;
+class SkArenaAlloc;
 class SkFilterColorProgram;
 class SkImage;
 class SkRuntimeImageFilter;
@@ -128,6 +129,13 @@ public:
         // painted.)
         bool forceUnoptimized = false;
 
+        // When drawing with the raster backend, compiles the effect again for the uniform values
+        // it's drawn with, folding them into the program as constants. This suits effects whose
+        // uniforms rarely change, since any work that depends only on them is done once, when the
+        // program is compiled. Programs for the most recently drawn values are cached. Array
+        // uniforms are not folded.
+        bool specializeUniforms = false;
+
     private:
         friend class SkRuntimeEffect;
         friend class SkRuntimeEffectPriv;
@@ -180,6 +188,42 @@ public:
         return MakeForBlender(std::move(sksl), Options{});
     }
 
+    /**
+     * Abstract class to store and load the compiled form of runtime effects across runs of a
+     * process, e.g. on disk. Keys are small, and derived from a hash of the SkSL and the options it
+     * was compiled with.
+     */
+    class SK_API PersistentCache {
+    public:
+        virtual ~PersistentCache() = default;
+
+        /**
+         * Returns the data for the key if it exists in the cache, otherwise returns null.
+         */
+        virtual sk_sp<SkData> load(const SkData& key) = 0;
+
+        /**
+         * Stores data in the cache, indexed by key.
+         */
+        virtual void store(const SkData& key, const SkData& data) = 0;
+
+    protected:
+        PersistentCache() = default;
+        PersistentCache(const PersistentCache&) = delete;
+        PersistentCache& operator=(const PersistentCache&) = delete;
+    };
+
+    /**
+     * Sets the cache consulted by MakeForColorFilter, MakeForShader and MakeForBlender, or clears
+     * it if cache is null. The caller keeps ownership, and the cache must be thread-safe and outlive
+     * every effect made while it was set.
+     *
+     * An effect loaded from the cache skips parsing and optimizing its SkSL. Its reflection data
+     * (uniforms, children, etc.) and raster pipeline program come from the cache, and the SkSL is
+     * only compiled if it is drawn in a way that needs more.
+     */
+    static void SetPersistentCache(PersistentCache* cache);
+
     // Object that allows passing a SkShader, SkColorFilter or SkBlender as a child
     class ChildPtr {
     public:
@@ -292,6 +336,18 @@ private:
                     std::vector<SkSL::SampleUsage>&& sampleUsages,
                     uint32_t flags);
 
+    // Makes an effect whose base program is compiled from `source` on first use. The names of the
+    // uniforms and children are copied.
+    SkRuntimeEffect(std::string source,
+                    const Options& options,
+                    SkSL::ProgramKind kind,
+                    SkSL::Version requiredVersion,
+                    std::vector<Uniform>&& uniforms,
+                    std::vector<Child>&& children,
+                    std::vector<SkSL::SampleUsage>&& sampleUsages,
+                    uint32_t flags,
+                    std::unique_ptr<SkSL::RP::Program> rpProgram);
+
     sk_sp<SkRuntimeEffect> makeUnoptimizedClone();
 
     static Result MakeFromSource(SkString sksl, const Options& options, SkSL::ProgramKind kind);
@@ -301,6 +357,16 @@ private:
                                SkSL::ProgramKind kind);
 
     static SkSL::ProgramSettings MakeSettings(const Options& options);
+    static uint32_t MakeHash(const std::string& source, const Options& options);
+
+    static sk_sp<SkData> PersistentCacheKey(const SkString& sksl,
+                                            const Options& options,
+                                            SkSL::ProgramKind kind);
+    static sk_sp<SkRuntimeEffect> MakeFromPersistentCache(const SkData& data,
+                                                          const SkString& sksl,
+                                                          const Options& options,
+                                                          SkSL::ProgramKind kind);
+    sk_sp<SkData> serializeForPersistentCache() const;
 
     uint32_t hash() const { return fHash; }
     bool usesSampleCoords()   const { return (fFlags & kUsesSampleCoords_Flag);   }
@@ -311,12 +377,23 @@ private:
     const SkFilterColorProgram* getFilterColorProgram() const;
     const SkSL::RP::Program* getRPProgram() const;
 
+    // Returns the program to draw the effect with `uniforms`, which is specialized for them if the
+    // effect was made with Options::specializeUniforms, and sets `programUniforms` to the uniform
+    // values that program takes. `alloc` keeps a specialized program alive.
+    const SkSL::RP::Program* getRPProgram(sk_sp<const SkData> uniforms,
+                                          SkArenaAlloc* alloc,
+                                          SkSpan<const float>* programUniforms) const;
+
+    // These compile the SkSL first, if the effect was loaded from a PersistentCache.
+    const SkSL::Program& baseProgram() const;
+    const SkSL::FunctionDefinition& main() const;
+
 #if defined(SK_GANESH)
-    friend class GrSkSLFP;             // fBaseProgram, fSampleUsages
+    friend class GrSkSLFP;             // baseProgram(), fSampleUsages
     friend class GrGLSLSkSLFP;         //
 #endif
 
-    friend class SkRTShader;            // fBaseProgram, fMain, fSampleUsages, getRPProgram()
+    friend class SkRTShader;            // baseProgram(), main(), fSampleUsages, getRPProgram()
     friend class SkRuntimeBlender;      //
     friend class SkRuntimeColorFilter;  //
 
@@ -325,15 +402,26 @@ private:
 
     uint32_t fHash;
 
+    std::string fSource;
+    Options fOptions;
+    SkSL::ProgramKind fKind;
+    SkSL::Version fRequiredVersion;
     std::unique_ptr<SkSL::Program> fBaseProgram;
+    const SkSL::FunctionDefinition* fMain;
+    mutable SkOnce fCompileBaseProgramOnce;
     std::unique_ptr<SkSL::RP::Program> fRPProgram;
     mutable SkOnce fCompileRPProgramOnce;
-    const SkSL::FunctionDefinition& fMain;
     std::vector<Uniform> fUniforms;
     std::vector<Child> fChildren;
     std::vector<SkSL::SampleUsage> fSampleUsages;
+    // Backs the names in fUniforms and fChildren when there is no base program yet.
+    std::string fReflectionNames;
+
+    class SpecializedRPPrograms;
+    std::unique_ptr<SpecializedRPPrograms> fSpecializedRPPrograms;
 
     std::unique_ptr<SkFilterColorProgram> fFilterColorProgram;
+    mutable SkOnce fMakeFilterColorProgramOnce;
 
     uint32_t fFlags;  // Flags
 };
@@ -12,6 +12,9 @@
 #include "include/private/base/SkTArray.h"
 #include "include/private/base/SkTDArray.h"
 
+#include <cstddef>
+#include <memory>
+
 struct SkRect;
 
 
@@ -110,4 +113,39 @@ private:
     void reset();
 };
 
+/** Storage for a series of path operations. Op() and Simplify() build their intermediate
+    contours in memory that they release before returning; a context keeps that memory between
+    calls instead, so that a caller performing many small operations in a row rarely touches
+    the heap. A context may be used by only one thread at a time.
+
+    Experimental.
+  */
+class SK_API SkPathOpsContext {
+public:
+    SkPathOpsContext();
+    ~SkPathOpsContext();
+
+    SkPathOpsContext(const SkPathOpsContext&) = delete;
+    SkPathOpsContext& operator=(const SkPathOpsContext&) = delete;
+
+    /** Same as Op(one, two, op, result), using the storage of this context. */
+    bool op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result);
+
+    /** Same as Simplify(path, result), using the storage of this context. */
+    bool simplify(const SkPath& path, SkPath* result);
+
+    /** Returns the number of blocks this context has allocated on the heap because its
+        storage was too small for an operation. Each time that happens the storage grows, so
+        that later operations of similar size need no further allocations.
+      */
+    int heapAllocationCount() const { return fHeapAllocationCount; }
+
+private:
+    void grow(int heapBlocks);
+
+    std::unique_ptr<char[]> fStorage;
+    size_t fStorageSize;
+    int fHeapAllocationCount = 0;
+};
+
 #endif
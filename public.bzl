@@ -352,7 +352,11 @@ BASE_SRCS_ALL = [
     "src/codec/SkPixmapUtils.h",
     "src/core/Sk4px.h",
     "src/core/SkAAClip.cpp",
+    "src/core/SkAAClipCache.cpp",
+    "src/core/SkAnalyticClipShader.cpp",
     "src/core/SkAAClip.h",
+    "src/core/SkAAClipCache.h",
+    "src/core/SkAnalyticClipShader.h",
     "src/core/SkATrace.cpp",
     "src/core/SkATrace.h",
     "src/core/SkAdvancedTypefaceMetrics.h",
@@ -483,6 +487,8 @@ BASE_SRCS_ALL = [
     "src/core/SkGpuBlurUtils.cpp",
     "src/core/SkGpuBlurUtils.h",
     "src/core/SkGraphics.cpp",
+    "src/core/SkHairlineBatcher.cpp",
+    "src/core/SkHairlineBatcher.h",
     "src/core/SkICC.cpp",
     "src/core/SkICCPriv.h",
     "src/core/SkIDChangeListener.cpp",
@@ -553,6 +559,8 @@ BASE_SRCS_ALL = [
     "src/core/SkPathMeasurePriv.h",
     "src/core/SkPathPriv.h",
     "src/core/SkPathRef.cpp",
+    "src/core/SkPathRefInterner.cpp",
+    "src/core/SkPathRefInterner.h",
     "src/core/SkPathUtils.cpp",
     "src/core/SkPath_serial.cpp",
     "src/core/SkPicture.cpp",
@@ -592,6 +600,8 @@ BASE_SRCS_ALL = [
     "src/core/SkRasterPipelineBlitter.cpp",
     "src/core/SkRasterPipelineOpContexts.h",
     "src/core/SkRasterPipelineOpList.h",
+    "src/core/SkRasterPipelineProfiler.cpp",
+    "src/core/SkRasterPipelineProfiler.h",
     "src/core/SkReadBuffer.cpp",
     "src/core/SkReadBuffer.h",
     "src/core/SkReadPixelsRec.cpp",
@@ -614,6 +624,8 @@ BASE_SRCS_ALL = [
     "src/core/SkRegion.cpp",
     "src/core/SkRegionPriv.h",
     "src/core/SkRegion_path.cpp",
+    "src/core/SkResample.cpp",
+    "src/core/SkResample.h",
     "src/core/SkResourceCache.cpp",
     "src/core/SkResourceCache.h",
     "src/core/SkRuntimeEffect.cpp",
@@ -630,6 +642,7 @@ BASE_SRCS_ALL = [
     "src/core/SkScan.h",
     "src/core/SkScanPriv.h",
     "src/core/SkScan_AAAPath.cpp",
+    "src/core/SkScan_AccumulatePath.cpp",
     "src/core/SkScan_AntiPath.cpp",
     "src/core/SkScan_Antihair.cpp",
     "src/core/SkScan_Hairline.cpp",
@@ -1088,6 +1101,8 @@ BASE_SRCS_ALL = [
     "src/gpu/ganesh/geometry/GrStyledShape.h",
     "src/gpu/ganesh/geometry/GrTriangulator.cpp",
     "src/gpu/ganesh/geometry/GrTriangulator.h",
+    "src/gpu/ganesh/geometry/GrTriangulatorCache.cpp",
+    "src/gpu/ganesh/geometry/GrTriangulatorCache.h",
     "src/gpu/ganesh/glsl/GrGLSLBlend.cpp",
     "src/gpu/ganesh/glsl/GrGLSLBlend.h",
     "src/gpu/ganesh/glsl/GrGLSLColorSpaceXformHelper.h",
@@ -1285,6 +1300,7 @@ BASE_SRCS_ALL = [
     "src/pathops/SkPathOpsCommon.h",
     "src/pathops/SkPathOpsConic.cpp",
     "src/pathops/SkPathOpsConic.h",
+    "src/pathops/SkPathOpsContext.cpp",
     "src/pathops/SkPathOpsCubic.cpp",
     "src/pathops/SkPathOpsCubic.h",
     "src/pathops/SkPathOpsCurve.cpp",
@@ -1343,6 +1359,8 @@ BASE_SRCS_ALL = [
     "src/pdf/SkPDFMakeToUnicodeCmap.h",
     "src/pdf/SkPDFMetadata.cpp",
     "src/pdf/SkPDFMetadata.h",
+    "src/pdf/SkPDFResourceCache.cpp",
+    "src/pdf/SkPDFResourceCache.h",
     "src/pdf/SkPDFResourceDict.cpp",
     "src/pdf/SkPDFResourceDict.h",
     "src/pdf/SkPDFShader.cpp",
@@ -57,6 +57,9 @@ public:
         return result;
     }
 
+    // The number of blocks handed out so far. Saturates once the block size stops growing.
+    int blockCount() const { return fIndex; }
+
 private:
     uint32_t fIndex : 6;
     uint32_t fBlockUnitSize : 26;
@@ -192,6 +195,10 @@ public:
         return objStart;
     }
 
+    // The number of blocks this arena has allocated on the heap, not counting the user-provided
+    // block. Saturates for arenas of several gigabytes.
+    int heapBlockCount() const { return fFibonacciProgression.blockCount(); }
+
 private:
     static void AssertRelease(bool cond) { if (!cond) { ::abort(); } }
 
@@ -1535,6 +1535,13 @@ bool SkAAClip::translate(int dx, int dy, SkAAClip* dst) const {
     return true;
 }
 
+size_t SkAAClip::approximateBytesUsed() const {
+    if (!fRunHead) {
+        return 0;
+    }
+    return sizeof(RunHead) + fRunHead->fRowCount * sizeof(YOffset) + fRunHead->fDataSize;
+}
+
 void SkAAClip::freeRuns() {
     if (fRunHead) {
         SkASSERT(fRunHead->fRefCnt.load() >= 1);
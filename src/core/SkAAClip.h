@@ -42,6 +42,9 @@ public:
 
     bool translate(int dx, int dy, SkAAClip* dst) const;
 
+    /** Returns the size of the clip's runs, which copies of the clip share. */
+    size_t approximateBytesUsed() const;
+
     /**
      *  Allocates a mask the size of the aaclip, and expands its data into
      *  the mask, using kA8_Format. Used for tests and visualization purposes.
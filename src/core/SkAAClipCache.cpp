@@ -0,0 +1,106 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkAAClipCache.h"
+
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkAAClip.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+
+#include <utility>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gAAClipKeyNamespaceLabel;
+
+uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('a', 'a', 'c', 'l');
+    return (sharedID << 32) | pathGenID;
+}
+
+struct AAClipKey : public SkResourceCache::Key {
+    AAClipKey(const SkPath& path, const SkMatrix& matrix, const SkIRect& bounds)
+            : fGenID(path.getGenerationID())
+            , fFillType((int32_t)path.getFillType())
+            , fBounds(bounds) {
+        matrix.get9(fMatrix);
+        this->init(&gAAClipKeyNamespaceLabel, make_shared_id(fGenID),
+                   sizeof(fGenID) + sizeof(fFillType) + sizeof(fMatrix) + sizeof(fBounds));
+    }
+
+    uint32_t fGenID;
+    int32_t  fFillType;  // The generation ID doesn't change with the fill type.
+    SkScalar fMatrix[9];
+    SkIRect  fBounds;
+};
+
+// Purges every cached clip of a path when its generation ID changes.
+class AAClipInvalidator : public SkIDChangeListener {
+public:
+    explicit AAClipInvalidator(uint64_t sharedID) : fSharedID(sharedID) {}
+
+private:
+    uint64_t fSharedID;
+
+    void changed() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+};
+
+struct AAClipRec : public SkResourceCache::Rec {
+    AAClipRec(const AAClipKey& key, const SkAAClip& clip, sk_sp<SkIDChangeListener> invalidator)
+            : fKey(key), fClip(clip), fInvalidator(std::move(invalidator)) {}
+
+    // Once the clip is purged, its path doesn't need to hold on to the listener. This keeps a
+    // path clipped under ever-changing matrices from collecting listeners.
+    ~AAClipRec() override { fInvalidator->markShouldDeregister(); }
+
+    AAClipKey                 fKey;
+    SkAAClip                  fClip;
+    sk_sp<SkIDChangeListener> fInvalidator;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fClip.approximateBytesUsed(); }
+    const char* getCategory() const override { return "aaclip-path"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const AAClipRec& rec = static_cast<const AAClipRec&>(baseRec);
+        *static_cast<SkAAClip*>(contextData) = rec.fClip;
+        return true;
+    }
+};
+
+bool is_cacheable(const SkPath& path, const SkMatrix& matrix) {
+    return !path.isVolatile() && path.isFinite() && matrix.isFinite();
+}
+} // namespace
+
+bool SkAAClipCache::SetPath(SkAAClip* clip, const SkPath& path, const SkMatrix& matrix,
+                            const SkIRect& bounds, SkResourceCache* localCache) {
+    SkPath devPath;
+    if (!is_cacheable(path, matrix)) {
+        path.transform(matrix, &devPath);
+        return clip->setPath(devPath, bounds, true);
+    }
+
+    AAClipKey key(path, matrix, bounds);
+    if (CHECK_LOCAL(localCache, find, Find, key, AAClipRec::Visitor, clip)) {
+        return !clip->isEmpty();
+    }
+
+    path.transform(matrix, &devPath);
+    bool nonEmpty = clip->setPath(devPath, bounds, true);
+    auto invalidator = sk_make_sp<AAClipInvalidator>(key.getSharedID());
+    SkPathPriv::AddGenIDChangeListener(path, invalidator);
+    CHECK_LOCAL(localCache, add, Add, new AAClipRec(key, *clip, std::move(invalidator)));
+    return nonEmpty;
+}
@@ -0,0 +1,36 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAAClipCache_DEFINED
+#define SkAAClipCache_DEFINED
+
+class SkAAClip;
+class SkMatrix;
+class SkPath;
+class SkResourceCache;
+struct SkIRect;
+
+/**
+ *  A cache of the SkAAClips that anti-aliased clip paths scan convert to, so that clipping to the
+ *  same path again (e.g. on every frame) shares the earlier clip's runs. Clips are keyed by the
+ *  path's generation ID and fill type, the matrix, and the clip bounds, and are purged when the
+ *  path is modified or deleted.
+ *
+ *  Entries live in the global SkResourceCache unless a local cache is given.
+ */
+class SkAAClipCache {
+public:
+    /**
+     *  Same as clip->setPath(devPath, bounds, true), where devPath is the path transformed by the
+     *  matrix, but returns a copy of the cached clip if there is one, and caches the clip
+     *  otherwise.
+     */
+    static bool SetPath(SkAAClip* clip, const SkPath& path, const SkMatrix& matrix,
+                        const SkIRect& bounds, SkResourceCache* localCache = nullptr);
+};
+
+#endif
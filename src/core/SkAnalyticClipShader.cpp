@@ -0,0 +1,456 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkAnalyticClipShader.h"
+
+#include "include/core/SkRRect.h"
+#include "include/private/SkColorData.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkVM.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace skia_private;
+
+namespace {
+
+// Splits each blit by how much of it the shape covers. The pixels it covers completely (or misses
+// completely, for an inverse shape) are passed straight through, and only the pixels along its edge
+// have their coverage computed and multiplied in.
+class AnalyticClipBlitter final : public SkBlitter {
+public:
+    AnalyticClipBlitter(sk_sp<const SkAnalyticClipShader> shape, SkBlitter* blitter)
+            : fShape(std::move(shape))
+            , fBlitter(blitter) {}
+
+    void blitH(int x, int y, int width) override {
+        this->forEachSpan(x, y, width, 1, [&](bool edge, int l, int r, int, int) {
+            if (edge) {
+                this->blitEdge(l, r, y, y + 1, 0xFF);
+            } else {
+                fBlitter->blitH(l, y, r - l);
+            }
+        });
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha aa[], const int16_t runs[]) override {
+        int width = 0;
+        for (int n = runs[0]; n > 0; n = runs[width]) {
+            width += n;
+        }
+        this->forEachSpan(x, y, width, 1, [&](bool edge, int l, int r, int, int) {
+            if (!edge && l == x && r == x + width) {
+                fBlitter->blitAntiH(x, y, aa, runs);
+                return;
+            }
+            // Copy the runs within [l, r), splitting them into single pixels along the edge.
+            this->ensureScratch(r - l);
+            int left = x;
+            for (int i = 0; left < r; left += runs[i], i += runs[i]) {
+                int spanL = std::max(left, l),
+                    spanR = std::min(left + runs[i], r);
+                for (int px = spanL; px < spanR; ++px) {
+                    if (!edge) {
+                        fScratchAA[spanL - l] = aa[i];
+                        fScratchRuns[spanL - l] = SkToS16(spanR - spanL);
+                        break;
+                    }
+                    fScratchAA[px - l] = SkMulDiv255Round(aa[i], fShape->alphaAt(px, y));
+                }
+            }
+            fScratchRuns[r - l] = 0;
+            if (edge) {
+                merge_runs(fScratchAA.get(), fScratchRuns.get(), r - l);
+            }
+            fBlitter->blitAntiH(l, y, fScratchAA.get(), fScratchRuns.get());
+        });
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        this->forEachSpan(x, y, 1, height, [&](bool edge, int l, int r, int t, int b) {
+            if (edge) {
+                this->blitEdge(l, r, t, b, alpha);
+            } else {
+                fBlitter->blitV(l, t, b - t, alpha);
+            }
+        });
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        this->forEachSpan(x, y, width, height, [&](bool edge, int l, int r, int t, int b) {
+            if (edge) {
+                this->blitEdge(l, r, t, b, 0xFF);
+            } else {
+                fBlitter->blitRect(l, t, r - l, b - t);
+            }
+        });
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        SkASSERT(mask.fFormat == SkMask::kBW_Format || mask.fFormat == SkMask::kA8_Format ||
+                 mask.fFormat == SkMask::k3D_Format || mask.fFormat == SkMask::kLCD16_Format);
+        this->forEachSpan(clip.fLeft, clip.fTop, clip.width(), clip.height(),
+                          [&](bool edge, int l, int r, int t, int b) {
+            if (!edge) {
+                fBlitter->blitMask(mask, SkIRect::MakeLTRB(l, t, r, b));
+                return;
+            }
+            // Blit the edge a row at a time, multiplying the shape's coverage into a copy of the
+            // mask. Like SkAAClip, this treats a 3D mask as A8.
+            const bool lcd = mask.fFormat == SkMask::kLCD16_Format;
+            this->ensureScratch(lcd ? 2 * (r - l) : r - l);
+            SkMask rowMask;
+            rowMask.fImage    = fScratchAA.get();
+            rowMask.fFormat   = lcd ? SkMask::kLCD16_Format : SkMask::kA8_Format;
+            rowMask.fRowBytes = 0;
+            for (int y = t; y < b; ++y) {
+                rowMask.fBounds.setLTRB(l, y, r, y + 1);
+                for (int x = l; x < r; ++x) {
+                    SkAlpha alpha = fShape->alphaAt(x, y);
+                    if (lcd) {
+                        uint16_t src = *mask.getAddrLCD16(x, y);
+                        reinterpret_cast<uint16_t*>(rowMask.fImage)[x - l] =
+                                SkPackRGB16(SkMulDiv255Round(SkGetPackedR16(src), alpha),
+                                            SkMulDiv255Round(SkGetPackedG16(src), alpha),
+                                            SkMulDiv255Round(SkGetPackedB16(src), alpha));
+                    } else {
+                        SkAlpha src;
+                        if (mask.fFormat == SkMask::kBW_Format) {
+                            int bit = (x - mask.fBounds.fLeft) & 7;
+                            src = (*mask.getAddr1(x, y) & (0x80 >> bit)) ? 0xFF : 0;
+                        } else {
+                            src = *mask.getAddr8(x, y);
+                        }
+                        rowMask.fImage[x - l] = SkMulDiv255Round(src, alpha);
+                    }
+                }
+                fBlitter->blitMask(rowMask, rowMask.fBounds);
+            }
+        });
+    }
+
+    bool blendsCoverageUniformly() const override {
+        // Every path above multiplies in the same coverage for a given pixel.
+        return fBlitter->blendsCoverageUniformly();
+    }
+
+private:
+    // Combines equal neighbouring alphas of single pixel runs.
+    static void merge_runs(SkAlpha aa[], int16_t runs[], int width) {
+        for (int i = 0; i < width;) {
+            int n = 1;
+            while (i + n < width && aa[i + n] == aa[i]) {
+                n++;
+            }
+            runs[i] = SkToS16(n);
+            i += n;
+        }
+    }
+
+    void ensureScratch(int width) {
+        if (fScratchWidth < width) {
+            fScratchWidth = width;
+            fScratchAA.reset(width);
+            fScratchRuns.reset(width + 1);
+        }
+    }
+
+    // Blits the rect [l, r) x [t, b) with alpha times the shape's coverage.
+    void blitEdge(int l, int r, int t, int b, SkAlpha alpha) {
+        if (r - l == 1) {
+            // Group rows with the same coverage into a single blitV().
+            for (int y = t; y < b;) {
+                SkAlpha a = SkMulDiv255Round(alpha, fShape->alphaAt(l, y));
+                int n = 1;
+                while (y + n < b && SkMulDiv255Round(alpha, fShape->alphaAt(l, y + n)) == a) {
+                    n++;
+                }
+                if (a) {
+                    fBlitter->blitV(l, y, n, a);
+                }
+                y += n;
+            }
+            return;
+        }
+        this->ensureScratch(r - l);
+        for (int y = t; y < b; ++y) {
+            for (int x = l; x < r; ++x) {
+                fScratchAA[x - l] = SkMulDiv255Round(alpha, fShape->alphaAt(x, y));
+            }
+            fScratchRuns[r - l] = 0;
+            merge_runs(fScratchAA.get(), fScratchRuns.get(), r - l);
+            if (fScratchAA[0] || fScratchRuns[0] < r - l) {
+                fBlitter->blitAntiH(l, y, fScratchAA.get(), fScratchRuns.get());
+            }
+        }
+    }
+
+    // Calls fn(edge, left, right, top, bottom) for each part of the rect that needs drawing,
+    // merging runs of rows that split the same way.
+    template <typename Fn>
+    void forEachSpan(int x, int y, int width, int height, Fn&& fn) const {
+        const int right = x + width,
+                  bottom = y + height;
+        const bool inverse = fShape->isInverse();
+        SkAnalyticClipShader::RowSpans spans = fShape->rowSpans(y, x, right), next;
+        for (int top = y; top < bottom;) {
+            int rowsEnd = top + 1;
+            while (rowsEnd < bottom && (next = fShape->rowSpans(rowsEnd, x, right)) == spans) {
+                rowsEnd++;
+            }
+            auto draw = [&](bool edge, int l, int r) {
+                if (l < r) {
+                    fn(edge, l, r, top, rowsEnd);
+                }
+            };
+            if (inverse) {
+                draw(false, x, spans.fAnyL);
+                draw(true, spans.fAnyL, spans.fFullL);
+                draw(true, spans.fFullR, spans.fAnyR);
+                draw(false, spans.fAnyR, right);
+            } else {
+                draw(true, spans.fAnyL, spans.fFullL);
+                draw(false, spans.fFullL, spans.fFullR);
+                draw(true, spans.fFullR, spans.fAnyR);
+            }
+            top = rowsEnd;
+            spans = next;
+        }
+    }
+
+    sk_sp<const SkAnalyticClipShader> fShape;
+    SkBlitter*                        fBlitter;
+
+    int                   fScratchWidth = 0;
+    AutoTMalloc<SkAlpha>  fScratchAA;
+    AutoTMalloc<int16_t>  fScratchRuns;
+};
+
+} // namespace
+
+static SkRasterPipeline_RRectCoverageCtx rrect_ctx(const SkRRect& rrect, bool inverse) {
+    SkRasterPipeline_RRectCoverageCtx ctx;
+    const SkRect& r = rrect.rect();
+    ctx.fBounds[0] = r.fLeft;
+    ctx.fBounds[1] = r.fTop;
+    ctx.fBounds[2] = r.fRight;
+    ctx.fBounds[3] = r.fBottom;
+    for (int i = 0; i < 4; ++i) {
+        SkVector radii = rrect.radii((SkRRect::Corner)i);
+        ctx.fRadiiX[i] = radii.fX;
+        ctx.fRadiiY[i] = radii.fY;
+    }
+    ctx.fInverse = inverse;
+    return ctx;
+}
+
+SkAnalyticClipShader::SkAnalyticClipShader(const SkRRect& devRRect, bool inverse)
+        : SkAnalyticClipShader(rrect_ctx(devRRect, inverse)) {}
+
+SkAnalyticClipShader::SkAnalyticClipShader(const SkRasterPipeline_RRectCoverageCtx& rrect)
+        : fBounds(SkRect::MakeLTRB(rrect.fBounds[0], rrect.fBounds[1],
+                                   rrect.fBounds[2], rrect.fBounds[3]))
+        , fRRect(rrect) {}
+
+sk_sp<SkAnalyticClipShader> SkAnalyticClipShader::makeOffset(int dx, int dy) const {
+    SkRasterPipeline_RRectCoverageCtx rrect = fRRect;
+    rrect.fBounds[0] += dx;
+    rrect.fBounds[1] += dy;
+    rrect.fBounds[2] += dx;
+    rrect.fBounds[3] += dy;
+    return sk_sp<SkAnalyticClipShader>(new SkAnalyticClipShader(rrect));
+}
+
+SkBlitter* SkAnalyticClipShader::makeBlitter(SkBlitter* blitter, SkArenaAlloc* alloc) const {
+    return alloc->make<AnalyticClipBlitter>(sk_ref_sp(this), blitter);
+}
+
+// These match approx_asin_unit() and unit_circle_area() in SkRasterPipeline_opts.h.
+static float approx_asin_unit(float x) {
+    float p = x * -0.0012624911f + 0.0066700901f;
+    p = x * p - 0.0170881256f;
+    p = x * p + 0.0308918810f;
+    p = x * p - 0.0501743046f;
+    p = x * p + 0.0889789874f;
+    p = x * p - 0.2145988016f;
+    p = x * p + 1.5707963050f;
+    return SK_ScalarPI/2 - std::sqrt(1 - x) * p;
+}
+
+static float unit_circle_area(float s) {
+    return 0.5f * (s * std::sqrt(std::max(1 - s*s, 0.f)) + approx_asin_unit(s));
+}
+
+SkAlpha SkAnalyticClipShader::alphaAt(int x, int y) const {
+    // This matches the rrect_coverage stage.
+    const float px = x + 0.5f,
+                py = y + 0.5f;
+    auto clamp01 = [](float v) { return std::min(std::max(v, 0.f), 1.f); };
+    const float L = fRRect.fBounds[0], T = fRRect.fBounds[1],
+                R = fRRect.fBounds[2], B = fRRect.fBounds[3];
+    float cov = clamp01(std::min(px - L, R - px) + 0.5f) * clamp01(std::min(py - T, B - py) + 0.5f);
+
+    const bool left = px < (L + R) * 0.5f,
+               top  = py < (T + B) * 0.5f;
+    const int corner = top ? (left ? 0 : 1) : (left ? 3 : 2);
+    float rx = fRRect.fRadiiX[corner],
+          ry = fRRect.fRadiiY[corner];
+    const float cx = left ? L + rx - px : px - (R - rx),
+                cy = top  ? T + ry - py : py - (B - ry);
+    const float u0 = std::max(cx - 0.5f, 0.f), u1 = std::min(cx + 0.5f, rx),
+                v0 = std::max(cy - 0.5f, 0.f), v1 = std::min(cy + 0.5f, ry);
+    if (u0 < u1 && v0 < v1) {
+        rx = std::max(rx, 1e-6f);
+        ry = std::max(ry, 1e-6f);
+        const float s0 = u0 / rx, s1 = u1 / rx,
+                    t0 = v0 / ry, t1 = v1 / ry;
+        // Only pixels straddling the ellipse need its area; the rest are wholly in or out.
+        if (s0*s0 + t0*t0 >= 1) {
+            cov = std::max(cov - (u1 - u0) * (v1 - v0), 0.f);
+        } else if (s1*s1 + t1*t1 > 1) {
+            const float sa = std::min(std::max(std::sqrt(std::max(1 - t1*t1, 0.f)), s0), s1),
+                        sb = std::min(std::max(std::sqrt(std::max(1 - t0*t0, 0.f)), s0), s1);
+            const float inside = (t1 - t0) * (sa - s0) +
+                                 (unit_circle_area(sb) - unit_circle_area(sa)) - t0 * (sb - sa);
+            cov = std::max(cov - ((u1 - u0) * (v1 - v0) - rx * ry * inside), 0.f);
+        }
+    }
+    if (this->isInverse()) {
+        cov = 1 - cov;
+    }
+    return SkToU8((int)(cov * 255 + 0.5f));
+}
+
+SkAnalyticClipShader::RowSpans SkAnalyticClipShader::rowSpans(int y, int left, int right) const {
+    const float top = y,
+                bottom = top + 1;
+    float anyL = left, anyR = right,
+          fullL = left, fullR = right;
+
+    const float L = fRRect.fBounds[0], T = fRRect.fBounds[1],
+                R = fRRect.fBounds[2], B = fRRect.fBounds[3];
+    // The stage only gives coverage to pixels whose centers are less than half a pixel
+    // outside of the bounds.
+    if (top < std::floor(T) || top >= std::ceil(B)) {
+        return {left, left, left, left};
+    }
+    anyL = std::floor(L);
+    anyR = std::ceil(R);
+
+    if (top < T || bottom > B) {
+        fullR = fullL;
+    } else {
+        fullL = std::ceil(L);
+        fullR = std::floor(R);
+        // A pixel is inside a rounded corner if its own corner closest to the rrect's is.
+        auto inset = [](float rx, float ry, float dy) {
+            float t = dy / ry;
+            return rx - rx * std::sqrt(std::max(0.f, 1 - t * t));
+        };
+        const float* rx = fRRect.fRadiiX;
+        const float* ry = fRRect.fRadiiY;
+        if (top < T + ry[0]) {
+            fullL = std::max(fullL, std::ceil(L + inset(rx[0], ry[0], T + ry[0] - top)));
+        }
+        if (top < T + ry[1]) {
+            fullR = std::min(fullR, std::floor(R - inset(rx[1], ry[1], T + ry[1] - top)));
+        }
+        if (bottom > B - ry[2]) {
+            fullR = std::min(fullR, std::floor(R - inset(rx[2], ry[2], bottom - (B - ry[2]))));
+        }
+        if (bottom > B - ry[3]) {
+            fullL = std::max(fullL, std::ceil(L + inset(rx[3], ry[3], bottom - (B - ry[3]))));
+        }
+    }
+
+    auto pin = [&](float x, int lo, int hi) {
+        return x <= lo ? lo : x >= hi ? hi : (int)x;
+    };
+    RowSpans spans;
+    spans.fAnyL  = pin(anyL, left, right);
+    spans.fAnyR  = pin(anyR, spans.fAnyL, right);
+    spans.fFullL = pin(fullL, spans.fAnyL, spans.fAnyR);
+    spans.fFullR = pin(fullR, spans.fFullL, spans.fAnyR);
+    return spans;
+}
+
+bool SkAnalyticClipShader::appendStages(const SkStageRec& rec, const MatrixRec& mRec) const {
+    if (!mRec.apply(rec)) {
+        return false;
+    }
+    rec.fPipeline->append(SkRasterPipelineOp::rrect_coverage, &fRRect);
+    return true;
+}
+
+skvm::Color SkAnalyticClipShader::program(skvm::Builder* b,
+                                          skvm::Coord,
+                                          skvm::Coord local,
+                                          skvm::Color,
+                                          const MatrixRec& mRec,
+                                          const SkColorInfo&,
+                                          skvm::Uniforms* uniforms,
+                                          SkArenaAlloc*) const {
+    if (!mRec.apply(b, &local, uniforms)) {
+        return {};
+    }
+    auto uniform = [&](float v) { return b->uniformF(uniforms->pushF(v)); };
+    skvm::F32 x = local.x,
+              y = local.y,
+              cov;
+
+    // This matches the rrect_coverage stage.
+    skvm::F32 L = uniform(fRRect.fBounds[0]), T = uniform(fRRect.fBounds[1]),
+              R = uniform(fRRect.fBounds[2]), B = uniform(fRRect.fBounds[3]);
+    cov = clamp01(min(x - L, R - x) + 0.5f) * clamp01(min(y - T, B - y) + 0.5f);
+
+    skvm::I32 left = x < (L + R) * 0.5f,
+              top  = y < (T + B) * 0.5f;
+    auto corner = [&](const float radii[4]) {
+        return select(top, select(left, uniform(radii[0]), uniform(radii[1])),
+                           select(left, uniform(radii[3]), uniform(radii[2])));
+    };
+    skvm::F32 rx = corner(fRRect.fRadiiX),
+              ry = corner(fRRect.fRadiiY);
+    skvm::F32 cx = select(left, L + rx - x, x - (R - rx)),
+              cy = select(top,  T + ry - y, y - (B - ry));
+    skvm::F32 u0 = max(cx - 0.5f, 0.0f), u1 = min(cx + 0.5f, rx),
+              v0 = max(cy - 0.5f, 0.0f), v1 = min(cy + 0.5f, ry);
+    skvm::I32 inCorner = (u0 < u1) & (v0 < v1);
+
+    auto circle_area = [](skvm::F32 s) {
+        skvm::F32 p = s * -0.0012624911f + 0.0066700901f;
+        p = s * p - 0.0170881256f;
+        p = s * p + 0.0308918810f;
+        p = s * p - 0.0501743046f;
+        p = s * p + 0.0889789874f;
+        p = s * p - 0.2145988016f;
+        p = s * p + 1.5707963050f;
+        skvm::F32 asin = SK_ScalarPI/2 - sqrt(1.0f - s) * p;
+        return 0.5f * (s * sqrt(max(1.0f - s*s, 0.0f)) + asin);
+    };
+    rx = max(rx, 1e-6f);
+    ry = max(ry, 1e-6f);
+    skvm::F32 s0 = u0 / rx, s1 = u1 / rx,
+              t0 = v0 / ry, t1 = v1 / ry;
+    skvm::F32 sa = min(max(sqrt(max(1.0f - t1*t1, 0.0f)), s0), s1),
+              sb = min(max(sqrt(max(1.0f - t0*t0, 0.0f)), s0), s1);
+    skvm::F32 inside = (t1 - t0) * (sa - s0) + (circle_area(sb) - circle_area(sa)) -
+                       t0 * (sb - sa);
+    skvm::F32 outside = (u1 - u0) * (v1 - v0) - rx * ry * inside;
+    cov = select(inCorner, max(cov - outside, 0.0f), cov);
+
+    if (this->isInverse()) {
+        cov = 1.0f - cov;
+    }
+    return {cov, cov, cov, cov};
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkAnalyticClipShader_DEFINED
+#define SkAnalyticClipShader_DEFINED
+
+#include "include/core/SkColor.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/shaders/SkShaderBase.h"
+
+class SkArenaAlloc;
+class SkBlitter;
+class SkRRect;
+
+/**
+ *  The anti-aliased coverage of an rrect in device space, or of everything outside of one, computed
+ *  for each pixel by a raster pipeline stage from the rrect's parameters. The coverage is the area
+ *  of the pixel inside of the rrect. SkRasterClip uses this in place of rasterizing the rrect into
+ *  an SkAAClip.
+ */
+class SkAnalyticClipShader final : public SkShaderBase {
+public:
+    SkAnalyticClipShader(const SkRRect& devRRect, bool inverse);
+
+    /** The bounds of the shape, ignoring inverse. */
+    const SkRect& bounds() const { return fBounds; }
+
+    bool isInverse() const { return fRRect.fInverse; }
+
+    sk_sp<SkAnalyticClipShader> makeOffset(int dx, int dy) const;
+
+    /**
+     *  Returns a blitter that clips its blits to the shape on their way to blitter: pixels the
+     *  shape covers completely are passed straight through, pixels it misses are dropped, and the
+     *  coverage of the rest is multiplied by alphaAt().
+     */
+    SkBlitter* makeBlitter(SkBlitter* blitter, SkArenaAlloc*) const;
+
+    /** The shape's coverage of the pixel (x, y), as the stage would compute it. */
+    SkAlpha alphaAt(int x, int y) const;
+
+    /**
+     *  Within a row of pixels, the columns [fFullL, fFullR) are entirely inside the shape, and the
+     *  columns outside of [fAnyL, fAnyR) get no coverage from it.
+     */
+    struct RowSpans {
+        int fAnyL, fFullL, fFullR, fAnyR;
+
+        bool operator==(const RowSpans& that) const {
+            return fAnyL == that.fAnyL && fFullL == that.fFullL &&
+                   fFullR == that.fFullR && fAnyR == that.fAnyR;
+        }
+    };
+
+    /** Returns the spans of row y, pinned to the columns [left, right). */
+    RowSpans rowSpans(int y, int left, int right) const;
+
+protected:
+    bool appendStages(const SkStageRec&, const MatrixRec&) const override;
+
+    skvm::Color program(skvm::Builder*,
+                        skvm::Coord,
+                        skvm::Coord,
+                        skvm::Color,
+                        const MatrixRec&,
+                        const SkColorInfo&,
+                        skvm::Uniforms*,
+                        SkArenaAlloc*) const override;
+
+private:
+    explicit SkAnalyticClipShader(const SkRasterPipeline_RRectCoverageCtx&);
+
+    // For serialization.  This will never be called.
+    Factory getFactory() const override { return nullptr; }
+    const char* getTypeName() const override { return nullptr; }
+
+    SkRect fBounds;
+    SkRasterPipeline_RRectCoverageCtx fRRect = {};
+};
+
+#endif
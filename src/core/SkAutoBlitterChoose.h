@@ -42,8 +42,9 @@ public:
                                      paint,
                                      &fAlloc,
                                      drawCoverage,
-                                     draw.fRC->clipShader(),
+                                     draw.fRC->nonAnalyticClipShader(),
                                      SkSurfacePropsCopyOrDefault(draw.fProps));
+        fBlitter = draw.fRC->applyAnalyticCoverage(fBlitter, &fAlloc);
         return fBlitter;
     }
 
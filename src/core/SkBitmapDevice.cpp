@@ -664,13 +664,13 @@ void SkBitmapDevice::onReplaceClip(const SkIRect& rect) {
 bool SkBitmapDevice::onClipIsWideOpen() const {
     const SkRasterClip& rc = fRCStack.rc();
     // If we're AA, we can't be wide-open (we would represent that as BW)
-    return rc.isBW() && rc.bwRgn().isRect() &&
+    return rc.isBW() && rc.bwRgn().isRect() && !rc.hasAnalyticCoverage() &&
            rc.bwRgn().getBounds() == SkIRect{0, 0, this->width(), this->height()};
 }
 
 bool SkBitmapDevice::onClipIsAA() const {
     const SkRasterClip& rc = fRCStack.rc();
-    return !rc.isEmpty() && rc.isAA();
+    return !rc.isEmpty() && (rc.isAA() || rc.hasAnalyticCoverage());
 }
 
 void SkBitmapDevice::onAsRgnClip(SkRegion* rgn) const {
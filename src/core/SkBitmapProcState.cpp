@@ -17,6 +17,9 @@
 #include "src/core/SkMipmapAccessor.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkResourceCache.h"
+#include "src/shaders/SkImageShader.h"
+
+#include <climits>
 
 // One-stop-shop shader for,
 //   - nearest-neighbor sampling (_nofilter_),
@@ -74,6 +77,118 @@ static void Clamp_S32_opaque_D32_nofilter_DX_shaderproc(const void* sIn, int x,
     }
 }
 
+static inline int sk_int_mod(int x, int n) {
+    SkASSERT(n > 0);
+    if ((unsigned)x >= (unsigned)n) {
+        if (x < 0) {
+            x = n + ~(~x % n);
+        } else {
+            x = x % n;
+        }
+    }
+    return x;
+}
+
+static inline int sk_int_mirror(int x, int n) {
+    x = sk_int_mod(x, 2 * n);
+    if (x >= n) {
+        x = n + ~(x - n);
+    }
+    return x;
+}
+
+static inline int tile_index(int x, int n, SkTileMode mode) {
+    switch (mode) {
+        case SkTileMode::kClamp:  return SkTPin(x, 0, n - 1);
+        case SkTileMode::kRepeat: return sk_int_mod(x, n);
+        case SkTileMode::kMirror: return sk_int_mirror(x, n);
+        case SkTileMode::kDecal:  break;
+    }
+    SkASSERT(false);
+    return 0;
+}
+
+// One-stop-shop shader for,
+//   - bicubic sampling (_bicubic_),
+//   - any tiling but decal,
+//   - with at most a scale and translate matrix (_DX_),
+//   - sampling from 8888 (_S32_) and drawing to 8888 (_D32_).
+// The filter is separable: for each chunk of the span we blend the four source rows under it into
+// one row, then blend four neighbors in that row for each pixel. When the chunk is minifying enough
+// that its source columns outnumber its taps, we filter just the four taps of each pixel instead.
+static void S32_alpha_D32_bicubic_DX_shaderproc(const void* sIn, int x, int y,
+                                                SkPMColor* colors, int count) {
+    const SkBitmapProcState& s = *static_cast<const SkBitmapProcState*>(sIn);
+    SkASSERT(s.fBicubic);
+    SkASSERT(s.fInvMatrix.isScaleTranslate());
+    SkASSERT(count > 0 && colors != nullptr);
+
+    const int width  = s.fPixmap.width(),
+              height = s.fPixmap.height();
+
+    // Taps are at the centers of the pixels 1.5 and 0.5 either side of each sample point, and all
+    // four of them share the fractional offset of the sample point from the second.
+    SkPoint pt;
+    s.fInvProc(s.fInvMatrix, x + SK_ScalarHalf, y + SK_ScalarHalf, &pt);
+    const float fx = pt.fX - 0.5f,
+                fy = pt.fY - 0.5f,
+                dx = s.fInvMatrix.getScaleX();
+
+    const int iy = sk_float_floor2int(fy);
+    const float ty = fy - iy;
+    const float* w = s.fCubicWeights;
+    const uint32_t* rows[4];
+    float wy[4];
+    for (int k = 0; k < 4; ++k) {
+        rows[k] = s.fPixmap.addr32(0, tile_index(iy - 1 + k, height, s.fTileModeY));
+        wy[k]   = w[k] + ty*(w[4+k] + ty*(w[8+k] + ty*w[12+k]));
+    }
+
+    constexpr int kChunk = 64;
+    int   ix    [kChunk],
+          starts[kChunk],
+          cols  [4*kChunk];
+    float tx    [kChunk],
+          row   [4*4*kChunk];
+
+    for (int done = 0; done < count; done += kChunk) {
+        const int n = std::min(count - done, kChunk);
+
+        int minX = INT_MAX,
+            maxX = INT_MIN;
+        for (int i = 0; i < n; ++i) {
+            const float sx = fx + (done + i) * dx;
+            ix[i] = sk_float_floor2int(sx);
+            tx[i] = sx - ix[i];
+            minX  = std::min(minX, ix[i]);
+            maxX  = std::max(maxX, ix[i]);
+        }
+
+        int ncols;
+        if (maxX - minX + 4 <= 4*n) {
+            ncols = maxX - minX + 4;
+            for (int c = 0; c < ncols; ++c) {
+                cols[c] = tile_index(minX - 1 + c, width, s.fTileModeX);
+            }
+            for (int i = 0; i < n; ++i) {
+                starts[i] = ix[i] - minX;
+            }
+        } else {
+            ncols = 4*n;
+            for (int i = 0; i < n; ++i) {
+                for (int k = 0; k < 4; ++k) {
+                    cols[4*i + k] = tile_index(ix[i] - 1 + k, width, s.fTileModeX);
+                }
+                starts[i] = 4*i;
+            }
+        }
+
+        SkOpts::S32_bicubic_filter_rows(rows, wy, cols, ncols, row);
+        SkOpts::S32_alpha_D32_bicubic_filter_cols(row, starts, tx, n, w, s.fPaintAlpha * (1/255.0f),
+                                                  colors + done);
+    }
+}
+
 static void S32_alpha_D32_nofilter_DX(const SkBitmapProcState& s,
                                       const uint32_t* xy, int count, SkPMColor* colors) {
     SkASSERT(count > 0 && colors != nullptr);
@@ -185,11 +300,12 @@ bool SkBitmapProcState::init(const SkMatrix& inv, SkAlpha paintAlpha,
     SkASSERT(!inv.hasPerspective());
     SkASSERT(SkOpts::S32_alpha_D32_filter_DXDY || inv.isScaleTranslate());
     SkASSERT(!sampling.isAniso());
-    SkASSERT(!sampling.useCubic);
+    SkASSERT(!sampling.useCubic || inv.isScaleTranslate());
     SkASSERT(sampling.mipmap != SkMipmapMode::kLinear);
 
     fPixmap.reset();
     fBilerp = false;
+    fBicubic = false;
 
     auto* access = SkMipmapAccessor::Make(&fAlloc, (const SkImage*)fImage, inv, sampling.mipmap);
     if (!access) {
@@ -199,7 +315,12 @@ bool SkBitmapProcState::init(const SkMatrix& inv, SkAlpha paintAlpha,
     fInvMatrix.preConcat(inv);
 
     fPaintAlpha = paintAlpha;
-    fBilerp = sampling.filter == SkFilterMode::kLinear;
+    fBilerp = !sampling.useCubic && sampling.filter == SkFilterMode::kLinear;
+    fBicubic = sampling.useCubic;
+    if (fBicubic) {
+        SkImageShader::CubicResamplerMatrix(sampling.cubic.B, sampling.cubic.C)
+                .getColMajor(fCubicWeights);
+    }
     SkASSERT(fPixmap.addr());
 
     bool integral_translate_only = just_trans_integral(fInvMatrix);
@@ -210,8 +331,10 @@ bool SkBitmapProcState::init(const SkMatrix& inv, SkAlpha paintAlpha,
         //
         // We don't do this if we're either trivial (can ignore the matrix) or clamping
         // in both X and Y since clamping to width,height is just as easy as to 0xFFFF.
+        // The bicubic shader proc tiles its own integer coordinates, so it skips this too.
 
-        if (fTileModeX != SkTileMode::kClamp || fTileModeY != SkTileMode::kClamp) {
+        if (!fBicubic &&
+            (fTileModeX != SkTileMode::kClamp || fTileModeY != SkTileMode::kClamp)) {
             SkMatrixPriv::PostIDiv(&fInvMatrix, fPixmap.width(), fPixmap.height());
         }
 
@@ -267,6 +390,14 @@ bool SkBitmapProcState::chooseProcs() {
 
     fAlphaScale = SkAlpha255To256(fPaintAlpha);
 
+    if (fBicubic) {
+        // Even an integer translate blurs with most cubic filters, so this always filters.
+        fMatrixProc   = nullptr;
+        fSampleProc32 = nullptr;
+        fShaderProc32 = S32_alpha_D32_bicubic_DX_shaderproc;
+        return true;
+    }
+
     bool translate_only = (fInvMatrix.getType() & ~SkMatrix::kTranslate_Mask) == 0;
     fMatrixProc = this->chooseMatrixProc(translate_only);
     SkASSERT(fMatrixProc);
@@ -335,26 +466,6 @@ static void Clamp_S32_D32_nofilter_trans_shaderproc(const void* sIn,
     SkOpts::memset32(colors, row[maxX], count);
 }
 
-static inline int sk_int_mod(int x, int n) {
-    SkASSERT(n > 0);
-    if ((unsigned)x >= (unsigned)n) {
-        if (x < 0) {
-            x = n + ~(~x % n);
-        } else {
-            x = x % n;
-        }
-    }
-    return x;
-}
-
-static inline int sk_int_mirror(int x, int n) {
-    x = sk_int_mod(x, 2 * n);
-    if (x >= n) {
-        x = n + ~(x - n);
-    }
-    return x;
-}
-
 static void Repeat_S32_D32_nofilter_trans_shaderproc(const void* sIn,
                                                      int x, int y,
                                                      SkPMColor* colors,
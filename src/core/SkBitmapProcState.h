@@ -54,6 +54,8 @@ struct SkBitmapProcState {
     SkTileMode              fTileModeX;
     SkTileMode              fTileModeY;
     bool                    fBilerp;
+    bool                    fBicubic;
+    float                   fCubicWeights[16];  // column-major cubic resampler matrix
 
     SkMatrixPriv::MapXYProc fInvProc;           // chooseProcs
     SkFractionalInt     fInvSxFractionalInt;
@@ -113,6 +113,13 @@ public:
      */
     virtual bool isNullBlitter() const;
 
+    /**
+     *  Returns true if every blit call blends a pixel the same way for the same coverage, so that
+     *  callers may gather many small blits into one blitMask() without changing any pixels.
+     *  Default impl returns false.
+     */
+    virtual bool blendsCoverageUniformly() const { return false; }
+
     /**
      * Special methods for blitters that can blit more than one row at a time.
      * This function returns the number of rows that this blitter could optimally
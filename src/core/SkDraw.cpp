@@ -29,6 +29,7 @@
 #include "src/core/SkBlitter.h"
 #include "src/core/SkDevice.h"
 #include "src/core/SkDrawProcs.h"
+#include "src/core/SkHairlineBatcher.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkImagePriv.h"
 #include "src/core/SkMaskFilterBase.h"
@@ -184,6 +185,8 @@ static void bw_pt_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
 
 static void bw_line_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
                               int count, SkBlitter* blitter) {
+    SkHairlineBatcher batcher;
+    blitter = batcher.apply(blitter, devPts, count, count >> 1, *rec.fRC);
     for (int i = 0; i < count; i += 2) {
         SkScan::HairLine(&devPts[i], 2, *rec.fRC, blitter);
     }
@@ -198,6 +201,8 @@ static void bw_poly_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
 
 static void aa_line_hair_proc(const PtProcRec& rec, const SkPoint devPts[],
                               int count, SkBlitter* blitter) {
+    SkHairlineBatcher batcher;
+    blitter = batcher.apply(blitter, devPts, count, count >> 1, *rec.fRC);
     for (int i = 0; i < count; i += 2) {
         SkScan::AntiHairLine(&devPts[i], 2, *rec.fRC, blitter);
     }
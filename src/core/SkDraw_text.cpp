@@ -44,8 +44,9 @@ void SkDraw::paintMasks(SkZip<const SkGlyph*, SkPoint> accepted, const SkPaint&
                                            paint,
                                            &alloc,
                                            false,
-                                           fRC->clipShader(),
+                                           fRC->nonAnalyticClipShader(),
                                            SkSurfacePropsCopyOrDefault(fProps));
+    blitter = fRC->applyAnalyticCoverage(blitter, &alloc);
 
     SkAAClipBlitterWrapper wrapper{*fRC, blitter};
     blitter = wrapper.getBlitter();
@@ -0,0 +1,243 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkHairlineBatcher.h"
+
+#include "include/private/base/SkTo.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkRasterClip.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <cstring>
+
+// Fewer segments than this are drawn directly; they rarely touch enough pixels to pay for the
+// tiles.
+static constexpr int kMinSegmentCount = 8;
+
+// Limits the tile table to 16K entries (16KB), e.g. a 4K x 4K device.
+static constexpr int64_t kMaxTileCount = 1 << 14;
+
+// Once at least kMinConflictCount writes have landed on pixels already in their tile, and they make
+// up more than 1/kMaxConflictRatio of all writes, the tiles are flushed too often to pay off.
+static constexpr int kMinConflictCount = 64;
+static constexpr int kMaxConflictRatio = 8;
+
+// A tile is blitted as a mask when at least 1/kMaskDensity of its dirty pixels are covered, and a
+// row at a time otherwise, so that sparse tiles don't run the blitter over empty pixels.
+static constexpr int kMaskDensity = 32;
+
+static void blit_pixel(SkBlitter* blitter, int x, int y, SkAlpha alpha) {
+    SkAlpha aa[1] = {alpha};
+    int16_t runs[2] = {1, 0};
+    blitter->blitAntiH(x, y, aa, runs);
+}
+
+SkBlitter* SkHairlineBatcher::apply(SkBlitter* blitter, const SkIRect& bounds, int segmentCount) {
+    SkASSERT(!fBlitter);
+    if (!gSkUseBatchedHairlines || segmentCount < kMinSegmentCount || bounds.isEmpty() ||
+            !blitter->blendsCoverageUniformly()) {
+        return blitter;
+    }
+    int64_t tilesWide = (bounds.width64() + kTileSize - 1) >> kTileShift;
+    int64_t tilesHigh = (bounds.height64() + kTileSize - 1) >> kTileShift;
+    if (tilesWide * tilesHigh > kMaxTileCount) {
+        return blitter;
+    }
+    fBlitter = blitter;
+    fBounds = bounds;
+    fTilesWide = SkToInt(tilesWide);
+    fTileSlots.push_back_n(SkToInt(tilesWide * tilesHigh), uint8_t(0));
+    return this;
+}
+
+SkBlitter* SkHairlineBatcher::apply(SkBlitter* blitter, const SkPoint pts[], int count,
+                                    int segmentCount, const SkRasterClip& clip) {
+    SkRect r;
+    SkIRect bounds;
+    if (segmentCount < kMinSegmentCount || !r.setBoundsCheck(pts, count) ||
+            !bounds.intersect(r.roundOut().makeOutset(1, 1), clip.getBounds())) {
+        return blitter;
+    }
+    return this->apply(blitter, bounds, segmentCount);
+}
+
+void SkHairlineBatcher::write(int x, int y, SkAlpha alpha) {
+    if (!alpha) {
+        return;
+    }
+    if (fPassThrough || !fBounds.contains(x, y)) {
+        blit_pixel(fBlitter, x, y, alpha);
+        return;
+    }
+    int dx = x - fBounds.fLeft,
+        dy = y - fBounds.fTop;
+    int index = (dy >> kTileShift) * fTilesWide + (dx >> kTileShift);
+    if (!fTileSlots[index]) {
+        if (fLiveTiles.size() == kMaxLiveTiles) {
+            this->flush();
+        }
+        Tile* tile;
+        if (fFreeTiles.empty()) {
+            // Zeroed, like the coverage of flushed tiles.
+            tile = fAlloc.make<Tile>();
+        } else {
+            tile = fFreeTiles.back();
+            fFreeTiles.pop_back();
+        }
+        tile->fIndex = index;
+        fLiveTiles.push_back(tile);
+        fTileSlots[index] = SkToU8(fLiveTiles.size());
+    }
+    Tile& tile = *fLiveTiles[fTileSlots[index] - 1];
+    uint8_t* coverage = tile.fCoverage + ((dy & (kTileSize - 1)) << kTileShift)
+                                       + (dx & (kTileSize - 1));
+    fWriteCount++;
+    if (*coverage) {
+        // The earlier write must be blended first.
+        this->flushTile(&tile);
+        if (++fConflictCount >= kMinConflictCount &&
+                fConflictCount * kMaxConflictRatio > fWriteCount) {
+            this->flush();
+            fPassThrough = true;
+            blit_pixel(fBlitter, x, y, alpha);
+            return;
+        }
+    }
+    *coverage = alpha;
+    if (tile.fPixelCount++ == 0) {
+        tile.fDirty.setLTRB(x, y, x + 1, y + 1);
+    } else {
+        tile.fDirty.fLeft   = std::min(tile.fDirty.fLeft,   x);
+        tile.fDirty.fTop    = std::min(tile.fDirty.fTop,    y);
+        tile.fDirty.fRight  = std::max(tile.fDirty.fRight,  x + 1);
+        tile.fDirty.fBottom = std::max(tile.fDirty.fBottom, y + 1);
+    }
+}
+
+void SkHairlineBatcher::flushTile(Tile* tile) {
+    const SkIRect& dirty = tile->fDirty;
+    const int tileLeft = fBounds.fLeft + ((dirty.fLeft - fBounds.fLeft) & ~(kTileSize - 1)),
+              tileTop  = fBounds.fTop  + ((dirty.fTop  - fBounds.fTop)  & ~(kTileSize - 1));
+    uint8_t* coverage = tile->fCoverage + ((dirty.fTop - tileTop) << kTileShift)
+                                        + (dirty.fLeft - tileLeft);
+    const int width = dirty.width();
+
+    if (tile->fPixelCount * kMaskDensity >= width * dirty.height()) {
+        SkMask mask;
+        mask.fImage    = coverage;
+        mask.fBounds   = dirty;
+        mask.fRowBytes = kTileSize;
+        mask.fFormat   = SkMask::kA8_Format;
+        fBlitter->blitMask(mask, dirty);
+    } else {
+        SkAlpha aa[kTileSize];
+        int16_t runs[kTileSize + 1];
+        uint8_t* row = coverage;
+        for (int y = dirty.fTop; y < dirty.fBottom; ++y, row += kTileSize) {
+            for (int i = 0; i < width;) {
+                int n = 1;
+                while (i + n < width && row[i + n] == row[i]) {
+                    n++;
+                }
+                aa[i] = row[i];
+                runs[i] = SkToS16(n);
+                i += n;
+            }
+            runs[width] = 0;
+            if (aa[0] || runs[0] < width) {
+                fBlitter->blitAntiH(dirty.fLeft, y, aa, runs);
+            }
+        }
+    }
+
+    for (int y = dirty.fTop; y < dirty.fBottom; ++y, coverage += kTileSize) {
+        memset(coverage, 0, width);
+    }
+    tile->fDirty.setEmpty();
+    tile->fPixelCount = 0;
+}
+
+void SkHairlineBatcher::flush() {
+    for (Tile* tile : fLiveTiles) {
+        if (tile->fPixelCount) {
+            this->flushTile(tile);
+        }
+        fTileSlots[tile->fIndex] = 0;
+        fFreeTiles.push_back(tile);
+    }
+    fLiveTiles.clear();
+}
+
+void SkHairlineBatcher::blitH(int x, int y, int width) {
+    if (fPassThrough) {
+        fBlitter->blitH(x, y, width);
+        return;
+    }
+    for (int i = 0; i < width; ++i) {
+        this->write(x + i, y, 0xFF);
+    }
+}
+
+void SkHairlineBatcher::blitAntiH(int x, int y, const SkAlpha antialias[],
+                                  const int16_t runs[]) {
+    if (fPassThrough) {
+        fBlitter->blitAntiH(x, y, antialias, runs);
+        return;
+    }
+    for (int n = runs[0]; n > 0; n = runs[0]) {
+        for (int i = 0; i < n; ++i) {
+            this->write(x + i, y, antialias[0]);
+        }
+        x += n;
+        runs += n;
+        antialias += n;
+    }
+}
+
+void SkHairlineBatcher::blitV(int x, int y, int height, SkAlpha alpha) {
+    if (fPassThrough) {
+        fBlitter->blitV(x, y, height, alpha);
+        return;
+    }
+    for (int i = 0; i < height; ++i) {
+        this->write(x, y + i, alpha);
+    }
+}
+
+void SkHairlineBatcher::blitRect(int x, int y, int width, int height) {
+    if (fPassThrough) {
+        fBlitter->blitRect(x, y, width, height);
+        return;
+    }
+    for (int i = 0; i < height; ++i) {
+        this->blitH(x, y + i, width);
+    }
+}
+
+void SkHairlineBatcher::blitMask(const SkMask& mask, const SkIRect& clip) {
+    this->flush();
+    fBlitter->blitMask(mask, clip);
+}
+
+void SkHairlineBatcher::blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) {
+    if (fPassThrough) {
+        fBlitter->blitAntiH2(x, y, a0, a1);
+        return;
+    }
+    this->write(x, y, SkToU8(a0));
+    this->write(x + 1, y, SkToU8(a1));
+}
+
+void SkHairlineBatcher::blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) {
+    if (fPassThrough) {
+        fBlitter->blitAntiV2(x, y, a0, a1);
+        return;
+    }
+    this->write(x, y, SkToU8(a0));
+    this->write(x, y + 1, SkToU8(a1));
+}
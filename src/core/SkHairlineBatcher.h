@@ -0,0 +1,96 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkHairlineBatcher_DEFINED
+#define SkHairlineBatcher_DEFINED
+
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/core/SkBlitter.h"
+
+#include <cstdint>
+
+class SkRasterClip;
+struct SkPoint;
+
+/**
+ *  Collects the pixels that hairline scan converters write, one tile of A8 coverage at a time,
+ *  and blits each tile with a single blitMask() (or one blitAntiH() per row, when few of the
+ *  tile's pixels are touched).
+ *
+ *  A tile holds at most one write per pixel; writing a pixel twice first blits the tile. Tiles
+ *  don't overlap, so every pixel is still blended exactly as many times and in the same order as
+ *  it would have been by blitting each write directly. If that happens too often to be worth the
+ *  bookkeeping, e.g. for dense zig-zags, the batcher flushes and passes later blits straight on.
+ *
+ *  Only a bounded number of tiles hold coverage at once; starting another one first blits them
+ *  all, so memory stays small however large the bounds are.
+ */
+class SkHairlineBatcher final : public SkBlitter {
+public:
+    SkHairlineBatcher() = default;
+    ~SkHairlineBatcher() override { this->flush(); }
+
+    /**
+     *  Returns a blitter that batches writes within bounds on their way to blitter, or blitter
+     *  itself if there are too few segments or bounds is too large to be worth batching, or if
+     *  blitter doesn't blend coverage uniformly. Writes outside of bounds are passed straight
+     *  through.
+     */
+    SkBlitter* apply(SkBlitter* blitter, const SkIRect& bounds, int segmentCount);
+
+    /**
+     *  Same as above, batching within a pixel of the points' bounds, clipped to the raster clip's
+     *  bounds.
+     */
+    SkBlitter* apply(SkBlitter* blitter, const SkPoint pts[], int count, int segmentCount,
+                     const SkRasterClip& clip);
+
+    /** Blits everything collected so far. */
+    void flush();
+
+    void blitH(int x, int y, int width) override;
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override;
+    void blitV(int x, int y, int height, SkAlpha alpha) override;
+    void blitRect(int x, int y, int width, int height) override;
+    void blitMask(const SkMask&, const SkIRect& clip) override;
+    void blitAntiH2(int x, int y, U8CPU a0, U8CPU a1) override;
+    void blitAntiV2(int x, int y, U8CPU a0, U8CPU a1) override;
+
+private:
+    static constexpr int kTileShift = 5;
+    static constexpr int kTileSize = 1 << kTileShift;
+
+    // Live tiles are numbered in fTileSlots' bytes.
+    static constexpr int kMaxLiveTiles = 128;
+    static_assert(kMaxLiveTiles < 256);
+
+    struct Tile {
+        uint8_t fCoverage[kTileSize * kTileSize];
+        SkIRect fDirty;
+        int     fPixelCount;
+        int     fIndex;    // of the tile of fBounds this holds
+    };
+
+    void write(int x, int y, SkAlpha alpha);
+    void flushTile(Tile*);
+
+    SkBlitter*           fBlitter = nullptr;
+    SkIRect              fBounds = SkIRect::MakeEmpty();
+    int                  fTilesWide = 0;
+    // For each tile of fBounds, 1 + its index in fLiveTiles, or 0 if it holds no coverage.
+    SkTArray<uint8_t>    fTileSlots;
+    SkTArray<Tile*>      fLiveTiles;
+    SkTArray<Tile*>      fFreeTiles;
+    int                  fWriteCount = 0;
+    int                  fConflictCount = 0;
+    bool                 fPassThrough = false;
+    SkSTArenaAlloc<4096> fAlloc;
+};
+
+#endif
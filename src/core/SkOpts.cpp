@@ -87,6 +87,8 @@ namespace SkOpts {
 
     DEFINE_DEFAULT(S32_alpha_D32_filter_DX);
     DEFINE_DEFAULT(S32_alpha_D32_filter_DXDY);
+    DEFINE_DEFAULT(S32_bicubic_filter_rows);
+    DEFINE_DEFAULT(S32_alpha_D32_bicubic_filter_cols);
 
     DEFINE_DEFAULT(interpret_skvm);
 #undef DEFINE_DEFAULT
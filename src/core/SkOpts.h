@@ -115,6 +115,12 @@ namespace SkOpts {
                                            const uint32_t* xy, int count, SkPMColor*);
     extern void (*S32_alpha_D32_filter_DXDY)(const SkBitmapProcState&,
                                              const uint32_t* xy, int count, SkPMColor*);
+    extern void (*S32_bicubic_filter_rows)(const uint32_t* const rows[4], const float wy[4],
+                                           const int cols[], int count, float out[]);
+    extern void (*S32_alpha_D32_bicubic_filter_cols)(const float row[], const int starts[],
+                                                     const float tx[], int count,
+                                                     const float weights[16], float alpha,
+                                                     SkPMColor colors[]);
 
     // We can't necessarily express the type of SkRasterPipeline stage functions here,
     // so we just use this void(*)(void) as a stand-in.
@@ -777,12 +777,61 @@ SkPathBuilder& SkPathBuilder::addPolygon(const SkPoint pts[], int count, bool is
 
 SkPathBuilder& SkPathBuilder::polylineTo(const SkPoint pts[], int count) {
     if (count > 0) {
-        this->ensureMove();
+        memcpy(this->allocPolylineTo(count), pts, count * sizeof(SkPoint));
+    }
+    return *this;
+}
+
+SkPoint* SkPathBuilder::allocPolylineTo(int count) {
+    if (count <= 0) {
+        return nullptr;
+    }
+    this->ensureMove();
+
+    this->incReserve(count, count);
+    memset(fVerbs.push_back_n(count), (uint8_t)SkPathVerb::kLine, count);
+    fSegmentMask |= kLine_SkPathSegmentMask;
+    return fPts.push_back_n(count);
+}
 
-        this->incReserve(count, count);
-        memcpy(fPts.push_back_n(count), pts, count * sizeof(SkPoint));
-        memset(fVerbs.push_back_n(count), (uint8_t)SkPathVerb::kLine, count);
-        fSegmentMask |= kLine_SkPathSegmentMask;
+SkPathBuilder& SkPathBuilder::addSegments(const SkPoint pts[],  int pointCount,
+                                          const uint8_t vbs[],  int verbCount,
+                                          const SkScalar ws[],  int wCount) {
+    if (verbCount <= 0) {
+        return *this;
+    }
+
+    const auto info = sk_path_analyze_verbs(vbs, verbCount);
+    if (!info.valid || info.points > pointCount || info.weights > wCount) {
+        SkDEBUGFAIL("invalid verbs and number of points/weights");
+        return *this;
+    }
+
+    // Everything is appended with one reservation per array.
+    const int ptBase = fPts.size();
+    this->incReserve(info.points, verbCount);
+    memcpy(fPts.push_back_n(info.points), pts, info.points * sizeof(SkPoint));
+    memcpy(fVerbs.push_back_n(verbCount), vbs, verbCount);
+    if (info.weights > 0) {
+        fConicWeights.reserve_back(fConicWeights.size() + info.weights);
+        memcpy(fConicWeights.push_back_n(info.weights), ws, info.weights * sizeof(SkScalar));
+    }
+    fSegmentMask |= info.segmentMask;
+
+    // Pick up the contour state from the last move, as moveTo() and close() would have.
+    int ptIndex = ptBase + info.points;
+    for (int i = verbCount - 1; i >= 0; --i) {
+        ptIndex -= SkPathPriv::PtsInVerb(vbs[i]);
+        if (vbs[i] == (uint8_t)SkPathVerb::kMove) {
+            break;
+        }
+    }
+    fLastMoveIndex = ptIndex;
+    fLastMovePoint = fPts[ptIndex];
+    fNeedsMoveVerb = (vbs[verbCount - 1] == (uint8_t)SkPathVerb::kClose);
+    auto isNotMove = [](uint8_t v) { return v != (uint8_t)SkPathVerb::kMove; };
+    if (std::any_of(vbs, vbs + verbCount, isNotMove)) {
+        fIsA = kIsA_MoreThanMoves;
     }
     return *this;
 }
@@ -106,6 +106,37 @@ public:
         path.fPathRef->addGenIDChangeListener(std::move(listener));
     }
 
+    static sk_sp<SkPathRef> RefPathRef(const SkPath& path) { return path.fPathRef; }
+
+    /**
+     * Makes a path that takes over the arrays, which must describe a valid path, without copying
+     * them. 'lastMoveIndex' is the index of the point that starts the last contour.
+     */
+    static SkPath MakeFromArrays(SkPathRef::PointsArray pts, SkPathRef::VerbsArray verbs,
+                                 SkPathRef::ConicWeightsArray weights, unsigned segmentMask,
+                                 int lastMoveIndex, bool isVolatile) {
+        const bool isClosed = !verbs.empty() && verbs.back() == SkPath::kClose_Verb;
+        SkPath path(sk_sp<SkPathRef>(new SkPathRef(std::move(pts), std::move(verbs),
+                                                   std::move(weights), segmentMask)),
+                    SkPathFillType::kWinding, isVolatile, SkPathConvexity::kUnknown,
+                    SkPathFirstDirection::kUnknown);
+        if (lastMoveIndex >= 0) {
+            path.fLastMoveToIndex = isClosed ? ~lastMoveIndex : lastMoveIndex;
+        }
+        return path;
+    }
+
+    /**
+     * Returns a copy of the path that uses 'pathRef', which must hold the same verbs, points, and
+     * conic weights as the path's own SkPathRef.
+     */
+    static SkPath WithPathRef(const SkPath& path, sk_sp<SkPathRef> pathRef) {
+        SkASSERT(*pathRef == *path.fPathRef);
+        SkPath copy = path;
+        copy.fPathRef = std::move(pathRef);
+        return copy;
+    }
+
     /**
      * This returns true for a rect that has a move followed by 3 or 4 lines and a close. If
      * 'isSimpleFill' is true, an uncloseed rect will also be accepted as long as it starts and
@@ -0,0 +1,53 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkPathRefInterner.h"
+
+#include "include/core/SkPath.h"
+#include "include/private/SkOpts_spi.h"
+#include "src/core/SkPathPriv.h"
+
+#include <utility>
+
+uint32_t SkPathRefInterner::Traits::Hash(const SkPathRef& ref) {
+    uint32_t hash = SkOpts::hash_fn(ref.verbsBegin(), ref.countVerbs() * sizeof(uint8_t), 0);
+    hash = SkOpts::hash_fn(ref.points(), ref.countPoints() * sizeof(SkPoint), hash);
+    return SkOpts::hash_fn(ref.conicWeights(), ref.countWeights() * sizeof(SkScalar), hash);
+}
+
+SkPath SkPathRefInterner::intern(const SkPath& path) {
+    if (!path.isFinite()) {
+        // NaNs never compare equal, so these could never be matched.
+        return path;
+    }
+    sk_sp<SkPathRef> ref = SkPathPriv::RefPathRef(path);
+    const uint32_t genID = path.getGenerationID();
+
+    sk_sp<SkPathRef> interned;
+    if (sk_sp<SkPathRef>* found = fRefsByGenID.find(genID)) {
+        interned = *found;
+    } else {
+        if (sk_sp<SkPathRef>* match = fRefs.find(*ref)) {
+            interned = *match;
+        } else {
+            interned = *fRefs.set(ref);
+        }
+        fRefsByGenID.set(genID, interned);
+    }
+
+    if (interned == ref) {
+        return path;
+    }
+    ++fSharedCount;
+    return SkPathPriv::WithPathRef(path, std::move(interned));
+}
+
+void SkPathRefInterner::reset() {
+    fRefs.reset();
+    fRefsByGenID.reset();
+    fSharedCount = 0;
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkPathRefInterner_DEFINED
+#define SkPathRefInterner_DEFINED
+
+#include "include/core/SkRefCnt.h"
+#include "include/private/SkPathRef.h"
+#include "src/core/SkTHash.h"
+
+#include <cstdint>
+
+class SkPath;
+
+/**
+ * Collapses paths with identical geometry onto one shared SkPathRef. Paths are matched by a hash
+ * of their verbs, points, and conic weights, so two SkPaths built independently from the same
+ * data end up sharing storage (and a generation ID) once interned.
+ *
+ * The interner keeps every interned SkPathRef alive until it is destroyed or reset.
+ */
+class SkPathRefInterner {
+public:
+    /**
+     * Returns a copy of the path that shares its SkPathRef with the first path interned with the
+     * same verbs, points, and conic weights. Fill type and volatility are kept from `path`.
+     * Non-finite paths are returned unchanged.
+     */
+    SkPath intern(const SkPath& path);
+
+    void reset();
+
+    // The number of distinct SkPathRefs held by the interner.
+    int uniqueCount() const { return fRefs.count(); }
+
+    // The number of intern() calls that replaced a path's SkPathRef with an identical one.
+    int sharedCount() const { return fSharedCount; }
+
+private:
+    struct Traits {
+        static const SkPathRef& GetKey(const sk_sp<SkPathRef>& ref) { return *ref; }
+        static uint32_t Hash(const SkPathRef& ref);
+    };
+
+    SkTHashTable<sk_sp<SkPathRef>, SkPathRef, Traits> fRefs;
+    // Paths are usually interned many times through the same SkPathRef. Remembering the result
+    // for each SkPathRef generation ID skips rehashing its contents.
+    SkTHashMap<uint32_t, sk_sp<SkPathRef>> fRefsByGenID;
+    int fSharedCount = 0;
+};
+
+#endif
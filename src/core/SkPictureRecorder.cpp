@@ -12,6 +12,7 @@
 #include "include/core/SkPictureRecorder.h"
 #include "include/core/SkTypes.h"
 #include "src/core/SkBigPicture.h"
+#include "src/core/SkPathRefInterner.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecordDraw.h"
 #include "src/core/SkRecordOpts.h"
@@ -38,6 +39,8 @@ SkCanvas* SkPictureRecorder::beginRecording(const SkRect& userCullRect,
         fRecord.reset(new SkRecord);
     }
     fRecorder->reset(fRecord.get(), cullRect);
+    fPathInterner = fInternPaths ? std::make_unique<SkPathRefInterner>() : nullptr;
+    fRecorder->setPathInterner(fPathInterner.get());
     fActivelyRecording = true;
     return this->getRecordingCanvas();
 }
@@ -62,6 +65,8 @@ public:
 sk_sp<SkPicture> SkPictureRecorder::finishRecordingAsPicture() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
+    fRecorder->setPathInterner(nullptr);
+    fPathInterner.reset();  // The recorded paths keep their interned SkPathRefs alive.
 
     if (fRecord->count() == 0) {
         return sk_make_sp<SkEmptyPicture>();
@@ -127,6 +132,8 @@ void SkPictureRecorder::partialReplay(SkCanvas* canvas) const {
 sk_sp<SkDrawable> SkPictureRecorder::finishRecordingAsDrawable() {
     fActivelyRecording = false;
     fRecorder->restoreToCount(1);  // If we were missing any restores, add them now.
+    fRecorder->setPathInterner(nullptr);
+    fPathInterner.reset();  // The recorded paths keep their interned SkPathRefs alive.
 
     SkRecordOptimize(fRecord.get());
 
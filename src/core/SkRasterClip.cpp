@@ -5,15 +5,22 @@
  * found in the LICENSE file.
  */
 
-#include "include/core/SkPath.h"
 #include "src/core/SkRasterClip.h"
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRRect.h"
+#include "src/core/SkAAClipCache.h"
+#include "src/core/SkAnalyticClipShader.h"
 #include "src/core/SkRegionPriv.h"
 
+bool gSkUseAnalyticAAClip = true;
+
 SkRasterClip::SkRasterClip(const SkRasterClip& that)
         : fIsBW(that.fIsBW)
         , fIsEmpty(that.fIsEmpty)
         , fIsRect(that.fIsRect)
         , fShader(that.fShader)
+        , fAnalyticShader(that.fAnalyticShader)
 {
     AUTO_RASTERCLIP_VALIDATE(that);
 
@@ -39,6 +46,7 @@ SkRasterClip& SkRasterClip::operator=(const SkRasterClip& that) {
     fIsEmpty = that.isEmpty();
     fIsRect = that.isRect();
     fShader = that.fShader;
+    fAnalyticShader = that.fAnalyticShader;
     SkDEBUGCODE(this->validate();)
     return *this;
 }
@@ -87,6 +95,7 @@ bool SkRasterClip::setEmpty() {
     fIsBW = true;
     fBW.setEmpty();
     fAA.setEmpty();
+    fAnalyticShader.reset();
     fIsEmpty = true;
     fIsRect = false;
     return false;
@@ -97,6 +106,7 @@ bool SkRasterClip::setRect(const SkIRect& rect) {
 
     fIsBW = true;
     fAA.setEmpty();
+    fAnalyticShader.reset();
     fIsRect = fBW.setRect(rect);
     fIsEmpty = !fIsRect;
     return fIsRect;
@@ -171,14 +181,29 @@ bool SkRasterClip::op(const SkRect& localRect, const SkMatrix& matrix, SkClipOp
 }
 
 bool SkRasterClip::op(const SkRRect& rrect, const SkMatrix& matrix, SkClipOp op, bool doAA) {
+    SkRRect devRRect;
+    if (doAA && rrect.transform(matrix, &devRRect) && this->opAnalytic(devRRect, op)) {
+        return !this->isEmpty();
+    }
     return this->op(SkPath::RRect(rrect), matrix, op, doAA);
 }
 
 bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, SkClipOp op, bool doAA) {
     AUTO_RASTERCLIP_VALIDATE(*this);
 
-    SkPath devPath;
-    path.transform(matrix, &devPath);
+    if (doAA && !path.isInverseFillType()) {
+        SkRect oval;
+        SkRRect rrect, devRRect;
+        if (path.isOval(&oval)) {
+            rrect.setOval(oval);
+        } else if (!path.isRRect(&rrect)) {
+            rrect.setEmpty();
+        }
+        if (!rrect.isEmpty() && rrect.transform(matrix, &devRRect) &&
+                this->opAnalytic(devRRect, op)) {
+            return !this->isEmpty();
+        }
+    }
 
     // Since op is either intersect or difference, the clip is always shrinking; that means we can
     // always use our current bounds as the limiting factor for region/aaclip operations.
@@ -189,17 +214,89 @@ bool SkRasterClip::op(const SkPath& path, const SkMatrix& matrix, SkClipOp op, b
         if (doAA && fIsBW) {
             this->convertToAA();
         }
-        if (fIsBW) {
-            fBW.setPath(devPath, SkRegion(this->getBounds()));
+        if (doAA) {
+            SkAAClipCache::SetPath(&fAA, path, matrix, this->getBounds());
         } else {
-            fAA.setPath(devPath, this->getBounds(), doAA);
+            SkPath devPath;
+            path.transform(matrix, &devPath);
+            if (fIsBW) {
+                fBW.setPath(devPath, SkRegion(this->getBounds()));
+            } else {
+                fAA.setPath(devPath, this->getBounds(), doAA);
+            }
         }
         return this->updateCacheAndReturnNonEmpty();
+    } else if (doAA) {
+        SkRasterClip clip;
+        clip.fIsBW = false;
+        SkAAClipCache::SetPath(&clip.fAA, path, matrix, this->getBounds());
+        clip.fIsEmpty = clip.computeIsEmpty();
+        clip.fIsRect = clip.computeIsRect();
+        return this->op(clip, op);
     } else {
+        SkPath devPath;
+        path.transform(matrix, &devPath);
         return this->op(SkRasterClip(devPath, this->getBounds(), doAA), op);
     }
 }
 
+// Analytic shapes compute coverage for their edge pixels on every draw, where an SkAAClip only
+// looks up runs it built once. That only pays off for shapes small enough that building the
+// SkAAClip dominates, and whose rounded corners (which are all edge pixels) are small.
+static constexpr int kMaxAnalyticClipSize = 256;
+static constexpr float kMaxAnalyticCornerArea = 32 * 32;
+
+bool SkRasterClip::opAnalytic(const SkRRect& devRRect, SkClipOp op) {
+    if (!gSkUseAnalyticAAClip || devRRect.isRect() || !devRRect.isValid() ||
+            !devRRect.getBounds().isFinite()) {
+        return false;
+    }
+    float cornerArea = 0;
+    for (int i = 0; i < 4; ++i) {
+        const SkVector radii = devRRect.radii((SkRRect::Corner)i);
+        cornerArea += radii.fX * radii.fY;
+    }
+    if (cornerArea > kMaxAnalyticCornerArea) {
+        return false;
+    }
+    return this->opAnalytic(
+            sk_make_sp<SkAnalyticClipShader>(devRRect, op == SkClipOp::kDifference), op);
+}
+
+bool SkRasterClip::opAnalytic(sk_sp<SkAnalyticClipShader> shape, SkClipOp op) {
+    // Keep the per-pixel cost bounded by recording at most one shape.
+    if (!shape || fAnalyticShader || shape->bounds().width() > kMaxAnalyticClipSize ||
+            shape->bounds().height() > kMaxAnalyticClipSize) {
+        return false;
+    }
+    const SkIRect bounds = shape->bounds().roundOut();
+    if (op == SkClipOp::kIntersect) {
+        // Pixels outside of the shape's bounds have no coverage, so the region or SkAAClip can
+        // exclude them.
+        if (!this->op(bounds, SkClipOp::kIntersect)) {
+            return true;
+        }
+    } else if (!SkIRect::Intersects(bounds, this->getBounds())) {
+        return true;
+    }
+    fAnalyticShader = std::move(shape);
+    return true;
+}
+
+sk_sp<SkShader> SkRasterClip::clipShader() const {
+    if (fShader && fAnalyticShader) {
+        return SkShaders::Blend(SkBlendMode::kSrcIn, fAnalyticShader, fShader);
+    }
+    return fAnalyticShader ? fAnalyticShader : fShader;
+}
+
+SkBlitter* SkRasterClip::applyAnalyticCoverage(SkBlitter* blitter, SkArenaAlloc* alloc) const {
+    if (!fAnalyticShader || !blitter) {
+        return blitter;
+    }
+    return fAnalyticShader->makeBlitter(blitter, alloc);
+}
+
 bool SkRasterClip::op(sk_sp<SkShader> sh) {
     AUTO_RASTERCLIP_VALIDATE(*this);
 
@@ -259,6 +356,7 @@ void SkRasterClip::translate(int dx, int dy, SkRasterClip* dst) const {
         fAA.translate(dx, dy, &dst->fAA);
         dst->fBW.setEmpty();
     }
+    dst->fAnalyticShader = fAnalyticShader ? fAnalyticShader->makeOffset(dx, dy) : nullptr;
     dst->updateCacheAndReturnNonEmpty();
 }
 
@@ -12,13 +12,25 @@
 #include "include/core/SkRegion.h"
 #include "include/core/SkShader.h"
 #include "include/private/base/SkMacros.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkAAClip.h"
 
+class SkAnalyticClipShader;
+class SkArenaAlloc;
+class SkBlitter;
 class SkRRect;
 
+// Whether small anti-aliased rrects clip with coverage computed per pixel, instead of being scan
+// converted into an SkAAClip.
+extern bool gSkUseAnalyticAAClip;
+
 /**
  *  Wraps a SkRegion and SkAAClip, so we have a single object that can represent either our
  *  BW or antialiased clips.
+ *
+ *  Intersecting with (or subtracting) a small anti-aliased rrect may instead record the shape,
+ *  only clipping the region or SkAAClip to its bounds. Its coverage is then computed for the
+ *  pixels drawn along its edges; see applyAnalyticCoverage().
  */
 class SkRasterClip {
 public:
@@ -85,7 +97,25 @@ public:
     void validate() const {}
 #endif
 
-    sk_sp<SkShader> clipShader() const { return fShader; }
+    /** Returns the shader that blitters must apply, including any analytic shape's coverage. */
+    sk_sp<SkShader> clipShader() const;
+
+    /** Same as clipShader(), without the coverage of an analytic shape. */
+    sk_sp<SkShader> nonAnalyticClipShader() const { return fShader; }
+
+    /**
+     *  Return true if part of the clip is an analytic shape, whose anti-aliased edges are applied
+     *  by clipShader() or applyAnalyticCoverage(), but not by the region or SkAAClip. These are
+     *  only clipped to the shape's bounds.
+     */
+    bool hasAnalyticCoverage() const { return SkToBool(fAnalyticShader); }
+
+    /**
+     *  Given a blitter that uses nonAnalyticClipShader(), returns a blitter that also applies the
+     *  analytic shape's coverage, computing it only for the pixels along the shape's edges.
+     *  Returns blitter if there is no analytic shape, or if blitter is null.
+     */
+    SkBlitter* applyAnalyticCoverage(SkBlitter* blitter, SkArenaAlloc*) const;
 
 private:
     SkRegion    fBW;
@@ -96,6 +126,8 @@ private:
     bool        fIsRect;
     // if present, this augments the clip, not replaces it
     sk_sp<SkShader> fShader;
+    // if present, the coverage of an analytic shape, which also augments the clip
+    sk_sp<SkAnalyticClipShader> fAnalyticShader;
 
     bool computeIsEmpty() const {
         return fIsBW ? fBW.isEmpty() : fAA.isEmpty();
@@ -122,6 +154,10 @@ private:
     void convertToAA();
 
     bool op(const SkRasterClip&, SkClipOp);
+
+    // These return false, leaving the clip unchanged, if the shape isn't clipped analytically.
+    bool opAnalytic(const SkRRect& devRRect, SkClipOp);
+    bool opAnalytic(sk_sp<SkAnalyticClipShader>, SkClipOp);
 };
 
 class SkAutoRasterClipValidate : SkNoncopyable {
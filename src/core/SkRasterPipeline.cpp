@@ -15,6 +15,7 @@
 #include "src/base/SkVx.h"
 #include "src/core/SkImageInfoPriv.h"
 #include "src/core/SkOpts.h"
+#include "src/core/SkRasterPipelineProfiler.h"
 
 #include <algorithm>
 #include <cstring>
@@ -89,7 +90,9 @@ const char* SkRasterPipeline::GetOpName(SkRasterPipelineOp op) {
 }
 
 void SkRasterPipeline::dump() const {
-    SkDebugf("SkRasterPipeline, %d stages\n", fNumStages);
+    const char* highpReason = this->highpReason();
+    SkDebugf("SkRasterPipeline, %d stages, %s%s\n", fNumStages,
+             highpReason ? "highp: " : "lowp", highpReason ? highpReason : "");
     std::vector<const char*> stages;
     for (auto st = fStages; st; st = st->prev) {
         stages.push_back(GetOpName(st->stage));
@@ -399,13 +402,61 @@ static void prepend_to_pipeline(SkRasterPipelineStage*& ip, SkOpts::StageFn stag
     ip->ctx = ctx;
 }
 
-bool SkRasterPipeline::build_lowp_pipeline(SkRasterPipelineStage* ip) const {
+// When profiling, a branch from stage i to stage i + offset sits at 2i + 1 (behind stage i's
+// profile stage), and must land on stage i + offset's profile stage at 2(i + offset).
+static void* profiled_branch_ctx(Op op, void* ctx, SkArenaAlloc* alloc) {
+    switch (op) {
+        case Op::branch_if_any_active_lanes:
+        case Op::branch_if_no_active_lanes:
+        case Op::jump: {
+            auto* branchCtx = alloc->make<SkRasterPipeline_BranchCtx>(
+                    *static_cast<SkRasterPipeline_BranchCtx*>(ctx));
+            branchCtx->offset = 2 * branchCtx->offset - 1;
+            return branchCtx;
+        }
+        case Op::branch_if_no_active_lanes_eq: {
+            auto* branchCtx = alloc->make<SkRasterPipeline_BranchIfEqualCtx>(
+                    *static_cast<SkRasterPipeline_BranchIfEqualCtx*>(ctx));
+            branchCtx->offset = 2 * branchCtx->offset - 1;
+            return branchCtx;
+        }
+        default:
+            return ctx;
+    }
+}
+
+const char* SkRasterPipeline::highpReason() const {
+    if (gForceHighPrecisionRasterPipeline) {
+        return "forced";
+    }
+    if (!SkOpts::just_return_lowp) {
+        return "no lowp stages in this build";
+    }
+    // Stages are stored backwards in fStages, so the last op we find is the first in the pipeline.
+    // (A pipeline with a stack_rewind always finds that op, so we needn't check fRewindCtx.)
+    const char* reason = nullptr;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        int opIndex = (int)st->stage;
+        if (opIndex >= kNumRasterPipelineLowpOps || !SkOpts::ops_lowp[opIndex]) {
+            reason = GetOpName(st->stage);
+        }
+    }
+    return reason;
+}
+
+bool SkRasterPipeline::build_lowp_pipeline(SkRasterPipelineStage* ip,
+                                           SkRasterPipeline_ProfileCtx* profile) const {
     if (gForceHighPrecisionRasterPipeline || fRewindCtx) {
         return false;
     }
     // Stages are stored backwards in fStages; to compensate, we assemble the pipeline in reverse
     // here, back to front.
+    const SkOpts::StageFn profileFn = SkOpts::ops_lowp[(int)Op::profile];
+    int index = fNumStages;
     prepend_to_pipeline(ip, SkOpts::just_return_lowp, /*ctx=*/nullptr);
+    if (profile) {
+        prepend_to_pipeline(ip, profileFn, &profile[index]);
+    }
     for (const StageList* st = fStages; st; st = st->prev) {
         int opIndex = (int)st->stage;
         if (opIndex >= kNumRasterPipelineLowpOps || !SkOpts::ops_lowp[opIndex]) {
@@ -413,16 +464,32 @@ bool SkRasterPipeline::build_lowp_pipeline(SkRasterPipelineStage* ip) const {
             return false;
         }
         prepend_to_pipeline(ip, SkOpts::ops_lowp[opIndex], st->ctx);
+        if (profile) {
+            prepend_to_pipeline(ip, profileFn, &profile[--index]);
+        }
     }
     return true;
 }
 
-void SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip) const {
+void SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip,
+                                            SkRasterPipeline_ProfileCtx* profile,
+                                            SkArenaAlloc* profileAlloc) const {
     // We assemble the pipeline in reverse, since the stage list is stored backwards.
+    const SkOpts::StageFn profileFn = SkOpts::ops_highp[(int)Op::profile];
+    int index = fNumStages;
     prepend_to_pipeline(ip, SkOpts::just_return_highp, /*ctx=*/nullptr);
+    if (profile) {
+        prepend_to_pipeline(ip, profileFn, &profile[index]);
+    }
     for (const StageList* st = fStages; st; st = st->prev) {
         int opIndex = (int)st->stage;
-        prepend_to_pipeline(ip, SkOpts::ops_highp[opIndex], st->ctx);
+        if (profile) {
+            prepend_to_pipeline(ip, SkOpts::ops_highp[opIndex],
+                                profiled_branch_ctx(st->stage, st->ctx, profileAlloc));
+            prepend_to_pipeline(ip, profileFn, &profile[--index]);
+        } else {
+            prepend_to_pipeline(ip, SkOpts::ops_highp[opIndex], st->ctx);
+        }
     }
 
     // stack_checkpoint and stack_rewind are only implemented in highp. We only need these stages
@@ -435,21 +502,48 @@ void SkRasterPipeline::build_highp_pipeline(SkRasterPipelineStage* ip) const {
     }
 }
 
+void SkRasterPipeline::attach_profiler(SkRasterPipeline_ProfileCtx* profile, bool lowp) const {
+    AutoSTMalloc<32, SkRasterPipelineOp> ops(fNumStages);
+    int index = fNumStages;
+    for (const StageList* st = fStages; st; st = st->prev) {
+        ops[--index] = st->stage;
+    }
+    const char* highpReason = lowp ? nullptr : this->highpReason();
+    SkASSERT(lowp || highpReason);
+    SkRasterPipelineProfiler::Attach(profile, ops.get(), fNumStages, highpReason);
+}
+
 SkRasterPipeline::StartPipelineFn SkRasterPipeline::build_pipeline(
-        SkRasterPipelineStage* ip) const {
+        SkRasterPipelineStage* ip, SkArenaAlloc* profileAlloc) const {
+    SkRasterPipeline_ProfileCtx* profile = nullptr;
+    if (profileAlloc) {
+        profile = profileAlloc->makeArray<SkRasterPipeline_ProfileCtx>(fNumStages + 1);
+    }
+
     // We try to build a lowp pipeline first; if that fails, we fall back to a highp float pipeline.
-    if (this->build_lowp_pipeline(ip)) {
+    if (this->build_lowp_pipeline(ip, profile)) {
+        if (profile) {
+            this->attach_profiler(profile, /*lowp=*/true);
+        }
         return SkOpts::start_pipeline_lowp;
     }
 
-    this->build_highp_pipeline(ip);
+    this->build_highp_pipeline(ip, profile, profileAlloc);
+    if (profile) {
+        this->attach_profiler(profile, /*lowp=*/false);
+    }
     return SkOpts::start_pipeline_highp;
 }
 
-int SkRasterPipeline::stages_needed() const {
+int SkRasterPipeline::stages_needed(bool profile) const {
     // Add 1 to budget for a `just_return` stage at the end.
     int stages = fNumStages + 1;
 
+    // When profiling, every stage (and the `just_return`) gets a profile stage in front of it.
+    if (profile) {
+        stages += fNumStages + 1;
+    }
+
     // If we have any stack_rewind stages, we will need to inject a stack_checkpoint stage.
     if (fRewindCtx) {
         stages += 1;
@@ -462,12 +556,15 @@ void SkRasterPipeline::run(size_t x, size_t y, size_t w, size_t h) const {
         return;
     }
 
-    int stagesNeeded = this->stages_needed();
+    const bool profile = SkRasterPipelineProfiler::IsEnabled();
+    int stagesNeeded = this->stages_needed(profile);
 
     // Best to not use fAlloc here... we can't bound how often run() will be called.
     AutoSTMalloc<32, SkRasterPipelineStage> program(stagesNeeded);
+    SkArenaAlloc profileAlloc(/*firstHeapAllocation=*/256);
 
-    auto start_pipeline = this->build_pipeline(program.get() + stagesNeeded);
+    auto start_pipeline = this->build_pipeline(program.get() + stagesNeeded,
+                                               profile ? &profileAlloc : nullptr);
     start_pipeline(x,y,x+w,y+h, program.get());
 }
 
@@ -476,11 +573,12 @@ std::function<void(size_t, size_t, size_t, size_t)> SkRasterPipeline::compile()
         return [](size_t, size_t, size_t, size_t) {};
     }
 
-    int stagesNeeded = this->stages_needed();
+    const bool profile = SkRasterPipelineProfiler::IsEnabled();
+    int stagesNeeded = this->stages_needed(profile);
 
     SkRasterPipelineStage* program = fAlloc->makeArray<SkRasterPipelineStage>(stagesNeeded);
 
-    auto start_pipeline = this->build_pipeline(program + stagesNeeded);
+    auto start_pipeline = this->build_pipeline(program + stagesNeeded, profile ? fAlloc : nullptr);
     return [=](size_t x, size_t y, size_t w, size_t h) {
         start_pipeline(x,y,x+w,y+h, program);
     };
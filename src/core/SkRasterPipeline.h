@@ -97,6 +97,10 @@ public:
     // Prints the entire StageList using SkDebugf.
     void dump() const;
 
+    // Returns why this pipeline has to run in highp: the name of its first op that has no lowp
+    // stage, or a reason that applies to every pipeline. Returns nullptr if it can run in lowp.
+    const char* highpReason() const;
+
     // Appends a stage for the specified matrix.
     // Tries to optimize the stage by analyzing the type of matrix.
     void append_matrix(SkArenaAlloc*, const SkMatrix&);
@@ -129,14 +133,20 @@ public:
     bool empty() const { return fStages == nullptr; }
 
 private:
-    bool build_lowp_pipeline(SkRasterPipelineStage* ip) const;
-    void build_highp_pipeline(SkRasterPipelineStage* ip) const;
+    // When profile is non-null, it holds the contexts for a profile stage in front of each stage
+    // and one more at the end; see SkRasterPipelineProfiler.
+    bool build_lowp_pipeline(SkRasterPipelineStage* ip, SkRasterPipeline_ProfileCtx* profile) const;
+    void build_highp_pipeline(SkRasterPipelineStage* ip,
+                              SkRasterPipeline_ProfileCtx* profile,
+                              SkArenaAlloc* profileAlloc) const;
+    void attach_profiler(SkRasterPipeline_ProfileCtx* profile, bool lowp) const;
 
     using StartPipelineFn = void(*)(size_t,size_t,size_t,size_t, SkRasterPipelineStage* program);
-    StartPipelineFn build_pipeline(SkRasterPipelineStage*) const;
+    // Builds a profiled pipeline when profileAlloc is non-null, allocating its contexts there.
+    StartPipelineFn build_pipeline(SkRasterPipelineStage*, SkArenaAlloc* profileAlloc) const;
 
     void unchecked_append(SkRasterPipelineOp, void*);
-    int stages_needed() const;
+    int stages_needed(bool profile) const;
 
     SkArenaAlloc*               fAlloc;
     SkRasterPipeline_RewindCtx* fRewindCtx;
@@ -54,6 +54,12 @@ public:
     void blitRect  (int x, int y, int width, int height)            override;
     void blitV     (int x, int y, int height, SkAlpha alpha)        override;
 
+    bool blendsCoverageUniformly() const override {
+        // blitRect() lerps by a clip shader's coverage after blending, while the other blits scale
+        // by it first. The two only disagree when the blend clamps.
+        return !fClipShaderBuffer || fBlend != SkBlendMode::kPlus;
+    }
+
 private:
     void blitRectWithTrace(int x, int y, int w, int h, bool trace);
     void append_load_dst      (SkRasterPipeline*) const;
@@ -101,6 +101,15 @@ struct SkRasterPipeline_CallbackCtx {
     float* read_from = rgba;
 };
 
+// When SkRasterPipelineProfiler is enabled, a profile stage is placed in front of every stage of a
+// pipeline (and one more before just_return), each with its own context.
+struct SkRasterPipeline_ProfileCtx {
+    void (*fn)(SkRasterPipeline_ProfileCtx* self, int active_pixels);
+
+    void* shape;  // the profiler's counters for this pipeline
+    int   stage;  // the index of the stage that follows, or the stage count at the end
+};
+
 // state shared by stack_checkpoint and stack_rewind
 struct SkRasterPipelineStage;
 
@@ -134,6 +143,13 @@ struct SkRasterPipeline_2PtConicalCtx {
              fP1;
 };
 
+struct SkRasterPipeline_RRectCoverageCtx {
+    float fBounds[4];   // left, top, right, bottom
+    float fRadiiX[4];   // upper-left, upper-right, lower-right, lower-left
+    float fRadiiY[4];
+    bool  fInverse;     // whether to return the coverage outside of the rrect
+};
+
 struct SkRasterPipeline_UniformColorCtx {
     float r,g,b,a;
     uint16_t rgba[4];  // [0,255] in a 16-bit lane.
@@ -159,6 +175,11 @@ struct SkRasterPipeline_TernaryOpCtx {
     const float *src1;
 };
 
+struct SkRasterPipeline_ConstantCtx {
+    int value;  // applied to every slot, reinterpreted as the stage's type
+    float *dst;
+};
+
 struct SkRasterPipeline_SwizzleCtx {
     float *ptr;
     uint16_t offsets[4];  // values must be byte offsets (4 * highp-stride * component-index)
@@ -51,7 +51,8 @@
     M(xy_to_unit_angle)                                            \
     M(xy_to_radius)                                                \
     M(emboss)                                                      \
-    M(swizzle)
+    M(swizzle)                                                     \
+    M(profile)
 
 #define SK_RASTER_PIPELINE_OPS_HIGHP_ONLY(M)                       \
     M(callback)                                                    \
@@ -100,6 +101,7 @@
     M(alter_2pt_conical_unswap)                                    \
     M(mask_2pt_conical_nan)                                        \
     M(mask_2pt_conical_degenerates) M(apply_vector_mask)           \
+    M(rrect_coverage)                                              \
     /* Dedicated SkSL stages begin here: */                                                   \
     M(init_lane_masks) M(store_device_xy01)                                                   \
     M(load_condition_mask) M(store_condition_mask) M(merge_condition_mask)                    \
@@ -156,6 +158,7 @@
     M(min_n_uints)    M(min_uint)    M(min_2_uints)    M(min_3_uints)    M(min_4_uints)       \
     M(mix_n_floats)   M(mix_float)   M(mix_2_floats)   M(mix_3_floats)   M(mix_4_floats)      \
     M(mix_n_ints)     M(mix_int)     M(mix_2_ints)     M(mix_3_ints)     M(mix_4_ints)        \
+    M(mad_n_floats)   M(mad_float)   M(mad_2_floats)   M(mad_3_floats)   M(mad_4_floats)      \
                                      M(dot_2_floats)   M(dot_3_floats)   M(dot_4_floats)      \
     M(cmplt_n_floats) M(cmplt_float) M(cmplt_2_floats) M(cmplt_3_floats) M(cmplt_4_floats)    \
     M(cmplt_n_ints)   M(cmplt_int)   M(cmplt_2_ints)   M(cmplt_3_ints)   M(cmplt_4_ints)      \
@@ -166,7 +169,18 @@
     M(cmpeq_n_floats) M(cmpeq_float) M(cmpeq_2_floats) M(cmpeq_3_floats) M(cmpeq_4_floats)    \
     M(cmpeq_n_ints)   M(cmpeq_int)   M(cmpeq_2_ints)   M(cmpeq_3_ints)   M(cmpeq_4_ints)      \
     M(cmpne_n_floats) M(cmpne_float) M(cmpne_2_floats) M(cmpne_3_floats) M(cmpne_4_floats)    \
-    M(cmpne_n_ints)   M(cmpne_int)   M(cmpne_2_ints)   M(cmpne_3_ints)   M(cmpne_4_ints)
+    M(cmpne_n_ints)   M(cmpne_int)   M(cmpne_2_ints)   M(cmpne_3_ints)   M(cmpne_4_ints)      \
+    /* Fused SkSL stages taking an immediate operand: */                                      \
+    M(add_imm_float)  M(add_imm_2_floats)  M(add_imm_3_floats)  M(add_imm_4_floats)           \
+    M(add_imm_int)    M(add_imm_2_ints)    M(add_imm_3_ints)    M(add_imm_4_ints)             \
+    M(mul_imm_float)  M(mul_imm_2_floats)  M(mul_imm_3_floats)  M(mul_imm_4_floats)           \
+    M(mul_imm_int)    M(mul_imm_2_ints)    M(mul_imm_3_ints)    M(mul_imm_4_ints)             \
+    M(bitwise_and_imm_int) M(bitwise_and_imm_2_ints)                                          \
+    M(bitwise_and_imm_3_ints) M(bitwise_and_imm_4_ints)                                       \
+    M(bitwise_xor_imm_int) M(min_imm_float) M(max_imm_float)                                  \
+    M(cmplt_imm_float) M(cmplt_imm_int) M(cmplt_imm_uint)                                     \
+    M(cmple_imm_float) M(cmple_imm_int) M(cmple_imm_uint)                                     \
+    M(cmpeq_imm_float) M(cmpeq_imm_int) M(cmpne_imm_float) M(cmpne_imm_int)
 
 // The combined list of all RasterPipeline ops:
 #define SK_RASTER_PIPELINE_OPS_ALL(M) \
@@ -0,0 +1,315 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkRasterPipelineProfiler.h"
+
+#include "include/core/SkString.h"
+#include "include/private/base/SkMutex.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkTHash.h"
+#include "src/core/SkTraceEvent.h"
+#include "src/utils/SkCycles.h"
+#include "src/utils/SkJSONWriter.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+using Op = SkRasterPipelineOp;
+
+namespace {
+
+struct StageCounters {
+    std::atomic<uint64_t> fCount{0};
+    std::atomic<uint64_t> fSampledCount{0};
+    std::atomic<uint64_t> fSampledCycles{0};
+
+    // The cycles spent in the stage, scaled up from its sampled runs to all of them.
+    double estimatedCycles() const {
+        uint64_t sampled = fSampledCount.load(std::memory_order_relaxed);
+        if (!sampled) {
+            return 0;
+        }
+        return (double)fSampledCycles.load(std::memory_order_relaxed) *
+               fCount.load(std::memory_order_relaxed) / sampled;
+    }
+};
+
+struct Shape {
+    Shape(const Op ops[], int count, const char* highpReason)
+            : fOps(ops, ops + count)
+            , fHighpReason(highpReason)
+            , fStages(new StageCounters[count]) {}
+
+    const std::vector<Op>            fOps;
+    const char* const                fHighpReason;  // nullptr for lowp pipelines
+    std::unique_ptr<StageCounters[]> fStages;
+    std::atomic<uint64_t>            fRuns{0};
+    std::atomic<uint64_t>            fPixels{0};
+};
+
+// Which stage of which shape this thread is timing, if any.
+struct ThreadState {
+    Shape*   fShape = nullptr;
+    int      fStage = 0;
+    uint64_t fStart = 0;
+    uint32_t fRuns  = 0;
+};
+
+struct Registry {
+    SkMutex fMutex;
+    SkTHashMap<SkString, std::unique_ptr<Shape>> fShapes SK_GUARDED_BY(fMutex);
+};
+
+}  // namespace
+
+static std::atomic<bool>     gEnabled{false};
+static std::atomic<uint64_t> gOverheadCycles{0};
+
+static Registry& registry() {
+    static Registry* registry = new Registry;
+    return *registry;
+}
+
+static ThreadState& thread_state() {
+    thread_local ThreadState state;
+    return state;
+}
+
+// The fewest cycles we've seen between two back-to-back reads of the counter. This is subtracted
+// from every sample, as a stand-in for the cost of the profile stages themselves.
+static uint64_t measure_overhead() {
+    uint64_t overhead = UINT64_MAX;
+    for (int i = 0; i < 1000; ++i) {
+        uint64_t start = SkCycles::Now();
+        overhead = std::min(overhead, SkCycles::Now() - start);
+    }
+    return overhead;
+}
+
+// Runs in front of stage ctx->stage (or at the end of the pipeline, when that's the stage count).
+// If this thread is sampling the current run, the time since the last profile stage is charged to
+// the stage that ran in between. Pipelines run by other pipelines' stages cut the outer samples
+// short, rather than being charged to the stage that ran them.
+static void profile(SkRasterPipeline_ProfileCtx* ctx, int activePixels) {
+    Shape* shape = static_cast<Shape*>(ctx->shape);
+    ThreadState& thread = thread_state();
+
+    bool sampling = thread.fShape == shape;
+    if (sampling) {
+        uint64_t cycles   = SkCycles::Now() - thread.fStart,
+                 overhead = gOverheadCycles.load(std::memory_order_relaxed);
+        StageCounters& stage = shape->fStages[thread.fStage];
+        stage.fSampledCount.fetch_add(1, std::memory_order_relaxed);
+        stage.fSampledCycles.fetch_add(cycles > overhead ? cycles - overhead : 0,
+                                       std::memory_order_relaxed);
+    }
+    thread.fShape = nullptr;
+
+    if (ctx->stage == 0) {
+        shape->fRuns.fetch_add(1, std::memory_order_relaxed);
+        shape->fPixels.fetch_add(activePixels, std::memory_order_relaxed);
+        sampling = ++thread.fRuns % SkRasterPipelineProfiler::kSampleInterval == 0;
+    }
+    if (ctx->stage == (int)shape->fOps.size()) {
+        return;
+    }
+    shape->fStages[ctx->stage].fCount.fetch_add(1, std::memory_order_relaxed);
+
+    if (sampling) {
+        thread.fShape = shape;
+        thread.fStage = ctx->stage;
+        thread.fStart = SkCycles::Now();
+    }
+}
+
+namespace SkRasterPipelineProfiler {
+
+void SetEnabled(bool enabled) {
+    if (enabled && !gOverheadCycles.load()) {
+        gOverheadCycles = measure_overhead();
+    }
+    gEnabled = enabled;
+}
+
+bool IsEnabled() {
+    return gEnabled.load(std::memory_order_relaxed);
+}
+
+void Reset() {
+    Registry& reg = registry();
+    SkAutoMutexExclusive lock(reg.fMutex);
+    reg.fShapes.foreach([](const SkString&, std::unique_ptr<Shape>* entry) {
+        Shape* shape = entry->get();
+        for (size_t i = 0; i < shape->fOps.size(); ++i) {
+            shape->fStages[i].fCount         = 0;
+            shape->fStages[i].fSampledCount  = 0;
+            shape->fStages[i].fSampledCycles = 0;
+        }
+        shape->fRuns   = 0;
+        shape->fPixels = 0;
+    });
+}
+
+void Attach(SkRasterPipeline_ProfileCtx ctxs[], const Op ops[], int count,
+            const char* highpReason) {
+    SkString key(highpReason ? highpReason : "lowp");
+    for (int i = 0; i < count; ++i) {
+        key.appendf(" %d", (int)ops[i]);
+    }
+
+    Shape* shape;
+    {
+        Registry& reg = registry();
+        SkAutoMutexExclusive lock(reg.fMutex);
+        std::unique_ptr<Shape>* found = reg.fShapes.find(key);
+        if (!found) {
+            found = reg.fShapes.set(key, std::make_unique<Shape>(ops, count, highpReason));
+        }
+        shape = found->get();
+    }
+
+    for (int i = 0; i <= count; ++i) {
+        ctxs[i] = {profile, shape, i};
+    }
+}
+
+namespace {
+
+struct StageSnapshot {
+    Op       fOp;
+    uint64_t fCount;
+    double   fCycles;
+};
+
+struct ShapeSnapshot {
+    const char*                fHighpReason;
+    uint64_t                   fRuns;
+    uint64_t                   fPixels;
+    double                     fCycles;
+    std::vector<StageSnapshot> fStages;
+};
+
+}  // namespace
+
+// Copies out the counters of every shape that has run, sorted by their estimated cycles.
+static std::vector<ShapeSnapshot> snapshot() {
+    std::vector<ShapeSnapshot> shapes;
+    {
+        Registry& reg = registry();
+        SkAutoMutexExclusive lock(reg.fMutex);
+        reg.fShapes.foreach([&](const SkString&, std::unique_ptr<Shape>* entry) {
+            const Shape* shape = entry->get();
+            uint64_t runs = shape->fRuns.load(std::memory_order_relaxed);
+            if (!runs) {
+                return;
+            }
+            ShapeSnapshot snap{shape->fHighpReason, runs,
+                               shape->fPixels.load(std::memory_order_relaxed), 0, {}};
+            for (size_t i = 0; i < shape->fOps.size(); ++i) {
+                const StageCounters& stage = shape->fStages[i];
+                double cycles = stage.estimatedCycles();
+                snap.fStages.push_back({shape->fOps[i],
+                                        stage.fCount.load(std::memory_order_relaxed),
+                                        cycles});
+                snap.fCycles += cycles;
+            }
+            shapes.push_back(std::move(snap));
+        });
+    }
+    std::sort(shapes.begin(), shapes.end(), [](const ShapeSnapshot& a, const ShapeSnapshot& b) {
+        return a.fCycles > b.fCycles;
+    });
+    return shapes;
+}
+
+void Dump(SkJSONWriter* writer) {
+    const std::vector<ShapeSnapshot> shapes = snapshot();
+
+    // Tally up the pixels that ran in highp by the reason they couldn't run in lowp, most first.
+    struct HighpReason {
+        const char* fReason;
+        uint64_t    fPipelines;
+        uint64_t    fPixels;
+    };
+    std::vector<HighpReason> reasons;
+    for (const ShapeSnapshot& shape : shapes) {
+        if (!shape.fHighpReason) {
+            continue;
+        }
+        auto it = std::find_if(reasons.begin(), reasons.end(), [&](const HighpReason& reason) {
+            return !strcmp(reason.fReason, shape.fHighpReason);
+        });
+        if (it == reasons.end()) {
+            reasons.push_back({shape.fHighpReason, 0, 0});
+            it = reasons.end() - 1;
+        }
+        it->fPipelines += 1;
+        it->fPixels    += shape.fPixels;
+    }
+    std::sort(reasons.begin(), reasons.end(), [](const HighpReason& a, const HighpReason& b) {
+        return a.fPixels > b.fPixels;
+    });
+
+    writer->beginObject();
+    writer->appendS32("sample_interval", kSampleInterval);
+    writer->appendU64("overhead_cycles", gOverheadCycles.load());
+    writer->beginArray("highp_reasons");
+    for (const HighpReason& reason : reasons) {
+        writer->beginObject(nullptr, /*multiline=*/false);
+        writer->appendCString("reason", reason.fReason);
+        writer->appendU64("pipelines", reason.fPipelines);
+        writer->appendU64("pixels", reason.fPixels);
+        writer->endObject();
+    }
+    writer->endArray();
+    writer->beginArray("pipelines");
+    for (const ShapeSnapshot& shape : shapes) {
+        writer->beginObject();
+        writer->appendCString("precision", shape.fHighpReason ? "highp" : "lowp");
+        if (shape.fHighpReason) {
+            writer->appendCString("highp_reason", shape.fHighpReason);
+        }
+        writer->appendU64("runs", shape.fRuns);
+        writer->appendU64("pixels", shape.fPixels);
+        writer->appendDouble("cycles", shape.fCycles);
+        writer->appendDouble("cycles_per_pixel", shape.fCycles / shape.fPixels);
+        writer->beginArray("stages");
+        for (const StageSnapshot& stage : shape.fStages) {
+            writer->beginObject(nullptr, /*multiline=*/false);
+            writer->appendCString("op", SkRasterPipeline::GetOpName(stage.fOp));
+            writer->appendU64("count", stage.fCount);
+            writer->appendDouble("cycles", stage.fCycles);
+            writer->endObject();
+        }
+        writer->endArray();
+        writer->endObject();
+    }
+    writer->endArray();
+    writer->endObject();
+}
+
+void EmitTraceCounters() {
+    double cycles[kNumRasterPipelineHighpOps] = {};
+    for (const ShapeSnapshot& shape : snapshot()) {
+        for (const StageSnapshot& stage : shape.fStages) {
+            cycles[(int)stage.fOp] += stage.fCycles;
+        }
+    }
+    for (int op = 0; op < kNumRasterPipelineHighpOps; ++op) {
+        if (cycles[op] > 0) {
+            TRACE_COUNTER1("skia", SkRasterPipeline::GetOpName((Op)op),
+                           std::min(cycles[op] / 1000, (double)INT_MAX));
+        }
+    }
+}
+
+}  // namespace SkRasterPipelineProfiler
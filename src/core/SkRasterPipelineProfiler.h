@@ -0,0 +1,61 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkRasterPipelineProfiler_DEFINED
+#define SkRasterPipelineProfiler_DEFINED
+
+#include "src/core/SkRasterPipelineOpList.h"
+
+class SkJSONWriter;
+struct SkRasterPipeline_ProfileCtx;
+
+/**
+ *  A runtime-enabled profiling mode for SkRasterPipeline. While it is enabled, every pipeline that
+ *  is built gets a profile stage in front of each of its stages. Those count how many times each
+ *  stage runs, and time the stages of every kSampleInterval'th run through the pipeline on each
+ *  thread with SkCycles, less the profiler's own measured overhead. Its "cycles" are SkCycles
+ *  ticks, which on ARM64 are system timer ticks rather than CPU cycles.
+ *
+ *  The counts are aggregated per pipeline shape: its precision and sequence of ops. Shapes are
+ *  never forgotten, so Reset() zeroes their counters rather than freeing them.
+ */
+namespace SkRasterPipelineProfiler {
+
+constexpr int kSampleInterval = 16;
+
+void SetEnabled(bool enabled);
+bool IsEnabled();
+
+/** Zeroes the counters of every pipeline shape seen so far. */
+void Reset();
+
+/**
+ *  Writes the counters as a JSON object holding an array of pipeline shapes, sorted by their
+ *  estimated cycles, each with an array of its stages. Highp shapes also name the reason they
+ *  couldn't run in lowp (see SkRasterPipeline::highpReason()), and those reasons are tallied up by
+ *  the pixels they sent down highp.
+ */
+void Dump(SkJSONWriter*);
+
+/**
+ *  Emits one trace counter per SkRasterPipelineOp that has run, holding the estimated kilocycles
+ *  spent in that op across all pipeline shapes.
+ */
+void EmitTraceCounters();
+
+/**
+ *  Points the contexts of a pipeline's count + 1 profile stages at the counters for its shape.
+ *  Called by SkRasterPipeline when it builds a pipeline; highpReason is nullptr for lowp pipelines.
+ */
+void Attach(SkRasterPipeline_ProfileCtx ctxs[],
+            const SkRasterPipelineOp ops[],
+            int count,
+            const char* highpReason);
+
+}  // namespace SkRasterPipelineProfiler
+
+#endif
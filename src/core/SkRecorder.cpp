@@ -29,6 +29,7 @@
 #include "include/private/base/SkTo.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkCanvasPriv.h"
+#include "src/core/SkPathRefInterner.h"
 #include "src/core/SkRecord.h"
 #include "src/core/SkRecords.h"
 #include "src/text/GlyphRun.h"
@@ -173,6 +174,10 @@ char* SkRecorder::copy(const char* src) {
     return this->copy(src, strlen(src)+1);
 }
 
+SkPath SkRecorder::internPath(const SkPath& path) {
+    return fPathInterner ? fPathInterner->intern(path) : path;
+}
+
 void SkRecorder::onDrawPaint(const SkPaint& paint) {
     this->append<SkRecords::DrawPaint>(paint);
 }
@@ -222,7 +227,7 @@ void SkRecorder::onDrawDrawable(SkDrawable* drawable, const SkMatrix* matrix) {
 }
 
 void SkRecorder::onDrawPath(const SkPath& path, const SkPaint& paint) {
-    this->append<SkRecords::DrawPath>(paint, path);
+    this->append<SkRecords::DrawPath>(paint, this->internPath(path));
 }
 
 void SkRecorder::onDrawImage2(const SkImage* image, SkScalar x, SkScalar y,
@@ -313,7 +318,7 @@ void SkRecorder::onDrawAtlas2(const SkImage* atlas, const SkRSXform xform[], con
 }
 
 void SkRecorder::onDrawShadowRec(const SkPath& path, const SkDrawShadowRec& rec) {
-    this->append<SkRecords::DrawShadowRec>(path, rec);
+    this->append<SkRecords::DrawShadowRec>(this->internPath(path), rec);
 }
 
 void SkRecorder::onDrawAnnotation(const SkRect& rect, const char key[], SkData* value) {
@@ -400,7 +405,7 @@ void SkRecorder::onClipRRect(const SkRRect& rrect, SkClipOp op, ClipEdgeStyle ed
 void SkRecorder::onClipPath(const SkPath& path, SkClipOp op, ClipEdgeStyle edgeStyle) {
     INHERITED(onClipPath, path, op, edgeStyle);
     SkRecords::ClipOpAndAA opAA(op, kSoft_ClipEdgeStyle == edgeStyle);
-    this->append<SkRecords::ClipPath>(path, opAA);
+    this->append<SkRecords::ClipPath>(this->internPath(path), opAA);
 }
 
 void SkRecorder::onClipShader(sk_sp<SkShader> cs, SkClipOp op) {
@@ -31,6 +31,7 @@ class SkMatrix;
 class SkMesh;
 class SkPaint;
 class SkPath;
+class SkPathRefInterner;
 class SkPicture;
 class SkRRect;
 class SkRecord;
@@ -86,6 +87,9 @@ public:
     SkDrawableList* getDrawableList() const { return fDrawableList.get(); }
     std::unique_ptr<SkDrawableList> detachDrawableList() { return std::move(fDrawableList); }
 
+    // Paths are recorded through the interner, if one is set. Does not take ownership.
+    void setPathInterner(SkPathRefInterner* interner) { fPathInterner = interner; }
+
     // Make SkRecorder forget entirely about its SkRecord*; all calls to SkRecorder will fail.
     void forgetRecord();
 
@@ -171,9 +175,12 @@ private:
     template<typename T, typename... Args>
     void append(Args&&...);
 
+    SkPath internPath(const SkPath&);
+
     size_t fApproxBytesUsedBySubPictures;
     SkRecord* fRecord;
     std::unique_ptr<SkDrawableList> fDrawableList;
+    SkPathRefInterner* fPathInterner = nullptr;
 };
 
 #endif//SkRecorder_DEFINED
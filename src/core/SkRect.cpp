@@ -74,6 +74,32 @@ bool SkRect::setBoundsCheck(const SkPoint pts[], int count) {
     }
 
     skvx::float4 accum = min * 0;
+    if (count >= 8) {
+        // Long arrays are scanned 8 points at a time, split across two sets of accumulators so
+        // that consecutive min/max/accum updates don't wait on each other.
+        skvx::float8 min0 = skvx::join(min, min),
+                     max0 = skvx::join(max, max),
+                     accum0 = skvx::join(accum, accum);
+        skvx::float8 min1 = min0, max1 = max0, accum1 = accum0;
+        do {
+            skvx::float8 xy0 = skvx::float8::Load(pts);
+            skvx::float8 xy1 = skvx::float8::Load(pts + 4);
+            accum0 = accum0 * xy0;
+            accum1 = accum1 * xy1;
+            min0 = skvx::min(min0, xy0);
+            min1 = skvx::min(min1, xy1);
+            max0 = skvx::max(max0, xy0);
+            max1 = skvx::max(max1, xy1);
+            pts   += 8;
+            count -= 8;
+        } while (count >= 8);
+        min0 = skvx::min(min0, min1);
+        max0 = skvx::max(max0, max1);
+        accum0 = accum0 * accum1;
+        min = skvx::min(min0.lo, min0.hi);
+        max = skvx::max(max0.lo, max0.hi);
+        accum = accum0.lo * accum0.hi;
+    }
     while (count) {
         skvx::float4 xy = skvx::float4::Load(pts);
         accum = accum * xy;
@@ -356,6 +356,9 @@ void SkRegion::BuildRectRuns(const SkIRect& bounds,
     runs[6] = SkRegion_kRunTypeSentinel;
 }
 
+// Scanlines with more intervals than this are binary searched by contains(x, y).
+static constexpr int kMinBinarySearchIntervals = 8;
+
 bool SkRegion::contains(int32_t x, int32_t y) const {
     SkDEBUGCODE(SkRegionPriv::Validate(*this));
 
@@ -368,16 +371,30 @@ bool SkRegion::contains(int32_t x, int32_t y) const {
     SkASSERT(this->isComplex());
 
     const RunType* runs = fRunHead->findScanline(y);
+    int intervals = runs[1];
 
     // Skip the Bottom and IntervalCount
     runs += 2;
 
+    // Long scanlines are binary searched for the last interval that starts at
+    // or before x. Short ones are cheaper to just walk.
+    if (intervals > kMinBinarySearchIntervals) {
+        int lo = 0,
+            hi = intervals;  // the interval at hi starts after x
+        while (hi - lo > 1) {
+            int mid = (lo + hi) >> 1;
+            if (x < runs[mid * 2]) {
+                hi = mid;
+            } else {
+                lo = mid;
+            }
+        }
+        return runs[lo * 2] <= x && x < runs[lo * 2 + 1];
+    }
+
     // Just walk this scanline, checking each interval. The X-sentinel will
     // appear as a left-inteval (runs[0]) and should abort the search.
     //
-    // We could do a bsearch, using interval-count (runs[1]), but need to time
-    // when that would be worthwhile.
-    //
     for (;;) {
         if (x < runs[0]) {
             break;
@@ -642,6 +659,10 @@ void SkRegion::translate(int dx, int dy, SkRegion* dst) const {
 
         SkASSERT(sruns - fRunHead->readonly_runs() == fRunHead->fRunCount);
         SkASSERT(druns - dst->fRunHead->readonly_runs() == dst->fRunHead->fRunCount);
+
+        if (this != dst) {
+            dst->fRunHead->copyRowIndex(*fRunHead);
+        }
     }
 
     SkDEBUGCODE(SkRegionPriv::Validate(*this));
@@ -783,6 +804,23 @@ static int operate_on_span(const SkRegionPriv::RunType a_runs[],
             dstOffset + distance_to_sentinel(a_runs) + distance_to_sentinel(b_runs) + 2);
     SkRegionPriv::RunType* dst = &(*array)[dstOffset]; // get pointer AFTER resizing.
 
+    // A span that only one of the operands covers is either copied as is or dropped.
+    // Valid runs never have touching intervals, so copying them matches what the
+    // general merge below would produce.
+    const bool a_only = b_runs[0] == SkRegion_kRunTypeSentinel;
+    const bool b_only = a_runs[0] == SkRegion_kRunTypeSentinel;
+    if (a_only != b_only) {
+        int inside = a_only ? 1 : 2;
+        if ((unsigned)(inside - min) <= (unsigned)(max - min)) {
+            const SkRegionPriv::RunType* src = a_only ? a_runs : b_runs;
+            int n = distance_to_sentinel(src);
+            memcpy(dst, src, n * sizeof(SkRegionPriv::RunType));
+            dst += n;
+        }
+        *dst++ = SkRegion_kRunTypeSentinel;
+        return dst - &(*array)[0];
+    }
+
     spanRec rec;
     bool    firstInterval = true;
 
@@ -1305,6 +1343,7 @@ size_t SkRegion::readFromMemory(const void* storage, size_t length) {
             tmp.allocateRuns(count, ySpanCount, intervalCount);
             SkASSERT(tmp.isComplex());
             SkAssertResult(buffer.read(tmp.fRunHead->writable_runs(), count * sizeof(int32_t)));
+            tmp.fRunHead->buildRowIndex();
         }
     }
     SkASSERT(tmp.isValid());
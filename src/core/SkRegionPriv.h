@@ -13,6 +13,7 @@
 #include "include/private/base/SkMalloc.h"
 #include "include/private/base/SkTo.h"
 
+#include <algorithm>
 #include <atomic>
 #include <functional>
 
@@ -87,7 +88,12 @@ public:
             return nullptr;
         }
 
-        const int64_t size = sk_64_mul(count, sizeof(RunType)) + sizeof(RunHead);
+        // Leave room after the runs for the row index, in case there turn out to be enough spans.
+        int64_t indexCount = MaxYSpanCount(count);
+        if (indexCount < kMinIndexedYSpanCount) {
+            indexCount = 0;
+        }
+        const int64_t size = sk_64_mul(count + indexCount, sizeof(RunType)) + sizeof(RunHead);
         if (count < 0 || !SkTFitsIn<int32_t>(size)) { SK_ABORT("Invalid Size"); }
 
         RunHead* head = (RunHead*)sk_malloc_throw(size);
@@ -130,6 +136,7 @@ public:
             writable = Alloc(fRunCount, fYSpanCount, fIntervalCount);
             memcpy(writable->writable_runs(), this->readonly_runs(),
                    fRunCount * sizeof(RunType));
+            writable->copyRowIndex(*this);
 
             // fRefCount might have changed since we last checked.
             // If we own the last reference at this point, we need to
@@ -177,6 +184,16 @@ public:
         // if the top-check fails, we didn't do a quick check on the bounds
         SkASSERT(y >= runs[0]);
 
+        if (this->hasRowIndex()) {
+            // Binary search for the first scanline whose bottom is below y.
+            const int32_t* index = this->readonly_row_index();
+            const int32_t* found = std::upper_bound(index, index + fYSpanCount, y,
+                    [runs](int y, int32_t offset) { return y < runs[offset]; });
+            // If we hit this, our bounds check failed.
+            SkASSERT(found < index + fYSpanCount);
+            return const_cast<SkRegion::RunType*>(runs + *found);
+        }
+
         runs += 1;  // skip top-Y
         for (;;) {
             int bottom = runs[0];
@@ -251,9 +268,63 @@ public:
         bounds->fLeft = left;
         bounds->fRight = rite;
         bounds->fBottom = bot;
+
+        this->buildRowIndex();
+    }
+
+    /**
+     *  Regions with at least this many spans keep the offset of each scanline in a row index after
+     *  their runs, so that findScanline() can binary search instead of walking every scanline.
+     */
+    inline static constexpr int kMinIndexedYSpanCount = 16;
+
+    bool hasRowIndex() const {
+        return fYSpanCount >= kMinIndexedYSpanCount;
+    }
+
+    /**
+     *  Fills in the row index from the runs, if there are enough spans to need one. This must be
+     *  called whenever the runs are written from scratch. Offsetting the runs' values doesn't
+     *  change the index.
+     */
+    void buildRowIndex() {
+        if (!this->hasRowIndex()) {
+            return;
+        }
+        SkASSERT(fYSpanCount <= MaxYSpanCount(fRunCount));
+        const RunType* runs = this->readonly_runs();
+        const RunType* scanline = runs + 1;  // skip top-Y
+        int32_t* index = this->writable_row_index();
+        for (int i = 0; i < fYSpanCount; ++i) {
+            index[i] = SkToS32(scanline - runs);
+            scanline = SkipEntireScanline(scanline);
+        }
+        SkASSERT(SkRegion_kRunTypeSentinel == *scanline);
+    }
+
+    /** Copies the row index from a RunHead with the same runs (up to an offset). */
+    void copyRowIndex(const RunHead& src) {
+        SkASSERT(fRunCount == src.fRunCount && fYSpanCount == src.fYSpanCount);
+        if (this->hasRowIndex()) {
+            memcpy(this->writable_row_index(), src.readonly_row_index(),
+                   fYSpanCount * sizeof(int32_t));
+        }
     }
 
 private:
+    // Each span takes at least three runs [B N S], after the top-Y and before the Y-sentinel.
+    static int MaxYSpanCount(int count) {
+        return (count - 2) / 3;
+    }
+
+    int32_t* writable_row_index() {
+        return this->writable_runs() + fRunCount;
+    }
+
+    const int32_t* readonly_row_index() const {
+        return this->readonly_runs() + fRunCount;
+    }
+
     int32_t fYSpanCount;
     int32_t fIntervalCount;
 };
@@ -0,0 +1,381 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/core/SkResample.h"
+
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRefCnt.h"
+#include "include/private/base/SkFloatingPoint.h"
+#include "include/private/base/SkTPin.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkConvertPixels.h"
+#include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace {
+
+using Filter = SkResample::Filter;
+
+// Each band of this many destination rows is resampled by its own task. Neighboring bands both
+// filter the source rows under the seam between them, which costs about radius/16 extra work.
+constexpr int kBandRows = 32;
+
+// Source rows are converted to the working format this many at a time.
+constexpr int kConvertRows = 8;
+
+// Downscales by twice this or more are first box filtered by a whole factor, leaving the filter
+// to downscale by between this and twice this. That caps its taps per pixel at about
+// 4 * kReduceGap * radius, instead of letting them grow with the scale.
+constexpr int kReduceGap = 2;
+
+// Boxes are summed as 32-bit integers, which holds 4096 * 4096 pixels' worth of 255s.
+constexpr int kMaxReduce = 4096;
+
+int reduce_factor(int srcLen, int dstLen) {
+    return SkTPin(srcLen / (dstLen * kReduceGap), 1, kMaxReduce);
+}
+
+float filter_radius(Filter filter) {
+    return filter == Filter::kLanczos3 ? 3.0f : 2.0f;
+}
+
+// Mitchell-Netravali cubics, as in SkImageShader::CubicResamplerMatrix().
+float cubic(float x, float B, float C) {
+    x = std::abs(x);
+    if (x < 1) {
+        return ((12 - 9*B - 6*C)*x*x*x + (-18 + 12*B + 6*C)*x*x + (6 - 2*B)) * (1/6.0f);
+    }
+    if (x < 2) {
+        return ((-B - 6*C)*x*x*x + (6*B + 30*C)*x*x + (-12*B - 48*C)*x + (8*B + 24*C)) * (1/6.0f);
+    }
+    return 0;
+}
+
+float lanczos3(float x) {
+    x = std::abs(x);
+    if (x < 1e-6f) {
+        return 1;
+    }
+    if (x >= 3) {
+        return 0;
+    }
+    const float px = SK_FloatPI * x;
+    return 3 * std::sin(px) * std::sin(px * (1/3.0f)) / (px * px);
+}
+
+float filter_weight(Filter filter, float x) {
+    switch (filter) {
+        case Filter::kMitchell:   return cubic(x, 1/3.0f, 1/3.0f);
+        case Filter::kCatmullRom: return cubic(x, 0, 0.5f);
+        case Filter::kLanczos3:   return lanczos3(x);
+    }
+    SkUNREACHABLE;
+}
+
+// The source pixels, and their normalized weights, that make up each destination pixel along one
+// axis. When downscaling, the filter is stretched to cover every source pixel.
+//
+// With a reduce factor above 1, the taps index boxes of that many source pixels instead. Each
+// weight is divided by its box's size, so it applies directly to the sum of the box's pixels.
+struct Taps {
+    std::vector<int>   fFirst;
+    std::vector<int>   fCount;
+    std::vector<int>   fOffset;   // of each destination pixel's first weight in fWeights
+    std::vector<float> fWeights;
+
+    Taps(int srcLen, int dstLen, int reduce, Filter filter) {
+        const int   boxes   = (srcLen + reduce - 1) / reduce;
+        const float scale   = (float)dstLen * reduce / srcLen,
+                    stretch = std::max(1.0f, 1 / scale),
+                    radius  = filter_radius(filter) * stretch;
+
+        for (int i = 0; i < dstLen; ++i) {
+            const float center = (i + 0.5f) / scale;
+            int first = std::max(0, sk_float_floor2int(center - radius)),
+                last  = std::min(boxes - 1, sk_float_ceil2int(center + radius));
+
+            // Skip taps at either end that the filter doesn't reach.
+            auto weight = [&](int j) {
+                return filter_weight(filter, (j + 0.5f - center) / stretch);
+            };
+            while (first < last && weight(first) == 0) { first++; }
+            while (last > first && weight(last)  == 0) { last--;  }
+
+            const int offset = (int)fWeights.size();
+            float sum = 0;
+            for (int j = first; j <= last; ++j) {
+                fWeights.push_back(weight(j));
+                sum += fWeights.back();
+            }
+            if (sum == 0) {
+                // Only possible for tiny sources near the edges; fall back to the nearest pixel.
+                fWeights.resize(offset);
+                fWeights.push_back(1);
+                first = last = SkTPin(sk_float_floor2int(center), 0, boxes - 1);
+                sum = 1;
+            }
+            for (int j = offset; j < (int)fWeights.size(); ++j) {
+                const int box = first + j - offset;
+                fWeights[j] /= sum * std::min(reduce, srcLen - box * reduce);
+            }
+
+            fFirst .push_back(first);
+            fCount .push_back(last - first + 1);
+            fOffset.push_back(offset);
+        }
+    }
+};
+
+struct Plan {
+    SkPixmap    fSrc,
+                fDst;
+    SkImageInfo fWork;  // premul RGBA F32, in the color space we filter in
+    int         fReduceX,
+                fReduceY;
+    Taps        fX,
+                fY;
+};
+
+// Rows of 8888 premul pixels already in the working color space skip SkConvertPixels().
+bool is_direct_8888(const SkImageInfo& info, const SkImageInfo& work) {
+    return (info.colorType() == kRGBA_8888_SkColorType ||
+            info.colorType() == kBGRA_8888_SkColorType) &&
+           info.alphaType() != kUnpremul_SkAlphaType &&
+           SkColorSpace::Equals(info.colorSpace(), work.colorSpace());
+}
+
+void load_8888(const uint32_t src[], int n, bool bgra, skvx::float4 dst[]) {
+    for (int i = 0; i < n; ++i) {
+        skvx::float4 c = skvx::cast<float>(skvx::byte4::Load(src + i)) * (1/255.0f);
+        dst[i] = bgra ? skvx::shuffle<2,1,0,3>(c) : c;
+    }
+}
+
+void store_8888(const skvx::float4 src[], int n, bool bgra, uint32_t dst[]) {
+    for (int i = 0; i < n; ++i) {
+        skvx::float4 c = bgra ? skvx::shuffle<2,1,0,3>(src[i]) : src[i];
+        skvx::cast<uint8_t>(skvx::lrint(c * 255)).store(dst + i);
+    }
+}
+
+// Adds the sum of each box of `reduce` pixels in src, the last possibly partial, to dst.
+void reduce_row(const skvx::float4 src[], int srcW, int reduce, skvx::float4 dst[]) {
+    if (reduce == 1) {
+        for (int x = 0; x < srcW; ++x) {
+            dst[x] += src[x];
+        }
+        return;
+    }
+    for (int x = 0; x < srcW; x += reduce) {
+        const int end = std::min(x + reduce, srcW);
+        skvx::float4 sum = *dst;
+        for (int k = x; k < end; ++k) {
+            sum += src[k];
+        }
+        *dst++ = sum;
+    }
+}
+
+// Sets dst to the sums of the boxes of 8888 pixels covering source rows [y0,y1), scaled to [0,1]
+// per pixel. The sums are integers until each box is done, so there's one conversion per box rather
+// than one per source pixel.
+void reduce_8888(const SkPixmap& src, int y0, int y1, int reduce, bool bgra,
+                 uint32_t columns[], skvx::float4 dst[]) {
+    const int n = 4 * src.width();
+    std::fill(columns, columns + n, 0);
+    for (int y = y0; y < y1; ++y) {
+        const uint8_t* row = static_cast<const uint8_t*>(src.addr(0, y));
+        int i = 0;
+        for (; i + 16 <= n; i += 16) {
+            // A fixed trip count lets compilers vectorize this without a cleanup loop.
+            for (int j = 0; j < 16; ++j) {
+                columns[i + j] += row[i + j];
+            }
+        }
+        for (; i < n; ++i) {
+            columns[i] += row[i];
+        }
+    }
+    for (int x = 0; x < src.width(); x += reduce) {
+        const int end = std::min(x + reduce, src.width());
+        skvx::uint4 sum = 0;
+        for (int k = x; k < end; ++k) {
+            sum += skvx::uint4::Load(columns + 4 * k);
+        }
+        const skvx::float4 c = skvx::cast<float>(sum) * (1/255.0f);
+        *dst++ = bgra ? skvx::shuffle<2,1,0,3>(c) : c;
+    }
+}
+
+// dst[i] is the weighted sum of src's pixels under destination pixel i.
+void filter_row(const skvx::float4 src[], const Taps& taps, skvx::float4 dst[]) {
+    for (size_t i = 0; i < taps.fFirst.size(); ++i) {
+        const skvx::float4* s = src + taps.fFirst[i];
+        const float*        w = taps.fWeights.data() + taps.fOffset[i];
+
+        skvx::float4 sum = 0;
+        for (int k = 0; k < taps.fCount[i]; ++k) {
+            sum += s[k] * w[k];
+        }
+        dst[i] = sum;
+    }
+}
+
+// Filters rows [top,bottom) of boxes horizontally into dst. 8888 sources already in the working
+// format are summed into boxes as integers. Anything else is converted to the working format a few
+// rows at a time, then summed. Without reducing, boxes are pixels.
+void filter_boxes(const Plan& plan, int top, int bottom, skvx::float4 dst[]) {
+    const int srcW   = plan.fSrc.width(),
+              srcH   = plan.fSrc.height(),
+              dstW   = plan.fDst.width(),
+              boxesW = (srcW + plan.fReduceX - 1) / plan.fReduceX;
+    const bool reduce    = plan.fReduceX > 1 || plan.fReduceY > 1,
+               directSrc = is_direct_8888(plan.fSrc.info(), plan.fWork),
+               srcBGRA   = plan.fSrc.colorType() == kBGRA_8888_SkColorType;
+    std::unique_ptr<skvx::float4[]> boxes(reduce ? new skvx::float4[boxesW] : nullptr);
+
+    if (directSrc && reduce) {
+        std::unique_ptr<uint32_t[]> columns(new uint32_t[4 * srcW]);
+        for (int box = top; box < bottom; ++box) {
+            reduce_8888(plan.fSrc, box * plan.fReduceY, std::min(srcH, (box + 1) * plan.fReduceY),
+                        plan.fReduceX, srcBGRA, columns.get(), boxes.get());
+            filter_row(boxes.get(), plan.fX, dst + (box - top) * dstW);
+        }
+        return;
+    }
+
+    std::unique_ptr<skvx::float4[]> srcRows(new skvx::float4[kConvertRows * srcW]);
+    const int srcTop    = top * plan.fReduceY,
+              srcBottom = std::min(srcH, bottom * plan.fReduceY);
+    for (int sy = srcTop; sy < srcBottom; sy += kConvertRows) {
+        const int n = std::min(kConvertRows, srcBottom - sy);
+        if (directSrc) {
+            for (int r = 0; r < n; ++r) {
+                load_8888(plan.fSrc.addr32(0, sy + r), srcW, srcBGRA, srcRows.get() + r * srcW);
+            }
+        } else {
+            SkAssertResult(SkConvertPixels(plan.fWork.makeWH(srcW, n), srcRows.get(),
+                                           srcW * sizeof(skvx::float4),
+                                           plan.fSrc.info().makeWH(srcW, n), plan.fSrc.addr(0, sy),
+                                           plan.fSrc.rowBytes()));
+        }
+        for (int r = 0; r < n; ++r) {
+            const skvx::float4* row = srcRows.get() + r * srcW;
+            const int y   = sy + r,
+                      box = y / plan.fReduceY;
+            if (reduce) {
+                if (y % plan.fReduceY == 0) {
+                    std::fill(boxes.get(), boxes.get() + boxesW, skvx::float4(0));
+                }
+                reduce_row(row, srcW, plan.fReduceX, boxes.get());
+                if ((y + 1) % plan.fReduceY != 0 && y + 1 < srcH) {
+                    continue;  // This row of boxes isn't finished yet.
+                }
+                row = boxes.get();
+            }
+            filter_row(row, plan.fX, dst + (box - top) * dstW);
+        }
+    }
+}
+
+void resample_band(const Plan& plan, int y0, int y1) {
+    const int dstW = plan.fDst.width();
+
+    // Filter each row of boxes under this band horizontally.
+    int top    = INT_MAX,
+        bottom = INT_MIN;
+    for (int y = y0; y < y1; ++y) {
+        top    = std::min(top,    plan.fY.fFirst[y]);
+        bottom = std::max(bottom, plan.fY.fFirst[y] + plan.fY.fCount[y]);
+    }
+    std::unique_ptr<skvx::float4[]> filtered(new skvx::float4[(bottom - top) * dstW]);
+    filter_boxes(plan, top, bottom, filtered.get());
+
+    // Filter those vertically into this band's destination rows.
+    std::unique_ptr<skvx::float4[]> band(new skvx::float4[(y1 - y0) * dstW]);
+    for (int y = y0; y < y1; ++y) {
+        skvx::float4* row = band.get() + (y - y0) * dstW;
+        std::fill(row, row + dstW, skvx::float4(0));
+
+        const float* w = plan.fY.fWeights.data() + plan.fY.fOffset[y];
+        for (int k = 0; k < plan.fY.fCount[y]; ++k) {
+            const skvx::float4* src = filtered.get() + (plan.fY.fFirst[y] + k - top) * dstW;
+            for (int x = 0; x < dstW; ++x) {
+                row[x] += src[x] * w[k];
+            }
+        }
+
+        // Most of these filters overshoot, so clamp back to valid premul colors (clamp_gamut).
+        for (int x = 0; x < dstW; ++x) {
+            const float a = SkTPin(row[x][3], 0.0f, 1.0f);
+            row[x] = skvx::min(skvx::max(row[x], 0.0f), a);
+        }
+    }
+    if (plan.fDst.alphaType() == kPremul_SkAlphaType &&
+        is_direct_8888(plan.fDst.info(), plan.fWork)) {
+        for (int y = y0; y < y1; ++y) {
+            store_8888(band.get() + (y - y0) * dstW, dstW,
+                       plan.fDst.colorType() == kBGRA_8888_SkColorType,
+                       plan.fDst.writable_addr32(0, y));
+        }
+    } else {
+        SkAssertResult(SkConvertPixels(plan.fDst.info().makeWH(dstW, y1 - y0),
+                                       plan.fDst.writable_addr(0, y0), plan.fDst.rowBytes(),
+                                       plan.fWork.makeWH(dstW, y1 - y0), band.get(),
+                                       dstW * sizeof(skvx::float4)));
+    }
+}
+
+}  // namespace
+
+namespace SkResample {
+
+bool Scale(const SkPixmap& src, const SkPixmap& dst, const Options& options) {
+    if (!src.addr() || !dst.addr() ||
+        !SkImageInfoValidConversion(dst.info(), src.info()) ||
+        src.rowBytes() % src.info().bytesPerPixel() ||
+        dst.rowBytes() % dst.info().bytesPerPixel()) {
+        return false;
+    }
+
+    sk_sp<SkColorSpace> workCS = dst.refColorSpace();
+    if (options.fLinear && workCS && !workCS->gammaIsLinear()) {
+        workCS = workCS->makeLinearGamma();
+    }
+
+    const int reduceX = reduce_factor(src.width(),  dst.width()),
+              reduceY = reduce_factor(src.height(), dst.height());
+    const Plan plan{src,
+                    dst,
+                    SkImageInfo::Make(1, 1, kRGBA_F32_SkColorType, kPremul_SkAlphaType,
+                                      std::move(workCS)),
+                    reduceX,
+                    reduceY,
+                    Taps(src.width(),  dst.width(),  reduceX, options.fFilter),
+                    Taps(src.height(), dst.height(), reduceY, options.fFilter)};
+
+    SkTaskGroup tasks(options.fExecutor ? *options.fExecutor : SkExecutor::GetDefault());
+    const int bands = (dst.height() + kBandRows - 1) / kBandRows;
+    tasks.batch(bands, [&](int band) {
+        const int y0 = band * kBandRows;
+        resample_band(plan, y0, std::min(y0 + kBandRows, dst.height()));
+    });
+    tasks.wait();
+    return true;
+}
+
+}  // namespace SkResample
@@ -0,0 +1,55 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef SkResample_DEFINED
+#define SkResample_DEFINED
+
+class SkExecutor;
+class SkPixmap;
+
+/**
+ *  A high quality image resampler for CPU-side rescales like thumbnailing, and for cubic downscales
+ *  in SkRescaleAndReadPixels. Unlike drawing the image scaled, this scales in a single separable
+ *  pass with a windowed filter that widens with the amount of downscaling, so every source pixel
+ *  contributes to the result. Downscales by 4x or more first average boxes of pixels, so the
+ *  filter itself never reads more than about 8 radii of pixels per axis.
+ *
+ *  The filter runs on premul RGBA floats in the destination's color space, or its linear-gamma
+ *  equivalent when filtering in linear light. Destination rows are split into bands that are
+ *  resampled independently, as tasks on an SkExecutor. A thread pool may run them concurrently;
+ *  how much that helps depends on the machine, and neighboring bands redo a little of each other's
+ *  vertical filtering.
+ */
+namespace SkResample {
+
+enum class Filter {
+    kMitchell,    // cubic, B = C = 1/3
+    kCatmullRom,  // cubic, B = 0, C = 1/2
+    kLanczos3,    // sinc windowed by sinc, three lobes
+};
+
+struct Options {
+    Filter fFilter = Filter::kMitchell;
+
+    // Filter linearized colors. Ignored when the destination has no color space (it's unclear how
+    // to linearize those) or its color space is already linear.
+    bool fLinear = false;
+
+    // Runs the bands of rows. nullptr means SkExecutor::GetDefault(), which runs them in turn on
+    // the calling thread unless a thread pool has been made the default.
+    SkExecutor* fExecutor = nullptr;
+};
+
+/**
+ *  Resamples all of src to fill all of dst, converting between their color types, alpha types and
+ *  color spaces. Returns false if either is empty, or if their pixels can't be converted.
+ */
+bool Scale(const SkPixmap& src, const SkPixmap& dst, const Options& = {});
+
+}  // namespace SkResample
+
+#endif
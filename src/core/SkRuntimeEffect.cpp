@@ -10,7 +10,9 @@
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkColorFilter.h"
 #include "include/core/SkData.h"
+#include "include/core/SkMilestone.h"
 #include "include/core/SkSurface.h"
+#include "include/private/SkSLString.h"
 #include "include/private/base/SkMutex.h"
 #include "include/private/base/SkOnce.h"
 #include "include/sksl/DSLCore.h"
@@ -21,6 +23,7 @@
 #include "src/core/SkColorSpacePriv.h"
 #include "src/core/SkColorSpaceXformSteps.h"
 #include "src/core/SkLRUCache.h"
+#include "src/core/SkMD5.h"
 #include "src/core/SkMatrixProvider.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
@@ -36,6 +39,7 @@
 #include "src/sksl/SkSLUtil.h"
 #include "src/sksl/analysis/SkSLProgramUsage.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
+#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
 #include "src/sksl/codegen/SkSLVMCodeGenerator.h"
 #include "src/sksl/ir/SkSLFunctionDefinition.h"
 #include "src/sksl/ir/SkSLProgram.h"
@@ -67,12 +71,15 @@
 
 #ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
 #include "src/core/SkStreamPriv.h"
-#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
 #include "src/sksl/tracing/SkRPDebugTrace.h"
 constexpr bool kRPEnableLiveTrace = false;
 #endif
 
 #include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
 
 #if defined(SK_BUILD_FOR_DEBUGGER)
     #define SK_LENIENT_SKSL_DESERIALIZATION 1
@@ -203,10 +210,14 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram() const {
     // can avoid the cost of invoking the RP code generator until it's actually needed.
     fCompileRPProgramOnce([&] {
 #ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
+        if (fRPProgram) {
+            // The program was loaded from a PersistentCache.
+            return;
+        }
         SkSL::SkRPDebugTrace debugTrace;
         const_cast<SkRuntimeEffect*>(this)->fRPProgram =
-                MakeRasterPipelineProgram(*fBaseProgram,
-                                          fMain,
+                MakeRasterPipelineProgram(this->baseProgram(),
+                                          this->main(),
                                           kRPEnableLiveTrace ? &debugTrace : nullptr);
         if (kRPEnableLiveTrace) {
             if (fRPProgram) {
@@ -224,12 +235,236 @@ const SkSL::RP::Program* SkRuntimeEffect::getRPProgram() const {
     return fRPProgram.get();
 }
 
+const SkSL::Program& SkRuntimeEffect::baseProgram() const {
+    // Effects loaded from a PersistentCache compile their SkSL the first time it's needed.
+    fCompileBaseProgramOnce([&] {
+        if (fBaseProgram) {
+            return;
+        }
+        SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+        std::unique_ptr<SkSL::Program> program =
+                compiler.convertProgram(fKind, fSource, MakeSettings(fOptions));
+        // The source compiled when it was stored, and the cache key includes everything that
+        // could change that.
+        SkASSERT_RELEASE(program);
+        const SkSL::FunctionDeclaration* main = program->getFunction("main");
+        SkASSERT_RELEASE(main);
+
+        auto self = const_cast<SkRuntimeEffect*>(this);
+        self->fMain = main->definition();
+        self->fBaseProgram = std::move(program);
+    });
+    return *fBaseProgram;
+}
+
+const SkSL::FunctionDefinition& SkRuntimeEffect::main() const {
+    this->baseProgram();
+    return *fMain;
+}
+
 [[maybe_unused]] static SkSpan<const float> uniforms_as_span(const SkData* inputs) {
     SkASSERT(inputs);
     return SkSpan<const float>{static_cast<const float*>(inputs->data()),
                                inputs->size() / sizeof(float)};
 }
 
+// The raster pipeline programs that an effect made with Options::specializeUniforms has compiled
+// for the uniform values it was most recently drawn with.
+class SkRuntimeEffect::SpecializedRPPrograms {
+public:
+    struct Program : public SkNVRefCnt<Program> {
+        // Null if the effect can't be specialized for these values; its own program is used.
+        std::unique_ptr<SkSL::RP::Program> fProgram;
+        // The byte ranges of the uniform data holding the uniforms that weren't folded, in the
+        // order the program takes them.
+        std::vector<std::pair<size_t, size_t>> fUniformRanges;
+        size_t fUniformSize = 0;
+    };
+
+    sk_sp<Program> findOrMake(const SkRuntimeEffect& effect, sk_sp<const SkData> uniforms) {
+        Key key{SkOpts::hash_fn(uniforms->data(), uniforms->size(), 0), std::move(uniforms)};
+        {
+            SkAutoMutexExclusive _(fMutex);
+            if (sk_sp<Program>* found = fCache.find(key)) {
+                return *found;
+            }
+        }
+
+        // Compile without holding the lock; if another thread beats us to it, both results match.
+        sk_sp<Program> program = Make(effect, *key.fUniforms);
+        SkAutoMutexExclusive _(fMutex);
+        return *fCache.insert_or_update(key, std::move(program));
+    }
+
+private:
+    struct Key {
+        uint32_t fHash;
+        sk_sp<const SkData> fUniforms;
+
+        bool operator==(const Key& that) const {
+            return fHash == that.fHash && fUniforms->equals(that.fUniforms.get());
+        }
+    };
+
+    struct KeyHash {
+        uint32_t operator()(const Key& key) const { return key.fHash; }
+    };
+
+    static sk_sp<Program> Make(const SkRuntimeEffect& effect, const SkData& uniforms);
+
+    // An effect's uniforms are expected to take on a handful of values at most, e.g. one per theme.
+    static constexpr int kMaxPrograms = 8;
+
+    SkMutex fMutex;
+    SkLRUCache<Key, sk_sp<Program>, KeyHash> fCache{kMaxPrograms};
+};
+
+// Returns the SkSL constructor for the uniform's value, or an empty string if it can't be written
+// as a literal.
+static std::string uniform_value_as_sksl(const SkSL::Type& type,
+                                         const SkRuntimeEffect::Uniform& uniform,
+                                         const SkData& data) {
+    const int count = uniform.sizeInBytes() / sizeof(float);
+    const bool isInt = uniform.type >= SkRuntimeEffect::Uniform::Type::kInt;
+    const std::byte* value = SkTAddOffset<const std::byte>(data.data(), uniform.offset);
+
+    std::string args;
+    for (int i = 0; i < count; ++i, value += sizeof(float)) {
+        if (i > 0) {
+            args += ", ";
+        }
+        if (isInt) {
+            args += std::to_string(sk_unaligned_load<int32_t>(value));
+        } else {
+            float f = sk_unaligned_load<float>(value);
+            if (!std::isfinite(f)) {
+                return {};
+            }
+            args += skstd::to_string(f);
+        }
+    }
+    return count == 1 ? args : type.displayName() + "(" + args + ")";
+}
+
+sk_sp<SkRuntimeEffect::SpecializedRPPrograms::Program> SkRuntimeEffect::SpecializedRPPrograms::Make(
+        const SkRuntimeEffect& effect, const SkData& uniforms) {
+    auto result = sk_make_sp<Program>();
+
+    // Rewrite the source, turning each uniform that isn't an array into a constant holding its
+    // value. The declarations' positions don't include the trailing semicolon. When several
+    // variables share a declaration, e.g. `uniform float a, b`, the ones after the first span just
+    // their names, and must be turned into constants along with the first.
+    const SkSL::Program& baseProgram = effect.baseProgram();
+    const std::string& source = *baseProgram.fSource;
+    std::string specialized;
+    int sourceOffset = 0;
+    bool declarationIsConst = false;
+    for (const SkSL::ProgramElement* elem : baseProgram.elements()) {
+        if (!elem->is<SkSL::GlobalVarDeclaration>()) {
+            continue;
+        }
+        const SkSL::VarDeclaration& decl =
+                elem->as<SkSL::GlobalVarDeclaration>().varDeclaration();
+        const SkSL::Variable& var = *decl.var();
+        if (!(var.modifiers().fFlags & SkSL::Modifiers::kUniform_Flag) ||
+            var.type().isEffectChild()) {
+            continue;
+        }
+        const SkRuntimeEffect::Uniform* uniform = effect.findUniform(var.name());
+        SkASSERT(uniform);
+
+        const int start = decl.fPosition.startOffset(),
+                  end   = decl.fPosition.endOffset();
+        const size_t nameEnd = start + var.name().size();
+        const bool continuesDeclaration =
+                source.compare(start, var.name().size(), var.name()) == 0 &&
+                (nameEnd == (size_t)end || source[nameEnd] == '[');
+        const bool isConst = !uniform->isArray();
+        if (continuesDeclaration && isConst != declarationIsConst) {
+            return result;
+        }
+        declarationIsConst = isConst;
+        if (!isConst) {
+            continue;
+        }
+
+        std::string value = uniform_value_as_sksl(var.type(), *uniform, uniforms);
+        if (value.empty()) {
+            return result;
+        }
+        specialized.append(source, sourceOffset, start - sourceOffset);
+        if (!continuesDeclaration) {
+            specialized += "const " + var.type().displayName() + " ";
+        }
+        specialized += std::string(var.name()) + " = " + value;
+        sourceOffset = end;
+    }
+    if (specialized.empty()) {
+        // There were no uniforms to fold.
+        return result;
+    }
+    specialized.append(source, sourceOffset);
+
+    SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+    std::unique_ptr<SkSL::Program> program =
+            compiler.convertProgram(effect.fKind, specialized, MakeSettings(effect.fOptions));
+    if (!program) {
+        return result;
+    }
+    const SkSL::FunctionDeclaration* main = program->getFunction("main");
+    SkASSERT(main);
+
+    // The arrays are left as uniforms, packed together.
+    for (const SkSL::ProgramElement* elem : program->elements()) {
+        if (elem->is<SkSL::GlobalVarDeclaration>()) {
+            const SkSL::Variable& var =
+                    *elem->as<SkSL::GlobalVarDeclaration>().varDeclaration().var();
+            if ((var.modifiers().fFlags & SkSL::Modifiers::kUniform_Flag) &&
+                !var.type().isEffectChild()) {
+                const SkRuntimeEffect::Uniform* uniform = effect.findUniform(var.name());
+                SkASSERT(uniform);
+                result->fUniformRanges.push_back({uniform->offset, uniform->sizeInBytes()});
+                result->fUniformSize += uniform->sizeInBytes();
+            }
+        }
+    }
+    result->fProgram = MakeRasterPipelineProgram(*program, *main->definition());
+    return result;
+}
+
+const SkSL::RP::Program* SkRuntimeEffect::getRPProgram(
+        sk_sp<const SkData> uniforms,
+        SkArenaAlloc* alloc,
+        SkSpan<const float>* programUniforms) const {
+    // `uniforms` may be released before the pipeline runs (it is the cache's key, and can be
+    // evicted), so the pipeline always reads a copy in `alloc`.
+    SkSpan<const float> src = uniforms_as_span(uniforms.get());
+    float* uniformCopy = alloc->makeArrayDefault<float>(src.size());
+    std::copy(src.begin(), src.end(), uniformCopy);
+    *programUniforms = SkSpan(uniformCopy, src.size());
+    if (!fSpecializedRPPrograms || fUniforms.empty()) {
+        return this->getRPProgram();
+    }
+    sk_sp<SpecializedRPPrograms::Program> specialized =
+            fSpecializedRPPrograms->findOrMake(*this, std::move(uniforms));
+    if (!specialized->fProgram) {
+        return this->getRPProgram();
+    }
+
+    auto uniformData = alloc->makeArrayDefault<float>(specialized->fUniformSize / sizeof(float));
+    std::byte* dst = reinterpret_cast<std::byte*>(uniformData);
+    for (auto [offset, size] : specialized->fUniformRanges) {
+        memcpy(dst, SkTAddOffset<const std::byte>(uniformCopy, offset), size);
+        dst += size;
+    }
+    *programUniforms = SkSpan(uniformData, specialized->fUniformSize / sizeof(float));
+
+    // The program may be evicted from the cache while the pipeline is still in use.
+    const SkSL::RP::Program* program = specialized->fProgram.get();
+    alloc->make<sk_sp<SpecializedRPPrograms::Program>>(std::move(specialized));
+    return program;
+}
+
 class RuntimeEffectRPCallbacks : public SkSL::RP::Callbacks {
 public:
     RuntimeEffectRPCallbacks(const SkStageRec& s,
@@ -285,7 +520,8 @@ bool SkRuntimeEffectPriv::CanDraw(const SkCapabilities* caps, const SkSL::Progra
 
 bool SkRuntimeEffectPriv::CanDraw(const SkCapabilities* caps, const SkRuntimeEffect* effect) {
     SkASSERT(effect);
-    return CanDraw(caps, effect->fBaseProgram.get());
+    SkASSERT(caps);
+    return effect->fRequiredVersion <= caps->skslVersion();
 }
 
 //////////////////////////////////////////////////////////////////////////////
@@ -407,6 +643,8 @@ static std::vector<skvm::Val> make_skvm_uniforms(skvm::Builder* p,
     return uniform;
 }
 
+static std::atomic<SkRuntimeEffect::PersistentCache*> gPersistentCache{nullptr};
+
 SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
     SkSL::ProgramSettings settings;
     settings.fInlineThreshold = 0;
@@ -431,6 +669,18 @@ SkSL::ProgramSettings SkRuntimeEffect::MakeSettings(const Options& options) {
 SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
                                                         const Options& options,
                                                         SkSL::ProgramKind kind) {
+    PersistentCache* persistentCache = gPersistentCache.load(std::memory_order_acquire);
+    sk_sp<SkData> key;
+    if (persistentCache) {
+        key = PersistentCacheKey(sksl, options, kind);
+        if (sk_sp<SkData> data = persistentCache->load(*key)) {
+            if (sk_sp<SkRuntimeEffect> effect =
+                        MakeFromPersistentCache(*data, sksl, options, kind)) {
+                return Result{std::move(effect), SkString()};
+            }
+        }
+    }
+
     SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
@@ -440,7 +690,11 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeFromSource(SkString sksl,
         RETURN_FAILURE("%s", compiler.errorText().c_str());
     }
 
-    return MakeInternal(std::move(program), options, kind);
+    Result result = MakeInternal(std::move(program), options, kind);
+    if (persistentCache && result.effect) {
+        persistentCache->store(*key, *result.effect->serializeForPersistentCache());
+    }
+    return result;
 }
 
 SkRuntimeEffect::Result SkRuntimeEffect::MakeInternal(std::unique_ptr<SkSL::Program> program,
@@ -583,7 +837,7 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     options.allowPrivateAccess = true;
 
     // We do know the original ProgramKind, so we don't need to re-derive it.
-    SkSL::ProgramKind kind = fBaseProgram->fConfig->fKind;
+    SkSL::ProgramKind kind = fKind;
 
     // Attempt to recompile the program's source with optimizations off. This ensures that the
     // Debugger shows results on every line, even for things that could be optimized away (static
@@ -591,7 +845,7 @@ sk_sp<SkRuntimeEffect> SkRuntimeEffect::makeUnoptimizedClone() {
     SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
     SkSL::ProgramSettings settings = MakeSettings(options);
     std::unique_ptr<SkSL::Program> program =
-            compiler.convertProgram(kind, *fBaseProgram->fSource, settings);
+            compiler.convertProgram(kind, this->source(), settings);
 
     if (!program) {
         // Turning off compiler optimizations can theoretically expose a program error that
@@ -636,6 +890,192 @@ SkRuntimeEffect::Result SkRuntimeEffect::MakeForBlender(SkString sksl, const Opt
     return result;
 }
 
+void SkRuntimeEffect::SetPersistentCache(PersistentCache* cache) {
+    gPersistentCache.store(cache, std::memory_order_release);
+}
+
+// Bump this when the data written by serializeForPersistentCache() changes.
+static constexpr uint32_t kPersistentCacheVersion = 2;
+
+// Different builds can compile the same SkSL into different raster pipeline programs, so cached
+// programs are only reused by builds with the same milestone and the same set of stages.
+static const SkMD5::Digest& persistent_cache_build_digest() {
+    static SkOnce once;
+    static SkMD5::Digest digest;
+    once([] {
+        SkMD5 md5;
+        const uint32_t header[] = {SK_MILESTONE, (uint32_t)SkSL::RP::BuilderOp::unsupported};
+        md5.write(header, sizeof(header));
+        static constexpr char kStageNames[] =
+            #define M(stage) #stage ","
+                SK_RASTER_PIPELINE_OPS_ALL(M);
+            #undef M
+        md5.write(kStageNames, sizeof(kStageNames));
+        digest = md5.finish();
+    });
+    return digest;
+}
+
+sk_sp<SkData> SkRuntimeEffect::PersistentCacheKey(const SkString& sksl,
+                                                  const Options& options,
+                                                  SkSL::ProgramKind kind) {
+    SK_BEGIN_REQUIRE_DENSE
+    struct Key {
+        uint32_t tag;
+        uint32_t version;
+        uint8_t  buildDigest[16];
+        uint8_t  skslDigest[16];
+        uint32_t kind;
+        uint32_t options;
+    };
+    SK_END_REQUIRE_DENSE
+
+    SkMD5 md5;
+    md5.write(sksl.c_str(), sksl.size());
+    SkMD5::Digest skslDigest = md5.finish();
+
+    Key key;
+    key.tag     = SkSetFourByteTag('s', 'k', 'r', 't');
+    key.version = kPersistentCacheVersion;
+    memcpy(key.buildDigest, persistent_cache_build_digest().data, sizeof(key.buildDigest));
+    memcpy(key.skslDigest, skslDigest.data, sizeof(key.skslDigest));
+    key.kind    = (uint32_t)kind;
+    key.options = (options.forceUnoptimized ? 1 : 0) |
+                  (options.allowPrivateAccess ? 2 : 0) |
+                  (uint32_t)options.maxVersionAllowed << 2;
+    return SkData::MakeWithCopy(&key, sizeof(key));
+}
+
+sk_sp<SkData> SkRuntimeEffect::serializeForPersistentCache() const {
+    SkBinaryWriteBuffer buffer;
+    buffer.writeUInt(kPersistentCacheVersion);
+    buffer.writeString(this->source());
+    buffer.writeUInt((uint32_t)fRequiredVersion);
+    buffer.writeUInt(fFlags);
+
+    buffer.writeUInt(fUniforms.size());
+    for (const Uniform& u : fUniforms) {
+        buffer.writeString(u.name);
+        buffer.writeUInt(u.offset);
+        buffer.writeUInt((uint32_t)u.type);
+        buffer.writeInt(u.count);
+        buffer.writeUInt(u.flags);
+    }
+
+    buffer.writeUInt(fChildren.size());
+    for (size_t i = 0; i < fChildren.size(); ++i) {
+        buffer.writeString(fChildren[i].name);
+        buffer.writeUInt((uint32_t)fChildren[i].type);
+        buffer.writeUInt((uint32_t)fSampleUsages[i].kind());
+        buffer.writeBool(fSampleUsages[i].hasPerspective());
+    }
+
+    // Without the raster pipeline backend, this is null, and drawing compiles the SkSL.
+    const SkSL::RP::Program* rpProgram = this->getRPProgram();
+    buffer.writeBool(rpProgram != nullptr);
+#ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
+    if (rpProgram) {
+        rpProgram->serialize(buffer);
+    }
+#endif
+    return buffer.snapshotAsData();
+}
+
+sk_sp<SkRuntimeEffect> SkRuntimeEffect::MakeFromPersistentCache(const SkData& data,
+                                                                const SkString& sksl,
+                                                                const Options& options,
+                                                                SkSL::ProgramKind kind) {
+    SkReadBuffer buffer(data.data(), data.size());
+    if (!buffer.validate(buffer.readUInt() == kPersistentCacheVersion)) {
+        return nullptr;
+    }
+    // The key only has a digest of the source.
+    SkString source;
+    buffer.readString(&source);
+    if (!buffer.validate(source.equals(sksl))) {
+        return nullptr;
+    }
+    auto requiredVersion = buffer.checkRange(SkSL::Version::k100, SkSL::Version::k300);
+    uint32_t flags = buffer.readUInt();
+
+    uint32_t uniformCount = buffer.readUInt();
+    if (!buffer.validateCanReadN<uint32_t>(uniformCount)) {
+        return nullptr;
+    }
+    std::vector<Uniform> uniforms(uniformCount);
+    std::vector<SkString> uniformNames(uniformCount);
+    size_t offset = 0;
+    for (uint32_t i = 0; i < uniformCount; ++i) {
+        Uniform& u = uniforms[i];
+        buffer.readString(&uniformNames[i]);
+        u.name   = std::string_view(uniformNames[i].c_str(), uniformNames[i].size());
+        u.offset = buffer.readUInt();
+        u.type   = buffer.checkRange(Uniform::Type::kFloat, Uniform::Type::kInt4);
+        u.count  = buffer.checkInt(1, std::numeric_limits<int>::max());
+        u.flags  = buffer.readUInt();
+        // Uniforms are tightly packed, in order.
+        if (!buffer.validate(u.offset == offset)) {
+            return nullptr;
+        }
+        offset += u.sizeInBytes();
+    }
+    // The raster pipeline program addresses the uniforms by int slot.
+    if (!buffer.validate(SkTFitsIn<int>(offset / sizeof(float)))) {
+        return nullptr;
+    }
+
+    uint32_t childCount = buffer.readUInt();
+    if (!buffer.validateCanReadN<uint32_t>(childCount)) {
+        return nullptr;
+    }
+    std::vector<Child> children(childCount);
+    std::vector<SkString> childNames(childCount);
+    std::vector<SkSL::SampleUsage> sampleUsages(childCount);
+    for (uint32_t i = 0; i < childCount; ++i) {
+        buffer.readString(&childNames[i]);
+        children[i].name  = std::string_view(childNames[i].c_str(), childNames[i].size());
+        children[i].type  = buffer.checkRange(ChildType::kShader, ChildType::kBlender);
+        children[i].index = i;
+        auto usageKind = buffer.checkRange(SkSL::SampleUsage::Kind::kNone,
+                                           SkSL::SampleUsage::Kind::kExplicit);
+        bool hasPerspective = buffer.readBool();
+        if (!buffer.validate(!hasPerspective ||
+                             usageKind == SkSL::SampleUsage::Kind::kUniformMatrix)) {
+            return nullptr;
+        }
+        sampleUsages[i] = SkSL::SampleUsage(usageKind, hasPerspective);
+    }
+
+    std::unique_ptr<SkSL::RP::Program> rpProgram;
+    if (buffer.readBool()) {
+#ifdef SK_ENABLE_SKSL_IN_RASTER_PIPELINE
+        // The program reads the effect's uniforms as floats, and invokes its children by index.
+        rpProgram = SkSL::RP::Program::Deserialize(buffer,
+                                                   SkToInt(offset / sizeof(float)),
+                                                   SkToInt(childCount));
+        if (!rpProgram) {
+            return nullptr;
+        }
+#else
+        return nullptr;
+#endif
+    }
+    if (!buffer.isValid() || !buffer.eof()) {
+        return nullptr;
+    }
+
+    // The effect copies the names of the uniforms and children.
+    return sk_sp<SkRuntimeEffect>(new SkRuntimeEffect(std::string(sksl.c_str(), sksl.size()),
+                                                      options,
+                                                      kind,
+                                                      requiredVersion,
+                                                      std::move(uniforms),
+                                                      std::move(children),
+                                                      std::move(sampleUsages),
+                                                      flags,
+                                                      std::move(rpProgram)));
+}
+
 sk_sp<SkRuntimeEffect> SkMakeCachedRuntimeEffect(
         SkRuntimeEffect::Result (*make)(SkString sksl, const SkRuntimeEffect::Options&),
         SkString sksl) {
@@ -707,6 +1147,28 @@ size_t SkRuntimeEffect::Uniform::sizeInBytes() const {
     return uniform_element_size(this->type) * this->count;
 }
 
+uint32_t SkRuntimeEffect::MakeHash(const std::string& source, const Options& options) {
+    uint32_t hash = SkOpts::hash_fn(source.c_str(), source.size(), 0);
+
+    // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
+    // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
+    // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
+    // to match the layout of Options.
+    // (specializeUniforms only changes which programs the raster backend compiles for each draw.)
+    struct KnownOptions {
+        bool forceUnoptimized, specializeUniforms, allowPrivateAccess;
+        SkSL::Version maxVersionAllowed;
+    };
+    static_assert(sizeof(Options) == sizeof(KnownOptions));
+    hash = SkOpts::hash_fn(&options.forceUnoptimized,
+                     sizeof(options.forceUnoptimized), hash);
+    hash = SkOpts::hash_fn(&options.allowPrivateAccess,
+                     sizeof(options.allowPrivateAccess), hash);
+    hash = SkOpts::hash_fn(&options.maxVersionAllowed,
+                     sizeof(options.maxVersionAllowed), hash);
+    return hash;
+}
+
 SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
                                  const Options& options,
                                  const SkSL::FunctionDefinition& main,
@@ -714,39 +1176,75 @@ SkRuntimeEffect::SkRuntimeEffect(std::unique_ptr<SkSL::Program> baseProgram,
                                  std::vector<Child>&& children,
                                  std::vector<SkSL::SampleUsage>&& sampleUsages,
                                  uint32_t flags)
-        : fHash(SkOpts::hash_fn(baseProgram->fSource->c_str(), baseProgram->fSource->size(), 0))
+        : fHash(MakeHash(*baseProgram->fSource, options))
+        , fOptions(options)
+        , fKind(baseProgram->fConfig->fKind)
+        , fRequiredVersion(baseProgram->fConfig->fRequiredSkSLVersion)
         , fBaseProgram(std::move(baseProgram))
-        , fMain(main)
+        , fMain(&main)
         , fUniforms(std::move(uniforms))
         , fChildren(std::move(children))
         , fSampleUsages(std::move(sampleUsages))
         , fFlags(flags) {
     SkASSERT(fBaseProgram);
+    SkASSERT(fBaseProgram->fConfig->enforcesSkSLVersion());
     SkASSERT(fChildren.size() == fSampleUsages.size());
 
-    // Everything from SkRuntimeEffect::Options which could influence the compiled result needs to
-    // be accounted for in `fHash`. If you've added a new field to Options and caused the static-
-    // assert below to trigger, please incorporate your field into `fHash` and update KnownOptions
-    // to match the layout of Options.
-    struct KnownOptions {
-        bool forceUnoptimized, allowPrivateAccess;
-        SkSL::Version maxVersionAllowed;
-    };
-    static_assert(sizeof(Options) == sizeof(KnownOptions));
-    fHash = SkOpts::hash_fn(&options.forceUnoptimized,
-                      sizeof(options.forceUnoptimized), fHash);
-    fHash = SkOpts::hash_fn(&options.allowPrivateAccess,
-                      sizeof(options.allowPrivateAccess), fHash);
-    fHash = SkOpts::hash_fn(&options.maxVersionAllowed,
-                      sizeof(options.maxVersionAllowed), fHash);
+    if (fOptions.specializeUniforms) {
+        fSpecializedRPPrograms = std::make_unique<SpecializedRPPrograms>();
+    }
+}
 
-    fFilterColorProgram = SkFilterColorProgram::Make(this);
+SkRuntimeEffect::SkRuntimeEffect(std::string source,
+                                 const Options& options,
+                                 SkSL::ProgramKind kind,
+                                 SkSL::Version requiredVersion,
+                                 std::vector<Uniform>&& uniforms,
+                                 std::vector<Child>&& children,
+                                 std::vector<SkSL::SampleUsage>&& sampleUsages,
+                                 uint32_t flags,
+                                 std::unique_ptr<SkSL::RP::Program> rpProgram)
+        : fHash(MakeHash(source, options))
+        , fSource(std::move(source))
+        , fOptions(options)
+        , fKind(kind)
+        , fRequiredVersion(requiredVersion)
+        , fMain(nullptr)
+        , fRPProgram(std::move(rpProgram))
+        , fUniforms(std::move(uniforms))
+        , fChildren(std::move(children))
+        , fSampleUsages(std::move(sampleUsages))
+        , fFlags(flags) {
+    SkASSERT(!fSource.empty());
+    SkASSERT(fChildren.size() == fSampleUsages.size());
+
+    for (const Uniform& u : fUniforms) {
+        fReflectionNames.append(u.name);
+    }
+    for (const Child& c : fChildren) {
+        fReflectionNames.append(c.name);
+    }
+    const char* name = fReflectionNames.c_str();
+    for (Uniform& u : fUniforms) {
+        u.name = std::string_view(name, u.name.size());
+        name += u.name.size();
+    }
+    for (Child& c : fChildren) {
+        c.name = std::string_view(name, c.name.size());
+        name += c.name.size();
+    }
+
+    if (fOptions.specializeUniforms) {
+        fSpecializedRPPrograms = std::make_unique<SpecializedRPPrograms>();
+    }
 }
 
 SkRuntimeEffect::~SkRuntimeEffect() = default;
 
 const std::string& SkRuntimeEffect::source() const {
-    return *fBaseProgram->fSource;
+    // Only an effect loaded from a PersistentCache holds onto its own copy of the source; it may
+    // not have a base program yet. Otherwise, the base program never changes.
+    return fSource.empty() ? *fBaseProgram->fSource : fSource;
 }
 
 size_t SkRuntimeEffect::uniformSize() const {
@@ -912,8 +1410,8 @@ std::unique_ptr<SkFilterColorProgram> SkFilterColorProgram::Make(const SkRuntime
 
     // Emit the skvm instructions for the SkSL
     skvm::Coord zeroCoord = {p.splat(0.0f), p.splat(0.0f)};
-    skvm::Color result = SkSL::ProgramToSkVM(*effect->fBaseProgram,
-                                             effect->fMain,
+    skvm::Color result = SkSL::ProgramToSkVM(effect->baseProgram(),
+                                             effect->main(),
                                              &p,
                                              /*debugTrace=*/nullptr,
                                              SkSpan(uniform),
@@ -978,6 +1476,9 @@ SkPMColor4f SkFilterColorProgram::eval(
 }
 
 const SkFilterColorProgram* SkRuntimeEffect::getFilterColorProgram() const {
+    fMakeFilterColorProgramOnce([&] {
+        const_cast<SkRuntimeEffect*>(this)->fFilterColorProgram = SkFilterColorProgram::Make(this);
+    });
     return fFilterColorProgram.get();
 }
 
@@ -1221,15 +1722,16 @@ public:
             // usage in runtime effects to just #version 100.
             return false;
         }
-        if (const SkSL::RP::Program* program = fEffect->getRPProgram()) {
-            sk_sp<const SkData> inputs = SkRuntimeEffectPriv::TransformUniforms(fEffect->uniforms(),
-                                                                                fUniforms,
-                                                                                rec.fDstCS);
+        sk_sp<const SkData> inputs = SkRuntimeEffectPriv::TransformUniforms(fEffect->uniforms(),
+                                                                            fUniforms,
+                                                                            rec.fDstCS);
+        SkSpan<const float> uniforms;
+        if (const SkSL::RP::Program* program =
+                    fEffect->getRPProgram(std::move(inputs), rec.fAlloc, &uniforms)) {
             SkShaderBase::MatrixRec matrix(SkMatrix::I());
             matrix.markCTMApplied();
             RuntimeEffectRPCallbacks callbacks(rec, matrix, fChildren, fEffect->fSampleUsages);
-            bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks,
-                                                 uniforms_as_span(inputs.get()));
+            bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
             return success;
         }
 #endif
@@ -1257,7 +1759,7 @@ public:
         // There should be no way for the color filter to use device coords, but we need to supply
         // something. (Uninitialized values can trigger asserts in skvm::Builder).
         skvm::Coord zeroCoord = { p->splat(0.0f), p->splat(0.0f) };
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
+        return SkSL::ProgramToSkVM(fEffect->baseProgram(), fEffect->main(), p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    c, c, &callbacks);
     }
@@ -1442,19 +1944,18 @@ public:
             // SkRP doesn't support debug traces yet; fall back to SkVM until this is implemented.
             return false;
         }
-        if (const SkSL::RP::Program* program = fEffect->getRPProgram()) {
+        sk_sp<const SkData> inputs = SkRuntimeEffectPriv::TransformUniforms(
+                fEffect->uniforms(), this->uniformData(rec.fDstCS), rec.fDstCS);
+        SkSpan<const float> uniforms;
+        if (const SkSL::RP::Program* program =
+                    fEffect->getRPProgram(std::move(inputs), rec.fAlloc, &uniforms)) {
             std::optional<MatrixRec> newMRec = mRec.apply(rec);
             if (!newMRec.has_value()) {
                 return false;
             }
 
-            sk_sp<const SkData> inputs = SkRuntimeEffectPriv::TransformUniforms(fEffect->uniforms(),
-                                                                                this->uniformData(rec.fDstCS),
-                                                                                rec.fDstCS);
-
             RuntimeEffectRPCallbacks callbacks(rec, *newMRec, fChildren, fEffect->fSampleUsages);
-            bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks,
-                                                 uniforms_as_span(inputs.get()));
+            bool success = program->appendStages(rec.fPipeline, rec.fAlloc, &callbacks, uniforms);
             return success;
         }
 #endif
@@ -1498,7 +1999,7 @@ public:
         std::vector<skvm::Val> uniform = make_skvm_uniforms(p, uniforms, fEffect->uniformSize(),
                                                             *inputs);
 
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p, fDebugTrace.get(),
+        return SkSL::ProgramToSkVM(fEffect->baseProgram(), fEffect->main(), p, fDebugTrace.get(),
                                    SkSpan(uniform), device, local, paint, paint, &callbacks);
     }
 
@@ -1612,7 +2113,7 @@ public:
 
         // Emit the blend function as an SkVM program.
         skvm::Coord zeroCoord = {p->splat(0.0f), p->splat(0.0f)};
-        return SkSL::ProgramToSkVM(*fEffect->fBaseProgram, fEffect->fMain, p,/*debugTrace=*/nullptr,
+        return SkSL::ProgramToSkVM(fEffect->baseProgram(), fEffect->main(), p,/*debugTrace=*/nullptr,
                                    SkSpan(uniform), /*device=*/zeroCoord, /*local=*/zeroCoord,
                                    src, dst, &callbacks);
     }
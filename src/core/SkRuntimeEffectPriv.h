@@ -20,8 +20,10 @@ namespace SkSL {
 class Context;
 class Variable;
 struct Program;
+namespace RP { class Program; }
 }
 
+class SkArenaAlloc;
 class SkCapabilities;
 struct SkColorSpaceXformSteps;
 
@@ -54,7 +56,17 @@ public:
     }
 
     static const SkSL::Program& Program(const SkRuntimeEffect& effect) {
-        return *effect.fBaseProgram;
+        return effect.baseProgram();
+    }
+
+    // Returns the raster pipeline program the effect is drawn with for `uniforms`, and the uniform
+    // values that program takes. Only a program specialized for `uniforms` is compiled unless SkSL
+    // in raster pipeline is enabled, so this is null otherwise.
+    static const SkSL::RP::Program* RPProgram(const SkRuntimeEffect& effect,
+                                              sk_sp<const SkData> uniforms,
+                                              SkArenaAlloc* alloc,
+                                              SkSpan<const float>* programUniforms) {
+        return effect.getRPProgram(std::move(uniforms), alloc, programUniforms);
     }
 
     static SkRuntimeEffect::Options ES3Options() {
@@ -12,6 +12,9 @@
 
 std::atomic<bool> gSkUseAnalyticAA{true};
 std::atomic<bool> gSkForceAnalyticAA{false};
+std::atomic<bool> gSkUseAccumulationAA{false};
+std::atomic<bool> gSkUseBandedAA{false};
+std::atomic<bool> gSkUseBatchedHairlines{true};
 
 static inline void blitrect(SkBlitter* blitter, const SkIRect& r) {
     blitter->blitRect(r.fLeft, r.fTop, r.width(), r.height());
@@ -25,6 +25,12 @@ typedef SkIRect SkXRect;
 
 extern std::atomic<bool> gSkUseAnalyticAA;
 extern std::atomic<bool> gSkForceAnalyticAA;
+extern std::atomic<bool> gSkUseAccumulationAA;
+// If set, anti-aliased fills of paths with many points may be scan converted in bands on
+// SkExecutor::GetDefault().
+extern std::atomic<bool> gSkUseBandedAA;
+// If set, hairlines with many segments accumulate their coverage in tiles before it is blitted.
+extern std::atomic<bool> gSkUseBatchedHairlines;
 
 class AdditiveBlitter;
 
@@ -85,6 +91,9 @@ private:
     static void AntiFillRect(const SkRect&, const SkRegion* clip, SkBlitter*);
     static void AntiFillXRect(const SkXRect&, const SkRegion*, SkBlitter*);
     static void AntiFillPath(const SkPath&, const SkRegion& clip, SkBlitter*, bool forceRLE);
+    // Returns false, drawing nothing, if the path should not be split into bands.
+    static bool AntiFillPathInBands(const SkPath&, const SkIRect& pathIR, const SkIRect& clippedIR,
+                                    const SkRegion& clip, SkBlitter*);
     static void FillTriangle(const SkPoint pts[], const SkRegion*, SkBlitter*);
 
     static void AntiFrameRect(const SkRect&, const SkPoint& strokeSize,
@@ -95,6 +104,10 @@ private:
                             const SkIRect& clipBounds, bool forceRLE);
     static void SAAFillPath(const SkPath& path, SkBlitter* blitter, const SkIRect& pathIR,
                             const SkIRect& clipBounds, bool forceRLE);
+    // Returns false, drawing nothing, if the path is too large for accumulation AA.
+    static bool AccumulationFillPath(const SkPath& path, SkBlitter* blitter,
+                                     const SkIRect& pathIR, const SkIRect& clipBounds,
+                                     bool forceRLE);
 };
 
 /** Assign an SkXRect from a SkIRect, by promoting the src rect's coordinates
@@ -9,9 +9,16 @@
 #define SkScanPriv_DEFINED
 
 #include "include/core/SkPath.h"
+#include "include/private/base/SkTArray.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkScan.h"
 
+#include <memory>
+
+class SkBasicEdgeBuilder;
+struct SkEdge;
+
 // controls how much we super-sample (when we use that scan convertion)
 #define SK_SUPERSAMPLE_SHIFT    2
 
@@ -37,6 +44,34 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect,
                   SkBlitter* blitter, int start_y, int stop_y, int shiftEdgesUp,
                   bool pathContainedInClip);
 
+/** The edges sk_fill_path() would build for a path, built and sorted once, and split into bands
+    of rows that can be filled independently, e.g. on different threads. Each band gets copies of
+    the edges that cross its top, stepped down to it, so it fills exactly the rows sk_fill_path()
+    would.
+ */
+class SkEdgeBands {
+public:
+    // bandTops holds the first row of each band, then the row below the last one.
+    SkEdgeBands(const SkPath&, const SkIRect& clipRect, int shiftEdgesUp, bool pathContainedInClip,
+                const int bandTops[], int bandCount);
+    ~SkEdgeBands();
+
+    // Fills one band's rows, consuming its edges. Each band may be filled once, concurrently with
+    // the others.
+    void fill(int band, SkBlitter*);
+
+private:
+    const SkPathFillType fFillType;
+    const bool fIsConvex;
+    const SkIRect fClipRect;
+    const int fShiftEdgesUp;
+    const bool fPathContainedInClip;
+    std::unique_ptr<SkBasicEdgeBuilder> fBuilder;
+    SkSTArenaAlloc<4096> fCopies;
+    const SkTArray<int> fBandTops;
+    SkTArray<SkTArray<SkEdge*>> fBands;
+};
+
 // blit the rects above and below avoid, clipped to clip
 void sk_blit_above(SkBlitter*, const SkIRect& avoid, const SkRegion& clip);
 void sk_blit_below(SkBlitter*, const SkIRect& avoid, const SkRegion& clip);
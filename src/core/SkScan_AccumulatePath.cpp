@@ -0,0 +1,312 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/private/base/SkTemplates.h"
+#include "include/private/base/SkTo.h"
+#include "src/base/SkVx.h"
+#include "src/core/SkBlitter.h"
+#include "src/core/SkGeometry.h"
+#include "src/core/SkLineClipper.h"
+#include "src/core/SkMask.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkScan.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+/*
+
+Accumulation anti-aliasing computes the exact area of each pixel covered by the path, like
+analytic AA, but organizes the work differently. Instead of walking sorted edges scanline by
+scanline, every line segment is visited once and deposits the signed area it contributes into
+a per-pixel accumulation buffer: for each row it crosses, the segment adds its height in that
+row (signed by its direction) split between the pixels it passes through, weighted by how much
+of each pixel lies to the right of it. A running sum along each row then turns those deltas into
+the winding coverage of every pixel, which is folded into an alpha according to the fill type.
+
+There is no edge list to build or sort, so complicated paths cost time proportional to the
+length of their outline plus the area of their bounds, and the row sums vectorize well. The
+price is a float per pixel of the bounds, so this is only used for paths that are not huge. And
+since each pixel only sees the sum of its signed areas, coverage is approximate in pixels where
+edges cross, such as the points of a self-intersecting star.
+
+*/
+
+namespace {
+
+// Beyond this many pixels, the coverage buffer costs more than it saves.
+constexpr int kMaxAccumulationArea = 1 << 20;
+
+// Curves are flattened to within this distance (in pixels) of the true curve.
+constexpr float kFlattenTolerance = 1.0f / 32;
+constexpr int kMaxCurveSegments = 256;
+
+class CoverageAccumulator {
+public:
+    // The accumulation buffer has two extra columns: a segment touching the right edge of
+    // bounds deposits some of its area one or two pixels past it.
+    CoverageAccumulator(const SkIRect& bounds)
+            : fBounds(bounds)
+            , fClip(SkRect::Make(bounds))
+            , fWidth(bounds.width())
+            , fStride(bounds.width() + 2)
+            , fAccumulation(SkToSizeT(fStride) * bounds.height()) {
+        sk_bzero(fAccumulation.get(), sizeof(float) * fStride * bounds.height());
+    }
+
+    void addLine(const SkPoint pts[2]) {
+        SkPoint lines[SkLineClipper::kMaxPoints];
+        int count = SkLineClipper::ClipLine(pts, fClip, lines, /*canCullToTheRight=*/true);
+        for (int i = 0; i < count; ++i) {
+            this->accumulate(lines[i] - SkVector::Make(fBounds.fLeft, fBounds.fTop),
+                             lines[i + 1] - SkVector::Make(fBounds.fLeft, fBounds.fTop));
+        }
+    }
+
+    void addQuad(const SkPoint pts[3]) {
+        SkVector d = pts[0] - pts[1] - pts[1] + pts[2];
+        // Wang's formula for quadratics.
+        int n = SkScalarCeilToInt(std::sqrt(d.length() * (0.25f / kFlattenTolerance)));
+        this->addPolyline(SkQuadCoeff(pts), n, pts[0], pts[2]);
+    }
+
+    void addCubic(const SkPoint pts[4]) {
+        SkVector d0 = pts[0] - pts[1] - pts[1] + pts[2],
+                 d1 = pts[1] - pts[2] - pts[2] + pts[3];
+        // Wang's formula for cubics.
+        float m = std::max(d0.length(), d1.length());
+        int n = SkScalarCeilToInt(std::sqrt(m * (0.75f / kFlattenTolerance)));
+        this->addPolyline(SkCubicCoeff(pts), n, pts[0], pts[3]);
+    }
+
+    // Sums each row into alpha, handing each finished row to blitRow.
+    template <bool kEvenOdd, bool kInverse, typename BlitRow>
+    void resolve(uint8_t* alpha, size_t alphaRowBytes, BlitRow&& blitRow) {
+        for (int y = 0; y < fBounds.height(); ++y) {
+            float* row = fAccumulation.get() + SkToSizeT(y) * fStride;
+            uint8_t* dst = alpha + y * alphaRowBytes;
+            resolve_row<kEvenOdd, kInverse>(row, dst, fWidth);
+            blitRow(fBounds.fTop + y, dst);
+        }
+    }
+
+    int width() const { return fWidth; }
+
+private:
+    template <typename Coeff>
+    void addPolyline(Coeff coeff, int n, SkPoint start, SkPoint end) {
+        n = std::clamp(n, 1, kMaxCurveSegments);
+        SkPoint line[2];
+        line[0] = start;
+        for (int i = 1; i <= n; ++i) {
+            // Use the exact end point so that consecutive segments meet.
+            line[1] = i == n ? end : to_point(coeff.eval(skvx::float2((float)i / n)));
+            this->addLine(line);
+            line[0] = line[1];
+        }
+    }
+
+    // p0 and p1 are relative to fBounds and lie within it.
+    void accumulate(SkPoint p0, SkPoint p1) {
+        if (p0.fY == p1.fY) {
+            return;
+        }
+        float dir = 1;
+        if (p0.fY > p1.fY) {
+            std::swap(p0, p1);
+            dir = -1;
+        }
+        const float dxdy = (p1.fX - p0.fX) / (p1.fY - p0.fY);
+        float x = p0.fX;
+        const int yStart = std::max(0, (int)p0.fY);
+        const int yEnd = std::min(fBounds.height(), SkScalarCeilToInt(p1.fY));
+        for (int y = yStart; y < yEnd; ++y) {
+            float* row = fAccumulation.get() + SkToSizeT(y) * fStride;
+            float dy = std::min((float)(y + 1), p1.fY) - std::max((float)y, p0.fY);
+            float xNext = x + dxdy * dy;
+            float d = dy * dir;
+            float x0 = std::min(x, xNext),
+                  x1 = std::max(x, xNext);
+            x0 = std::clamp(x0, 0.f, (float)fWidth);
+            x1 = std::clamp(x1, 0.f, (float)fWidth);
+            float x0Floor = std::floor(x0);
+            int x0i = (int)x0Floor;
+            float x1Ceil = std::ceil(x1);
+            int x1i = (int)x1Ceil;
+            if (x1i <= x0i + 1) {
+                // The segment stays within one pixel in this row.
+                float xmf = 0.5f * (x0 + x1) - x0Floor;
+                row[x0i]     += d - d * xmf;
+                row[x0i + 1] += d * xmf;
+            } else {
+                float s = 1 / (x1 - x0);
+                float x0f = x0 - x0Floor;
+                float a0 = 0.5f * s * (1 - x0f) * (1 - x0f);
+                float x1f = x1 - x1Ceil + 1;
+                float am = 0.5f * s * x1f * x1f;
+                row[x0i] += d * a0;
+                if (x1i == x0i + 2) {
+                    row[x0i + 1] += d * (1 - a0 - am);
+                } else {
+                    float a1 = s * (1.5f - x0f);
+                    row[x0i + 1] += d * (a1 - a0);
+                    for (int xi = x0i + 2; xi < x1i - 1; ++xi) {
+                        row[xi] += d * s;
+                    }
+                    float a2 = a1 + (x1i - x0i - 3) * s;
+                    row[x1i - 1] += d * (1 - a2 - am);
+                }
+                row[x1i] += d * am;
+            }
+            x = xNext;
+        }
+    }
+
+    template <bool kEvenOdd, bool kInverse>
+    static SK_ALWAYS_INLINE skvx::float4 fold(skvx::float4 winding) {
+        skvx::float4 c = abs(winding);
+        if (kEvenOdd) {
+            // A triangle wave: 0 for even windings, 1 for odd ones.
+            c = c - 2 * floor(c * 0.5f);
+            c = min(c, 2 - c);
+        } else {
+            c = min(c, 1);
+        }
+        return kInverse ? 1 - c : c;
+    }
+
+    // Turns one row of area deltas into alpha, leaving the row zeroed.
+    template <bool kEvenOdd, bool kInverse>
+    static void resolve_row(float* row, uint8_t* alpha, int width) {
+        using float4 = skvx::float4;
+        float4 carry = 0;
+        int x = 0;
+        for (; x + 4 <= width; x += 4) {
+            float4 v = float4::Load(row + x);
+            // Prefix sum within the vector in two shifted adds, then add in the previous total.
+            v += skvx::shuffle<0,0,1,2>(v) * float4{0, 1, 1, 1};
+            v += skvx::shuffle<0,0,0,1>(v) * float4{0, 0, 1, 1};
+            v += carry;
+            carry = skvx::shuffle<3,3,3,3>(v);
+            float4 c = fold<kEvenOdd, kInverse>(v);
+            skvx::cast<uint8_t>(c * 255 + 0.5f).store(alpha + x);
+            float4(0).store(row + x);
+        }
+        float sum = carry[0];
+        for (; x < width; ++x) {
+            sum += row[x];
+            row[x] = 0;
+            float c = fold<kEvenOdd, kInverse>(float4(sum))[0];
+            alpha[x] = (uint8_t)(c * 255 + 0.5f);
+        }
+        row[width] = row[width + 1] = 0;
+    }
+
+    const SkIRect fBounds;
+    const SkRect fClip;
+    const int fWidth;
+    const int fStride;
+    skia_private::AutoTMalloc<float> fAccumulation;
+};
+
+}  // namespace
+
+bool SkScan::AccumulationFillPath(const SkPath& path,
+                                  SkBlitter* blitter,
+                                  const SkIRect& ir,
+                                  const SkIRect& clipBounds,
+                                  bool forceRLE) {
+    const bool isInverse = path.isInverseFillType();
+    SkIRect bounds;
+    if (isInverse) {
+        // Rows above and below ir are filled by the caller, but we own the whole width of the
+        // clip for the rows in between.
+        bounds = {clipBounds.fLeft, ir.fTop, clipBounds.fRight, ir.fBottom};
+        if (!bounds.intersect(clipBounds)) {
+            return true;
+        }
+    } else if (!bounds.intersect(ir, clipBounds)) {
+        return true;
+    }
+    if ((int64_t)bounds.width() * bounds.height() > kMaxAccumulationArea) {
+        return false;
+    }
+
+    CoverageAccumulator accumulator(bounds);
+    SkPathEdgeIter iter(path);
+    while (auto e = iter.next()) {
+        switch (e.fEdge) {
+            case SkPathEdgeIter::Edge::kLine:
+                accumulator.addLine(e.fPts);
+                break;
+            case SkPathEdgeIter::Edge::kQuad:
+                accumulator.addQuad(e.fPts);
+                break;
+            case SkPathEdgeIter::Edge::kConic: {
+                SkAutoConicToQuads quadder;
+                const SkPoint* quads = quadder.computeQuads(e.fPts, iter.conicWeight(),
+                                                            kFlattenTolerance);
+                for (int i = 0; i < quadder.countQuads(); ++i) {
+                    accumulator.addQuad(quads + 2 * i);
+                }
+                break;
+            }
+            case SkPathEdgeIter::Edge::kCubic:
+                accumulator.addCubic(e.fPts);
+                break;
+        }
+    }
+
+    const bool isEvenOdd = (path.getFillType() == SkPathFillType::kEvenOdd ||
+                            path.getFillType() == SkPathFillType::kInverseEvenOdd);
+    auto resolve = [&](uint8_t* alpha, size_t alphaRowBytes, auto&& blitRow) {
+        if (isEvenOdd) {
+            isInverse ? accumulator.resolve<true, true>(alpha, alphaRowBytes, blitRow)
+                      : accumulator.resolve<true, false>(alpha, alphaRowBytes, blitRow);
+        } else {
+            isInverse ? accumulator.resolve<false, true>(alpha, alphaRowBytes, blitRow)
+                      : accumulator.resolve<false, false>(alpha, alphaRowBytes, blitRow);
+        }
+    };
+
+    const int width = accumulator.width();
+    if (!forceRLE) {
+        // Resolve every row into one mask and blit it in a single call.
+        skia_private::AutoTMalloc<uint8_t> storage(SkToSizeT(width) * bounds.height());
+        resolve(storage.get(), width, [](int, const uint8_t*) {});
+        SkMask mask;
+        mask.fImage = storage.get();
+        mask.fBounds = bounds;
+        mask.fRowBytes = width;
+        mask.fFormat = SkMask::kA8_Format;
+        blitter->blitMask(mask, bounds);
+        return true;
+    }
+
+    // Blit each row as runs of equal alpha.
+    skia_private::AutoTMalloc<uint8_t> alpha(width + 1);
+    skia_private::AutoTMalloc<int16_t> runs(width + 1);
+    resolve(alpha.get(), 0, [&](int y, const uint8_t* rowAlpha) {
+        int x = 0;
+        bool empty = true;
+        while (x < width) {
+            int start = x;
+            while (++x < width && rowAlpha[x] == rowAlpha[start]) {}
+            // AntiFillPath limits the clip to 32767 pixels, so every run fits in an int16_t.
+            runs[start] = SkToS16(x - start);
+            empty &= rowAlpha[start] == 0;
+        }
+        runs[width] = 0;
+        if (!empty) {
+            blitter->blitAntiH(bounds.fLeft, y, alpha.get(), runs.get());
+        }
+    });
+    return true;
+}
@@ -10,10 +10,15 @@
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkRegion.h"
+#include "include/private/base/SkTemplates.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkAntiRun.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkMask.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkTaskGroup.h"
+
+#include <cstring>
 
 #define SHIFT   SK_SUPERSAMPLE_SHIFT
 #define SCALE   (1 << SHIFT)
@@ -664,6 +669,127 @@ static int rect_overflows_short_shift(SkIRect rect, int shift) {
            overflows_short_shift(rect.fBottom, shift);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+/** When gSkUseBandedAA is set, paths with many points and tall bounds are supersampled in
+    horizontal bands on the default executor. Each band writes its coverage into its own rows of a
+    shared A8 mask, which is blitted through the real clip once every band is done.
+
+    The bands are cut on pixel rows. The path's edges are built and sorted once, with the same clip
+    as a serial scan conversion, then split between the bands by SkEdgeBands; edges that start
+    above a band are stepped down to it rather than clipped to it. A supersampled row's coverage
+    depends only on where its edges cross it, so the mask holds exactly the coverage a serial scan
+    conversion would blit. Paths that would be drawn with analytic or accumulation AA are not
+    banded, as those walk edges in ways that can't be split on rows.
+ */
+static constexpr int kMinBandedPathPoints = 1 << 14;
+static constexpr int kMinBandHeight = 32;
+static constexpr int kMaxBands = 32;
+// One byte of mask per pixel.
+static constexpr int64_t kMaxBandedArea = 1 << 24;
+// Our antialiasing can't handle a clip larger than this (the runs[] uses int16_t for its index).
+static constexpr int32_t kMaxClipCoord = 32767;
+
+namespace {
+
+// Writes coverage into the rows of an A8 mask, which must contain everything blitted. The scan
+// converters blit each pixel at most once, so coverage is stored rather than accumulated.
+class CoverageMaskBlitter final : public SkBlitter {
+public:
+    CoverageMaskBlitter(const SkMask& mask) : fMask(mask) {}
+
+    void blitH(int x, int y, int width) override {
+        memset(fMask.getAddr8(x, y), 0xFF, width);
+    }
+
+    void blitAntiH(int x, int y, const SkAlpha antialias[], const int16_t runs[]) override {
+        uint8_t* dst = fMask.getAddr8(x, y);
+        for (int n = runs[0]; n > 0; n = runs[0]) {
+            memset(dst, antialias[0], n);
+            dst += n;
+            antialias += n;
+            runs += n;
+        }
+    }
+
+    void blitV(int x, int y, int height, SkAlpha alpha) override {
+        for (int i = 0; i < height; ++i) {
+            *fMask.getAddr8(x, y + i) = alpha;
+        }
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        for (int i = 0; i < height; ++i) {
+            memset(fMask.getAddr8(x, y + i), 0xFF, width);
+        }
+    }
+
+    void blitMask(const SkMask& mask, const SkIRect& clip) override {
+        if (mask.fFormat != SkMask::kA8_Format) {
+            this->SkBlitter::blitMask(mask, clip);
+            return;
+        }
+        for (int y = clip.fTop; y < clip.fBottom; ++y) {
+            memcpy(fMask.getAddr8(clip.fLeft, y), mask.getAddr8(clip.fLeft, y), clip.width());
+        }
+    }
+
+private:
+    const SkMask fMask;
+};
+
+}  // namespace
+
+bool SkScan::AntiFillPathInBands(const SkPath& path, const SkIRect& ir, const SkIRect& clippedIR,
+                                 const SkRegion& clip, SkBlitter* blitter) {
+    if (!gSkUseBandedAA || gSkUseAccumulationAA || path.countPoints() < kMinBandedPathPoints ||
+        (int64_t)clippedIR.width() * clippedIR.height() > kMaxBandedArea || ShouldUseAAA(path) ||
+        MaskSuperBlitter::CanHandleRect(ir)) {
+        return false;
+    }
+    const int bands = std::min(kMaxBands, clippedIR.height() / kMinBandHeight);
+    if (bands < 2) {
+        return false;
+    }
+
+    const size_t rowBytes = clippedIR.width();
+    skia_private::AutoTMalloc<uint8_t> storage(rowBytes * clippedIR.height());
+    sk_bzero(storage.get(), rowBytes * clippedIR.height());
+    SkMask mask;
+    mask.fImage = storage.get();
+    mask.fBounds = clippedIR;
+    mask.fRowBytes = SkToU32(rowBytes);
+    mask.fFormat = SkMask::kA8_Format;
+
+    // The same clip bounds that SAAFillPath() would be given.
+    SkIRect clipBounds = clip.getBounds();
+    if (!clipBounds.intersect({0, 0, kMaxClipCoord, kMaxClipCoord})) {
+        return true;
+    }
+    int bandTops[kMaxBands + 1];
+    for (int i = 0; i <= bands; ++i) {
+        bandTops[i] = clippedIR.fTop + clippedIR.height() * i / bands;
+    }
+    SkEdgeBands edges(path, clipBounds, SHIFT, clipBounds.contains(ir), bandTops, bands);
+
+    SkTaskGroup tasks(SkExecutor::GetDefault());
+    tasks.batch(bands, [&](int i) {
+        SkIRect band = ir;
+        band.fTop    = bandTops[i];
+        band.fBottom = bandTops[i + 1];
+        CoverageMaskBlitter bandBlitter(mask);
+        SuperBlitter superBlit(&bandBlitter, band, clipBounds, /*isInverse=*/false);
+        edges.fill(i, &superBlit);
+    });
+    tasks.wait();
+
+    SkScanClipper clipper(blitter, &clip, clippedIR);
+    if (SkBlitter* clippedBlitter = clipper.getBlitter()) {
+        clippedBlitter->blitMask(mask, clippedIR);
+    }
+    return true;
+}
+
 void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
                           SkBlitter* blitter, bool forceRLE) {
     if (origClip.isEmpty()) {
@@ -697,6 +823,11 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         return;
     }
 
+    if (!isInverse && !forceRLE &&
+        SkScan::AntiFillPathInBands(path, ir, clippedIR, origClip, blitter)) {
+        return;
+    }
+
     // Our antialiasing can't handle a clip larger than 32767, so we restrict
     // the clip to that limit here. (the runs[] uses int16_t for its index).
     //
@@ -706,7 +837,6 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
     SkRegion tmpClipStorage;
     const SkRegion* clipRgn = &origClip;
     {
-        static const int32_t kMaxClipCoord = 32767;
         const SkIRect& bounds = origClip.getBounds();
         if (bounds.fRight > kMaxClipCoord || bounds.fBottom > kMaxClipCoord) {
             SkIRect limit = { 0, 0, kMaxClipCoord, kMaxClipCoord };
@@ -735,7 +865,10 @@ void SkScan::AntiFillPath(const SkPath& path, const SkRegion& origClip,
         sk_blit_above(blitter, ir, *clipRgn);
     }
 
-    if (ShouldUseAAA(path)) {
+    if (gSkUseAccumulationAA &&
+        SkScan::AccumulationFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE)) {
+        // Accumulation AA handled the path; it declines paths with very large bounds.
+    } else if (ShouldUseAAA(path)) {
         // Do not use AAA if path is too complicated:
         // there won't be any speedup or significant visual improvement.
         SkScan::AAAFillPath(path, blitter, ir, clipRgn->getBounds(), forceRLE);
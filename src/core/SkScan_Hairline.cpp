@@ -9,6 +9,7 @@
 #include "src/base/SkMathPriv.h"
 #include "src/core/SkBlitter.h"
 #include "src/core/SkFDot6.h"
+#include "src/core/SkHairlineBatcher.h"
 #include "src/core/SkLineClipper.h"
 #include "src/core/SkPathPriv.h"
 #include "src/core/SkRasterClip.h"
@@ -511,6 +512,7 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
         return;
     }
 
+    SkHairlineBatcher batcher;
     SkAAClipBlitterWrapper wrap;
     const SkRegion* clip = nullptr;
     SkRect insetStorage, outsetStorage;
@@ -523,6 +525,11 @@ void hair_path(const SkPath& path, const SkRasterClip& rclip, SkBlitter* blitter
         if (rclip.quickReject(ibounds)) {
             return;
         }
+        // The batcher sits below any clipping, so it only sees pixels that are really drawn.
+        SkIRect batchBounds;
+        if (batchBounds.intersect(ibounds, rclip.getBounds())) {
+            blitter = batcher.apply(blitter, batchBounds, path.countVerbs());
+        }
         if (!rclip.quickContains(ibounds)) {
             if (rclip.isBW()) {
                 clip = &rclip.bwRgn();
@@ -703,6 +710,8 @@ void SkScan::FrameRect(const SkRect& r, const SkPoint& strokeSize,
 
 void SkScan::HairLine(const SkPoint pts[], int count, const SkRasterClip& clip,
                       SkBlitter* blitter) {
+    SkHairlineBatcher batcher;
+    blitter = batcher.apply(blitter, pts, count, count - 1, clip);
     if (clip.isBW()) {
         HairLineRgn(pts, count, &clip.bwRgn(), blitter);
     } else {
@@ -724,6 +733,8 @@ void SkScan::HairLine(const SkPoint pts[], int count, const SkRasterClip& clip,
 
 void SkScan::AntiHairLine(const SkPoint pts[], int count, const SkRasterClip& clip,
                           SkBlitter* blitter) {
+    SkHairlineBatcher batcher;
+    blitter = batcher.apply(blitter, pts, count, count - 1, clip);
     if (clip.isBW()) {
         AntiHairLineRgn(pts, count, &clip.bwRgn(), blitter);
     } else {
@@ -378,10 +378,8 @@ static bool operator<(const SkEdge& a, const SkEdge& b) {
     return valuea < valueb;
 }
 
-static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
-    SkTQSort(list, list + count);
-
-    // now make the edges linked in sorted order
+static SkEdge* link_edges(SkEdge* list[], int count, SkEdge** last) {
+    // make the edges linked in sorted order
     for (int i = 1; i < count; i++) {
         list[i - 1]->fNext = list[i];
         list[i]->fPrev = list[i - 1];
@@ -391,23 +389,21 @@ static SkEdge* sort_edges(SkEdge* list[], int count, SkEdge** last) {
     return list[0];
 }
 
-// clipRect has not been shifted up
-void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitter,
-                  int start_y, int stop_y, int shiftEdgesUp, bool pathContainedInClip) {
-    SkASSERT(blitter);
-
+static SkIRect shift_clip(const SkIRect& clipRect, int shiftEdgesUp) {
     SkIRect shiftedClip = clipRect;
     shiftedClip.fLeft = SkLeftShift(shiftedClip.fLeft, shiftEdgesUp);
     shiftedClip.fRight = SkLeftShift(shiftedClip.fRight, shiftEdgesUp);
     shiftedClip.fTop = SkLeftShift(shiftedClip.fTop, shiftEdgesUp);
     shiftedClip.fBottom = SkLeftShift(shiftedClip.fBottom, shiftEdgesUp);
+    return shiftedClip;
+}
 
-    SkBasicEdgeBuilder builder(shiftEdgesUp);
-    int count = builder.buildEdges(path, pathContainedInClip ? nullptr : &shiftedClip);
-    SkEdge** list = builder.edgeList();
-
+// Walks the edges in list, which must be sorted and all start at or below start_y.
+static void fill_edges(SkEdge* list[], int count, SkPathFillType fillType, bool isConvex,
+                       const SkIRect& clipRect, SkBlitter* blitter, int start_y, int stop_y,
+                       int shiftEdgesUp, bool pathContainedInClip) {
     if (0 == count) {
-        if (path.isInverseFillType()) {
+        if (SkPathFillType_IsInverse(fillType)) {
             /*
              *  Since we are in inverse-fill, our caller has already drawn above
              *  our top (start_y) and will draw below our bottom (stop_y). Thus
@@ -432,8 +428,8 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
     }
 
     SkEdge headEdge, tailEdge, *last;
-    // this returns the first and last edge after they're sorted into a dlink list
-    SkEdge* edge = sort_edges(list, count, &last);
+    // this returns the first and last edge after they're linked into a dlink list
+    SkEdge* edge = link_edges(list, count, &last);
 
     headEdge.fPrev = nullptr;
     headEdge.fNext = edge;
@@ -448,6 +444,7 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
 
     // now edge is the head of the sorted linklist
 
+    const SkIRect shiftedClip = shift_clip(clipRect, shiftEdgesUp);
     start_y = SkLeftShift(start_y, shiftEdgesUp);
     stop_y = SkLeftShift(stop_y, shiftEdgesUp);
     if (!pathContainedInClip && start_y < shiftedClip.fTop) {
@@ -460,19 +457,141 @@ void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitte
     InverseBlitter  ib;
     PrePostProc     proc = nullptr;
 
-    if (path.isInverseFillType()) {
+    if (SkPathFillType_IsInverse(fillType)) {
         ib.setBlitter(blitter, clipRect, shiftEdgesUp);
         blitter = &ib;
         proc = PrePostInverseBlitterProc;
     }
 
     // count >= 2 is required as the convex walker does not handle missing right edges
-    if (path.isConvex() && (nullptr == proc) && count >= 2) {
+    if (isConvex && (nullptr == proc) && count >= 2) {
         walk_simple_edges(&headEdge, blitter, start_y, stop_y);
     } else {
-        walk_edges(&headEdge, path.getFillType(), blitter, start_y, stop_y, proc,
-                   shiftedClip.right());
+        walk_edges(&headEdge, fillType, blitter, start_y, stop_y, proc, shiftedClip.right());
+    }
+}
+
+// clipRect has not been shifted up
+void sk_fill_path(const SkPath& path, const SkIRect& clipRect, SkBlitter* blitter,
+                  int start_y, int stop_y, int shiftEdgesUp, bool pathContainedInClip) {
+    SkASSERT(blitter);
+
+    SkIRect shiftedClip = shift_clip(clipRect, shiftEdgesUp);
+
+    SkBasicEdgeBuilder builder(shiftEdgesUp);
+    int count = builder.buildEdges(path, pathContainedInClip ? nullptr : &shiftedClip);
+    SkEdge** list = builder.edgeList();
+    SkTQSort(list, list + count);
+
+    fill_edges(list, count, path.getFillType(), path.isConvex(), clipRect, blitter, start_y,
+               stop_y, shiftEdgesUp, pathContainedInClip);
+}
+
+// Steps a copy of edge down to start at row y, exactly as walk_edges() would have by the time it
+// got there. Returns false if the edge ends above y.
+static bool advance_edge_to_y(SkEdge* edge, int y) {
+    while (edge->fLastY < y) {
+        if (edge->fCurveCount > 0) {
+            if (!((SkQuadraticEdge*)edge)->updateQuadratic()) {
+                return false;
+            }
+        } else if (edge->fCurveCount < 0) {
+            if (!((SkCubicEdge*)edge)->updateCubic()) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    if (edge->fFirstY < y) {
+        // The same as adding fDX once per row, including any wrap-around.
+        edge->fX = (SkFixed)(uint32_t)((int64_t)edge->fX +
+                                       (int64_t)edge->fDX * (y - edge->fFirstY));
+        edge->fFirstY = y;
+    }
+    return true;
+}
+
+static size_t edge_size(const SkEdge* edge) {
+    return edge->fCurveCount > 0 ? sizeof(SkQuadraticEdge) :
+           edge->fCurveCount < 0 ? sizeof(SkCubicEdge)     : sizeof(SkEdge);
+}
+
+SkEdgeBands::SkEdgeBands(const SkPath& path, const SkIRect& clipRect, int shiftEdgesUp,
+                         bool pathContainedInClip, const int bandTops[], int bandCount)
+        : fFillType(path.getFillType())
+        , fIsConvex(path.isConvex())
+        , fClipRect(clipRect)
+        , fShiftEdgesUp(shiftEdgesUp)
+        , fPathContainedInClip(pathContainedInClip)
+        , fBuilder(std::make_unique<SkBasicEdgeBuilder>(shiftEdgesUp))
+        , fBandTops(bandTops, bandCount + 1)
+        , fBands(bandCount) {
+    SkASSERT(bandCount > 0);
+
+    const SkIRect shiftedClip = shift_clip(clipRect, shiftEdgesUp);
+    const int count = fBuilder->buildEdges(path, pathContainedInClip ? nullptr : &shiftedClip);
+    SkEdge** list = fBuilder->edgeList();
+    SkTQSort(list, list + count);
+
+    SkTArray<int> shiftedTops(fBandTops.size());
+    for (int top : fBandTops) {
+        shiftedTops.push_back(SkLeftShift(top, shiftEdgesUp));
+    }
+    for (int i = 0; i < bandCount; ++i) {
+        fBands.push_back();
+    }
+
+    // Each edge goes to the band it starts in, and a copy of it, stepped down to the band's top,
+    // to each band below that it reaches. Since the list is sorted, each band gets all of its
+    // copies first, then its own edges in order.
+    int band = 0;
+    for (int i = 0; i < count; ++i) {
+        SkEdge* edge = list[i];
+        while (band < bandCount && edge->fFirstY >= shiftedTops[band + 1]) {
+            ++band;
+        }
+        if (band == bandCount) {
+            break;
+        }
+        int later = band;
+        if (edge->fFirstY >= shiftedTops[band]) {
+            fBands[band].push_back(edge);
+            later = band + 1;
+        }
+        const SkEdge* prev = edge;
+        for (; later < bandCount; ++later) {
+            if (prev->fCurveCount == 0 && prev->fLastY < shiftedTops[later]) {
+                break;
+            }
+            SkCubicEdge scratch;
+            memcpy(&scratch, prev, edge_size(prev));
+            if (!advance_edge_to_y(&scratch, shiftedTops[later])) {
+                break;
+            }
+            SkEdge* copy = (SkEdge*)fCopies.makeBytesAlignedTo(edge_size(&scratch),
+                                                               alignof(SkCubicEdge));
+            memcpy(copy, &scratch, edge_size(&scratch));
+            fBands[later].push_back(copy);
+            prev = copy;
+        }
+    }
+}
+
+SkEdgeBands::~SkEdgeBands() = default;
+
+void SkEdgeBands::fill(int band, SkBlitter* blitter) {
+    SkTArray<SkEdge*>& edges = fBands[band];
+    // The copies were appended in the order of the edges they came from, and all start at the
+    // band's top, along with some of its own edges; sort them into place.
+    const int top = SkLeftShift(fBandTops[band], fShiftEdgesUp);
+    int atTop = 0;
+    while (atTop < edges.size() && edges[atTop]->fFirstY == top) {
+        ++atTop;
     }
+    SkTQSort(edges.begin(), edges.begin() + atTop);
+    fill_edges(edges.begin(), edges.size(), fFillType, fIsConvex, fClipRect, blitter,
+               fBandTops[band], fBandTops[band + 1], fShiftEdgesUp, fPathContainedInClip);
 }
 
 void sk_blit_above(SkBlitter* blitter, const SkIRect& ir, const SkRegion& clip) {
@@ -716,8 +835,8 @@ static void sk_fill_triangle(const SkPoint pts[], const SkIRect* clipRect,
 
     SkEdge headEdge, tailEdge, *last;
 
-    // this returns the first and last edge after they're sorted into a dlink list
-    SkEdge* edge = sort_edges(list, count, &last);
+    // this returns the first and last edge after they're linked into a dlink list
+    SkEdge* edge = link_edges(list, count, &last);
 
     headEdge.fPrev = nullptr;
     headEdge.fNext = edge;
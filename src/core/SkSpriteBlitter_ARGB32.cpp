@@ -6,20 +6,34 @@
  */
 
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkPaint.h"
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkTemplates.h"
 #include "src/base/SkArenaAlloc.h"
 #include "src/core/SkBlitRow.h"
+#include "src/core/SkOpts.h"
 #include "src/core/SkSpriteBlitter.h"
 #include "src/core/SkXfermodePriv.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// The 8888 sprite blitters below also take sources in the other RGBA/BGRA order. Each row of those
+// is swapped into swapRow (at least as wide as the source) with SkOpts::RGBA_to_BGRA first.
+static const uint32_t* swap_rb_if_needed(uint32_t* swapRow, const uint32_t* src, int width) {
+    if (swapRow) {
+        SkOpts::RGBA_to_BGRA(swapRow, src, width);
+        return swapRow;
+    }
+    return src;
+}
+
 class Sprite_D32_S32 : public SkSpriteBlitter {
 public:
-    Sprite_D32_S32(const SkPixmap& src, U8CPU alpha)  : INHERITED(src) {
-        SkASSERT(src.colorType() == kN32_SkColorType);
+    Sprite_D32_S32(const SkPixmap& src, U8CPU alpha, uint32_t* swapRow)
+            : INHERITED(src), fSwapRow(swapRow) {
+        SkASSERT(src.colorType() == kRGBA_8888_SkColorType ||
+                 src.colorType() == kBGRA_8888_SkColorType);
 
         unsigned flags32 = 0;
         if (255 != alpha) {
@@ -43,7 +57,7 @@ public:
         U8CPU             alpha = fAlpha;
 
         do {
-            proc(dst, src, width, alpha);
+            proc(dst, swap_rb_if_needed(fSwapRow, src, width), width, alpha);
             dst = (uint32_t* SK_RESTRICT)((char*)dst + dstRB);
             src = (const uint32_t* SK_RESTRICT)((const char*)src + srcRB);
         } while (--height != 0);
@@ -52,6 +66,7 @@ public:
 private:
     SkBlitRow::Proc32   fProc32;
     U8CPU               fAlpha;
+    uint32_t*           fSwapRow;
 
     using INHERITED = SkSpriteBlitter;
 };
@@ -60,7 +75,8 @@ private:
 
 class Sprite_D32_S32A_Xfer: public SkSpriteBlitter {
 public:
-    Sprite_D32_S32A_Xfer(const SkPixmap& source, const SkPaint& paint) : SkSpriteBlitter(source) {
+    Sprite_D32_S32A_Xfer(const SkPixmap& source, const SkPaint& paint, uint32_t* swapRow)
+            : SkSpriteBlitter(source), fSwapRow(swapRow) {
         fXfermode = SkXfermode::Peek(paint.getBlendMode_or(SkBlendMode::kSrcOver));
         SkASSERT(fXfermode);
     }
@@ -74,7 +90,7 @@ public:
         SkXfermode* xfermode = fXfermode;
 
         do {
-            xfermode->xfer32(dst, src, width, nullptr);
+            xfermode->xfer32(dst, swap_rb_if_needed(fSwapRow, src, width), width, nullptr);
 
             dst = (uint32_t* SK_RESTRICT)((char*)dst + dstRB);
             src = (const uint32_t* SK_RESTRICT)((const char*)src + srcRB);
@@ -83,6 +99,7 @@ public:
 
 protected:
     SkXfermode* fXfermode;
+    uint32_t*   fSwapRow;
 
 private:
     using INHERITED = SkSpriteBlitter;
@@ -90,6 +107,53 @@ private:
 
 ///////////////////////////////////////////////////////////////////////////////
 
+// The other 8888 order, copied with kSrc (or an opaque kSrcOver) at full alpha: just swap R and B.
+class Sprite_D32_S32_SwapRB : public SkSpriteBlitter {
+public:
+    Sprite_D32_S32_SwapRB(const SkPixmap& source) : INHERITED(source) {}
+
+    void blitRect(int x, int y, int width, int height) override {
+        SkASSERT(width > 0 && height > 0);
+        uint32_t* SK_RESTRICT dst = fDst.writable_addr32(x, y);
+        const uint32_t* SK_RESTRICT src = fSource.addr32(x - fLeft, y - fTop);
+        size_t dstRB = fDst.rowBytes();
+        size_t srcRB = fSource.rowBytes();
+
+        do {
+            SkOpts::RGBA_to_BGRA(dst, src, width);
+            dst = (uint32_t* SK_RESTRICT)((char*)dst + dstRB);
+            src = (const uint32_t* SK_RESTRICT)((const char*)src + srcRB);
+        } while (--height != 0);
+    }
+
+private:
+    using INHERITED = SkSpriteBlitter;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
+// A8 sources are coverage for the (sRGB) paint color, drawn kSrcOver just like an A8 mask.
+class Sprite_D32_A8 : public SkSpriteBlitter {
+public:
+    Sprite_D32_A8(const SkPixmap& source, SkColor color) : INHERITED(source), fColor(color) {
+        SkASSERT(source.colorType() == kAlpha_8_SkColorType);
+    }
+
+    void blitRect(int x, int y, int width, int height) override {
+        SkASSERT(width > 0 && height > 0);
+        SkOpts::blit_mask_d32_a8(fDst.writable_addr32(x, y), fDst.rowBytes(),
+                                 fSource.addr8(x - fLeft, y - fTop), fSource.rowBytes(),
+                                 fColor, width, height);
+    }
+
+private:
+    SkColor fColor;
+
+    using INHERITED = SkSpriteBlitter;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+
 SkSpriteBlitter* SkSpriteBlitter::ChooseL32(const SkPixmap& source, const SkPaint& paint,
                                             SkArenaAlloc* allocator) {
     SkASSERT(allocator != nullptr);
@@ -106,14 +170,35 @@ SkSpriteBlitter* SkSpriteBlitter::ChooseL32(const SkPixmap& source, const SkPain
 
     U8CPU alpha = paint.getAlpha();
 
-    if (source.colorType() == kN32_SkColorType) {
+    SkColorType swappedN32 = kN32_SkColorType == kRGBA_8888_SkColorType ? kBGRA_8888_SkColorType
+                                                                         : kRGBA_8888_SkColorType;
+
+    if (source.colorType() == kN32_SkColorType || source.colorType() == swappedN32) {
+        const bool swapRB = source.colorType() == swappedN32;
+        if (swapRB && 255 == alpha &&
+            (paint.asBlendMode() == SkBlendMode::kSrc ||
+             (paint.isSrcOver() && source.isOpaque()))) {
+            return allocator->make<Sprite_D32_S32_SwapRB>(source);
+        }
+        if (!paint.isSrcOver() && 255 != alpha) {
+            return nullptr;
+        }
+        uint32_t* swapRow = swapRB ? allocator->makeArrayDefault<uint32_t>(source.width())
+                                   : nullptr;
         if (paint.isSrcOver()) {
             // this can handle alpha, but not xfermode
-            return allocator->make<Sprite_D32_S32>(source, alpha);
+            return allocator->make<Sprite_D32_S32>(source, alpha, swapRow);
         }
-        if (255 == alpha) {
-            // this can handle an xfermode, but not alpha
-            return allocator->make<Sprite_D32_S32A_Xfer>(source, paint);
+        // this can handle an xfermode, but not alpha
+        return allocator->make<Sprite_D32_S32A_Xfer>(source, paint, swapRow);
+    }
+
+    if (source.colorType() == kAlpha_8_SkColorType && paint.isSrcOver()) {
+        // The paint color is sRGB, so it can only be used as-is on untagged or sRGB destinations.
+        // Our caller has already checked that the source's color space matches the destination's.
+        SkColorSpace* cs = source.colorSpace();
+        if (!cs || cs->isSRGB()) {
+            return allocator->make<Sprite_D32_A8>(source, paint.getColor());
         }
     }
     return nullptr;
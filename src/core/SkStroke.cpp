@@ -1336,6 +1336,304 @@ void SkPathStroker::cubicTo(const SkPoint& pt1, const SkPoint& pt2,
     this->postJoinTo(pt3, normalCD, unitCD);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+
+// Strokes paths made only of lines. It makes the same decisions as SkPathStroker does for lines,
+// so the two build the same path, but it computes the segments' normals in one pass up front
+// and writes to SkStrokerPriv::PathBuffers instead of SkPaths.
+class SkPolylineStroker {
+public:
+    SkPolylineStroker(const SkPath& src,
+                      SkScalar radius, SkScalar miterLimit, SkPaint::Cap,
+                      SkPaint::Join, SkScalar resScale,
+                      bool canIgnoreCenter);
+
+    void stroke(SkPath* dst);
+
+private:
+    // Passed as the source point index of lines that are not in the source.
+    enum {
+        kClosingLine = -1,  // the line SkPath::Iter adds to close a contour
+        kNoTangent   = -2,  // a zero-length line that stands in for an empty contour
+    };
+
+    using PathBuffer = SkStrokerPriv::PathBuffer;
+
+    const SkPath& fSrc;
+    SkScalar    fRadius;
+    SkScalar    fInvMiterLimit;
+    SkScalar    fResScale;
+    SkScalar    fInvResScale;
+
+    SkVector    fFirstNormal, fPrevNormal, fFirstUnitNormal, fPrevUnitNormal;
+    SkPoint     fFirstPt, fPrevPt;  // on original path
+    SkPoint     fFirstOuterPt;
+    int         fFirstOuterPtIndexInContour;
+    int         fSegmentCount;
+    int         fPrevPtIndex;       // index of fPrevPt in the source, or -1
+    bool        fPrevIsLine;
+    bool        fCanIgnoreCenter;
+    bool        fJoinCompleted;
+    bool        fIsButtCap;
+
+    SkStrokerPriv::CapProcT<PathBuffer>  fCapper;
+    SkStrokerPriv::JoinProcT<PathBuffer> fJoiner;
+
+    PathBuffer  fInner, fOuter;
+
+    // fUnitNormals[i] is the unit normal of the line from source point i-1 to point i, or
+    // (0, 0) if that line is too short to have one.
+    skia_private::AutoSTMalloc<32, SkVector> fUnitNormals;
+
+    void computeUnitNormals();
+    bool hasValidTangent(int ptIndex, int verbIndex) const;
+    bool isCurrentContourEmpty() const {
+        return fInner.isZeroLengthSincePoint(0) &&
+               fOuter.isZeroLengthSincePoint(fFirstOuterPtIndexInContour);
+    }
+
+    void moveTo(const SkPoint&, int ptIndex);
+    void lineTo(const SkPoint&, int ptIndex, int verbIndex);
+    void finishContour(bool close, bool isLine);
+};
+
+SkPolylineStroker::SkPolylineStroker(const SkPath& src,
+                                     SkScalar radius, SkScalar miterLimit,
+                                     SkPaint::Cap cap, SkPaint::Join join, SkScalar resScale,
+                                     bool canIgnoreCenter)
+        : fSrc(src)
+        , fRadius(radius)
+        , fInvMiterLimit(0)
+        , fResScale(resScale)
+        , fFirstOuterPtIndexInContour(0)
+        , fSegmentCount(-1)
+        , fPrevPtIndex(-1)
+        , fPrevIsLine(false)
+        , fCanIgnoreCenter(canIgnoreCenter)
+        , fJoinCompleted(false)
+        , fIsButtCap(cap == SkPaint::kButt_Cap) {
+    if (join == SkPaint::kMiter_Join) {
+        if (miterLimit <= SK_Scalar1) {
+            join = SkPaint::kBevel_Join;
+        } else {
+            fInvMiterLimit = SkScalarInvert(miterLimit);
+        }
+    }
+    fCapper = SkStrokerPriv::BufferCapFactory(cap);
+    fJoiner = SkStrokerPriv::BufferJoinFactory(join);
+
+    // Same estimates as SkPathStroker.
+    fOuter.incReserve(src.countPoints() * 3);
+    fInner.incReserve(src.countPoints());
+    fInvResScale = SkScalarInvert(resScale * 4);
+}
+
+void SkPolylineStroker::computeUnitNormals() {
+    const SkPoint* pts = SkPathPriv::PointData(fSrc);
+    const int count = fSrc.countPoints();
+    fUnitNormals.reset(count);
+    if (count == 0) {
+        return;
+    }
+    SkVector* unitNormals = fUnitNormals.get();
+    unitNormals[0] = {0, 0};
+    // Matches set_normal_unitnormal(), which rounds through doubles as SkPoint::setNormalize()
+    // does, so these are exactly the normals SkPathStroker computes. The lines are independent,
+    // so this loop keeps the divides and square roots of several lines in flight at once.
+    for (int i = 1; i < count; ++i) {
+        SkVector unit;
+        if (unit.setNormalize((pts[i].fX - pts[i - 1].fX) * fResScale,
+                              (pts[i].fY - pts[i - 1].fY) * fResScale)) {
+            SkPointPriv::RotateCCW(&unit);
+        }
+        unitNormals[i] = unit;
+    }
+}
+
+bool SkPolylineStroker::hasValidTangent(int ptIndex, int verbIndex) const {
+    // Matches has_valid_tangent(): is there a line with length later in this contour?
+    if (ptIndex < 0) {
+        // Nothing follows the closing line.
+        return false;
+    }
+    const SkPoint* pts = SkPathPriv::PointData(fSrc);
+    const uint8_t* verbs = SkPathPriv::VerbData(fSrc);
+    const int verbCount = fSrc.countVerbs();
+    SkPoint lastPt = pts[ptIndex];
+    for (int v = verbIndex + 1; v < verbCount; ++v) {
+        switch (verbs[v]) {
+            case SkPath::kLine_Verb:
+                if (pts[++ptIndex] != lastPt) {
+                    return true;
+                }
+                break;
+            case SkPath::kClose_Verb:
+                return lastPt != fFirstPt;
+            default:
+                return false;
+        }
+    }
+    return false;
+}
+
+void SkPolylineStroker::moveTo(const SkPoint& pt, int ptIndex) {
+    if (fSegmentCount > 0) {
+        this->finishContour(false, false);
+    }
+    fSegmentCount = 0;
+    fFirstPt = fPrevPt = pt;
+    fPrevPtIndex = ptIndex;
+    fJoinCompleted = false;
+}
+
+void SkPolylineStroker::lineTo(const SkPoint& currPt, int ptIndex, int verbIndex) {
+    bool teenyLine = SkPointPriv::EqualsWithinTolerance(fPrevPt, currPt,
+                                                        SK_ScalarNearlyZero * fInvResScale);
+    if (fIsButtCap && teenyLine) {
+        return;
+    }
+    if (teenyLine && (fJoinCompleted || this->hasValidTangent(ptIndex, verbIndex))) {
+        return;
+    }
+
+    SkVector normal, unitNormal;
+    if (ptIndex > 0 && fPrevPtIndex == ptIndex - 1) {
+        unitNormal = fUnitNormals[ptIndex];
+    } else if (unitNormal.setNormalize((currPt.fX - fPrevPt.fX) * fResScale,
+                                       (currPt.fY - fPrevPt.fY) * fResScale)) {
+        SkPointPriv::RotateCCW(&unitNormal);
+    }
+    if (unitNormal.isZero()) {
+        if (fIsButtCap) {
+            return;
+        }
+        // As in SkPathStroker::preJoinTo(), zero length lines with square or round caps get an
+        // upright orientation.
+        normal.set(fRadius, 0);
+        unitNormal.set(1, 0);
+    } else {
+        unitNormal.scale(fRadius, &normal);
+    }
+
+    if (fSegmentCount == 0) {
+        fFirstNormal = normal;
+        fFirstUnitNormal = unitNormal;
+        fFirstOuterPt.set(fPrevPt.fX + normal.fX, fPrevPt.fY + normal.fY);
+
+        fOuter.moveTo(fFirstOuterPt.fX, fFirstOuterPt.fY);
+        fInner.moveTo(fPrevPt.fX - normal.fX, fPrevPt.fY - normal.fY);
+    } else {
+        fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt, unitNormal,
+                fRadius, fInvMiterLimit, fPrevIsLine, true);
+    }
+    fPrevIsLine = true;
+
+    fOuter.lineTo(currPt.fX + normal.fX, currPt.fY + normal.fY);
+    fInner.lineTo(currPt.fX - normal.fX, currPt.fY - normal.fY);
+
+    fJoinCompleted = true;
+    fPrevPt = currPt;
+    fPrevPtIndex = ptIndex;
+    fPrevUnitNormal = unitNormal;
+    fPrevNormal = normal;
+    fSegmentCount += 1;
+}
+
+void SkPolylineStroker::finishContour(bool close, bool currIsLine) {
+    if (fSegmentCount > 0) {
+        SkPoint pt;
+
+        if (close) {
+            fJoiner(&fOuter, &fInner, fPrevUnitNormal, fPrevPt,
+                    fFirstUnitNormal, fRadius, fInvMiterLimit,
+                    fPrevIsLine, currIsLine);
+            fOuter.close();
+
+            if (fCanIgnoreCenter) {
+                // If we can ignore the center just make sure the larger of the two paths
+                // is preserved and don't add the smaller one.
+                if (fInner.getBounds().contains(fOuter.getBounds())) {
+                    fInner.swap(fOuter);
+                }
+            } else {
+                // now add fInner as its own contour
+                fInner.getLastPt(&pt);
+                fOuter.moveTo(pt.fX, pt.fY);
+                fOuter.reversePathTo(fInner);
+                fOuter.close();
+            }
+        } else {    // add caps to start and end
+            // cap the end
+            fInner.getLastPt(&pt);
+            fCapper(&fOuter, fPrevPt, fPrevNormal, pt,
+                    currIsLine ? &fInner : nullptr);
+            fOuter.reversePathTo(fInner);
+            // cap the start
+            fCapper(&fOuter, fFirstPt, -fFirstNormal, fFirstOuterPt,
+                    fPrevIsLine ? &fInner : nullptr);
+            fOuter.close();
+        }
+    }
+    fInner.rewind();
+    fSegmentCount = -1;
+    fFirstOuterPtIndexInContour = fOuter.countPoints();
+}
+
+void SkPolylineStroker::stroke(SkPath* dst) {
+    this->computeUnitNormals();
+
+    // Walks the verbs the way SkStroke::strokePath() walks an SkPath::Iter.
+    const SkPoint* pts = SkPathPriv::PointData(fSrc);
+    const uint8_t* verbs = SkPathPriv::VerbData(fSrc);
+    const int verbCount = fSrc.countVerbs();
+    SkPoint lastPt = {0, 0};
+    bool lastSegmentIsLine = false;
+    int ptIndex = -1;
+    for (int v = 0; v < verbCount; ++v) {
+        switch (verbs[v]) {
+            case SkPath::kMove_Verb:
+                ++ptIndex;
+                if (v + 1 < verbCount) {    // a trailing move is ignored
+                    lastPt = pts[ptIndex];
+                    this->moveTo(lastPt, ptIndex);
+                }
+                break;
+            case SkPath::kLine_Verb:
+                ++ptIndex;
+                lastPt = pts[ptIndex];
+                this->lineTo(lastPt, ptIndex, v);
+                lastSegmentIsLine = true;
+                break;
+            case SkPath::kClose_Verb:
+                if (lastPt != fFirstPt) {
+                    lastPt = fFirstPt;
+                    this->lineTo(lastPt, kClosingLine, v);
+                    lastSegmentIsLine = true;
+                }
+                if (!fIsButtCap) {
+                    // Contours with no length keep their square and round caps, as in
+                    // SkStroke::strokePath().
+                    if (fSegmentCount == 0) {
+                        this->lineTo(fFirstPt, kNoTangent, v);
+                        lastSegmentIsLine = true;
+                        break;
+                    }
+                    if (this->isCurrentContourEmpty()) {
+                        lastSegmentIsLine = true;
+                        break;
+                    }
+                }
+                this->finishContour(true, lastSegmentIsLine);
+                break;
+            default:
+                SkDEBUGFAIL("unexpected verb");
+                break;
+        }
+    }
+    this->finishContour(false, lastSegmentIsLine);
+    *dst = fOuter.detach();
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -1448,59 +1746,67 @@ void SkStroke::strokePath(const SkPath& src, SkPath* dst) const {
     bool ignoreCenter = fDoFill && (src.getSegmentMasks() == SkPath::kLine_SegmentMask) &&
                         src.isLastContourClosed() && src.isConvex();
 
-    SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
-                            fResScale, ignoreCenter);
-    SkPath::Iter    iter(src, false);
-    SkPath::Verb    lastSegment = SkPath::kMove_Verb;
-
-    for (;;) {
-        SkPoint  pts[4];
-        switch (iter.next(pts)) {
-            case SkPath::kMove_Verb:
-                stroker.moveTo(pts[0]);
-                break;
-            case SkPath::kLine_Verb:
-                stroker.lineTo(pts[1], &iter);
-                lastSegment = SkPath::kLine_Verb;
-                break;
-            case SkPath::kQuad_Verb:
-                stroker.quadTo(pts[1], pts[2]);
-                lastSegment = SkPath::kQuad_Verb;
-                break;
-            case SkPath::kConic_Verb: {
-                stroker.conicTo(pts[1], pts[2], iter.conicWeight());
-                lastSegment = SkPath::kConic_Verb;
-            } break;
-            case SkPath::kCubic_Verb:
-                stroker.cubicTo(pts[1], pts[2], pts[3]);
-                lastSegment = SkPath::kCubic_Verb;
-                break;
-            case SkPath::kClose_Verb:
-                if (SkPaint::kButt_Cap != this->getCap()) {
-                    /* If the stroke consists of a moveTo followed by a close, treat it
-                       as if it were followed by a zero-length line. Lines without length
-                       can have square and round end caps. */
-                    if (stroker.hasOnlyMoveTo()) {
-                        stroker.lineTo(stroker.moveToPt());
-                        goto ZERO_LENGTH;
-                    }
-                    /* If the stroke consists of a moveTo followed by one or more zero-length
-                       verbs, then followed by a close, treat is as if it were followed by a
-                       zero-length line. Lines without length can have square & round end caps. */
-                    if (stroker.isCurrentContourEmpty()) {
-                ZERO_LENGTH:
-                        lastSegment = SkPath::kLine_Verb;
-                        break;
+    if (fUsePolylineStroker && src.getSegmentMasks() == SkPath::kLine_SegmentMask &&
+        src.isFinite()) {
+        SkPolylineStroker stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                                  fResScale, ignoreCenter);
+        stroker.stroke(dst);
+    } else {
+        SkPathStroker   stroker(src, radius, fMiterLimit, this->getCap(), this->getJoin(),
+                                fResScale, ignoreCenter);
+        SkPath::Iter    iter(src, false);
+        SkPath::Verb    lastSegment = SkPath::kMove_Verb;
+
+        for (;;) {
+            SkPoint  pts[4];
+            switch (iter.next(pts)) {
+                case SkPath::kMove_Verb:
+                    stroker.moveTo(pts[0]);
+                    break;
+                case SkPath::kLine_Verb:
+                    stroker.lineTo(pts[1], &iter);
+                    lastSegment = SkPath::kLine_Verb;
+                    break;
+                case SkPath::kQuad_Verb:
+                    stroker.quadTo(pts[1], pts[2]);
+                    lastSegment = SkPath::kQuad_Verb;
+                    break;
+                case SkPath::kConic_Verb: {
+                    stroker.conicTo(pts[1], pts[2], iter.conicWeight());
+                    lastSegment = SkPath::kConic_Verb;
+                } break;
+                case SkPath::kCubic_Verb:
+                    stroker.cubicTo(pts[1], pts[2], pts[3]);
+                    lastSegment = SkPath::kCubic_Verb;
+                    break;
+                case SkPath::kClose_Verb:
+                    if (SkPaint::kButt_Cap != this->getCap()) {
+                        /* If the stroke consists of a moveTo followed by a close, treat it
+                           as if it were followed by a zero-length line. Lines without length
+                           can have square and round end caps. */
+                        if (stroker.hasOnlyMoveTo()) {
+                            stroker.lineTo(stroker.moveToPt());
+                            goto ZERO_LENGTH;
+                        }
+                        /* If the stroke consists of a moveTo followed by one or more
+                           zero-length verbs, then followed by a close, treat is as if it were
+                           followed by a zero-length line. Lines without length can have square
+                           & round end caps. */
+                        if (stroker.isCurrentContourEmpty()) {
+                    ZERO_LENGTH:
+                            lastSegment = SkPath::kLine_Verb;
+                            break;
+                        }
                     }
-                }
-                stroker.close(lastSegment == SkPath::kLine_Verb);
-                break;
-            case SkPath::kDone_Verb:
-                goto DONE;
+                    stroker.close(lastSegment == SkPath::kLine_Verb);
+                    break;
+                case SkPath::kDone_Verb:
+                    goto DONE;
+            }
         }
+    DONE:
+        stroker.done(dst, lastSegment == SkPath::kLine_Verb);
     }
-DONE:
-    stroker.done(dst, lastSegment == SkPath::kLine_Verb);
 
     if (fDoFill && !ignoreCenter) {
         if (SkPathPriv::ComputeFirstDirection(src) == SkPathFirstDirection::kCCW) {
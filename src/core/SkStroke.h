@@ -64,6 +64,12 @@ public:
                        SkPathDirection = SkPathDirection::kCW) const;
     void    strokePath(const SkPath& path, SkPath*) const;
 
+    /**
+     *  Paths made only of lines are stroked by a faster stroker that builds the same result.
+     *  Turning it off is only useful for comparing the two.
+     */
+    void setUsePolylineStroker(bool use) { fUsePolylineStroker = use; }
+
     ////////////////////////////////////////////////////////////////
 
 private:
@@ -71,6 +77,7 @@ private:
     SkScalar    fResScale;
     uint8_t     fCap, fJoin;
     bool        fDoFill;
+    bool        fUsePolylineStroker = true;
 
     friend class SkPaint;
 };
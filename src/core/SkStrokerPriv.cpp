@@ -7,18 +7,21 @@
 
 #include "include/core/SkPath.h"
 #include "src/core/SkGeometry.h"
+#include "src/core/SkPathPriv.h"
 #include "src/core/SkPointPriv.h"
 #include "src/core/SkStrokerPriv.h"
 
 #include <utility>
 
-static void ButtCapper(SkPath* path, const SkPoint& pivot, const SkVector& normal,
-                       const SkPoint& stop, SkPath*) {
+template <typename Path>
+static void ButtCapper(Path* path, const SkPoint& pivot, const SkVector& normal,
+                       const SkPoint& stop, Path*) {
     path->lineTo(stop.fX, stop.fY);
 }
 
-static void RoundCapper(SkPath* path, const SkPoint& pivot, const SkVector& normal,
-                        const SkPoint& stop, SkPath*) {
+template <typename Path>
+static void RoundCapper(Path* path, const SkPoint& pivot, const SkVector& normal,
+                        const SkPoint& stop, Path*) {
     SkVector parallel;
     SkPointPriv::RotateCW(normal, &parallel);
 
@@ -28,8 +31,9 @@ static void RoundCapper(SkPath* path, const SkPoint& pivot, const SkVector& norm
     path->conicTo(projectedCenter - normal, stop, SK_ScalarRoot2Over2);
 }
 
-static void SquareCapper(SkPath* path, const SkPoint& pivot, const SkVector& normal,
-                         const SkPoint& stop, SkPath* otherPath) {
+template <typename Path>
+static void SquareCapper(Path* path, const SkPoint& pivot, const SkVector& normal,
+                         const SkPoint& stop, Path* otherPath) {
     SkVector parallel;
     SkPointPriv::RotateCW(normal, &parallel);
 
@@ -67,7 +71,8 @@ static AngleType Dot2AngleType(SkScalar dot) {
     }
 }
 
-static void HandleInnerJoin(SkPath* inner, const SkPoint& pivot, const SkVector& after) {
+template <typename Path>
+static void HandleInnerJoin(Path* inner, const SkPoint& pivot, const SkVector& after) {
 #if 1
     /*  In the degenerate case that the stroke radius is larger than our segments
         just connecting the two inner segments may "show through" as a funny
@@ -81,7 +86,8 @@ static void HandleInnerJoin(SkPath* inner, const SkPoint& pivot, const SkVector&
     inner->lineTo(pivot.fX - after.fX, pivot.fY - after.fY);
 }
 
-static void BluntJoiner(SkPath* outer, SkPath* inner, const SkVector& beforeUnitNormal,
+template <typename Path>
+static void BluntJoiner(Path* outer, Path* inner, const SkVector& beforeUnitNormal,
                         const SkPoint& pivot, const SkVector& afterUnitNormal,
                         SkScalar radius, SkScalar invMiterLimit, bool, bool) {
     SkVector    after;
@@ -97,7 +103,8 @@ static void BluntJoiner(SkPath* outer, SkPath* inner, const SkVector& beforeUnit
     HandleInnerJoin(inner, pivot, after);
 }
 
-static void RoundJoiner(SkPath* outer, SkPath* inner, const SkVector& beforeUnitNormal,
+template <typename Path>
+static void RoundJoiner(Path* outer, Path* inner, const SkVector& beforeUnitNormal,
                         const SkPoint& pivot, const SkVector& afterUnitNormal,
                         SkScalar radius, SkScalar invMiterLimit, bool, bool) {
     SkScalar    dotProd = SkPoint::DotProduct(beforeUnitNormal, afterUnitNormal);
@@ -134,7 +141,8 @@ static void RoundJoiner(SkPath* outer, SkPath* inner, const SkVector& beforeUnit
 
 #define kOneOverSqrt2   (0.707106781f)
 
-static void MiterJoiner(SkPath* outer, SkPath* inner, const SkVector& beforeUnitNormal,
+template <typename Path>
+static void MiterJoiner(Path* outer, Path* inner, const SkVector& beforeUnitNormal,
                         const SkPoint& pivot, const SkVector& afterUnitNormal,
                         SkScalar radius, SkScalar invMiterLimit,
                         bool prevIsLine, bool currIsLine) {
@@ -218,7 +226,7 @@ DO_BLUNT:
 
 SkStrokerPriv::CapProc SkStrokerPriv::CapFactory(SkPaint::Cap cap) {
     const SkStrokerPriv::CapProc gCappers[] = {
-        ButtCapper, RoundCapper, SquareCapper
+        ButtCapper<SkPath>, RoundCapper<SkPath>, SquareCapper<SkPath>
     };
 
     SkASSERT((unsigned)cap < SkPaint::kCapCount);
@@ -227,9 +235,123 @@ SkStrokerPriv::CapProc SkStrokerPriv::CapFactory(SkPaint::Cap cap) {
 
 SkStrokerPriv::JoinProc SkStrokerPriv::JoinFactory(SkPaint::Join join) {
     const SkStrokerPriv::JoinProc gJoiners[] = {
-        MiterJoiner, RoundJoiner, BluntJoiner
+        MiterJoiner<SkPath>, RoundJoiner<SkPath>, BluntJoiner<SkPath>
     };
 
     SkASSERT((unsigned)join < SkPaint::kJoinCount);
     return gJoiners[join];
 }
+
+SkStrokerPriv::CapProcT<SkStrokerPriv::PathBuffer> SkStrokerPriv::BufferCapFactory(
+        SkPaint::Cap cap) {
+    const SkStrokerPriv::CapProcT<PathBuffer> gCappers[] = {
+        ButtCapper<PathBuffer>, RoundCapper<PathBuffer>, SquareCapper<PathBuffer>
+    };
+
+    SkASSERT((unsigned)cap < SkPaint::kCapCount);
+    return gCappers[cap];
+}
+
+SkStrokerPriv::JoinProcT<SkStrokerPriv::PathBuffer> SkStrokerPriv::BufferJoinFactory(
+        SkPaint::Join join) {
+    const SkStrokerPriv::JoinProcT<PathBuffer> gJoiners[] = {
+        MiterJoiner<PathBuffer>, RoundJoiner<PathBuffer>, BluntJoiner<PathBuffer>
+    };
+
+    SkASSERT((unsigned)join < SkPaint::kJoinCount);
+    return gJoiners[join];
+}
+
+/////////////////////////////////////////////////////////////////////////////
+
+void SkStrokerPriv::PathBuffer::conicTo(const SkPoint& pt1, const SkPoint& pt2, SkScalar w) {
+    // check for <= 0 or NaN with this test
+    if (!(w > 0)) {
+        this->lineTo(pt2);
+    } else if (!SkScalarIsFinite(w)) {
+        this->lineTo(pt1);
+        this->lineTo(pt2);
+    } else if (SK_Scalar1 == w) {
+        fPts.push_back(pt1);
+        fPts.push_back(pt2);
+        fVerbs.push_back((uint8_t)SkPath::kQuad_Verb);
+        fSegmentMask |= SkPath::kQuad_SegmentMask;
+    } else {
+        fPts.push_back(pt1);
+        fPts.push_back(pt2);
+        fVerbs.push_back((uint8_t)SkPath::kConic_Verb);
+        fConicWeights.push_back(w);
+        fSegmentMask |= SkPath::kConic_SegmentMask;
+    }
+}
+
+void SkStrokerPriv::PathBuffer::reversePathTo(const PathBuffer& src) {
+    if (src.fVerbs.empty()) {
+        return;
+    }
+    SkASSERT(src.fVerbs.front() == (uint8_t)SkPath::kMove_Verb);
+    const uint8_t* verbs = src.fVerbs.end();
+    const SkPoint* pts = src.fPts.end() - 1;
+    const SkScalar* conicWeights = src.fConicWeights.end();
+
+    while (verbs > src.fVerbs.begin()) {
+        uint8_t v = *--verbs;
+        pts -= SkPathPriv::PtsInVerb(v);
+        switch (v) {
+            case SkPath::kMove_Verb:
+                // if the path has multiple contours, stop after reversing the last
+                return;
+            case SkPath::kLine_Verb:
+                this->lineTo(pts[0]);
+                break;
+            case SkPath::kQuad_Verb:
+                this->conicTo(pts[1], pts[0], SK_Scalar1);
+                break;
+            case SkPath::kConic_Verb:
+                this->conicTo(pts[1], pts[0], *--conicWeights);
+                break;
+            case SkPath::kClose_Verb:
+                break;
+            default:
+                SkDEBUGFAIL("unexpected verb");
+                break;
+        }
+    }
+}
+
+bool SkStrokerPriv::PathBuffer::isZeroLengthSincePoint(int startPtIndex) const {
+    int count = fPts.size() - startPtIndex;
+    if (count < 2) {
+        return true;
+    }
+    const SkPoint* pts = fPts.begin() + startPtIndex;
+    for (int index = 1; index < count; ++index) {
+        if (pts[0] != pts[index]) {
+            return false;
+        }
+    }
+    return true;
+}
+
+SkRect SkStrokerPriv::PathBuffer::getBounds() const {
+    SkRect bounds;
+    bounds.setBounds(fPts.begin(), fPts.size());
+    return bounds;
+}
+
+void SkStrokerPriv::PathBuffer::swap(PathBuffer& that) {
+    using std::swap;
+    fPts.swap(that.fPts);
+    fVerbs.swap(that.fVerbs);
+    fConicWeights.swap(that.fConicWeights);
+    swap(fSegmentMask, that.fSegmentMask);
+    swap(fLastMoveIndex, that.fLastMoveIndex);
+}
+
+SkPath SkStrokerPriv::PathBuffer::detach() {
+    SkPath path = SkPathPriv::MakeFromArrays(std::move(fPts), std::move(fVerbs),
+                                             std::move(fConicWeights),
+                                             fSegmentMask, fLastMoveIndex, /*isVolatile=*/true);
+    this->rewind();
+    return path;
+}
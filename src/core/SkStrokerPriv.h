@@ -9,6 +9,7 @@
 #ifndef SkStrokerPriv_DEFINED
 #define SkStrokerPriv_DEFINED
 
+#include "include/private/SkPathRef.h"
 #include "src/core/SkStroke.h"
 
 #define CWX(x, y)   (-y)
@@ -23,21 +24,96 @@
 
 class SkStrokerPriv {
 public:
-    typedef void (*CapProc)(SkPath* path,
-                            const SkPoint& pivot,
-                            const SkVector& normal,
-                            const SkPoint& stop,
-                            SkPath* otherPath);
-
-    typedef void (*JoinProc)(SkPath* outer, SkPath* inner,
-                             const SkVector& beforeUnitNormal,
-                             const SkPoint& pivot,
-                             const SkVector& afterUnitNormal,
-                             SkScalar radius, SkScalar invMiterLimit,
-                             bool prevIsLine, bool currIsLine);
+    /**
+     *  Collects the stroke of a path made only of lines. It supports just the edits that the
+     *  cappers and joiners make, skips the bookkeeping SkPath does on every edit, and hands its
+     *  storage to the final path without copying it.
+     */
+    class PathBuffer {
+    public:
+        void incReserve(int extraPtCount) {
+            fPts.reserve_back(extraPtCount);
+            fVerbs.reserve_back(extraPtCount);
+        }
+
+        void moveTo(SkScalar x, SkScalar y) {
+            fLastMoveIndex = fPts.size();
+            fPts.push_back({x, y});
+            fVerbs.push_back((uint8_t)SkPath::kMove_Verb);
+        }
+        void lineTo(SkScalar x, SkScalar y) {
+            fPts.push_back({x, y});
+            fVerbs.push_back((uint8_t)SkPath::kLine_Verb);
+            fSegmentMask |= SkPath::kLine_SegmentMask;
+        }
+        void lineTo(const SkPoint& pt) { this->lineTo(pt.fX, pt.fY); }
+        // Same as SkPath::conicTo(), including its handling of degenerate weights.
+        void conicTo(const SkPoint& pt1, const SkPoint& pt2, SkScalar w);
+        void close() {
+            if (!fVerbs.empty() && fVerbs.back() != (uint8_t)SkPath::kClose_Verb) {
+                fVerbs.push_back((uint8_t)SkPath::kClose_Verb);
+            }
+        }
+        // Appends the last contour of 'src', from back to front.
+        void reversePathTo(const PathBuffer& src);
+
+        void setLastPt(SkScalar x, SkScalar y) { fPts.back().set(x, y); }
+        bool getLastPt(SkPoint* pt) const {
+            if (fPts.empty()) {
+                return false;
+            }
+            *pt = fPts.back();
+            return true;
+        }
+
+        int countPoints() const { return fPts.size(); }
+        bool isZeroLengthSincePoint(int startPtIndex) const;
+        SkRect getBounds() const;
+
+        void rewind() {
+            fPts.clear();
+            fVerbs.clear();
+            fConicWeights.clear();
+            fSegmentMask = 0;
+            fLastMoveIndex = -1;
+        }
+        void swap(PathBuffer& that);
+
+        // Moves the contents to a volatile path, like those SkPathStroker builds, and rewinds.
+        SkPath detach();
+
+    private:
+        SkPathRef::PointsArray       fPts;
+        SkPathRef::VerbsArray        fVerbs;
+        SkPathRef::ConicWeightsArray fConicWeights;
+        unsigned                     fSegmentMask = 0;
+        int                          fLastMoveIndex = -1;
+    };
+
+    template <typename Path>
+    using CapProcT = void (*)(Path* path,
+                              const SkPoint& pivot,
+                              const SkVector& normal,
+                              const SkPoint& stop,
+                              Path* otherPath);
+
+    template <typename Path>
+    using JoinProcT = void (*)(Path* outer, Path* inner,
+                               const SkVector& beforeUnitNormal,
+                               const SkPoint& pivot,
+                               const SkVector& afterUnitNormal,
+                               SkScalar radius, SkScalar invMiterLimit,
+                               bool prevIsLine, bool currIsLine);
+
+    typedef CapProcT<SkPath>  CapProc;
+    typedef JoinProcT<SkPath> JoinProc;
 
     static CapProc  CapFactory(SkPaint::Cap);
     static JoinProc JoinFactory(SkPaint::Join);
+
+    // The same cappers and joiners, writing to PathBuffers.
+    static CapProcT<PathBuffer>  BufferCapFactory(SkPaint::Cap);
+    static JoinProcT<PathBuffer> BufferJoinFactory(SkPaint::Join);
 };
 
 #endif
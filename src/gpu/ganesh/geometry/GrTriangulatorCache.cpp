@@ -0,0 +1,191 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/core/SkData.h"
+#include "include/core/SkPath.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkTypes.h"
+#include "include/private/SkIDChangeListener.h"
+#include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
+#include "src/gpu/ganesh/GrEagerVertexAllocator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulator.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#define CHECK_LOCAL(localCache, localName, globalName, ...) \
+    ((localCache) ? localCache->localName(__VA_ARGS__) : SkResourceCache::globalName(__VA_ARGS__))
+
+namespace {
+static unsigned gTriangulatorKeyNamespaceLabel;
+
+// Paths without curves triangulate the same way at every tolerance.
+constexpr int32_t kLinearToleranceBucket = std::numeric_limits<int32_t>::min();
+
+uint64_t make_shared_id(uint32_t pathGenID) {
+    uint64_t sharedID = SkSetFourByteTag('t', 'r', 'i', 's');
+    return (sharedID << 32) | pathGenID;
+}
+
+// Tolerances are bucketed by half octaves. Every tolerance in a bucket is served by the
+// triangulation at the bucket's smallest tolerance.
+int32_t tolerance_bucket(const SkPath& path, SkScalar tolerance) {
+    if (path.getSegmentMasks() == SkPath::kLine_SegmentMask) {
+        return kLinearToleranceBucket;
+    }
+    return (int32_t)std::floor(2 * std::log2(tolerance));
+}
+
+SkScalar bucket_tolerance(int32_t bucket) {
+    return std::exp2(bucket * 0.5f);
+}
+
+struct TriangulatorKey : public SkResourceCache::Key {
+    TriangulatorKey(uint32_t genID, int32_t toleranceBucket, const SkRect& clipBounds)
+            : fGenID(genID)
+            , fToleranceBucket(toleranceBucket)
+            , fClipBounds(clipBounds) {
+        this->init(&gTriangulatorKeyNamespaceLabel, make_shared_id(genID),
+                   sizeof(fGenID) + sizeof(fToleranceBucket) + sizeof(fClipBounds));
+    }
+
+    uint32_t fGenID;
+    int32_t  fToleranceBucket;
+    SkRect   fClipBounds;  // Empty unless the path is inverse filled.
+};
+
+struct Triangles {
+    sk_sp<SkData> fVertices;
+    size_t        fStride = 0;
+    int           fVertexCount = 0;
+    bool          fIsLinear = false;
+};
+
+struct TriangulatorRec : public SkResourceCache::Rec {
+    TriangulatorRec(const TriangulatorKey& key, const Triangles& triangles)
+            : fKey(key), fTriangles(triangles) {}
+
+    TriangulatorKey fKey;
+    Triangles       fTriangles;
+
+    const Key& getKey() const override { return fKey; }
+    size_t bytesUsed() const override { return sizeof(*this) + fTriangles.fVertices->size(); }
+    const char* getCategory() const override { return "triangulated-path"; }
+
+    static bool Visitor(const SkResourceCache::Rec& baseRec, void* contextData) {
+        const TriangulatorRec& rec = static_cast<const TriangulatorRec&>(baseRec);
+        *static_cast<Triangles*>(contextData) = rec.fTriangles;
+        return true;
+    }
+};
+
+// Purges every cached triangulation of a path when its generation ID changes.
+class TriangulationInvalidator : public SkIDChangeListener {
+public:
+    explicit TriangulationInvalidator(uint64_t sharedID) : fSharedID(sharedID) {}
+
+private:
+    uint64_t fSharedID;
+
+    void changed() override { SkResourceCache::PostPurgeSharedID(fSharedID); }
+};
+
+// Forwards to the caller's allocator, keeping a copy of the vertices it is given.
+class RecordingVertexAllocator : public GrEagerVertexAllocator {
+public:
+    explicit RecordingVertexAllocator(GrEagerVertexAllocator* target) : fTarget(target) {}
+
+    void* lock(size_t stride, int eagerCount) override {
+        fStride = stride;
+        fVertices = fTarget->lock(stride, eagerCount);
+        return fVertices;
+    }
+
+    void unlock(int actualCount) override {
+        if (fVertices) {
+            fTriangles.fVertices = SkData::MakeWithCopy(fVertices, actualCount * fStride);
+            fTriangles.fStride = fStride;
+            fTriangles.fVertexCount = actualCount;
+        }
+        fVertices = nullptr;
+        fTarget->unlock(actualCount);
+    }
+
+    Triangles fTriangles;
+
+private:
+    GrEagerVertexAllocator* fTarget;
+    void* fVertices = nullptr;
+    size_t fStride = 0;
+};
+
+bool is_cacheable(const SkPath& path, SkScalar tolerance) {
+    return !path.isVolatile() && path.isFinite() && std::isfinite(tolerance) && tolerance > 0;
+}
+
+TriangulatorKey make_key(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds) {
+    return TriangulatorKey(path.getGenerationID(),
+                           tolerance_bucket(path, tolerance),
+                           path.isInverseFillType() ? clipBounds : SkRect::MakeEmpty());
+}
+} // namespace
+
+int GrTriangulatorCache::Find(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                              GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                              SkResourceCache* localCache) {
+    if (!is_cacheable(path, tolerance)) {
+        return 0;
+    }
+    TriangulatorKey key = make_key(path, tolerance, clipBounds);
+    Triangles triangles;
+    if (!CHECK_LOCAL(localCache, find, Find, key, TriangulatorRec::Visitor, &triangles)) {
+        return 0;
+    }
+    void* vertices = vertexAllocator->lock(triangles.fStride, triangles.fVertexCount);
+    if (!vertices) {
+        return 0;
+    }
+    memcpy(vertices, triangles.fVertices->data(), triangles.fVertices->size());
+    vertexAllocator->unlock(triangles.fVertexCount);
+    *isLinear = triangles.fIsLinear;
+    return triangles.fVertexCount;
+}
+
+int GrTriangulatorCache::PathToTriangles(const SkPath& path, SkScalar tolerance,
+                                         const SkRect& clipBounds,
+                                         GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                                         SkResourceCache* localCache) {
+    if (!is_cacheable(path, tolerance)) {
+        return GrTriangulator::PathToTriangles(path, tolerance, clipBounds, vertexAllocator,
+                                               isLinear);
+    }
+    if (int count = Find(path, tolerance, clipBounds, vertexAllocator, isLinear, localCache)) {
+        return count;
+    }
+    TriangulatorKey key = make_key(path, tolerance, clipBounds);
+    SkScalar bucketTolerance = key.fToleranceBucket == kLinearToleranceBucket
+                                       ? tolerance
+                                       : bucket_tolerance(key.fToleranceBucket);
+    RecordingVertexAllocator recorder(vertexAllocator);
+    int count = GrTriangulator::PathToTriangles(path, bucketTolerance, clipBounds, &recorder,
+                                                isLinear);
+    if (count > 0 && recorder.fTriangles.fVertices) {
+        recorder.fTriangles.fIsLinear = *isLinear;
+        CHECK_LOCAL(localCache, add, Add, new TriangulatorRec(key, recorder.fTriangles));
+        SkPathPriv::AddGenIDChangeListener(
+                path, sk_make_sp<TriangulationInvalidator>(key.getSharedID()));
+    }
+    return count;
+}
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
@@ -0,0 +1,50 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#ifndef GrTriangulatorCache_DEFINED
+#define GrTriangulatorCache_DEFINED
+
+#if !defined(SK_ENABLE_OPTIMIZE_SIZE)
+
+#include "include/core/SkScalar.h"
+
+class GrEagerVertexAllocator;
+class SkPath;
+class SkResourceCache;
+struct SkRect;
+
+/**
+ * A CPU-side cache of GrTriangulator::PathToTriangles results, shared by every context in the
+ * process. Triangle lists are keyed by the path's generation ID and a tolerance bucket (plus the
+ * clip bounds, for inverse fills), and are purged when the path is modified or deleted. A path
+ * with no curves shares one entry across all tolerances.
+ *
+ * Entries live in the global SkResourceCache unless a local cache is given.
+ */
+class GrTriangulatorCache {
+public:
+    /**
+     * Same as GrTriangulator::PathToTriangles, but returns a copy of the cached triangles if the
+     * path has been triangulated at a compatible tolerance before, and caches the triangles
+     * otherwise. The triangulation is never coarser than the requested tolerance.
+     */
+    static int PathToTriangles(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                               GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                               SkResourceCache* localCache = nullptr);
+
+    /**
+     * Writes the cached triangles for the path to the allocator and returns their vertex count,
+     * or returns 0 if there are none.
+     */
+    static int Find(const SkPath& path, SkScalar tolerance, const SkRect& clipBounds,
+                    GrEagerVertexAllocator* vertexAllocator, bool* isLinear,
+                    SkResourceCache* localCache = nullptr);
+};
+
+#endif // SK_ENABLE_OPTIMIZE_SIZE
+
+#endif // GrTriangulatorCache_DEFINED
@@ -28,6 +28,7 @@
 #include "src/gpu/ganesh/geometry/GrPathUtils.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/gpu/ganesh/ops/GrMeshDrawOp.h"
 #include "src/gpu/ganesh/ops/GrSimpleMeshDrawOpHelperWithStencil.h"
 
@@ -282,7 +283,9 @@ private:
         SkPath path;
         shape.asPath(&path);
 
-        return GrTriangulator::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
+        // The triangles are in the path's own space, so other contexts that draw this path (and
+        // this one, once its vertex buffer has been purged) can reuse them.
+        return GrTriangulatorCache::PathToTriangles(path, tol, clipBounds, allocator, isLinear);
     }
 
     void createNonAAMesh(GrMeshDrawTarget* target) {
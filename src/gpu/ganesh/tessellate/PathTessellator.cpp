@@ -25,6 +25,53 @@ namespace {
 
 using namespace skgpu::tess;
 
+// Collects runs of consecutive quadratics or cubics, mapped by the path matrix, so that PatchWriter
+// can evaluate Wang's formula for a batch of them at once. Callers flush() before writing anything
+// else, so patches are still written in path order.
+template <typename Writer>
+class CurveRun {
+public:
+    explicit CurveRun(Writer* writer) : fWriter(writer) {}
+
+    void addQuadratic(const AffineMatrix& m, const SkPoint pts[3]) {
+        SkPoint* dst = this->append(SkPathVerb::kQuad, 3);
+        m.map2Points(pts).store(dst);
+        m.map1Point(pts+2).store(dst + 2);
+    }
+
+    void addCubic(const AffineMatrix& m, const SkPoint pts[4]) {
+        SkPoint* dst = this->append(SkPathVerb::kCubic, 4);
+        m.map2Points(pts).store(dst);
+        m.map2Points(pts+2).store(dst + 2);
+    }
+
+    void flush() {
+        if (fCount == 0) {
+            return;
+        }
+        if (fVerb == SkPathVerb::kQuad) {
+            fWriter->writeQuadratics(fPts, fCount);
+        } else {
+            fWriter->writeCubics(fPts, fCount);
+        }
+        fCount = 0;
+    }
+
+private:
+    SkPoint* append(SkPathVerb verb, int ptsPerCurve) {
+        if (verb != fVerb || fCount == Writer::kCurveBatchSize) {
+            this->flush();
+            fVerb = verb;
+        }
+        return fPts + ptsPerCurve * fCount++;
+    }
+
+    Writer*    fWriter;
+    SkPathVerb fVerb = SkPathVerb::kCubic;
+    int        fCount = 0;
+    SkPoint    fPts[Writer::kCurveBatchSize * 4];
+};
+
 using CurveWriter = PatchWriter<VertexChunkPatchAllocator,
                                 Optional<PatchAttribs::kColor>,
                                 Optional<PatchAttribs::kWideColorIfEnabled>,
@@ -36,18 +83,17 @@ void write_curve_patches(CurveWriter&& patchWriter,
                          const SkMatrix& shaderMatrix,
                          const PathTessellator::PathDrawList& pathDrawList) {
     patchWriter.setShaderTransform(wangs_formula::VectorXform{shaderMatrix});
+    CurveRun curves(&patchWriter);
     for (auto [pathMatrix, path, color] : pathDrawList) {
         AffineMatrix m(pathMatrix);
         if (patchWriter.attribs() & PatchAttribs::kColor) {
+            curves.flush();
             patchWriter.updateColorAttrib(color);
         }
         for (auto [verb, pts, w] : SkPathPriv::Iterate(path)) {
             switch (verb) {
                 case SkPathVerb::kQuad: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto p2 = m.map1Point(pts+2);
-
-                    patchWriter.writeQuadratic(p0, p1, p2);
+                    curves.addQuadratic(m, pts);
                     break;
                 }
 
@@ -55,15 +101,13 @@ void write_curve_patches(CurveWriter&& patchWriter,
                     auto [p0, p1] = m.map2Points(pts);
                     auto p2 = m.map1Point(pts+2);
 
+                    curves.flush();
                     patchWriter.writeConic(p0, p1, p2, *w);
                     break;
                 }
 
                 case SkPathVerb::kCubic: {
-                    auto [p0, p1] = m.map2Points(pts);
-                    auto [p2, p3] = m.map2Points(pts+2);
-
-                    patchWriter.writeCubic(p0, p1, p2, p3);
+                    curves.addCubic(m, pts);
                     break;
                 }
 
@@ -71,6 +115,7 @@ void write_curve_patches(CurveWriter&& patchWriter,
             }
         }
     }
+    curves.flush();
 }
 
 using WedgeWriter = PatchWriter<VertexChunkPatchAllocator,
@@ -83,6 +128,7 @@ void write_wedge_patches(WedgeWriter&& patchWriter,
                          const SkMatrix& shaderMatrix,
                          const PathTessellator::PathDrawList& pathDrawList) {
     patchWriter.setShaderTransform(wangs_formula::VectorXform{shaderMatrix});
+    CurveRun curves(&patchWriter);
     for (auto [pathMatrix, path, color] : pathDrawList) {
         AffineMatrix m(pathMatrix);
         if (patchWriter.attribs() & PatchAttribs::kColor) {
@@ -103,16 +149,14 @@ void write_wedge_patches(WedgeWriter&& patchWriter,
                     case SkPathVerb::kLine: {
                         // Explicitly convert the line to an equivalent cubic w/ four distinct
                         // control points because it fans better and avoids double-hitting pixels.
+                        curves.flush();
                         patchWriter.writeLine(m.map2Points(pts));
                         lastPoint = pts[1];
                         break;
                     }
 
                     case SkPathVerb::kQuad: {
-                        auto [p0, p1] = m.map2Points(pts);
-                        auto p2 = m.map1Point(pts+2);
-
-                        patchWriter.writeQuadratic(p0, p1, p2);
+                        curves.addQuadratic(m, pts);
                         lastPoint = pts[2];
                         break;
                     }
@@ -121,16 +165,14 @@ void write_wedge_patches(WedgeWriter&& patchWriter,
                         auto [p0, p1] = m.map2Points(pts);
                         auto p2 = m.map1Point(pts+2);
 
+                        curves.flush();
                         patchWriter.writeConic(p0, p1, p2, *w);
                         lastPoint = pts[2];
                         break;
                     }
 
                     case SkPathVerb::kCubic: {
-                        auto [p0, p1] = m.map2Points(pts);
-                        auto [p2, p3] = m.map2Points(pts+2);
-
-                        patchWriter.writeCubic(p0, p1, p2, p3);
+                        curves.addCubic(m, pts);
                         lastPoint = pts[3];
                         break;
                     }
@@ -140,6 +182,8 @@ void write_wedge_patches(WedgeWriter&& patchWriter,
                     }
                 }
             }
+            // The next contour has its own fan point.
+            curves.flush();
             if (lastPoint != startPoint) {
                 SkPoint pts[2] = {lastPoint, startPoint};
                 patchWriter.writeLine(m.map2Points(pts));
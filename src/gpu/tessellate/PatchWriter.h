@@ -15,6 +15,7 @@
 #include "src/gpu/tessellate/Tessellation.h"
 #include "src/gpu/tessellate/WangsFormula.h"
 
+#include <algorithm>
 #include <type_traits>
 #include <variant>
 
@@ -379,18 +380,7 @@ public:
     // Write a cubic curve with its four control points.
     AI void writeCubic(float2 p0, float2 p1, float2 p2, float2 p3) {
         float n4 = wangs_formula::cubic_p4(kPrecision, p0, p1, p2, p3, fApproxTransform);
-        if constexpr (kDiscardFlatCurves) {
-            if (n4 <= 1.f) {
-                // This cubic only needs one segment (e.g. a line) but we're not filling space with
-                // fans or stroking, so nothing actually needs to be drawn.
-                return;
-            }
-        }
-        if (int numPatches = this->accountForCurve(n4)) {
-            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
-        } else {
-            this->writeCubicPatch(p0, p1, p2, p3);
-        }
+        this->writeCubic(p0, p1, p2, p3, n4);
     }
     AI void writeCubic(const SkPoint pts[4]) {
         float4 p0p1 = float4::Load(pts);
@@ -398,6 +388,26 @@ public:
         this->writeCubic(p0p1.lo, p0p1.hi, p2p3.lo, p2p3.hi);
     }
 
+    // Number of curves whose Wang's formula values writeCubics() and writeQuadratics() compute
+    // before writing any of them.
+    static constexpr int kCurveBatchSize = 8 * wangs_formula::kBatchWidth;
+
+    // Write 'count' cubics stored back to back in 'pts' (4 points each). Wang's formula is
+    // evaluated for a batch of cubics at a time before they are chopped and written.
+    void writeCubics(const SkPoint pts[], int count) {
+        float n4[kCurveBatchSize];
+        for (int i = 0; i < count; i += kCurveBatchSize) {
+            int batchCount = std::min(count - i, kCurveBatchSize);
+            const SkPoint* batch = pts + i*4;
+            wangs_formula::cubic_p4(kPrecision, batch, batchCount, n4, fApproxTransform);
+            for (int j = 0; j < batchCount; ++j) {
+                float4 p0p1 = float4::Load(batch + j*4);
+                float4 p2p3 = float4::Load(batch + j*4 + 2);
+                this->writeCubic(p0p1.lo, p0p1.hi, p2p3.lo, p2p3.hi, n4[j]);
+            }
+        }
+    }
+
     // Write a conic curve with three control points and 'w', with the last coord of the last
     // control point signaling a conic by being set to infinity.
     AI void writeConic(float2 p0, float2 p1, float2 p2, float w) {
@@ -426,18 +436,7 @@ public:
     // equivalent cubic.
     AI void writeQuadratic(float2 p0, float2 p1, float2 p2) {
         float n4 = wangs_formula::quadratic_p4(kPrecision, p0, p1, p2, fApproxTransform);
-        if constexpr (kDiscardFlatCurves) {
-            if (n4 <= 1.f) {
-                // This quad only needs one segment (e.g. a line) but we're not filling space with
-                // fans or stroking, so nothing actually needs to be drawn.
-                return;
-            }
-        }
-        if (int numPatches = this->accountForCurve(n4)) {
-            this->chopAndWriteQuads(p0, p1, p2, numPatches);
-        } else {
-            this->writeQuadPatch(p0, p1, p2);
-        }
+        this->writeQuadratic(p0, p1, p2, n4);
     }
     AI void writeQuadratic(const SkPoint pts[3]) {
         this->writeQuadratic(skvx::bit_pun<float2>(pts[0]),
@@ -445,6 +444,23 @@ public:
                              skvx::bit_pun<float2>(pts[2]));
     }
 
+    // Write 'count' quadratics stored back to back in 'pts' (3 points each). Wang's formula is
+    // evaluated for a batch of quadratics at a time before they are chopped and written.
+    void writeQuadratics(const SkPoint pts[], int count) {
+        float n4[kCurveBatchSize];
+        for (int i = 0; i < count; i += kCurveBatchSize) {
+            int batchCount = std::min(count - i, kCurveBatchSize);
+            const SkPoint* batch = pts + i*3;
+            wangs_formula::quadratic_p4(kPrecision, batch, batchCount, n4, fApproxTransform);
+            for (int j = 0; j < batchCount; ++j) {
+                this->writeQuadratic(skvx::bit_pun<float2>(batch[j*3]),
+                                     skvx::bit_pun<float2>(batch[j*3 + 1]),
+                                     skvx::bit_pun<float2>(batch[j*3 + 2]),
+                                     n4[j]);
+            }
+        }
+    }
+
     // Write a line that is automatically converted into an equivalent cubic.
     AI void writeLine(float4 p0p1) {
         // No chopping needed, a line only ever requires one segment (the minimum required already).
@@ -495,6 +511,36 @@ public:
     }
 
 private:
+    // Writes a cubic or quadratic whose Wang's formula value (raised to the 4th power) is known.
+    AI void writeCubic(float2 p0, float2 p1, float2 p2, float2 p3, float n4) {
+        if constexpr (kDiscardFlatCurves) {
+            if (n4 <= 1.f) {
+                // This cubic only needs one segment (e.g. a line) but we're not filling space with
+                // fans or stroking, so nothing actually needs to be drawn.
+                return;
+            }
+        }
+        if (int numPatches = this->accountForCurve(n4)) {
+            this->chopAndWriteCubics(p0, p1, p2, p3, numPatches);
+        } else {
+            this->writeCubicPatch(p0, p1, p2, p3);
+        }
+    }
+    AI void writeQuadratic(float2 p0, float2 p1, float2 p2, float n4) {
+        if constexpr (kDiscardFlatCurves) {
+            if (n4 <= 1.f) {
+                // This quad only needs one segment (e.g. a line) but we're not filling space with
+                // fans or stroking, so nothing actually needs to be drawn.
+                return;
+            }
+        }
+        if (int numPatches = this->accountForCurve(n4)) {
+            this->chopAndWriteQuads(p0, p1, p2, numPatches);
+        } else {
+            this->writeQuadPatch(p0, p1, p2);
+        }
+    }
+
     AI void emitPatchAttribs(VertexWriter vertexWriter,
                              const JoinAttrib& join,
                              float explicitCurveType) {
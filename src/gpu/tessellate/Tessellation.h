@@ -121,6 +121,31 @@ constexpr size_t PatchStride(PatchAttribs attribs) {
 // point(s) occurred at 180-degree turnaround points on a degenerate flat line.
 int FindCubicConvex180Chops(const SkPoint[], float T[2], bool* areCusps);
 
+// Loads 8 cubics stored back to back in 'pts' (4 points each), transposed so that lane k of x[j]
+// and y[j] holds point j of cubic k.
+SK_ALWAYS_INLINE void LoadTransposedCubics(const SkPoint pts[],
+                                           skvx::float8 x[4],
+                                           skvx::float8 y[4]) {
+    // Each strided load transposes 4 cubics into lanes of {x0,x2}, {y0,y2}, {x1,x3}, {y1,y3}.
+    skvx::float8 lo[4], hi[4];
+    skvx::strided_load4(&pts[0].fX, lo[0], lo[1], lo[2], lo[3]);
+    skvx::strided_load4(&pts[16].fX, hi[0], hi[1], hi[2], hi[3]);
+    auto even = [](skvx::float8 a, skvx::float8 b) {
+        return skvx::shuffle<0,2,4,6,8,10,12,14>(join(a, b));
+    };
+    auto odd = [](skvx::float8 a, skvx::float8 b) {
+        return skvx::shuffle<1,3,5,7,9,11,13,15>(join(a, b));
+    };
+    x[0] = even(lo[0], hi[0]);
+    x[2] = odd(lo[0], hi[0]);
+    y[0] = even(lo[1], hi[1]);
+    y[2] = odd(lo[1], hi[1]);
+    x[1] = even(lo[2], hi[2]);
+    x[3] = odd(lo[2], hi[2]);
+    y[1] = even(lo[3], hi[3]);
+    y[3] = odd(lo[3], hi[3]);
+}
+
 // Returns true if the given conic (or quadratic) has a cusp point. The w value is not necessary in
 // determining this. If there is a cusp, it can be found at the midtangent.
 inline bool ConicHasCusp(const SkPoint p[3]) {
@@ -87,6 +87,13 @@ public:
         return join(fC0 * vectors.x() + fC1 * vectors.y(),
                     fC0 * vectors.z() + fC1 * vectors.w());
     }
+    // Transforms N vectors at once, given as separate lanes of x and y components.
+    template <int N>
+    AI void operator()(skvx::Vec<N,float>* x, skvx::Vec<N,float>* y) const {
+        skvx::Vec<N,float> tx = fC0[0] * *x + fC1[0] * *y;
+        *y = fC0[1] * *x + fC1[1] * *y;
+        *x = tx;
+    }
 private:
     // First and second columns of 2x2 matrix
     skvx::float2 fC0;
@@ -167,6 +174,66 @@ AI int cubic_log2(float precision,
     return nextlog16(cubic_p4(precision, pts, vectorXform));
 }
 
+// Number of curves the batch versions of quadratic_p4 and cubic_p4 evaluate per SIMD iteration.
+constexpr static int kBatchWidth = 8;
+
+// Computes quadratic_p4 for 'count' quadratics stored back to back in 'pts' (3 points each), and
+// writes the results to 'p4'. Curves are transposed so each SIMD lane evaluates one curve.
+inline void quadratic_p4(float precision,
+                         const SkPoint pts[],
+                         int count,
+                         float p4[],
+                         const VectorXform& vectorXform = VectorXform()) {
+    using floatN = skvx::Vec<kBatchWidth, float>;
+    int i = 0;
+    for (; i + kBatchWidth <= count; i += kBatchWidth) {
+        float xy[2][3][kBatchWidth];
+        for (int k = 0; k < kBatchWidth; ++k) {
+            for (int j = 0; j < 3; ++j) {
+                xy[0][j][k] = pts[(i + k)*3 + j].fX;
+                xy[1][j][k] = pts[(i + k)*3 + j].fY;
+            }
+        }
+        floatN x[3], y[3];
+        for (int j = 0; j < 3; ++j) {
+            x[j] = floatN::Load(xy[0][j]);
+            y[j] = floatN::Load(xy[1][j]);
+        }
+        floatN vx = -2*x[1] + x[0] + x[2];
+        floatN vy = -2*y[1] + y[0] + y[2];
+        vectorXform(&vx, &vy);
+        ((vx*vx + vy*vy) * length_term_p2<2>(precision)).store(p4 + i);
+    }
+    for (; i < count; ++i) {
+        p4[i] = quadratic_p4(precision, pts + i*3, vectorXform);
+    }
+}
+
+// Computes cubic_p4 for 'count' cubics stored back to back in 'pts' (4 points each), and writes
+// the results to 'p4'. Curves are transposed so each SIMD lane evaluates one curve.
+inline void cubic_p4(float precision,
+                     const SkPoint pts[],
+                     int count,
+                     float p4[],
+                     const VectorXform& vectorXform = VectorXform()) {
+    using floatN = skvx::Vec<kBatchWidth, float>;
+    int i = 0;
+    for (; i + kBatchWidth <= count; i += kBatchWidth) {
+        floatN x[4], y[4];
+        tess::LoadTransposedCubics(pts + i*4, x, y);
+        floatN v0x = -2*x[1] + x[0] + x[2];
+        floatN v0y = -2*y[1] + y[0] + y[2];
+        floatN v1x = -2*x[2] + x[1] + x[3];
+        floatN v1y = -2*y[2] + y[1] + y[3];
+        vectorXform(&v0x, &v0y);
+        vectorXform(&v1x, &v1y);
+        (max(v0x*v0x + v0y*v0y, v1x*v1x + v1y*v1y) * length_term_p2<3>(precision)).store(p4 + i);
+    }
+    for (; i < count; ++i) {
+        p4[i] = cubic_p4(precision, pts + i*4, vectorXform);
+    }
+}
+
 // Returns the maximum number of line segments a cubic with the given device-space bounding box size
 // would ever need to be divided into, raised to the 4th power. This is simply a special case of the
 // cubic formula where we maximize its value by placing control points on specific corners of the
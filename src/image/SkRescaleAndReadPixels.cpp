@@ -19,12 +19,30 @@
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkSamplingOptions.h"
 #include "include/core/SkSurface.h"
+#include "src/core/SkResample.h"
 
 #include <cmath>
 #include <cstddef>
 #include <memory>
 #include <utility>
 
+namespace {
+
+class Result : public SkImage::AsyncReadResult {
+public:
+    Result(std::unique_ptr<const char[]> data, size_t rowBytes)
+            : fData(std::move(data)), fRowBytes(rowBytes) {}
+    int count() const override { return 1; }
+    const void* data(int i) const override { return fData.get(); }
+    size_t rowBytes(int i) const override { return fRowBytes; }
+
+private:
+    std::unique_ptr<const char[]> fData;
+    size_t fRowBytes;
+};
+
+}  // namespace
+
 void SkRescaleAndReadPixels(SkBitmap bmp,
                             const SkImageInfo& resultInfo,
                             const SkIRect& srcRect,
@@ -53,10 +71,23 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
     SkPaint paint;
     paint.setBlendMode(SkBlendMode::kSrc);
     if (stepsX < 0 || stepsY < 0) {
+        // Downscale in one pass of SkResample's Mitchell filter, the same cubic kRepeatedCubic
+        // draws with, rather than falling back to the repeated bilinear draws below.
+        if (rescaleMode == SkImage::RescaleMode::kRepeatedCubic) {
+            SkPixmap src;
+            size_t rowBytes = resultInfo.minRowBytes();
+            std::unique_ptr<char[]> data(new char[resultInfo.height() * rowBytes]);
+            SkResample::Options options;
+            options.fLinear = rescaleGamma == SkImage::RescaleGamma::kLinear;
+            if (bmp.pixmap().extractSubset(&src, srcRect) &&
+                SkResample::Scale(src, SkPixmap(resultInfo, data.get(), rowBytes), options)) {
+                callback(context, std::make_unique<Result>(std::move(data), rowBytes));
+                return;
+            }
+        }
+
         // Don't trigger MIP generation. We don't currently have a way to trigger bicubic for
         // downscaling draws.
-
-        // TODO: should we trigger cubic now that we can?
         if (rescaleMode != SkImage::RescaleMode::kNearest) {
             rescaleMode = SkImage::RescaleMode::kRepeatedLinear;
         }
@@ -147,18 +178,6 @@ void SkRescaleAndReadPixels(SkBitmap bmp,
     std::unique_ptr<char[]> data(new char[resultInfo.height() * rowBytes]);
     SkPixmap pm(resultInfo, data.get(), rowBytes);
     if (srcImage->readPixels(nullptr, pm, srcX, srcY)) {
-        class Result : public SkImage::AsyncReadResult {
-        public:
-            Result(std::unique_ptr<const char[]> data, size_t rowBytes)
-                    : fData(std::move(data)), fRowBytes(rowBytes) {}
-            int count() const override { return 1; }
-            const void* data(int i) const override { return fData.get(); }
-            size_t rowBytes(int i) const override { return fRowBytes; }
-
-        private:
-            std::unique_ptr<const char[]> fData;
-            size_t fRowBytes;
-        };
         callback(context, std::make_unique<Result>(std::move(data), rowBytes));
     } else {
         callback(context, nullptr);
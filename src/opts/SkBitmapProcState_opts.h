@@ -12,11 +12,13 @@
 #include "src/base/SkVx.h"
 #include "src/core/SkBitmapProcState.h"
 
+#include <algorithm>
+
 // SkBitmapProcState optimized Shader, Sample, or Matrix procs.
 //
-// Only S32_alpha_D32_filter_DX exploits instructions beyond
-// our common baseline SSE2/NEON instruction sets, so that's
-// all that lives here.
+// Only S32_alpha_D32_filter_DX and the bicubic filters exploit
+// instructions beyond our common baseline SSE2/NEON instruction
+// sets, so that's all that lives here.
 //
 // The rest are scattershot at the moment but I want to get them
 // all migrated to be normal code inside SkBitmapProcState.cpp.
@@ -533,6 +535,58 @@ static void decode_packed_coordinates_and_weight(U32 packed, Out* v0, Out* v1, O
                                                        const uint32_t*, int, SkPMColor*) = nullptr;
 #endif
 
+// Bicubic filtering with a scale+translate matrix is separable. S32_bicubic_filter_rows() blends
+// the four source rows under a span into one row of unpacked float colors, one per column in
+// cols[]. S32_alpha_D32_bicubic_filter_cols() then blends four adjacent entries of that row, from
+// starts[i] on, for each pixel, with the weights for its fractional position tx[i]. Both work
+// on one whole 8888 pixel per skvx::float4, so they don't care about the channel order.
+/*not static*/ inline
+void S32_bicubic_filter_rows(const uint32_t* const rows[4], const float wy[4],
+                             const int cols[], int count, float out[]) {
+    auto load = [](const uint32_t* row, int col) {
+        return skvx::cast<float>(skvx::byte4::Load(row + col));
+    };
+    while (count --> 0) {
+        const int col = *cols++;
+        skvx::float4 c = load(rows[0], col) * wy[0]
+                       + load(rows[1], col) * wy[1]
+                       + load(rows[2], col) * wy[2]
+                       + load(rows[3], col) * wy[3];
+        c.store(out);
+        out += 4;
+    }
+}
+
+/*not static*/ inline
+void S32_alpha_D32_bicubic_filter_cols(const float row[], const int starts[], const float tx[],
+                                       int count, const float weights[16], float alpha,
+                                       SkPMColor colors[]) {
+    // weights is the column-major cubic resampler matrix, giving each tap's weight as a cubic
+    // polynomial in tx.
+    const auto w0 = skvx::float4::Load(weights +  0),
+               w1 = skvx::float4::Load(weights +  4),
+               w2 = skvx::float4::Load(weights +  8),
+               w3 = skvx::float4::Load(weights + 12);
+    constexpr int kA = SK_A32_SHIFT / 8;
+
+    while (count --> 0) {
+        const float t = *tx++;
+        const skvx::float4 w = w0 + t*(w1 + t*(w2 + t*w3));
+
+        const float* p = row + 4 * *starts++;
+        skvx::float4 c = skvx::float4::Load(p + 0) * w[0]
+                       + skvx::float4::Load(p + 4) * w[1]
+                       + skvx::float4::Load(p + 8) * w[2]
+                       + skvx::float4::Load(p +12) * w[3];
+
+        // Bicubic filters overshoot, so clamp back to valid premul colors (clamp_gamut).
+        const float a = std::min(std::max(c[kA], 0.0f), 255.0f);
+        c = skvx::min(skvx::max(c, 0.0f), a);
+
+        skvx::cast<uint8_t>(c * alpha + 0.5f).store(colors++);
+    }
+}
+
 }  // namespace SK_OPTS_NS
 
 namespace sktests {
@@ -24,6 +24,8 @@ namespace SkOpts {
         blit_row_s32a_opaque = hsw::blit_row_s32a_opaque;
 
         S32_alpha_D32_filter_DX  = hsw::S32_alpha_D32_filter_DX;
+        S32_bicubic_filter_rows           = hsw::S32_bicubic_filter_rows;
+        S32_alpha_D32_bicubic_filter_cols = hsw::S32_alpha_D32_bicubic_filter_cols;
 
         cubic_solver = SK_OPTS_NS::cubic_solver;
 
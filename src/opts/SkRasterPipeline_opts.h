@@ -3066,6 +3066,68 @@ STAGE(apply_vector_mask, const uint32_t* ctx) {
     a = sk_bit_cast<F>(sk_bit_cast<U32>(a) & mask);
 }
 
+// The arcsine of 0 <= x <= 1, to within 2e-8, from Abramowitz and Stegun 4.4.46.
+SI F approx_asin_unit(F x) {
+    F p = mad(x, -0.0012624911f,  0.0066700901f);
+      p = mad(x, p,              -0.0170881256f);
+      p = mad(x, p,               0.0308918810f);
+      p = mad(x, p,              -0.0501743046f);
+      p = mad(x, p,               0.0889789874f);
+      p = mad(x, p,              -0.2145988016f);
+      p = mad(x, p,               1.5707963050f);
+    return SK_ScalarPI/2 - sqrt_(1 - x) * p;
+}
+
+// The area under the unit circle between 0 and 0 <= s <= 1.
+SI F unit_circle_area(F s) {
+    return 0.5f * (s * sqrt_(max(1 - s*s, 0.0f)) + approx_asin_unit(s));
+}
+
+// This replaces the device coordinates (x,y) in r,g with the area of the pixel inside of an rrect.
+
+STAGE(rrect_coverage, const SkRasterPipeline_RRectCoverageCtx* ctx) {
+    F x = r, y = g;
+    F L = ctx->fBounds[0], T = ctx->fBounds[1],
+      R = ctx->fBounds[2], B = ctx->fBounds[3];
+
+    // Start with the area inside of the rect, one axis at a time.
+    F cov = clamp_01_(min(x - L, R - x) + 0.5f) * clamp_01_(min(y - T, B - y) + 0.5f);
+
+    // Then find the closest corner, and where the pixel is relative to its ellipse's center.
+    I32 left = x < (L + R) * 0.5f,
+        top  = y < (T + B) * 0.5f;
+    F rx = if_then_else(top, if_then_else(left, F(ctx->fRadiiX[0]), F(ctx->fRadiiX[1])),
+                             if_then_else(left, F(ctx->fRadiiX[3]), F(ctx->fRadiiX[2]))),
+      ry = if_then_else(top, if_then_else(left, F(ctx->fRadiiY[0]), F(ctx->fRadiiY[1])),
+                             if_then_else(left, F(ctx->fRadiiY[3]), F(ctx->fRadiiY[2])));
+    F cx = if_then_else(left, L + rx - x, x - (R - rx)),
+      cy = if_then_else(top,  T + ry - y, y - (B - ry));
+
+    // The part of the pixel in the corner's box, [0,rx] x [0,ry] going away from the center.
+    F u0 = max(cx - 0.5f, 0.0f), u1 = min(cx + 0.5f, rx),
+      v0 = max(cy - 0.5f, 0.0f), v1 = min(cy + 0.5f, ry);
+    I32 inCorner = (u0 < u1) & (v0 < v1);
+
+    // Scaled to the unit circle, the area inside of it is the integral over [s0,s1] of
+    // clamp(sqrt(1 - s^2) - t0, 0, t1 - t0). The circle is above t1 until sa, and above t0 until
+    // sb.
+    rx = max(rx, 1e-6f);
+    ry = max(ry, 1e-6f);
+    F s0 = u0 / rx, s1 = u1 / rx,
+      t0 = v0 / ry, t1 = v1 / ry;
+    F sa = min(max(sqrt_(max(1 - t1*t1, 0.0f)), s0), s1),
+      sb = min(max(sqrt_(max(1 - t0*t0, 0.0f)), s0), s1);
+    F inside = (t1 - t0) * (sa - s0) + (unit_circle_area(sb) - unit_circle_area(sa)) -
+               t0 * (sb - sa);
+    F outside = (u1 - u0) * (v1 - v0) - rx * ry * inside;
+    cov = if_then_else(inCorner, max(cov - outside, 0.0f), cov);
+
+    if (ctx->fInverse) {
+        cov = 1 - cov;
+    }
+    r = g = b = a = cov;
+}
+
 SI void save_xy(F* r, F* g, SkRasterPipeline_SamplerCtx* c) {
     // Whether bilinear or bicubic, all sample points are at the same fractional offset (fx,fy).
     // They're either the 4 corners of a logical 1x1 pixel or the 16 corners of a 3x3 grid
@@ -3221,6 +3283,12 @@ STAGE(callback, SkRasterPipeline_CallbackCtx* c) {
     load4(c->read_from,0, &r,&g,&b,&a);
 }
 
+// Profile stages may be placed between any two stages, including those of SkSL programs, so they
+// must tail-call like them.
+STAGE_TAIL(profile, SkRasterPipeline_ProfileCtx* ctx) {
+    ctx->fn(ctx, tail ? tail : N);
+}
+
 // All control flow stages used by SkSL maintain some state in the common registers:
 //   dr: condition mask
 //   dg: loop mask
@@ -3756,6 +3824,73 @@ DECLARE_N_WAY_BINARY_FLOAT(pow)
 #undef DECLARE_N_WAY_BINARY_INT
 #undef DECLARE_N_WAY_BINARY_UINT
 
+// Immediate-operand ops fuse a literal push with the binary op that consumes it. The literal is
+// splatted from the context, and applied to each of the adjacent slots at `dst`.
+template <typename T, void (*ApplyFn)(T*, T*)>
+SI void apply_binary_immediate(SkRasterPipeline_ConstantCtx* ctx, int numSlots) {
+    I32 splat = ctx->value;
+    T src = sk_bit_cast<T>(splat);
+    T* dst = (T*)ctx->dst;
+    T* end = dst + numSlots;
+    do {
+        ApplyFn(dst, &src);
+        dst += 1;
+    } while (dst != end);
+}
+
+#define DECLARE_IMM_BINARY_FLOAT(name)                                             \
+    STAGE_TAIL(name##_imm_float, SkRasterPipeline_ConstantCtx* ctx) {              \
+        apply_binary_immediate<F, &name##_fn>(ctx, 1);                             \
+    }
+#define DECLARE_IMM_BINARY_INT(name)                                               \
+    STAGE_TAIL(name##_imm_int, SkRasterPipeline_ConstantCtx* ctx) {                \
+        apply_binary_immediate<I32, &name##_fn>(ctx, 1);                           \
+    }
+#define DECLARE_IMM_BINARY_UINT(name)                                              \
+    STAGE_TAIL(name##_imm_uint, SkRasterPipeline_ConstantCtx* ctx) {               \
+        apply_binary_immediate<U32, &name##_fn>(ctx, 1);                           \
+    }
+#define DECLARE_MULTI_IMM_BINARY_FLOAT(name)                                       \
+    DECLARE_IMM_BINARY_FLOAT(name)                                                 \
+    STAGE_TAIL(name##_imm_2_floats, SkRasterPipeline_ConstantCtx* ctx) {           \
+        apply_binary_immediate<F, &name##_fn>(ctx, 2);                             \
+    }                                                                              \
+    STAGE_TAIL(name##_imm_3_floats, SkRasterPipeline_ConstantCtx* ctx) {           \
+        apply_binary_immediate<F, &name##_fn>(ctx, 3);                             \
+    }                                                                              \
+    STAGE_TAIL(name##_imm_4_floats, SkRasterPipeline_ConstantCtx* ctx) {           \
+        apply_binary_immediate<F, &name##_fn>(ctx, 4);                             \
+    }
+#define DECLARE_MULTI_IMM_BINARY_INT(name)                                         \
+    DECLARE_IMM_BINARY_INT(name)                                                   \
+    STAGE_TAIL(name##_imm_2_ints, SkRasterPipeline_ConstantCtx* ctx) {             \
+        apply_binary_immediate<I32, &name##_fn>(ctx, 2);                           \
+    }                                                                              \
+    STAGE_TAIL(name##_imm_3_ints, SkRasterPipeline_ConstantCtx* ctx) {             \
+        apply_binary_immediate<I32, &name##_fn>(ctx, 3);                           \
+    }                                                                              \
+    STAGE_TAIL(name##_imm_4_ints, SkRasterPipeline_ConstantCtx* ctx) {             \
+        apply_binary_immediate<I32, &name##_fn>(ctx, 4);                           \
+    }
+
+// The most common ops get specializations for 1-4 slots; the rest only fuse with scalars.
+DECLARE_MULTI_IMM_BINARY_FLOAT(add)  DECLARE_MULTI_IMM_BINARY_INT(add)
+DECLARE_MULTI_IMM_BINARY_FLOAT(mul)  DECLARE_MULTI_IMM_BINARY_INT(mul)
+                                     DECLARE_MULTI_IMM_BINARY_INT(bitwise_and)
+                                     DECLARE_IMM_BINARY_INT(bitwise_xor)
+DECLARE_IMM_BINARY_FLOAT(min)
+DECLARE_IMM_BINARY_FLOAT(max)
+DECLARE_IMM_BINARY_FLOAT(cmplt)      DECLARE_IMM_BINARY_INT(cmplt)  DECLARE_IMM_BINARY_UINT(cmplt)
+DECLARE_IMM_BINARY_FLOAT(cmple)      DECLARE_IMM_BINARY_INT(cmple)  DECLARE_IMM_BINARY_UINT(cmple)
+DECLARE_IMM_BINARY_FLOAT(cmpeq)      DECLARE_IMM_BINARY_INT(cmpeq)
+DECLARE_IMM_BINARY_FLOAT(cmpne)      DECLARE_IMM_BINARY_INT(cmpne)
+
+#undef DECLARE_IMM_BINARY_FLOAT
+#undef DECLARE_IMM_BINARY_INT
+#undef DECLARE_IMM_BINARY_UINT
+#undef DECLARE_MULTI_IMM_BINARY_FLOAT
+#undef DECLARE_MULTI_IMM_BINARY_INT
+
 // Dots can be represented with multiply and add ops, but they are so foundational that it's worth
 // having dedicated ops.
 STAGE_TAIL(dot_2_floats, F* dst) {
@@ -3816,8 +3951,14 @@ SI void mix_fn(I32* a, I32* x, I32* y) {
         apply_adjacent_ternary<I32, &name##_fn>((I32*)ctx->dst, (I32*)ctx->src0, (I32*)ctx->src1); \
     }
 
+SI void mad_fn(F* a, F* b, F* c) {
+    // Fuses `a * b` with an add of `c`, which was pushed between the multiply and the add.
+    *a = mad(*a, *b, *c);
+}
+
 DECLARE_TERNARY_FLOAT(mix)
 DECLARE_TERNARY_INT(mix)
+DECLARE_TERNARY_FLOAT(mad)
 
 #undef DECLARE_TERNARY_FLOAT
 #undef DECLARE_TERNARY_INT
@@ -5346,6 +5487,12 @@ STAGE_PP(swizzle, void* ctx) {
     }
 }
 
+// ~~~~~~ Profiling ~~~~~~ //
+
+STAGE_PP(profile, SkRasterPipeline_ProfileCtx* ctx) {
+    ctx->fn(ctx, tail ? tail : N);
+}
+
 #endif//defined(JUMPER_IS_SCALAR) controlling whether we build lowp stages
 }  // namespace lowp
 
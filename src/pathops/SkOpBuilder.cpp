@@ -144,6 +144,10 @@ bool SkOpBuilder::resolve(SkPath* result) {
     SkPath original = *result;
     int count = fOps.size();
     bool allUnion = true;
+    bool onlyUnion = true;
+    for (int index = 0; index < count; ++index) {
+        onlyUnion &= kUnion_SkPathOp == fOps[index];
+    }
     SkPathFirstDirection firstDir = SkPathFirstDirection::kUnknown;
     for (int index = 0; index < count; ++index) {
         SkPath* test = &fPathRefs[index];
@@ -175,6 +179,23 @@ bool SkOpBuilder::resolve(SkPath* result) {
             }
         }
     }
+    if (!allUnion && onlyUnion) {
+        // Union is associative, so resolve the unions as a balanced tree. Each path then takes
+        // part in log(count) ops, instead of the result of every op growing by one more path.
+        for (int step = 1; step < count; step *= 2) {
+            for (int index = 0; index + step < count; index += 2 * step) {
+                if (!Op(fPathRefs[index], fPathRefs[index + step], kUnion_SkPathOp,
+                        &fPathRefs[index])) {
+                    reset();
+                    *result = original;
+                    return false;
+                }
+            }
+        }
+        *result = fPathRefs[0];
+        reset();
+        return true;
+    }
     if (!allUnion) {
         *result = fPathRefs[0];
         for (int index = 1; index < count; ++index) {
@@ -10,6 +10,7 @@
 #include "include/pathops/SkPathOps.h"
 #include "src/pathops/SkPathOpsTypes.h"
 
+class SkArenaAlloc;
 class SkOpAngle;
 class SkOpCoincidence;
 class SkOpContourHead;
@@ -32,5 +33,14 @@ bool HandleCoincidence(SkOpContourHead* , SkOpCoincidence* );
 bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
              SkDEBUGPARAMS(bool skipAssert)
              SkDEBUGPARAMS(const char* testName));
+// OpDebug and SimplifyDebug build their contours in a local arena; these build them in the
+// caller's arena instead, so that its blocks can be reused from one call to the next.
+bool OpWithAllocator(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+                     SkArenaAlloc* allocator
+                     SkDEBUGPARAMS(bool skipAssert)
+                     SkDEBUGPARAMS(const char* testName));
+bool SimplifyWithAllocator(const SkPath& path, SkPath* result, SkArenaAlloc* allocator
+                           SkDEBUGPARAMS(bool skipAssert)
+                           SkDEBUGPARAMS(const char* testName));
 
 #endif
@@ -0,0 +1,68 @@
+/*
+ * Copyright 2023 Google Inc.
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#include "include/core/SkPath.h"
+#include "include/core/SkTypes.h"
+#include "include/pathops/SkPathOps.h"
+#include "src/base/SkArenaAlloc.h"
+#include "src/pathops/SkPathOpsCommon.h"
+
+#include <algorithm>
+
+// The storage starts at the size of the inline block used by Op() and Simplify(), and stops
+// growing at a size that the contours of very large paths would exceed anyway.
+static constexpr size_t kInitialStorageSize = 4096;
+static constexpr size_t kMaxStorageSize = 1 << 20;
+
+SkPathOpsContext::SkPathOpsContext()
+        : fStorage(new char[kInitialStorageSize])
+        , fStorageSize(kInitialStorageSize) {}
+
+SkPathOpsContext::~SkPathOpsContext() = default;
+
+bool SkPathOpsContext::op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
+    bool success;
+    int heapBlocks;
+    {
+        SkArenaAlloc allocator(fStorage.get(), fStorageSize, fStorageSize);
+        success = OpWithAllocator(one, two, op, result, &allocator
+                SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+        heapBlocks = allocator.heapBlockCount();
+    }
+    this->grow(heapBlocks);
+    return success;
+}
+
+bool SkPathOpsContext::simplify(const SkPath& path, SkPath* result) {
+    bool success;
+    int heapBlocks;
+    {
+        SkArenaAlloc allocator(fStorage.get(), fStorageSize, fStorageSize);
+        success = SimplifyWithAllocator(path, result, &allocator
+                SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+        heapBlocks = allocator.heapBlockCount();
+    }
+    this->grow(heapBlocks);
+    return success;
+}
+
+void SkPathOpsContext::grow(int heapBlocks) {
+    if (!heapBlocks) {
+        return;
+    }
+    fHeapAllocationCount += heapBlocks;
+    // With the first heap block the size of the storage, n heap blocks of Fibonacci-growing size
+    // hold less than the storage doubled n times.
+    size_t size = fStorageSize;
+    for (int i = 0; i < heapBlocks && size < kMaxStorageSize; ++i) {
+        size *= 2;
+    }
+    size = std::min(size, kMaxStorageSize);
+    if (size > fStorageSize) {
+        fStorage.reset(new char[size]);
+        fStorageSize = size;
+    }
+}
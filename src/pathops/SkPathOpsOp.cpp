@@ -249,7 +249,158 @@ extern void (*gVerboseFinalize)();
 
 #endif
 
-bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+static void set_rect_result(const SkRect& rect, SkPathFillType fillType, SkPath* result) {
+    result->reset();
+    result->setFillType(fillType);
+    if (!rect.isEmpty()) {
+        result->addRect(rect);
+    }
+}
+
+// Returns true and sets rect to one minus two if that difference is a single rectangle.
+static bool rect_difference(const SkRect& one, const SkRect& two, SkRect* rect) {
+    if (!SkRect::Intersects(one, two)) {
+        *rect = one;
+        return true;
+    }
+    if (two.contains(one)) {
+        rect->setEmpty();
+        return true;
+    }
+    if (two.fLeft <= one.fLeft && one.fRight <= two.fRight) {
+        if (two.fTop <= one.fTop) {
+            rect->setLTRB(one.fLeft, two.fBottom, one.fRight, one.fBottom);
+            return true;
+        }
+        if (one.fBottom <= two.fBottom) {
+            rect->setLTRB(one.fLeft, one.fTop, one.fRight, two.fTop);
+            return true;
+        }
+    }
+    if (two.fTop <= one.fTop && one.fBottom <= two.fBottom) {
+        if (two.fLeft <= one.fLeft) {
+            rect->setLTRB(two.fRight, one.fTop, one.fRight, one.fBottom);
+            return true;
+        }
+        if (one.fRight <= two.fRight) {
+            rect->setLTRB(one.fLeft, one.fTop, two.fLeft, one.fBottom);
+            return true;
+        }
+    }
+    return false;
+}
+
+// Returns true and sets rect to the union of one and two if that union is a single rectangle.
+static bool rect_union(const SkRect& one, const SkRect& two, SkRect* rect) {
+    if (one.contains(two)) {
+        *rect = one;
+        return true;
+    }
+    if (two.contains(one)) {
+        *rect = two;
+        return true;
+    }
+    if ((one.fLeft == two.fLeft && one.fRight == two.fRight &&
+            one.fTop <= two.fBottom && two.fTop <= one.fBottom) ||
+        (one.fTop == two.fTop && one.fBottom == two.fBottom &&
+            one.fLeft <= two.fRight && two.fLeft <= one.fRight)) {
+        *rect = one;
+        rect->join(two);
+        return true;
+    }
+    return false;
+}
+
+// Combines operands whose result is known without finding their intersections: rectangles
+// whose combination is again a rectangle, a rectangle inside a convex path, and convex paths
+// whose bounds do not overlap. Returns false if the general algorithm is required.
+static bool op_fast_path(const SkPath& one, const SkPath& two, SkPathOp op,
+        SkPathFillType fillType, SkPath* result, SkArenaAlloc* allocator) {
+    if (one.isInverseFillType() || two.isInverseFillType()
+            || !one.isFinite() || !two.isFinite()) {
+        return false;
+    }
+    const SkPath* minuend = &one;
+    const SkPath* subtrahend = &two;
+    if (op == kReverseDifference_SkPathOp) {
+        std::swap(minuend, subtrahend);
+        op = kDifference_SkPathOp;
+    }
+    const SkRect& bounds1 = minuend->getBounds();
+    const SkRect& bounds2 = subtrahend->getBounds();
+    if (bounds1.isEmpty() || bounds2.isEmpty()) {
+        return false;
+    }
+    SkRect rect1, rect2, rect;
+    bool isRect1 = minuend->isRect(&rect1);
+    bool isRect2 = subtrahend->isRect(&rect2);
+    if (isRect1 && isRect2) {
+        if ((op == kUnion_SkPathOp && rect_union(rect1, rect2, &rect))
+                || (op == kDifference_SkPathOp && rect_difference(rect1, rect2, &rect))) {
+            set_rect_result(rect, fillType, result);
+            return true;
+        }
+        if (op == kXOR_SkPathOp && rect1 == rect2) {
+            set_rect_result(SkRect::MakeEmpty(), fillType, result);
+            return true;
+        }
+    }
+    if (!minuend->isConvex() || !subtrahend->isConvex()) {
+        return false;
+    }
+    SkPath work;
+    if (isRect1 && subtrahend->conservativelyContainsRect(rect1)) {
+        switch (op) {
+            case kIntersect_SkPathOp:
+                set_rect_result(rect1, fillType, result);
+                return true;
+            case kDifference_SkPathOp:
+                set_rect_result(SkRect::MakeEmpty(), fillType, result);
+                return true;
+            case kUnion_SkPathOp:
+                work = *subtrahend;
+                break;
+            default:
+                return false;
+        }
+    } else if (isRect2 && minuend->conservativelyContainsRect(rect2)) {
+        switch (op) {
+            case kIntersect_SkPathOp:
+                set_rect_result(rect2, fillType, result);
+                return true;
+            case kUnion_SkPathOp:
+                work = *minuend;
+                break;
+            default:
+                return false;
+        }
+    } else if (!SkRect::Intersects(bounds1, bounds2)) {
+        switch (op) {
+            case kIntersect_SkPathOp:
+                break;
+            case kDifference_SkPathOp:
+                work = *minuend;
+                break;
+            case kUnion_SkPathOp:
+            case kXOR_SkPathOp:
+                work = *minuend;
+                work.addPath(*subtrahend);
+                break;
+            default:
+                SkASSERT(0);  // unhandled case
+        }
+    } else {
+        return false;
+    }
+    // Operands that are passed through are simplified, so that the result has the same form
+    // (degenerate and collinear edges removed, even-odd fill) as the general algorithm's.
+    SkASSERT(!SkPathFillType_IsInverse(fillType));
+    return SimplifyWithAllocator(work, result, allocator
+            SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+}
+
+bool OpWithAllocator(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result,
+        SkArenaAlloc* allocator
         SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
 #if DEBUG_DUMP_VERIFY
 #ifndef SK_DEBUG
@@ -297,12 +448,15 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
         if (inverseFill != work.isInverseFillType()) {
             work.toggleInverseFillType();
         }
-        return Simplify(work, result);
+        return SimplifyWithAllocator(work, result, allocator
+                SkDEBUGPARAMS(true) SkDEBUGPARAMS(nullptr));
+    }
+    if (op_fast_path(one, two, op, fillType, result, allocator)) {
+        return true;
     }
-    SkSTArenaAlloc<4096> allocator;  // FIXME: add a constant expression here, tune
     SkOpContour contour;
     SkOpContourHead* contourList = static_cast<SkOpContourHead*>(&contour);
-    SkOpGlobalState globalState(contourList, &allocator
+    SkOpGlobalState globalState(contourList, allocator
             SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
     SkOpCoincidence coincidence(&globalState);
     const SkPath* minuend = &one;
@@ -380,6 +534,13 @@ bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
     return true;
 }
 
+bool OpDebug(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result
+        SkDEBUGPARAMS(bool skipAssert) SkDEBUGPARAMS(const char* testName)) {
+    SkSTArenaAlloc<4096> allocator;  // FIXME: add a constant expression here, tune
+    return OpWithAllocator(one, two, op, result, &allocator
+            SkDEBUGPARAMS(skipAssert) SkDEBUGPARAMS(testName));
+}
+
 bool Op(const SkPath& one, const SkPath& two, SkPathOp op, SkPath* result) {
 #if DEBUG_DUMP_VERIFY
     if (SkPathOpsDebug::gVerifyOp) {
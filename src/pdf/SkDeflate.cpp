@@ -15,6 +15,8 @@
 #include "zlib.h"
 
 #include <algorithm>
+#include <cmath>
+#include <cstdint>
 
 namespace {
 
@@ -111,6 +113,16 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
     }
     const char* buffer = (const char*)void_buffer;
     while (len > 0) {
+        if (0 == fImpl->fInBufferIndex && len >= sizeof(fImpl->fInBuffer)) {
+            // Nothing is buffered, so hand large writes to zlib directly instead of copying
+            // them through fInBuffer 4K at a time.
+            size_t direct = std::min<size_t>(len, 1 << 30);
+            do_deflate(Z_NO_FLUSH, &fImpl->fZStream, fImpl->fOut,
+                       (unsigned char*)const_cast<char*>(buffer), direct);
+            len -= direct;
+            buffer += direct;
+            continue;
+        }
         size_t tocopy =
                 std::min(len, sizeof(fImpl->fInBuffer) - fImpl->fInBufferIndex);
         memcpy(fImpl->fInBuffer + fImpl->fInBufferIndex, buffer, tocopy);
@@ -132,3 +144,45 @@ bool SkDeflateWStream::write(const void* void_buffer, size_t len) {
 size_t SkDeflateWStream::bytesWritten() const {
     return fImpl->fZStream.total_in + fImpl->fInBufferIndex;
 }
+
+SkDeflateContent SkDeflateClassifyContent(const void* data, size_t length) {
+    // Look at up to kWindowCount evenly spaced windows rather than the whole buffer.
+    static constexpr size_t kWindowSize = 256;
+    static constexpr size_t kWindowCount = 16;
+    if (length < kWindowSize) {
+        return SkDeflateContent::kGeneral;
+    }
+    size_t windowCount = std::min(kWindowCount, length / kWindowSize);
+    size_t stride = length / windowCount;
+
+    const uint8_t* bytes = static_cast<const uint8_t*>(data);
+    uint32_t histogram[256] = {};
+    size_t repeats = 0;
+    for (size_t w = 0; w < windowCount; ++w) {
+        const uint8_t* window = bytes + w * stride;
+        for (size_t i = 0; i < kWindowSize; ++i) {
+            uint8_t b = window[i];
+            histogram[b]++;
+            // A byte matching the one 1, 2, 3 or 4 bytes back continues a run of gray, 16-bit,
+            // RGB or RGBA pixels (or of plain repeated bytes).
+            if (i >= 4 && (b == window[i - 1] || b == window[i - 2] ||
+                           b == window[i - 3] || b == window[i - 4])) {
+                repeats++;
+            }
+        }
+    }
+    const size_t sampled = windowCount * kWindowSize;
+    if (repeats * 4 >= sampled * 3) {
+        return SkDeflateContent::kRepetitive;
+    }
+
+    // Order-0 entropy in bits per byte. Deflate can't do much with data close to 8.
+    float entropy = 0;
+    for (uint32_t count : histogram) {
+        if (count) {
+            float p = (float)count / sampled;
+            entropy -= p * std::log2(p);
+        }
+    }
+    return entropy > 7.5f ? SkDeflateContent::kIncompressible : SkDeflateContent::kGeneral;
+}
@@ -11,6 +11,8 @@
 
 #include "include/core/SkStream.h"
 
+#include <cstddef>
+
 /**
   * Wrap a stream in this class to compress the information written to
   * this stream using the Deflate algorithm.
@@ -50,4 +52,15 @@ private:
     std::unique_ptr<Impl> fImpl;
 };
 
+/** A rough guess, from a sample of the data, at how it will respond to DEFLATE. */
+enum class SkDeflateContent {
+    kGeneral,         // Compress at whatever level was asked for.
+    kRepetitive,      // Mostly runs of repeated bytes or pixels; the fastest level compresses
+                      // this nearly as well as the slowest.
+    kIncompressible,  // Looks like noise or already-compressed data; store it instead.
+};
+
+/** Samples at most a few kilobytes of data, so it is cheap next to compressing it. */
+SkDeflateContent SkDeflateClassifyContent(const void* data, size_t length);
+
 #endif  // SkFlate_DEFINED
@@ -16,9 +16,11 @@
 #include "include/private/SkColorData.h"
 #include "include/private/base/SkTo.h"
 #include "src/core/SkImageInfoPriv.h"
+#include "src/core/SkStreamPriv.h"
 #include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkJpegInfo.h"
 #include "src/pdf/SkPDFDocumentPriv.h"
+#include "src/pdf/SkPDFResourceCache.h"
 #include "src/pdf/SkPDFTypes.h"
 #include "src/pdf/SkPDFUtils.h"
 
@@ -67,18 +69,12 @@ static SkColor get_neighbor_avg_color(const SkPixmap& bm, int xOrig, int yOrig)
                  : SK_ColorTRANSPARENT;
 }
 
-namespace {
-enum class SkPDFStreamFormat { DCT, Flate, Uncompressed };
-}
-
-template <typename T>
 static void emit_image_stream(SkPDFDocument* doc,
                               SkPDFIndirectReference ref,
-                              T writeStream,
+                              const SkStreamAsset& data,
                               SkISize size,
                               const char* colorSpace,
                               SkPDFIndirectReference sMask,
-                              int length,
                               SkPDFStreamFormat format) {
     SkPDFDict pdfDict("XObject");
     pdfDict.insertName("Subtype", "Image");
@@ -108,20 +104,38 @@ static void emit_image_stream(SkPDFDocument* doc,
     if (format == SkPDFStreamFormat::DCT) {
         pdfDict.insertInt("ColorTransform", 0);
     }
-    pdfDict.insertInt("Length", length);
-    doc->emitStream(pdfDict, std::move(writeStream), ref);
+    pdfDict.insertInt("Length", SkToInt(data.getLength()));
+    doc->emitStream(pdfDict,
+                    [&data](SkWStream* dst) { SkStreamCopy(dst, data.duplicate().get()); },
+                    ref);
 }
 
-static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndirectReference ref) {
-    SkPDF::Metadata::CompressionLevel compressionLevel = doc->metadata().fCompressionLevel;
-    SkPDFStreamFormat format = compressionLevel == SkPDF::Metadata::CompressionLevel::None
-                             ? SkPDFStreamFormat::Uncompressed
-                             : SkPDFStreamFormat::Flate;
+static void emit_encoded_image(const SkPDFEncodedImage& image,
+                               SkPDFDocument* doc,
+                               SkPDFIndirectReference ref) {
+    SkPDFIndirectReference sMask;
+    if (image.fAlpha) {
+        sMask = doc->reserveRef();
+    }
+    emit_image_stream(doc, ref, *image.fData, image.fDimensions, image.fColorSpace,
+                      sMask, image.fFormat);
+    if (image.fAlpha) {
+        emit_image_stream(doc, sMask, *image.fAlpha, image.fDimensions, "DeviceGray",
+                          SkPDFIndirectReference(), image.fAlphaFormat);
+    }
+}
+
+static std::unique_ptr<SkStreamAsset> deflated_alpha(const SkPixmap& pm,
+                                                     const SkPDF::Metadata& metadata,
+                                                     SkPDFStreamFormat* format) {
+    int compressionLevel = SkPDFUtils::DeflateLevel(metadata, pm.addr(), pm.computeByteSize());
+    *format = compressionLevel == 0 ? SkPDFStreamFormat::Uncompressed
+                                    : SkPDFStreamFormat::Flate;
     SkDynamicMemoryWStream buffer;
     SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
-    if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
+    if (*format == SkPDFStreamFormat::Flate) {
+        deflateWStream.emplace(&buffer, compressionLevel);
         stream = &*deflateWStream;
     }
     if (kAlpha_8_SkColorType == pm.colorType()) {
@@ -153,29 +167,21 @@ static void do_deflated_alpha(const SkPixmap& pm, SkPDFDocument* doc, SkPDFIndir
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), "DeviceGray", SkPDFIndirectReference(),
-                      length, format);
+    return buffer.detachAsStream();
 }
 
-static void do_deflated_image(const SkPixmap& pm,
-                              SkPDFDocument* doc,
-                              bool isOpaque,
-                              SkPDFIndirectReference ref) {
-    SkPDFIndirectReference sMask;
-    if (!isOpaque) {
-        sMask = doc->reserveRef();
-    }
-    SkPDF::Metadata::CompressionLevel compressionLevel = doc->metadata().fCompressionLevel;
-    SkPDFStreamFormat format = compressionLevel == SkPDF::Metadata::CompressionLevel::None
-                             ? SkPDFStreamFormat::Uncompressed
-                             : SkPDFStreamFormat::Flate;
+static void deflate_image(const SkPixmap& pm,
+                          const SkPDF::Metadata& metadata,
+                          bool isOpaque,
+                          SkPDFEncodedImage* dst) {
+    int compressionLevel = SkPDFUtils::DeflateLevel(metadata, pm.addr(), pm.computeByteSize());
+    SkPDFStreamFormat format = compressionLevel == 0 ? SkPDFStreamFormat::Uncompressed
+                                                     : SkPDFStreamFormat::Flate;
     SkDynamicMemoryWStream buffer;
     SkWStream* stream = &buffer;
     std::optional<SkDeflateWStream> deflateWStream;
     if (format == SkPDFStreamFormat::Flate) {
-        deflateWStream.emplace(&buffer, SkToInt(compressionLevel));
+        deflateWStream.emplace(&buffer, compressionLevel);
         stream = &*deflateWStream;
     }
     const char* colorSpace = "DeviceGray";
@@ -184,7 +190,7 @@ static void do_deflated_image(const SkPixmap& pm,
             fill_stream(stream, '\x00', pm.width() * pm.height());
             break;
         case kGray_8_SkColorType:
-            SkASSERT(sMask.fValue = -1);
+            SkASSERT(isOpaque);
             SkASSERT(pm.rowBytes() == (size_t)pm.width());
             stream->write(pm.addr8(), pm.width() * pm.height());
             break;
@@ -221,16 +227,16 @@ static void do_deflated_image(const SkPixmap& pm,
     #ifdef SK_PDF_BASE85_BINARY
     SkPDFUtils::Base85Encode(buffer.detachAsStream(), &buffer);
     #endif
-    int length = SkToInt(buffer.bytesWritten());
-    emit_image_stream(doc, ref, [&buffer](SkWStream* stream) { buffer.writeToAndReset(stream); },
-                      pm.info().dimensions(), colorSpace, sMask, length, format);
+    dst->fDimensions = pm.info().dimensions();
+    dst->fColorSpace = colorSpace;
+    dst->fFormat = format;
+    dst->fData = buffer.detachAsStream();
     if (!isOpaque) {
-        do_deflated_alpha(pm, doc, sMask);
+        dst->fAlpha = deflated_alpha(pm, metadata, &dst->fAlphaFormat);
     }
 }
 
-static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
-                    SkPDFIndirectReference ref) {
+static bool jpeg_image(sk_sp<SkData> data, SkISize size, SkPDFEncodedImage* dst) {
     SkISize jpegSize;
     SkEncodedInfo::Color jpegColorType;
     SkEncodedOrigin exifOrientation;
@@ -251,10 +257,10 @@ static bool do_jpeg(sk_sp<SkData> data, SkPDFDocument* doc, SkISize size,
     data = buffer.detachAsData();
     #endif
 
-    emit_image_stream(doc, ref,
-                      [&data](SkWStream* dst) { dst->write(data->data(), data->size()); },
-                      jpegSize, yuv ? "DeviceRGB" : "DeviceGray",
-                      SkPDFIndirectReference(), SkToInt(data->size()), SkPDFStreamFormat::DCT);
+    dst->fDimensions = jpegSize;
+    dst->fColorSpace = yuv ? "DeviceRGB" : "DeviceGray";
+    dst->fFormat = SkPDFStreamFormat::DCT;
+    dst->fData = SkMemoryStream::Make(std::move(data));
     return true;
 }
 
@@ -282,30 +288,78 @@ static SkBitmap to_pixels(const SkImage* image) {
     return bm;
 }
 
-void serialize_image(const SkImage* img,
-                     int encodingQuality,
-                     SkPDFDocument* doc,
-                     SkPDFIndirectReference ref) {
-    SkASSERT(img);
-    SkASSERT(doc);
-    SkASSERT(encodingQuality >= 0);
+// encodedData and bm are img's encoded data and pixels, if the caller already has them.
+static void encode_image(const SkImage* img,
+                         sk_sp<SkData> encodedData,
+                         SkBitmap bm,
+                         int encodingQuality,
+                         const SkPDF::Metadata& metadata,
+                         SkPDFEncodedImage* dst) {
     SkISize dimensions = img->dimensions();
-    if (sk_sp<SkData> data = img->refEncodedData()) {
-        if (do_jpeg(std::move(data), doc, dimensions, ref)) {
+    if (encodedData) {
+        if (jpeg_image(std::move(encodedData), dimensions, dst)) {
             return;
         }
     }
-    SkBitmap bm = to_pixels(img);
+    if (bm.drawsNothing()) {
+        bm = to_pixels(img);
+    }
     const SkPixmap& pm = bm.pixmap();
     bool isOpaque = pm.isOpaque() || pm.computeIsOpaque();
     if (encodingQuality <= 100 && isOpaque) {
         if (sk_sp<SkData> data = img->encodeToData(SkEncodedImageFormat::kJPEG, encodingQuality)) {
-            if (do_jpeg(std::move(data), doc, dimensions, ref)) {
+            if (jpeg_image(std::move(data), dimensions, dst)) {
                 return;
             }
         }
     }
-    do_deflated_image(pm, doc, isOpaque, ref);
+    deflate_image(pm, metadata, isOpaque, dst);
+}
+
+void serialize_image(const SkImage* img,
+                     int encodingQuality,
+                     SkPDFDocument* doc,
+                     SkPDFIndirectReference ref) {
+    SkASSERT(img);
+    SkASSERT(doc);
+    SkASSERT(encodingQuality >= 0);
+    const SkPDF::Metadata& metadata = doc->metadata();
+    SkPDFResourceCache* cache = SkPDFResourceCache::Get(metadata);
+    if (!cache) {
+        SkPDFEncodedImage encoded;
+        encode_image(img, img->refEncodedData(), SkBitmap(), encodingQuality, metadata, &encoded);
+        emit_encoded_image(encoded, doc, ref);
+        return;
+    }
+
+    auto idKey = SkPDFResourceCache::MakeImageKey(img->uniqueID(), img->imageInfo(),
+                                                  encodingQuality, metadata);
+    if (sk_sp<const SkPDFEncodedImage> cached = cache->findImage(idKey)) {
+        emit_encoded_image(*cached, doc, ref);
+        return;
+    }
+    // A different SkImage, e.g. one decoded again by this document, may still have the same
+    // content as one encoded by another document.
+    sk_sp<SkData> encodedData = img->refEncodedData();
+    SkBitmap bm;
+    if (!encodedData) {
+        bm = to_pixels(img);
+    }
+    auto contentKey = encodedData
+            ? SkPDFResourceCache::MakeImageKey(encodedData->data(), encodedData->size(),
+                                               img->imageInfo(), encodingQuality, metadata)
+            : SkPDFResourceCache::MakeImageKey(bm.getPixels(), bm.computeByteSize(),
+                                               bm.info(), encodingQuality, metadata);
+    sk_sp<const SkPDFEncodedImage> encoded = cache->findImage(contentKey);
+    if (!encoded) {
+        auto image = sk_make_sp<SkPDFEncodedImage>();
+        encode_image(img, std::move(encodedData), std::move(bm), encodingQuality, metadata,
+                     image.get());
+        encoded = std::move(image);
+        cache->addImage(contentKey, encoded);
+    }
+    cache->addImageAlias(idKey, contentKey);
+    emit_encoded_image(*encoded, doc, ref);
 }
 
 SkPDFIndirectReference SkPDFSerializeImage(const SkImage* img,
@@ -7,10 +7,36 @@
 #ifndef SkPDFBitmap_DEFINED
 #define SkPDFBitmap_DEFINED
 
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkSize.h"
+#include "include/core/SkStream.h"
+
+#include <memory>
+
 class SkImage;
 class SkPDFDocument;
 struct SkPDFIndirectReference;
 
+enum class SkPDFStreamFormat { DCT, Flate, Uncompressed };
+
+/**
+ * An image encoded the way it is embedded in a document, which can be emitted into any
+ * document with the same encoding settings.
+ */
+struct SkPDFEncodedImage : public SkNVRefCnt<SkPDFEncodedImage> {
+    SkISize fDimensions = {0, 0};
+    const char* fColorSpace = "DeviceRGB";  // or "DeviceGray"
+    SkPDFStreamFormat fFormat = SkPDFStreamFormat::Uncompressed;
+    // The streams are only ever duplicated, so several documents can emit them at once.
+    std::unique_ptr<SkStreamAsset> fData;
+    SkPDFStreamFormat fAlphaFormat = SkPDFStreamFormat::Uncompressed;
+    std::unique_ptr<SkStreamAsset> fAlpha;  // The soft mask, or nullptr if the image is opaque.
+
+    size_t bytesUsed() const {
+        return sizeof(*this) + fData->getLength() + (fAlpha ? fAlpha->getLength() : 0);
+    }
+};
+
 /**
  * Serialize a SkImage as an Image Xobject.
  *  quality > 100 means lossless
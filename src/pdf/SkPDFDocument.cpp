@@ -609,16 +609,18 @@ void SkPDFDocument::onClose(SkWStream* stream) {
     }
 }
 
-void SkPDFDocument::incrementJobCount() { fJobCount++; }
+void SkPDFDocument::incrementJobCount() { fJobSlots.wait(); }
 
-void SkPDFDocument::signalJobComplete() { fSemaphore.signal(); }
+void SkPDFDocument::signalJobComplete() { fJobSlots.signal(); }
 
 void SkPDFDocument::waitForJobs() {
-     // fJobCount can increase while we wait.
-     while (fJobCount > 0) {
-         fSemaphore.wait();
-         --fJobCount;
-     }
+    // Jobs are only launched from the thread that calls this, so once we hold every slot no job
+    // can still be pending. Completed objects have already been written (in whatever order they
+    // finished) with their offsets recorded in fOffsetMap.
+    for (int i = 0; i < kMaxPendingJobs; ++i) {
+        fJobSlots.wait();
+    }
+    fJobSlots.signal(kMaxPendingJobs);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -133,7 +133,10 @@ public:
     SkString nextFontSubsetTag();
 
     SkExecutor* executor() const { return fExecutor; }
+    // Reserves one of the kMaxPendingJobs job slots before a job is handed to the executor,
+    // blocking the calling thread until a running job completes if all slots are taken.
     void incrementJobCount();
+    // Releases the slot reserved by incrementJobCount(); called by the job when it is done.
     void signalJobComplete();
     size_t currentPageIndex() { return fPages.size(); }
     size_t pageCount() { return fPageRefs.size(); }
@@ -166,7 +169,6 @@ private:
 
     sk_sp<SkPDFDevice> fPageDevice;
     std::atomic<int> fNextObjectNumber = {1};
-    std::atomic<int> fJobCount = {0};
     uint32_t fNextFontSubsetTag = {0};
     SkUUID fUUID;
     SkPDFIndirectReference fInfoDict;
@@ -179,8 +181,13 @@ private:
     // For tagged PDFs.
     SkPDFTagTree fTagTree;
 
+    // Bounds how many serialization jobs may be queued or running at once. Every job holds its
+    // uncompressed content until it has been written, so producers wait for a free slot rather
+    // than letting a long document queue up all of its pages and images in memory.
+    static constexpr int kMaxPendingJobs = 32;
+
     SkMutex fMutex;
-    SkSemaphore fSemaphore;
+    SkSemaphore fJobSlots{kMaxPendingJobs};
 
     void waitForJobs();
     SkWStream* beginObject(SkPDFIndirectReference);
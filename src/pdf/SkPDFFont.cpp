@@ -41,6 +41,7 @@
 #include "src/pdf/SkPDFFormXObject.h"
 #include "src/pdf/SkPDFMakeCIDGlyphWidthsArray.h"
 #include "src/pdf/SkPDFMakeToUnicodeCmap.h"
+#include "src/pdf/SkPDFResourceCache.h"
 #include "src/pdf/SkPDFSubsetFont.h"
 #include "src/pdf/SkPDFType1Font.h"
 #include "src/pdf/SkPDFUtils.h"
@@ -324,10 +325,22 @@ static void emit_subset_type0(const SkPDFFont& font, SkPDFDocument* doc) {
                 if (!SkToBool(metrics.fFlags &
                               SkAdvancedTypefaceMetrics::kNotSubsettable_FontFlag)) {
                     SkASSERT(font.firstGlyphID() == 1);
-                    sk_sp<SkData> subsetFontData = SkPDFSubsetFont(
-                            stream_to_data(std::move(fontAsset)), font.glyphUsage(),
-                            doc->metadata().fSubsetter,
-                            metrics.fFontName.c_str(), ttcIndex);
+                    SkPDFResourceCache* cache = SkPDFResourceCache::Get(doc->metadata());
+                    SkPDF::Metadata::Subsetter subsetter = doc->metadata().fSubsetter;
+                    sk_sp<SkData> subsetFontData;
+                    if (cache) {
+                        subsetFontData = cache->findFontSubset(face->uniqueID(), ttcIndex,
+                                                               font.glyphUsage(), subsetter);
+                    }
+                    if (!subsetFontData) {
+                        subsetFontData = SkPDFSubsetFont(
+                                stream_to_data(std::move(fontAsset)), font.glyphUsage(),
+                                subsetter, metrics.fFontName.c_str(), ttcIndex);
+                        if (cache && subsetFontData) {
+                            cache->addFontSubset(face->uniqueID(), ttcIndex,
+                                                 font.glyphUsage(), subsetter, subsetFontData);
+                        }
+                    }
                     if (subsetFontData) {
                         std::unique_ptr<SkPDFDict> tmp = SkPDFMakeDict();
                         tmp->insertInt("Length1", SkToInt(subsetFontData->size()));
@@ -0,0 +1,136 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "src/pdf/SkPDFResourceCache.h"
+
+#include "include/private/SkChecksum.h"
+#include "include/private/SkOpts_spi.h"
+#include "src/core/SkMD5.h"
+#include "src/pdf/SkPDFGlyphUse.h"
+
+sk_sp<SkPDF::ResourceCache> SkPDF::ResourceCache::Make(size_t byteLimit) {
+    return sk_make_sp<SkPDFResourceCache>(byteLimit);
+}
+
+size_t SkPDFResourceCache::bytesUsed() const {
+    SkAutoMutexExclusive lock(fMutex);
+    return fBytesUsed;
+}
+
+bool SkPDFResourceCache::reserve(size_t bytes) {
+    if (bytes > fByteLimit - fBytesUsed) {
+        return false;
+    }
+    fBytesUsed += bytes;
+    return true;
+}
+
+static SkPDFResourceCache::ImageKey image_key(const SkImageInfo& info,
+                                              int encodingQuality,
+                                              const SkPDF::Metadata& metadata) {
+    SkPDFResourceCache::ImageKey key;
+    key.fWidth = info.width();
+    key.fHeight = info.height();
+    key.fColorType = (int32_t)info.colorType();
+    key.fAlphaType = (int32_t)info.alphaType();
+    key.fEncodingQuality = encodingQuality;
+    key.fCompressionLevel = (int32_t)metadata.fCompressionLevel;
+    key.fAdaptiveCompression = metadata.fAdaptiveCompression;
+    return key;
+}
+
+SkPDFResourceCache::ImageKey SkPDFResourceCache::MakeImageKey(uint32_t imageID,
+                                                              const SkImageInfo& info,
+                                                              int encodingQuality,
+                                                              const SkPDF::Metadata& metadata) {
+    ImageKey key = image_key(info, encodingQuality, metadata);
+    key.fImageID = imageID;
+    return key;
+}
+
+SkPDFResourceCache::ImageKey SkPDFResourceCache::MakeImageKey(const void* content,
+                                                              size_t length,
+                                                              const SkImageInfo& info,
+                                                              int encodingQuality,
+                                                              const SkPDF::Metadata& metadata) {
+    ImageKey key = image_key(info, encodingQuality, metadata);
+    // A hit is trusted without comparing content, so this needs a real 128-bit digest.
+    SkMD5 md5;
+    md5.write(content, length);
+    SkMD5::Digest digest = md5.finish();
+    static_assert(sizeof(key.fContentDigest) == sizeof(digest.data));
+    memcpy(key.fContentDigest, digest.data, sizeof(digest.data));
+    return key;
+}
+
+sk_sp<const SkPDFEncodedImage> SkPDFResourceCache::findImage(const ImageKey& key) {
+    SkAutoMutexExclusive lock(fMutex);
+    if (sk_sp<const SkPDFEncodedImage>* found = fImages.find(key)) {
+        fHitCount.fetch_add(1, std::memory_order_relaxed);
+        return *found;
+    }
+    return nullptr;
+}
+
+void SkPDFResourceCache::addImage(const ImageKey& key, sk_sp<const SkPDFEncodedImage> image) {
+    SkASSERT(image);
+    SkAutoMutexExclusive lock(fMutex);
+    // Another document may have encoded the same image at the same time.
+    if (!fImages.find(key) && this->reserve(image->bytesUsed())) {
+        fImages.set(key, std::move(image));
+    }
+}
+
+void SkPDFResourceCache::addImageAlias(const ImageKey& alias, const ImageKey& key) {
+    SkAutoMutexExclusive lock(fMutex);
+    sk_sp<const SkPDFEncodedImage>* image = fImages.find(key);
+    if (image && !fImages.find(alias) && this->reserve(sizeof(ImageKey))) {
+        fImages.set(alias, *image);
+    }
+}
+
+uint32_t SkPDFResourceCache::FontKeyHash::operator()(const FontKey& key) const {
+    uint32_t hash = SkOpts::hash_fn(key.fGlyphs.data(), key.fGlyphs.size() * sizeof(SkGlyphID),
+                                    key.fTypefaceID);
+    return SkChecksum::Mix(hash ^ (uint32_t)key.fTTCIndex ^ ((uint32_t)key.fSubsetter << 16));
+}
+
+SkPDFResourceCache::FontKey SkPDFResourceCache::MakeFontKey(uint32_t typefaceID,
+                                                            int ttcIndex,
+                                                            const SkPDFGlyphUse& glyphUsage,
+                                                            SkPDF::Metadata::Subsetter subsetter) {
+    FontKey key{typefaceID, ttcIndex, subsetter, {}};
+    glyphUsage.getSetValues([&key](unsigned gid) { key.fGlyphs.push_back((SkGlyphID)gid); });
+    return key;
+}
+
+sk_sp<SkData> SkPDFResourceCache::findFontSubset(uint32_t typefaceID,
+                                                 int ttcIndex,
+                                                 const SkPDFGlyphUse& glyphUsage,
+                                                 SkPDF::Metadata::Subsetter subsetter) {
+    FontKey key = MakeFontKey(typefaceID, ttcIndex, glyphUsage, subsetter);
+    SkAutoMutexExclusive lock(fMutex);
+    if (sk_sp<SkData>* found = fFontSubsets.find(key)) {
+        fHitCount.fetch_add(1, std::memory_order_relaxed);
+        return *found;
+    }
+    return nullptr;
+}
+
+void SkPDFResourceCache::addFontSubset(uint32_t typefaceID,
+                                       int ttcIndex,
+                                       const SkPDFGlyphUse& glyphUsage,
+                                       SkPDF::Metadata::Subsetter subsetter,
+                                       sk_sp<SkData> subset) {
+    SkASSERT(subset);
+    FontKey key = MakeFontKey(typefaceID, ttcIndex, glyphUsage, subsetter);
+    size_t bytes = subset->size() + key.fGlyphs.size() * sizeof(SkGlyphID) + sizeof(FontKey);
+    SkAutoMutexExclusive lock(fMutex);
+    if (!fFontSubsets.find(key) && this->reserve(bytes)) {
+        fFontSubsets.set(std::move(key), std::move(subset));
+    }
+}
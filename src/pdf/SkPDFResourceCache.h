@@ -0,0 +1,101 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+#ifndef SkPDFResourceCache_DEFINED
+#define SkPDFResourceCache_DEFINED
+
+#include "include/core/SkData.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkRefCnt.h"
+#include "include/docs/SkPDFDocument.h"
+#include "include/private/base/SkMutex.h"
+#include "include/private/base/SkThreadAnnotations.h"
+#include "src/core/SkTHash.h"
+#include "src/pdf/SkPDFBitmap.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+class SkPDFGlyphUse;
+
+class SkPDFResourceCache final : public SkPDF::ResourceCache {
+public:
+    explicit SkPDFResourceCache(size_t byteLimit) : fByteLimit(byteLimit) {}
+
+    static SkPDFResourceCache* Get(const SkPDF::Metadata& metadata) {
+        // Make() is the only way to create a ResourceCache.
+        return static_cast<SkPDFResourceCache*>(metadata.fResourceCache);
+    }
+
+    size_t bytesUsed() const override;
+    int hitCount() const override { return fHitCount.load(std::memory_order_relaxed); }
+
+    // Identifies an image together with everything that affects how it is encoded.
+    struct ImageKey {
+        uint32_t fImageID = 0;          // SkImage::uniqueID(), or zero when keyed by content.
+        uint8_t fContentDigest[16] = {};  // SkMD5 of the encoded data or pixels.
+        int32_t fWidth = 0;
+        int32_t fHeight = 0;
+        int32_t fColorType = 0;         // e.g. A8 and Gray8 pixels are encoded differently.
+        int32_t fAlphaType = 0;
+        int32_t fEncodingQuality = 0;
+        int32_t fCompressionLevel = 0;
+        int32_t fAdaptiveCompression = 0;
+
+        bool operator==(const ImageKey& that) const {
+            return 0 == memcmp(this, &that, sizeof(ImageKey));
+        }
+    };
+    static ImageKey MakeImageKey(uint32_t imageID, const SkImageInfo&, int encodingQuality,
+                                 const SkPDF::Metadata&);
+    static ImageKey MakeImageKey(const void* content, size_t length, const SkImageInfo&,
+                                 int encodingQuality, const SkPDF::Metadata&);
+
+    sk_sp<const SkPDFEncodedImage> findImage(const ImageKey&);
+    void addImage(const ImageKey&, sk_sp<const SkPDFEncodedImage>);
+    // Makes alias find the image already added under key, without holding its data twice.
+    void addImageAlias(const ImageKey& alias, const ImageKey& key);
+
+    // Returns the subset of the font made by SkPDFSubsetFont(), or nullptr if it isn't cached.
+    sk_sp<SkData> findFontSubset(uint32_t typefaceID, int ttcIndex,
+                                 const SkPDFGlyphUse&, SkPDF::Metadata::Subsetter);
+    void addFontSubset(uint32_t typefaceID, int ttcIndex,
+                       const SkPDFGlyphUse&, SkPDF::Metadata::Subsetter, sk_sp<SkData>);
+
+private:
+    struct FontKey {
+        uint32_t fTypefaceID;
+        int fTTCIndex;
+        SkPDF::Metadata::Subsetter fSubsetter;
+        std::vector<SkGlyphID> fGlyphs;
+
+        bool operator==(const FontKey& that) const {
+            return fTypefaceID == that.fTypefaceID &&
+                   fTTCIndex == that.fTTCIndex &&
+                   fSubsetter == that.fSubsetter &&
+                   fGlyphs == that.fGlyphs;
+        }
+    };
+    struct FontKeyHash {
+        uint32_t operator()(const FontKey&) const;
+    };
+    static FontKey MakeFontKey(uint32_t typefaceID, int ttcIndex,
+                               const SkPDFGlyphUse&, SkPDF::Metadata::Subsetter);
+
+    bool reserve(size_t bytes) SK_REQUIRES(fMutex);
+
+    const size_t fByteLimit;
+    mutable SkMutex fMutex;
+    size_t fBytesUsed SK_GUARDED_BY(fMutex) = 0;
+    std::atomic<int> fHitCount{0};
+    SkTHashMap<ImageKey, sk_sp<const SkPDFEncodedImage>> fImages SK_GUARDED_BY(fMutex);
+    SkTHashMap<FontKey, sk_sp<SkData>, FontKeyHash> fFontSubsets SK_GUARDED_BY(fMutex);
+};
+
+#endif  // SkPDFResourceCache_DEFINED
@@ -543,12 +543,21 @@ static void serialize_stream(SkPDFDict* origDict,
     SkPDFDict tmpDict;
     SkPDFDict& dict = origDict ? *origDict : tmpDict;
     static const size_t kMinimumSavings = strlen("/Filter_/FlateDecode_");
-    if (doc->metadata().fCompressionLevel != SkPDF::Metadata::CompressionLevel::None &&
-        compress == SkPDFSteamCompressionEnabled::Yes &&
-        stream->getLength() > kMinimumSavings)
-    {
+    int compressionLevel = 0;
+    if (compress == SkPDFSteamCompressionEnabled::Yes && stream->getLength() > kMinimumSavings) {
+        const void* sample = stream->getMemoryBase();
+        size_t sampleLength = stream->getLength();
+        uint8_t buffer[4096];
+        if (!sample && doc->metadata().fAdaptiveCompression) {
+            sampleLength = stream->read(buffer, sizeof(buffer));
+            SkAssertResult(stream->rewind());
+            sample = buffer;
+        }
+        compressionLevel = SkPDFUtils::DeflateLevel(doc->metadata(), sample, sampleLength);
+    }
+    if (compressionLevel != 0) {
         SkDynamicMemoryWStream compressedData;
-        SkDeflateWStream deflateWStream(&compressedData,SkToInt(doc->metadata().fCompressionLevel));
+        SkDeflateWStream deflateWStream(&compressedData, compressionLevel);
         SkStreamCopy(&deflateWStream, stream);
         deflateWStream.finalize();
         #ifdef SK_PDF_BASE85_BINARY
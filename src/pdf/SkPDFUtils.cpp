@@ -12,9 +12,11 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/private/base/SkFixed.h"
+#include "include/private/base/SkTo.h"
 #include "src/core/SkGeometry.h"
 #include "src/core/SkPathPriv.h"
 #include "src/image/SkImage_Base.h"
+#include "src/pdf/SkDeflate.h"
 #include "src/pdf/SkPDFResourceDict.h"
 #include "src/pdf/SkPDFTypes.h"
 
@@ -345,6 +347,26 @@ bool SkPDFUtils::ToBitmap(const SkImage* img, SkBitmap* dst) {
     return false;
 }
 
+int SkPDFUtils::DeflateLevel(const SkPDF::Metadata& metadata,
+                             const void* sample,
+                             size_t sampleLength) {
+    using CompressionLevel = SkPDF::Metadata::CompressionLevel;
+    if (metadata.fCompressionLevel == CompressionLevel::None) {
+        return 0;
+    }
+    if (metadata.fAdaptiveCompression) {
+        switch (SkDeflateClassifyContent(sample, sampleLength)) {
+            case SkDeflateContent::kGeneral:
+                break;
+            case SkDeflateContent::kRepetitive:
+                return SkToInt(CompressionLevel::LowButFast);
+            case SkDeflateContent::kIncompressible:
+                return 0;
+        }
+    }
+    return SkToInt(metadata.fCompressionLevel);
+}
+
 #ifdef SK_PDF_BASE85_BINARY
 void SkPDFUtils::Base85Encode(std::unique_ptr<SkStreamAsset> stream, SkDynamicMemoryWStream* dst) {
     SkASSERT(dst);
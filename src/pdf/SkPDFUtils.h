@@ -11,6 +11,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkShader.h"
 #include "include/core/SkStream.h"
+#include "include/docs/SkPDFDocument.h"
 #include "src/base/SkUTF.h"
 #include "src/base/SkUtils.h"
 #include "src/pdf/SkPDFTypes.h"
@@ -127,6 +128,10 @@ void PopulateTilingPatternDict(SkPDFDict* pattern,
 
 bool ToBitmap(const SkImage* img, SkBitmap* dst);
 
+// Returns the level to pass to SkDeflateWStream for data starting with (or sampled by) the
+// given bytes, or 0 if it should not be compressed at all.
+int DeflateLevel(const SkPDF::Metadata&, const void* sample, size_t sampleLength);
+
 #ifdef SK_PDF_BASE85_BINARY
 void Base85Encode(std::unique_ptr<SkStreamAsset> src, SkDynamicMemoryWStream* dst);
 #endif //  SK_PDF_BASE85_BINARY
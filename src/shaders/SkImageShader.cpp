@@ -255,7 +255,7 @@ SkShaderBase::Context* SkImageShader::onMakeContext(const ContextRec& rec,
         }
         return false;
     };
-    if (sampling.useCubic || !supported(sampling)) {
+    if (!sampling.useCubic && !supported(sampling)) {
         return nullptr;
     }
 
@@ -280,6 +280,11 @@ SkShaderBase::Context* SkImageShader::onMakeContext(const ContextRec& rec,
         return nullptr;
     }
 
+    // SkBitmapProcState only has a bicubic shader proc for scale+translate matrices.
+    if (sampling.useCubic && !inv.isScaleTranslate()) {
+        return nullptr;
+    }
+
     if (!rec.isLegacyCompatible(fImage->colorSpace())) {
         return nullptr;
     }
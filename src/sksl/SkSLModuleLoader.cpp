@@ -21,6 +21,7 @@
 #include "src/sksl/ir/SkSLVariable.h"
 
 #include <algorithm>
+#include <atomic>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -141,31 +142,50 @@ static constexpr BuiltinTypePtr kPrivateTypes[] = {
 
 #undef TYPE
 
+// Each built-in module is compiled under its own mutex, the first time it's requested, and is
+// then published for lock-free reads. A module's symbols are read-only once it's published, so
+// modules which only share ancestors (e.g. Public and GPU) can be compiled in parallel, and a
+// thread which needs an already-loaded module never waits on one that's loading another.
+namespace {
+
+struct ModuleSlot {
+    SkMutex fMutex;
+    std::atomic<const Module*> fModule{nullptr};
+    std::unique_ptr<const Module> fOwnedModule;
+    // Modules being compiled at the same time can't share a ModifiersPool.
+    std::unique_ptr<ModifiersPool> fModifiers;
+
+    // The caller must hold fMutex.
+    void unload() {
+        fMutex.assertHeld();
+        fModule.store(nullptr, std::memory_order_relaxed);
+        fOwnedModule = nullptr;
+        fModifiers = nullptr;
+    }
+};
+
+}  // namespace
+
 struct ModuleLoader::Impl {
     Impl();
 
     void makeRootSymbolTable();
 
-    // This mutex is taken when ModuleLoader::Get is called, and released when the returned
-    // ModuleLoader object falls out of scope.
-    SkMutex fMutex;
     const BuiltinTypes fBuiltinTypes;
     ModifiersPool fCoreModifiers;
 
     std::unique_ptr<const Module> fRootModule;
 
-    std::unique_ptr<const Module> fSharedModule;            // [Root] + Public intrinsics
-    std::unique_ptr<const Module> fGPUModule;               // [Shared] + Non-public intrinsics/
-                                                            //     helper functions
-    std::unique_ptr<const Module> fVertexModule;            // [GPU] + Vertex stage decls
-    std::unique_ptr<const Module> fFragmentModule;          // [GPU] + Fragment stage decls
-    std::unique_ptr<const Module> fComputeModule;           // [GPU] + Compute stage decls
-    std::unique_ptr<const Module> fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
-    std::unique_ptr<const Module> fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
-
-    std::unique_ptr<const Module> fPublicModule;            // [Shared] minus Private types +
-                                                            //     Runtime effect intrinsics
-    std::unique_ptr<const Module> fRuntimeShaderModule;     // [Public] + Runtime shader decls
+    ModuleSlot fSharedModule;            // [Root] + Public intrinsics
+    ModuleSlot fGPUModule;               // [Shared] + Non-public intrinsics/helper functions
+    ModuleSlot fVertexModule;            // [GPU] + Vertex stage decls
+    ModuleSlot fFragmentModule;          // [GPU] + Fragment stage decls
+    ModuleSlot fComputeModule;           // [GPU] + Compute stage decls
+    ModuleSlot fGraphiteVertexModule;    // [Vert] + Graphite vertex helpers
+    ModuleSlot fGraphiteFragmentModule;  // [Frag] + Graphite fragment helpers
+
+    ModuleSlot fPublicModule;            // [Shared] minus Private types + Runtime effect intrinsics
+    ModuleSlot fRuntimeShaderModule;     // [Public] + Runtime shader decls
 };
 
 ModuleLoader ModuleLoader::Get() {
@@ -173,24 +193,32 @@ ModuleLoader ModuleLoader::Get() {
     return ModuleLoader(*sModuleLoaderImpl);
 }
 
-ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {
-    fModuleLoader.fMutex.acquire();
-}
-
-ModuleLoader::~ModuleLoader() {
-    fModuleLoader.fMutex.release();
-}
+ModuleLoader::ModuleLoader(ModuleLoader::Impl& m) : fModuleLoader(m) {}
 
 void ModuleLoader::unloadModules() {
-    fModuleLoader.fSharedModule           = nullptr;
-    fModuleLoader.fGPUModule              = nullptr;
-    fModuleLoader.fVertexModule           = nullptr;
-    fModuleLoader.fFragmentModule         = nullptr;
-    fModuleLoader.fComputeModule          = nullptr;
-    fModuleLoader.fGraphiteVertexModule   = nullptr;
-    fModuleLoader.fGraphiteFragmentModule = nullptr;
-    fModuleLoader.fPublicModule           = nullptr;
-    fModuleLoader.fRuntimeShaderModule    = nullptr;
+    // Loads lock a module's slot before its parent's, so we take every lock in that same order.
+    // Holding them all waits out any load in progress, and keeps a child from being compiled
+    // against a parent that we're about to unload.
+    ModuleSlot* slots[] = {
+        &fModuleLoader.fRuntimeShaderModule,
+        &fModuleLoader.fPublicModule,
+        &fModuleLoader.fGraphiteFragmentModule,
+        &fModuleLoader.fGraphiteVertexModule,
+        &fModuleLoader.fComputeModule,
+        &fModuleLoader.fFragmentModule,
+        &fModuleLoader.fVertexModule,
+        &fModuleLoader.fGPUModule,
+        &fModuleLoader.fSharedModule,
+    };
+    for (ModuleSlot* slot : slots) {
+        slot->fMutex.acquire();
+    }
+    for (ModuleSlot* slot : slots) {
+        slot->unload();
+    }
+    for (ModuleSlot* slot : slots) {
+        slot->fMutex.release();
+    }
 }
 
 ModuleLoader::Impl::Impl() {
@@ -248,6 +276,23 @@ static std::unique_ptr<Module> compile_and_shrink(SkSL::Compiler* compiler,
     return m;
 }
 
+// Returns the slot's module, calling `compile` to create it (under the slot's mutex) if it hasn't
+// been loaded yet. Parent modules are loaded from inside `compile`, so locks are only ever taken
+// from child to parent.
+template <typename Fn>
+static const Module* load_module(ModuleSlot& slot, Fn&& compile) {
+    if (const Module* module = slot.fModule.load(std::memory_order_acquire)) {
+        return module;
+    }
+    SkAutoMutexExclusive lock(slot.fMutex);
+    if (!slot.fOwnedModule) {
+        slot.fModifiers = std::make_unique<ModifiersPool>();
+        slot.fOwnedModule = compile(*slot.fModifiers);
+        slot.fModule.store(slot.fOwnedModule.get(), std::memory_order_release);
+    }
+    return slot.fOwnedModule.get();
+}
+
 const BuiltinTypes& ModuleLoader::builtinTypes() {
     return fModuleLoader.fBuiltinTypes;
 }
@@ -299,103 +344,96 @@ void ModuleLoader::addPublicTypeAliases(const SkSL::Module* module) {
 }
 
 const Module* ModuleLoader::loadPublicModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fPublicModule) {
+    return load_module(fModuleLoader.fPublicModule, [&](ModifiersPool& modifiersPool) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fPublicModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kGeneric,
-                                                         MODULE_DATA(sksl_public),
-                                                         sharedModule,
-                                                         this->coreModifiers());
-        this->addPublicTypeAliases(fModuleLoader.fPublicModule.get());
-    }
-    return fModuleLoader.fPublicModule.get();
+        std::unique_ptr<Module> m = compile_and_shrink(compiler,
+                                                       ProgramKind::kGeneric,
+                                                       MODULE_DATA(sksl_public),
+                                                       sharedModule,
+                                                       modifiersPool);
+        this->addPublicTypeAliases(m.get());
+        return m;
+    });
 }
 
 const Module* ModuleLoader::loadPrivateRTShaderModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fRuntimeShaderModule) {
+    return load_module(fModuleLoader.fRuntimeShaderModule, [&](ModifiersPool& modifiersPool) {
         const Module* publicModule = this->loadPublicModule(compiler);
-        fModuleLoader.fRuntimeShaderModule = compile_and_shrink(compiler,
-                                                                ProgramKind::kFragment,
-                                                                MODULE_DATA(sksl_rt_shader),
-                                                                publicModule,
-                                                                this->coreModifiers());
-    }
-    return fModuleLoader.fRuntimeShaderModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_rt_shader),
+                                  publicModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadSharedModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fSharedModule) {
+    return load_module(fModuleLoader.fSharedModule, [&](ModifiersPool& modifiersPool) {
         const Module* rootModule = this->rootModule();
-        fModuleLoader.fSharedModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kFragment,
-                                                         MODULE_DATA(sksl_shared),
-                                                         rootModule,
-                                                         this->coreModifiers());
-    }
-    return fModuleLoader.fSharedModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_shared),
+                                  rootModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadGPUModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fGPUModule) {
+    return load_module(fModuleLoader.fGPUModule, [&](ModifiersPool& modifiersPool) {
         const Module* sharedModule = this->loadSharedModule(compiler);
-        fModuleLoader.fGPUModule = compile_and_shrink(compiler,
-                                                      ProgramKind::kFragment,
-                                                      MODULE_DATA(sksl_gpu),
-                                                      sharedModule,
-                                                      this->coreModifiers());
-    }
-    return fModuleLoader.fGPUModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_gpu),
+                                  sharedModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadFragmentModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fFragmentModule) {
+    return load_module(fModuleLoader.fFragmentModule, [&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fFragmentModule = compile_and_shrink(compiler,
-                                                           ProgramKind::kFragment,
-                                                           MODULE_DATA(sksl_frag),
-                                                           gpuModule,
-                                                           this->coreModifiers());
-    }
-    return fModuleLoader.fFragmentModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kFragment,
+                                  MODULE_DATA(sksl_frag),
+                                  gpuModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadVertexModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fVertexModule) {
+    return load_module(fModuleLoader.fVertexModule, [&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fVertexModule = compile_and_shrink(compiler,
-                                                         ProgramKind::kVertex,
-                                                         MODULE_DATA(sksl_vert),
-                                                         gpuModule,
-                                                         this->coreModifiers());
-    }
-    return fModuleLoader.fVertexModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kVertex,
+                                  MODULE_DATA(sksl_vert),
+                                  gpuModule,
+                                  modifiersPool);
+    });
 }
 
 const Module* ModuleLoader::loadComputeModule(SkSL::Compiler* compiler) {
-    if (!fModuleLoader.fComputeModule) {
+    return load_module(fModuleLoader.fComputeModule, [&](ModifiersPool& modifiersPool) {
         const Module* gpuModule = this->loadGPUModule(compiler);
-        fModuleLoader.fComputeModule = compile_and_shrink(compiler,
-                                                          ProgramKind::kCompute,
-                                                          MODULE_DATA(sksl_compute),
-                                                          gpuModule,
-                                                          this->coreModifiers());
-        add_compute_type_aliases(fModuleLoader.fComputeModule->fSymbols.get(),
-                                 this->builtinTypes());
-    }
-    return fModuleLoader.fComputeModule.get();
+        std::unique_ptr<Module> m = compile_and_shrink(compiler,
+                                                       ProgramKind::kCompute,
+                                                       MODULE_DATA(sksl_compute),
+                                                       gpuModule,
+                                                       modifiersPool);
+        add_compute_type_aliases(m->fSymbols.get(), this->builtinTypes());
+        return m;
+    });
 }
 
 const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler) {
 #if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteFragmentModule) {
+    return load_module(fModuleLoader.fGraphiteFragmentModule, [&](ModifiersPool& modifiersPool) {
         const Module* fragmentModule = this->loadFragmentModule(compiler);
-        fModuleLoader.fGraphiteFragmentModule = compile_and_shrink(compiler,
-                                                                   ProgramKind::kGraphiteFragment,
-                                                                   MODULE_DATA(sksl_graphite_frag),
-                                                                   fragmentModule,
-                                                                   this->coreModifiers());
-    }
-    return fModuleLoader.fGraphiteFragmentModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteFragment,
+                                  MODULE_DATA(sksl_graphite_frag),
+                                  fragmentModule,
+                                  modifiersPool);
+    });
 #else
     return this->loadFragmentModule(compiler);
 #endif
@@ -403,15 +441,14 @@ const Module* ModuleLoader::loadGraphiteFragmentModule(SkSL::Compiler* compiler)
 
 const Module* ModuleLoader::loadGraphiteVertexModule(SkSL::Compiler* compiler) {
 #if defined(SK_GRAPHITE)
-    if (!fModuleLoader.fGraphiteVertexModule) {
+    return load_module(fModuleLoader.fGraphiteVertexModule, [&](ModifiersPool& modifiersPool) {
         const Module* vertexModule = this->loadVertexModule(compiler);
-        fModuleLoader.fGraphiteVertexModule = compile_and_shrink(compiler,
-                                                                 ProgramKind::kGraphiteVertex,
-                                                                 MODULE_DATA(sksl_graphite_vert),
-                                                                 vertexModule,
-                                                                 this->coreModifiers());
-    }
-    return fModuleLoader.fGraphiteVertexModule.get();
+        return compile_and_shrink(compiler,
+                                  ProgramKind::kGraphiteVertex,
+                                  MODULE_DATA(sksl_graphite_vert),
+                                  vertexModule,
+                                  modifiersPool);
+    });
 #else
     return this->loadVertexModule(compiler);
 #endif
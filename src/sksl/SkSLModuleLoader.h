@@ -27,10 +27,9 @@ private:
 
 public:
     ModuleLoader(ModuleLoader::Impl&);
-    ~ModuleLoader();
 
-    // Acquires a mutex-locked reference to the singleton ModuleLoader. When the ModuleLoader is
-    // allowed to fall out of scope, the mutex will be released.
+    // Returns a reference to the singleton ModuleLoader. It's safe to load modules from several
+    // threads at once; each module is loaded under its own lock.
     static ModuleLoader Get();
 
     // The built-in types and root module are universal, immutable, and shared by every Compiler.
@@ -38,11 +37,13 @@ public:
     const BuiltinTypes& builtinTypes();
     const Module* rootModule();
 
-    // This ModifiersPool is shared by every built-in module.
+    // This ModifiersPool holds the root module's modifiers. It isn't locked, so it's only meant for
+    // tools which compile modules on a single thread; each built-in module gets a pool of its own.
     ModifiersPool& coreModifiers();
 
-    // These modules are loaded on demand; once loaded, they are kept for the lifetime of the
-    // process.
+    // These modules are loaded on demand, along with their parent modules; once loaded, they are
+    // kept for the lifetime of the process. A thread loading one module doesn't block threads
+    // loading modules other than its ancestors.
     const Module* loadSharedModule(SkSL::Compiler* compiler);
     const Module* loadGPUModule(SkSL::Compiler* compiler);
     const Module* loadVertexModule(SkSL::Compiler* compiler);
@@ -58,7 +59,8 @@ public:
     // `vec4` are added; SkSL private types like `sampler2D` are replaced with an invalid type.
     void addPublicTypeAliases(const SkSL::Module* module);
 
-    // This unloads every module. It's useful primarily for benchmarking purposes.
+    // This unloads every module. It's useful primarily for benchmarking purposes, and must not be
+    // called while other threads are using the modules.
     void unloadModules();
 };
 
@@ -21,6 +21,8 @@
 
 #if !defined(SKSL_STANDALONE)
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
 #endif
 
 #include <algorithm>
@@ -91,7 +93,46 @@ namespace RP {
 
 #define ALL_MULTI_SLOT_TERNARY_OP_CASES \
          BuilderOp::mix_n_floats:       \
-    case BuilderOp::mix_n_ints
+    case BuilderOp::mix_n_ints:         \
+    case BuilderOp::mad_n_floats
+
+#define ALL_IMMEDIATE_BINARY_OP_CASES      \
+         BuilderOp::add_imm_float:         \
+    case BuilderOp::add_imm_int:           \
+    case BuilderOp::mul_imm_float:         \
+    case BuilderOp::mul_imm_int:           \
+    case BuilderOp::bitwise_and_imm_int:   \
+    case BuilderOp::bitwise_xor_imm_int:   \
+    case BuilderOp::min_imm_float:         \
+    case BuilderOp::max_imm_float:         \
+    case BuilderOp::cmplt_imm_float:       \
+    case BuilderOp::cmplt_imm_int:         \
+    case BuilderOp::cmplt_imm_uint:        \
+    case BuilderOp::cmple_imm_float:       \
+    case BuilderOp::cmple_imm_int:         \
+    case BuilderOp::cmple_imm_uint:        \
+    case BuilderOp::cmpeq_imm_float:       \
+    case BuilderOp::cmpeq_imm_int:         \
+    case BuilderOp::cmpne_imm_float:       \
+    case BuilderOp::cmpne_imm_int
+
+std::atomic<bool> gFuseStages{true};
+
+// Returns the widest vector that an ALL_IMMEDIATE_BINARY_OP_CASES op has a stage for.
+static int immediate_op_max_slots(BuilderOp immOp) {
+    // Only the most common ops have specializations for 2-4 slots.
+    switch (immOp) {
+        case BuilderOp::add_imm_float:
+        case BuilderOp::add_imm_int:
+        case BuilderOp::mul_imm_float:
+        case BuilderOp::mul_imm_int:
+        case BuilderOp::bitwise_and_imm_int:
+            return 4;
+
+        default:
+            return 1;
+    }
+}
 
 void Builder::unary_op(BuilderOp op, int32_t slots) {
     switch (op) {
@@ -110,6 +151,10 @@ void Builder::binary_op(BuilderOp op, int32_t slots) {
     switch (op) {
         case ALL_N_WAY_BINARY_OP_CASES:
         case ALL_MULTI_SLOT_BINARY_OP_CASES:
+            if (gFuseStages &&
+                (this->fuseImmediateBinaryOp(op, slots) || this->fuseMultiplyAdd(op, slots))) {
+                break;
+            }
             fInstructions.push_back({op, {}, slots});
             break;
 
@@ -119,6 +164,117 @@ void Builder::binary_op(BuilderOp op, int32_t slots) {
     }
 }
 
+bool Builder::fuseImmediateBinaryOp(BuilderOp op, int32_t slots) {
+    // The right-hand side must be a single value, pushed as a literal or as zeros, and splatted
+    // across every slot.
+    if (fInstructions.size() < slots) {
+        return false;
+    }
+    const Instruction& lastInstruction = fInstructions.back();
+    int value;
+    if (lastInstruction.fOp == BuilderOp::push_zeros && lastInstruction.fImmA >= slots) {
+        value = 0;
+    } else if (lastInstruction.fOp == BuilderOp::push_literal) {
+        value = lastInstruction.fImmA;
+        for (int index = 1; index < slots; ++index) {
+            const Instruction& inst = fInstructions.fromBack(index);
+            if (inst.fOp != BuilderOp::push_literal || inst.fImmA != value) {
+                return false;
+            }
+        }
+    } else {
+        return false;
+    }
+
+    // Pick the immediate-operand op. Subtraction becomes the addition of the negated literal;
+    // flipping the sign bit negates a float exactly.
+    BuilderOp immOp;
+    switch (op) {
+        case BuilderOp::sub_n_floats:
+            value ^= 0x80000000;
+            [[fallthrough]];
+        case BuilderOp::add_n_floats:       immOp = BuilderOp::add_imm_float;       break;
+        case BuilderOp::sub_n_ints:
+            value = (int)(0u - (uint32_t)value);
+            [[fallthrough]];
+        case BuilderOp::add_n_ints:         immOp = BuilderOp::add_imm_int;         break;
+        case BuilderOp::mul_n_floats:       immOp = BuilderOp::mul_imm_float;       break;
+        case BuilderOp::mul_n_ints:         immOp = BuilderOp::mul_imm_int;         break;
+        case BuilderOp::bitwise_and_n_ints: immOp = BuilderOp::bitwise_and_imm_int; break;
+        case BuilderOp::bitwise_xor_n_ints: immOp = BuilderOp::bitwise_xor_imm_int; break;
+        case BuilderOp::min_n_floats:       immOp = BuilderOp::min_imm_float;       break;
+        case BuilderOp::max_n_floats:       immOp = BuilderOp::max_imm_float;       break;
+        case BuilderOp::cmplt_n_floats:     immOp = BuilderOp::cmplt_imm_float;     break;
+        case BuilderOp::cmplt_n_ints:       immOp = BuilderOp::cmplt_imm_int;       break;
+        case BuilderOp::cmplt_n_uints:      immOp = BuilderOp::cmplt_imm_uint;      break;
+        case BuilderOp::cmple_n_floats:     immOp = BuilderOp::cmple_imm_float;     break;
+        case BuilderOp::cmple_n_ints:       immOp = BuilderOp::cmple_imm_int;       break;
+        case BuilderOp::cmple_n_uints:      immOp = BuilderOp::cmple_imm_uint;      break;
+        case BuilderOp::cmpeq_n_floats:     immOp = BuilderOp::cmpeq_imm_float;     break;
+        case BuilderOp::cmpeq_n_ints:       immOp = BuilderOp::cmpeq_imm_int;       break;
+        case BuilderOp::cmpne_n_floats:     immOp = BuilderOp::cmpne_imm_float;     break;
+        case BuilderOp::cmpne_n_ints:       immOp = BuilderOp::cmpne_imm_int;       break;
+        default:                            return false;
+    }
+
+    if (slots > immediate_op_max_slots(immOp)) {
+        return false;
+    }
+
+    // Remove the pushed value, and apply the op to the left-hand side in place.
+    if (lastInstruction.fOp == BuilderOp::push_zeros) {
+        this->discard_stack(slots);
+    } else {
+        fInstructions.pop_back_n(slots);
+    }
+    fInstructions.push_back({immOp, {}, slots, value});
+    return true;
+}
+
+bool Builder::fuseMultiplyAdd(BuilderOp op, int32_t slots) {
+    if (op != BuilderOp::add_n_floats) {
+        return false;
+    }
+    // Look for `mul_n_floats`, followed by pushes of exactly `slots` values that don't depend on
+    // the stack, followed by this add. The multiply's operands and the addend are then adjacent on
+    // the stack, and a single `mad` can consume all three.
+    int numPushed = 0;
+    int index = 0;
+    for (; numPushed < slots && index < fInstructions.size(); ++index) {
+        const Instruction& inst = fInstructions.fromBack(index);
+        switch (inst.fOp) {
+            case BuilderOp::push_literal:
+                numPushed += 1;
+                break;
+
+            case BuilderOp::push_slots:
+            case BuilderOp::push_uniform:
+            case BuilderOp::push_zeros:
+                numPushed += inst.fImmA;
+                break;
+
+            default:
+                return false;
+        }
+    }
+    if (numPushed != slots || index >= fInstructions.size()) {
+        return false;
+    }
+    const Instruction& mulInstruction = fInstructions.fromBack(index);
+    if (mulInstruction.fOp != BuilderOp::mul_n_floats || mulInstruction.fImmA != slots) {
+        return false;
+    }
+
+    // Remove the multiply, sliding the pushes back into its place.
+    for (int mulIdx = fInstructions.size() - 1 - index; mulIdx < fInstructions.size() - 1;
+         ++mulIdx) {
+        fInstructions[mulIdx] = fInstructions[mulIdx + 1];
+    }
+    fInstructions.pop_back();
+    fInstructions.push_back({BuilderOp::mad_n_floats, {}, slots});
+    return true;
+}
+
 void Builder::ternary_op(BuilderOp op, int32_t slots) {
     switch (op) {
         case ALL_MULTI_SLOT_TERNARY_OP_CASES:
@@ -337,6 +493,17 @@ void Builder::push_duplicates(int count) {
             lastInstruction.fImmA += count;
             return;
         }
+
+        // If the previous op is pushing a literal, we can push more copies of it. A splatted
+        // literal can then be fused into the op that consumes it, and `makeStages` writes the run
+        // of literals with one op instead of a push followed by a swizzle.
+        if (gFuseStages && lastInstruction.fOp == BuilderOp::push_literal) {
+            int value = lastInstruction.fImmA;
+            for (; count > 0; --count) {
+                fInstructions.push_back({BuilderOp::push_literal, {}, value});
+            }
+            return;
+        }
     }
     SkASSERT(count >= 0);
     if (count >= 3) {
@@ -824,6 +991,34 @@ static int stack_usage(const Instruction& inst) {
     }
 }
 
+// Collects the constants written by a run of instructions into adjacent slots, starting with the
+// push_literal or copy_constant at `index`. Runs of pushes can include push_zeros; runs of copies
+// into value slots can include zero_slot_unmasked. Returns the number of instructions in the run.
+static int gather_constant_run(const SkTArray<Instruction>& instrs, int index,
+                               SkTArray<int>* values) {
+    const bool onStack = (instrs[index].fOp == BuilderOp::push_literal);
+    Slot nextSlot = instrs[index].fSlotA;
+    int end = index;
+    for (; end < instrs.size(); ++end) {
+        const Instruction& inst = instrs[end];
+        if (onStack && inst.fOp == BuilderOp::push_literal) {
+            values->push_back(inst.fImmA);
+        } else if (onStack && inst.fOp == BuilderOp::push_zeros) {
+            values->push_back_n(inst.fImmA, 0);
+        } else if (!onStack && inst.fOp == BuilderOp::copy_constant && inst.fSlotA == nextSlot) {
+            values->push_back(inst.fImmA);
+            nextSlot += 1;
+        } else if (!onStack && inst.fOp == BuilderOp::zero_slot_unmasked &&
+                   inst.fSlotA == nextSlot) {
+            values->push_back_n(inst.fImmA, 0);
+            nextSlot += inst.fImmA;
+        } else {
+            break;
+        }
+    }
+    return end - index;
+}
+
 Program::StackDepthMap Program::tempStackMaxDepths() const {
     StackDepthMap largest;
     StackDepthMap current;
@@ -1032,6 +1227,313 @@ Program::SlotData Program::allocateSlotData(SkArenaAlloc* alloc) const {
 
 #if !defined(SKSL_STANDALONE)
 
+void Program::serialize(SkWriteBuffer& buffer) const {
+    buffer.writeInt(fNumValueSlots);
+    buffer.writeInt(fNumUniformSlots);
+    buffer.writeInt(fNumLabels);
+    buffer.writeInt(fInstructions.size());
+    for (const Instruction& inst : fInstructions) {
+        buffer.writeInt((int)inst.fOp);
+        buffer.writeInt(inst.fSlotA);
+        buffer.writeInt(inst.fSlotB);
+        buffer.writeInt(inst.fSlotC);
+        buffer.writeInt(inst.fImmA);
+        buffer.writeInt(inst.fImmB);
+        buffer.writeInt(inst.fImmC);
+    }
+}
+
+// A deserialized program can't use more slots, stack entries or labels than this. It keeps the
+// sizes computed by allocateSlotData() and appendStages() well away from overflowing.
+static constexpr int kMaxDeserializedSlots = 1 << 20;
+
+// Returns the largest of the first `count` nybbles in `components`.
+static int max_nybble(uint32_t components, int count) {
+    int result = 0;
+    for (int index = 0; index < count; ++index) {
+        result = std::max(result, (int)(components & 0xF));
+        components >>= 4;
+    }
+    return result;
+}
+
+// Checks every instruction of a deserialized program against the ranges that makeStages() and
+// appendStages() rely on: slots must lie inside the value or uniform buffer that the op reads,
+// ops must not pop more entries than their stack holds, and labels and children must exist.
+static bool validate_instructions(const SkTArray<Instruction>& instrs,
+                                  int numValueSlots,
+                                  int numUniformSlots,
+                                  int numLabels,
+                                  int numChildren) {
+    auto IsCount = [](int count) { return count >= 1 && count <= kMaxDeserializedSlots; };
+    auto IsValueRange = [&](Slot slot, int count) {
+        return IsCount(count) && slot >= 0 && slot <= numValueSlots - count;
+    };
+    auto IsUniformRange = [&](Slot slot, int count) {
+        return IsCount(count) && slot >= 0 && slot <= numUniformSlots - count;
+    };
+    auto IsLabel = [&](int labelID) { return labelID >= 0 && labelID < numLabels; };
+
+    SkBitSet labelsDefined(numLabels);
+    SkBitSet labelsTargeted(numLabels);
+    SkTHashMap<int, int> depths; // <stack index, depth of stack>
+    SkTHashMap<int, int> largest;
+    int currentStack = 0;
+
+    for (const Instruction& inst : instrs) {
+        const int a = inst.fImmA;
+        const int b = inst.fImmB;
+        const int c = inst.fImmC;
+        const int depth = depths[currentStack];
+        auto Needs = [&](int count) { return IsCount(count) && count <= depth; };
+
+        bool valid;
+        switch (inst.fOp) {
+            case BuilderOp::label:
+                valid = IsLabel(a) && !labelsDefined.test(a);
+                if (valid) {
+                    labelsDefined.set(a);
+                }
+                break;
+
+            case BuilderOp::jump:
+            case BuilderOp::branch_if_any_active_lanes:
+            case BuilderOp::branch_if_no_active_lanes:
+                valid = IsLabel(a);
+                if (valid) {
+                    labelsTargeted.set(a);
+                }
+                break;
+
+            case BuilderOp::branch_if_no_active_lanes_on_stack_top_equal:
+                valid = IsLabel(a) && Needs(1);
+                if (valid) {
+                    labelsTargeted.set(a);
+                }
+                break;
+
+            case BuilderOp::init_lane_masks:
+            case BuilderOp::mask_off_loop_mask:
+            case BuilderOp::mask_off_return_mask:
+            case BuilderOp::push_literal:
+            case BuilderOp::push_src_rgba:
+            case BuilderOp::push_dst_rgba:
+            case BuilderOp::push_condition_mask:
+            case BuilderOp::push_loop_mask:
+            case BuilderOp::push_return_mask:
+                valid = true;
+                break;
+
+            case BuilderOp::store_src_rg:
+                valid = IsValueRange(inst.fSlotA, 2);
+                break;
+
+            case BuilderOp::store_src:
+            case BuilderOp::store_dst:
+            case BuilderOp::store_device_xy01:
+            case BuilderOp::load_src:
+            case BuilderOp::load_dst:
+                valid = IsValueRange(inst.fSlotA, 4);
+                break;
+
+            case BuilderOp::reenable_loop_mask:
+            case BuilderOp::copy_constant:
+                valid = IsValueRange(inst.fSlotA, 1);
+                break;
+
+            case ALL_SINGLE_SLOT_UNARY_OP_CASES:
+            case ALL_MULTI_SLOT_UNARY_OP_CASES:
+            case BuilderOp::discard_stack:
+                valid = Needs(a);
+                break;
+
+            case ALL_N_WAY_BINARY_OP_CASES:
+            case ALL_MULTI_SLOT_BINARY_OP_CASES:
+            case BuilderOp::select:
+                valid = IsCount(a) && Needs(2 * a);
+                break;
+
+            case ALL_IMMEDIATE_BINARY_OP_CASES:
+                // The stage is picked by adding the slot count to the op.
+                valid = a >= 1 && a <= immediate_op_max_slots(inst.fOp) && Needs(a);
+                break;
+
+            case ALL_MULTI_SLOT_TERNARY_OP_CASES:
+                valid = IsCount(a) && Needs(3 * a);
+                break;
+
+            case BuilderOp::copy_slot_masked:
+            case BuilderOp::copy_slot_unmasked:
+                valid = IsValueRange(inst.fSlotA, a) && IsValueRange(inst.fSlotB, a);
+                break;
+
+            case BuilderOp::zero_slot_unmasked:
+            case BuilderOp::push_slots:
+                valid = IsValueRange(inst.fSlotA, a);
+                break;
+
+            case BuilderOp::push_uniform:
+                valid = IsUniformRange(inst.fSlotA, a);
+                break;
+
+            case BuilderOp::push_zeros:
+                valid = IsCount(a);
+                break;
+
+            case BuilderOp::dot_2_floats:
+            case BuilderOp::dot_3_floats:
+            case BuilderOp::dot_4_floats: {
+                int width = (int)inst.fOp - (int)BuilderOp::dot_2_floats + 2;
+                valid = (a == width) && Needs(2 * a);
+                break;
+            }
+            case BuilderOp::swizzle_1:
+            case BuilderOp::swizzle_2:
+            case BuilderOp::swizzle_3:
+            case BuilderOp::swizzle_4: {
+                int generated = (int)inst.fOp - (int)BuilderOp::swizzle_1 + 1;
+                valid = a <= 4 && Needs(a) && max_nybble(b, generated) < a;
+                break;
+            }
+            case BuilderOp::shuffle: {
+                int consumed = a >> 16;
+                int generated = a & 0xFFFF;
+                valid = generated >= 1 && generated <= 16 && consumed <= 16 && Needs(consumed) &&
+                        max_nybble(b, std::min(generated, 8)) < consumed &&
+                        max_nybble(c, std::max(generated - 8, 0)) < consumed;
+                break;
+            }
+            case BuilderOp::pop_src_rg:
+            case BuilderOp::merge_condition_mask:
+            case BuilderOp::case_op:
+                valid = Needs(2);
+                break;
+
+            case BuilderOp::pop_src_rgba:
+            case BuilderOp::pop_dst_rgba:
+                valid = Needs(4);
+                break;
+
+            case BuilderOp::pop_condition_mask:
+            case BuilderOp::pop_loop_mask:
+            case BuilderOp::pop_and_reenable_loop_mask:
+            case BuilderOp::merge_loop_mask:
+            case BuilderOp::pop_return_mask:
+                valid = Needs(1);
+                break;
+
+            case BuilderOp::copy_stack_to_slots:
+            case BuilderOp::copy_stack_to_slots_unmasked:
+                valid = IsCount(a) && a <= b && Needs(b) && IsValueRange(inst.fSlotA, a);
+                break;
+
+            case BuilderOp::swizzle_copy_stack_to_slots:
+                // The stage is picked by adding the slot count to swizzle_copy_slot_masked.
+                valid = a >= 1 && a <= 4 && a <= b && Needs(b) &&
+                        IsValueRange(inst.fSlotA, max_nybble(c, a) + 1);
+                break;
+
+            case BuilderOp::push_clone:
+                valid = IsCount(a) && a <= b && Needs(b);
+                break;
+
+            case BuilderOp::push_clone_from_stack: {
+                const int* otherDepth = depths.find(b);
+                valid = IsCount(a) && a <= c && otherDepth && c <= *otherDepth;
+                break;
+            }
+            case BuilderOp::set_current_stack:
+                valid = a >= 0 && a < kMaxDeserializedSlots;
+                currentStack = a;
+                break;
+
+            case BuilderOp::invoke_shader:
+            case BuilderOp::invoke_color_filter:
+            case BuilderOp::invoke_blender:
+                valid = a >= 0 && a < numChildren;
+                break;
+
+            default:
+                // makeStages() has no conversion for this op.
+                valid = false;
+                break;
+        }
+        if (!valid) {
+            return false;
+        }
+
+        int& newDepth = depths[currentStack];
+        newDepth += stack_usage(inst);
+        if (newDepth < 0 || newDepth > kMaxDeserializedSlots) {
+            return false;
+        }
+        int& largestDepth = largest[currentStack];
+        largestDepth = std::max(largestDepth, newDepth);
+    }
+
+    // Every stack must be balanced, and together they must fit in the slot data.
+    for (const auto& [stackIdx, depth] : depths) {
+        (void)stackIdx;
+        if (depth != 0) {
+            return false;
+        }
+    }
+    int totalStackSlots = 0;
+    for (const auto& [stackIdx, depth] : largest) {
+        (void)stackIdx;
+        totalStackSlots += depth;
+        if (numValueSlots + totalStackSlots > kMaxDeserializedSlots) {
+            return false;
+        }
+    }
+
+    // Every branch must land on a label.
+    for (int labelID = 0; labelID < numLabels; ++labelID) {
+        if (labelsTargeted.test(labelID) && !labelsDefined.test(labelID)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+std::unique_ptr<Program> Program::Deserialize(SkReadBuffer& buffer,
+                                              int numUniformSlots,
+                                              int numChildren) {
+    const int numValueSlots = buffer.checkInt(0, kMaxDeserializedSlots);
+    const int numStoredUniformSlots = buffer.readInt();
+    const int numLabels = buffer.checkInt(0, kMaxDeserializedSlots);
+    const int numInstructions = buffer.readInt();
+    // Each instruction takes up seven ints.
+    if (!buffer.validate(numStoredUniformSlots == numUniformSlots && numInstructions >= 0) ||
+        !buffer.validateCanReadN<int32_t>(7 * (size_t)numInstructions)) {
+        return nullptr;
+    }
+
+    SkTArray<Instruction> instrs;
+    instrs.reserve_back(numInstructions);
+    for (int i = 0; i < numInstructions; ++i) {
+        auto op = buffer.checkRange((BuilderOp)0, BuilderOp::unsupported);
+        Slot slots[3];
+        for (Slot& slot : slots) {
+            slot = buffer.readInt();
+        }
+        int immA = buffer.readInt();
+        int immB = buffer.readInt();
+        int immC = buffer.readInt();
+        Instruction& inst = instrs.push_back(Instruction{op, {}, immA, immB, immC});
+        inst.fSlotA = slots[0];
+        inst.fSlotB = slots[1];
+        inst.fSlotC = slots[2];
+    }
+    if (!buffer.isValid() ||
+        !buffer.validate(validate_instructions(instrs, numValueSlots, numUniformSlots, numLabels,
+                                               numChildren))) {
+        return nullptr;
+    }
+    return std::make_unique<Program>(std::move(instrs), numValueSlots, numUniformSlots, numLabels,
+                                     /*debugTrace=*/nullptr);
+}
+
 bool Program::appendStages(SkRasterPipeline* pipeline,
                            SkArenaAlloc* alloc,
                            RP::Callbacks* callbacks,
@@ -1158,7 +1660,8 @@ void Program::makeStages(SkTArray<Stage>* pipeline,
 
     // Write each BuilderOp to the pipeline array.
     pipeline->reserve_back(fInstructions.size());
-    for (const Instruction& inst : fInstructions) {
+    for (int instIdx = 0; instIdx < fInstructions.size(); ++instIdx) {
+        const Instruction& inst = fInstructions[instIdx];
         auto SlotA    = [&]() { return &slots.values[N * inst.fSlotA]; };
         auto SlotB    = [&]() { return &slots.values[N * inst.fSlotB]; };
         auto UniformA = [&]() { return &uniforms[inst.fSlotA]; };
@@ -1245,6 +1748,14 @@ void Program::makeStages(SkTArray<Stage>* pipeline,
                                                       dst, src, inst.fImmA);
                 break;
             }
+            case ALL_IMMEDIATE_BINARY_OP_CASES: {
+                auto* ctx = alloc->make<SkRasterPipeline_ConstantCtx>();
+                ctx->value = inst.fImmB;
+                ctx->dst = tempStackPtr - (inst.fImmA * N);
+                auto stage = (ProgramOp)((int)inst.fOp + inst.fImmA - 1);
+                pipeline->push_back({stage, ctx});
+                break;
+            }
             case ALL_MULTI_SLOT_TERNARY_OP_CASES: {
                 float* src1 = tempStackPtr - (inst.fImmA * N);
                 float* src0 = tempStackPtr - (inst.fImmA * 2 * N);
@@ -1404,6 +1915,24 @@ void Program::makeStages(SkTArray<Stage>* pipeline,
             case BuilderOp::copy_constant:
             case BuilderOp::push_literal: {
                 float* dst = (inst.fOp == BuilderOp::push_literal) ? tempStackPtr : SlotA();
+                if (gFuseStages) {
+                    // Write a run of constants into adjacent slots from a single array.
+                    SkSTArray<16, int> values;
+                    int runLength = gather_constant_run(fInstructions, instIdx, &values);
+                    if (runLength > 1) {
+                        int* constants = alloc->makeArrayDefault<int>(values.size());
+                        std::copy(values.begin(), values.end(), constants);
+                        this->appendCopyConstants(pipeline, alloc, dst, (float*)constants,
+                                                  values.size());
+                        // Skip over the rest of the run; the first instruction's stack usage is
+                        // accounted for below.
+                        for (int index = 1; index < runLength; ++index) {
+                            tempStackPtr += stack_usage(fInstructions[instIdx + index]) * N;
+                        }
+                        instIdx += runLength - 1;
+                        break;
+                    }
+                }
                 int* constantPtr;
                 if (int** lookup = constantLookupMap.find(inst.fImmA)) {
                     constantPtr = *lookup;
@@ -1789,6 +2318,29 @@ void Program::dump(SkWStream* out) const {
             return src;
         };
 
+        // Interpret the context value as a Constant structure, for an immediate-operand op.
+        auto ImmediateCtx = [&](ProgramOp op, const void* v,
+                                int numSlots) -> std::tuple<std::string, std::string> {
+            const auto* ctx = static_cast<const SkRasterPipeline_ConstantCtx*>(v);
+            bool isFloat = false;
+            switch (op) {
+                case ProgramOp::add_imm_float:    case ProgramOp::add_imm_2_floats:
+                case ProgramOp::add_imm_3_floats: case ProgramOp::add_imm_4_floats:
+                case ProgramOp::mul_imm_float:    case ProgramOp::mul_imm_2_floats:
+                case ProgramOp::mul_imm_3_floats: case ProgramOp::mul_imm_4_floats:
+                case ProgramOp::min_imm_float:    case ProgramOp::max_imm_float:
+                case ProgramOp::cmplt_imm_float:  case ProgramOp::cmple_imm_float:
+                case ProgramOp::cmpeq_imm_float:  case ProgramOp::cmpne_imm_float:
+                    isFloat = true;
+                    break;
+
+                default:
+                    break;
+            }
+            return std::make_tuple(PtrCtx(ctx->dst, numSlots),
+                                   Imm(sk_bit_cast<float>(ctx->value), isFloat));
+        };
+
         // Interpret the context value as a Swizzle structure.
         auto SwizzleCtx = [&](ProgramOp op, const void* v) -> std::tuple<std::string, std::string> {
             const auto* ctx = static_cast<const SkRasterPipeline_SwizzleCtx*>(v);
@@ -1989,7 +2541,7 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2) = AdjacentPtrCtx(stage.ctx, 1);
                 break;
 
-            case POp::mix_float:   case POp::mix_int:
+            case POp::mix_float:   case POp::mix_int:   case POp::mad_float:
                 std::tie(opArg1, opArg2, opArg3) = Adjacent3PtrCtx(stage.ctx, 1);
                 break;
 
@@ -2009,7 +2561,7 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2) = AdjacentPtrCtx(stage.ctx, 2);
                 break;
 
-            case POp::mix_2_floats:   case POp::mix_2_ints:
+            case POp::mix_2_floats:   case POp::mix_2_ints:   case POp::mad_2_floats:
                 std::tie(opArg1, opArg2, opArg3) = Adjacent3PtrCtx(stage.ctx, 2);
                 break;
 
@@ -2029,7 +2581,7 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2) = AdjacentPtrCtx(stage.ctx, 3);
                 break;
 
-            case POp::mix_3_floats:   case POp::mix_3_ints:
+            case POp::mix_3_floats:   case POp::mix_3_ints:   case POp::mad_3_floats:
                 std::tie(opArg1, opArg2, opArg3) = Adjacent3PtrCtx(stage.ctx, 3);
                 break;
 
@@ -2049,7 +2601,7 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2) = AdjacentPtrCtx(stage.ctx, 4);
                 break;
 
-            case POp::mix_4_floats:   case POp::mix_4_ints:
+            case POp::mix_4_floats:   case POp::mix_4_ints:   case POp::mad_4_floats:
                 std::tie(opArg1, opArg2, opArg3) = Adjacent3PtrCtx(stage.ctx, 4);
                 break;
 
@@ -2071,10 +2623,40 @@ void Program::dump(SkWStream* out) const {
                 std::tie(opArg1, opArg2) = AdjacentBinaryOpCtx(stage.ctx);
                 break;
 
-            case POp::mix_n_floats:   case POp::mix_n_ints:
+            case POp::mix_n_floats:   case POp::mix_n_ints:   case POp::mad_n_floats:
                 std::tie(opArg1, opArg2, opArg3) = AdjacentTernaryOpCtx(stage.ctx);
                 break;
 
+            case POp::add_imm_float:    case POp::add_imm_int:
+            case POp::mul_imm_float:    case POp::mul_imm_int:
+            case POp::bitwise_and_imm_int:
+            case POp::bitwise_xor_imm_int:
+            case POp::min_imm_float:    case POp::max_imm_float:
+            case POp::cmplt_imm_float:  case POp::cmplt_imm_int:  case POp::cmplt_imm_uint:
+            case POp::cmple_imm_float:  case POp::cmple_imm_int:  case POp::cmple_imm_uint:
+            case POp::cmpeq_imm_float:  case POp::cmpeq_imm_int:
+            case POp::cmpne_imm_float:  case POp::cmpne_imm_int:
+                std::tie(opArg1, opArg2) = ImmediateCtx(stage.op, stage.ctx, 1);
+                break;
+
+            case POp::add_imm_2_floats: case POp::add_imm_2_ints:
+            case POp::mul_imm_2_floats: case POp::mul_imm_2_ints:
+            case POp::bitwise_and_imm_2_ints:
+                std::tie(opArg1, opArg2) = ImmediateCtx(stage.op, stage.ctx, 2);
+                break;
+
+            case POp::add_imm_3_floats: case POp::add_imm_3_ints:
+            case POp::mul_imm_3_floats: case POp::mul_imm_3_ints:
+            case POp::bitwise_and_imm_3_ints:
+                std::tie(opArg1, opArg2) = ImmediateCtx(stage.op, stage.ctx, 3);
+                break;
+
+            case POp::add_imm_4_floats: case POp::add_imm_4_ints:
+            case POp::mul_imm_4_floats: case POp::mul_imm_4_ints:
+            case POp::bitwise_and_imm_4_ints:
+                std::tie(opArg1, opArg2) = ImmediateCtx(stage.op, stage.ctx, 4);
+                break;
+
             case POp::jump:
             case POp::branch_if_any_active_lanes:
             case POp::branch_if_no_active_lanes:
@@ -2186,6 +2768,10 @@ void Program::dump(SkWStream* out) const {
             case POp::bitwise_and_3_ints:
             case POp::bitwise_and_4_ints:
             case POp::bitwise_and_n_ints:
+            case POp::bitwise_and_imm_int:
+            case POp::bitwise_and_imm_2_ints:
+            case POp::bitwise_and_imm_3_ints:
+            case POp::bitwise_and_imm_4_ints:
                 opText = opArg1 + " &= " + opArg2;
                 break;
 
@@ -2202,6 +2788,7 @@ void Program::dump(SkWStream* out) const {
             case POp::bitwise_xor_3_ints:
             case POp::bitwise_xor_4_ints:
             case POp::bitwise_xor_n_ints:
+            case POp::bitwise_xor_imm_int:
                 opText = opArg1 + " ^= " + opArg2;
                 break;
 
@@ -2326,6 +2913,10 @@ void Program::dump(SkWStream* out) const {
             case POp::add_3_floats: case POp::add_3_ints:
             case POp::add_4_floats: case POp::add_4_ints:
             case POp::add_n_floats: case POp::add_n_ints:
+            case POp::add_imm_float:    case POp::add_imm_int:
+            case POp::add_imm_2_floats: case POp::add_imm_2_ints:
+            case POp::add_imm_3_floats: case POp::add_imm_3_ints:
+            case POp::add_imm_4_floats: case POp::add_imm_4_ints:
                 opText = opArg1 + " += " + opArg2;
                 break;
 
@@ -2342,6 +2933,10 @@ void Program::dump(SkWStream* out) const {
             case POp::mul_3_floats: case POp::mul_3_ints:
             case POp::mul_4_floats: case POp::mul_4_ints:
             case POp::mul_n_floats: case POp::mul_n_ints:
+            case POp::mul_imm_float:    case POp::mul_imm_int:
+            case POp::mul_imm_2_floats: case POp::mul_imm_2_ints:
+            case POp::mul_imm_3_floats: case POp::mul_imm_3_ints:
+            case POp::mul_imm_4_floats: case POp::mul_imm_4_ints:
                 opText = opArg1 + " *= " + opArg2;
                 break;
 
@@ -2358,6 +2953,7 @@ void Program::dump(SkWStream* out) const {
             case POp::min_3_floats: case POp::min_3_ints: case POp::min_3_uints:
             case POp::min_4_floats: case POp::min_4_ints: case POp::min_4_uints:
             case POp::min_n_floats: case POp::min_n_ints: case POp::min_n_uints:
+            case POp::min_imm_float:
                 opText = opArg1 + " = min(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2366,6 +2962,7 @@ void Program::dump(SkWStream* out) const {
             case POp::max_3_floats: case POp::max_3_ints: case POp::max_3_uints:
             case POp::max_4_floats: case POp::max_4_ints: case POp::max_4_uints:
             case POp::max_n_floats: case POp::max_n_ints: case POp::max_n_uints:
+            case POp::max_imm_float:
                 opText = opArg1 + " = max(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2374,6 +2971,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmplt_3_floats: case POp::cmplt_3_ints: case POp::cmplt_3_uints:
             case POp::cmplt_4_floats: case POp::cmplt_4_ints: case POp::cmplt_4_uints:
             case POp::cmplt_n_floats: case POp::cmplt_n_ints: case POp::cmplt_n_uints:
+            case POp::cmplt_imm_float:  case POp::cmplt_imm_int:  case POp::cmplt_imm_uint:
                 opText = opArg1 + " = lessThan(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2382,6 +2980,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmple_3_floats: case POp::cmple_3_ints: case POp::cmple_3_uints:
             case POp::cmple_4_floats: case POp::cmple_4_ints: case POp::cmple_4_uints:
             case POp::cmple_n_floats: case POp::cmple_n_ints: case POp::cmple_n_uints:
+            case POp::cmple_imm_float:  case POp::cmple_imm_int:  case POp::cmple_imm_uint:
                 opText = opArg1 + " = lessThanEqual(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2390,6 +2989,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmpeq_3_floats: case POp::cmpeq_3_ints:
             case POp::cmpeq_4_floats: case POp::cmpeq_4_ints:
             case POp::cmpeq_n_floats: case POp::cmpeq_n_ints:
+            case POp::cmpeq_imm_float:  case POp::cmpeq_imm_int:
                 opText = opArg1 + " = equal(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2398,6 +2998,7 @@ void Program::dump(SkWStream* out) const {
             case POp::cmpne_3_floats: case POp::cmpne_3_ints:
             case POp::cmpne_4_floats: case POp::cmpne_4_ints:
             case POp::cmpne_n_floats: case POp::cmpne_n_ints:
+            case POp::cmpne_imm_float:  case POp::cmpne_imm_int:
                 opText = opArg1 + " = notEqual(" + opArg1 + ", " + opArg2 + ")";
                 break;
 
@@ -2409,6 +3010,12 @@ void Program::dump(SkWStream* out) const {
                 opText = opArg1 + " = mix(" + opArg2 + ", " + opArg3 + ", " + opArg1 + ")";
                 break;
 
+            case POp::mad_float:      case POp::mad_2_floats:
+            case POp::mad_3_floats:   case POp::mad_4_floats:
+            case POp::mad_n_floats:
+                opText = opArg1 + " = " + opArg1 + " * " + opArg2 + " + " + opArg3;
+                break;
+
             case POp::jump:
             case POp::branch_if_any_active_lanes:
             case POp::branch_if_no_active_lanes:
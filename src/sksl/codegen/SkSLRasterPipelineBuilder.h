@@ -12,13 +12,16 @@
 #include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkTHash.h"
 
+#include <atomic>
 #include <cstdint>
 #include <initializer_list>
 #include <memory>
 
 class SkArenaAlloc;
 class SkRasterPipeline;
+class SkReadBuffer;
 class SkWStream;
+class SkWriteBuffer;
 
 namespace SkSL {
 
@@ -26,6 +29,12 @@ class SkRPDebugTrace;
 
 namespace RP {
 
+// When set, the Builder fuses common instruction sequences into single stages: a literal and the
+// binary op that consumes it become an immediate-operand op, a multiply and a later add of a pushed
+// value become `mad`, and runs of constants bound for adjacent slots are written by one op.
+// Benchmarks turn this off to measure the fusions.
+extern std::atomic<bool> gFuseStages;
+
 // A single scalar in our program consumes one slot.
 using Slot = int;
 constexpr Slot NA = -1;
@@ -155,6 +164,18 @@ public:
                       SkArenaAlloc* alloc,
                       Callbacks* callbacks,
                       SkSpan<const float> uniforms) const;
+
+    /** Writes the program's instructions, so that Deserialize() can recreate it later. */
+    void serialize(SkWriteBuffer& buffer) const;
+
+    /**
+     * Reads a program written by serialize(), or returns null if the data is malformed. Every
+     * instruction is checked against the program's slots, temp stacks and labels, and against the
+     * caller's uniform slot and child counts, before the program is built.
+     */
+    static std::unique_ptr<Program> Deserialize(SkReadBuffer& buffer,
+                                                int numUniformSlots,
+                                                int numChildren);
 #endif
 
     void dump(SkWStream* out) const;
@@ -556,6 +577,11 @@ public:
 private:
     void simplifyPopSlotsUnmasked(SlotRange* dst);
 
+    // Fuses a binary op with the instructions before it, when possible. Returns true if the op was
+    // folded into the instruction stream.
+    bool fuseImmediateBinaryOp(BuilderOp op, int32_t slots);
+    bool fuseMultiplyAdd(BuilderOp op, int32_t slots);
+
     SkTArray<Instruction> fInstructions;
     int fNumLabels = 0;
     int fExecutionMaskWritesEnabled = 0;
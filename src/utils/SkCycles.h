@@ -4,26 +4,28 @@
  * Use of this source code is governed by a BSD-style license that can be
  * found in the LICENSE file.
  *
- * This is an experimental (and probably temporary) solution that allows
- * to compare performance SkVM blitters vs RasterPipeline blitters.
- * In addition to measuring performance (which is questionable) it also produces
- * other counts (pixels, scanlines) and more detailed traces that
- * can explain the current results (SkVM is slower) and help improve it.
- * The entire code is hidden under build flag skia_compare_vm_vs_rp=true
- * and will not appear at all without it.
+ * A cheap, monotonic cycle counter, for timing very short stretches of code. It is used by
+ * SkBlitterTrace (behind the skia_compare_vm_vs_rp build flag) and by SkRasterPipelineProfiler.
+ * On x86 it counts TSC cycles. On ARM64, including Android, it reads the generic timer's virtual
+ * count, which ticks at a fixed frequency (often 19.2-50MHz) well below the CPU clock, so a short
+ * stretch of code is only resolved on average over many samples. Now() returns 0 on platforms
+ * where we don't know how to read the counter.
  */
 #ifndef SkCycles_DEFINED
 #define SkCycles_DEFINED
+
+#include "include/core/SkTypes.h"
+
 #include <cstdint>
-#include <x86intrin.h>
+
+#if defined(SK_CPU_X86) && !defined(SK_BUILD_FOR_WIN)
+    #include <x86intrin.h>
+#endif
+
 class SkCycles {
 public:
     static uint64_t Now() {
-        #ifndef SKIA_COMPARE_VM_VS_RP
-        {
-            return 0ul;
-        }
-        #elif defined(SK_BUILD_FOR_WIN)
+        #if defined(SK_BUILD_FOR_WIN)
         {
             return 0ul;
         }
@@ -31,10 +33,6 @@ public:
         {
             return 0ul;
         }
-        #elif defined(SK_BUILD_FOR_ANDROID)
-        {
-            return 0ul;
-        }
         #elif defined(SK_CPU_X86)
         {
             unsigned aux;
@@ -7,13 +7,18 @@
 
 #include "include/core/SkAlphaType.h"
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlurTypes.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorType.h"
+#include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
+#include "include/core/SkMaskFilter.h"
 #include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
+#include "include/core/SkPoint.h"
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRegion.h"
@@ -23,14 +28,20 @@
 #include "include/private/base/SkMalloc.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkAAClip.h"
+#include "src/core/SkAAClipCache.h"
 #include "src/core/SkMask.h"
 #include "src/core/SkRasterClip.h"
+#include "src/core/SkResourceCache.h"
 #include "tests/Test.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
 #include <cstring>
 #include <initializer_list>
 #include <string>
+#include <vector>
 
 static bool operator==(const SkMask& a, const SkMask& b) {
     if (a.fFormat != b.fFormat || a.fBounds != b.fBounds) {
@@ -438,6 +449,277 @@ static void test_huge(skiatest::Reporter* reporter) {
     clip.setRect(r);
 }
 
+using DrawProc = void (*)(SkCanvas*);
+
+// Draws white through the clip, and returns the largest difference in alpha when
+// gSkUseAnalyticAAClip is on and off, or -1 if the pixels well inside and outside of the shape
+// don't match exactly.
+template <typename ClipProc>
+static int analytic_clip_error(ClipProc clip, DrawProc draw) {
+    SkBitmap bitmaps[2];
+    for (int i = 0; i < 2; ++i) {
+        const bool prev = gSkUseAnalyticAAClip;
+        gSkUseAnalyticAAClip = (i == 0);
+        bitmaps[i].allocN32Pixels(100, 100);
+        bitmaps[i].eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmaps[i]);
+        clip(&canvas);
+        canvas.resetMatrix();
+        draw(&canvas);
+        gSkUseAnalyticAAClip = prev;
+    }
+    int maxError = 0;
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            int a0 = SkColorGetA(bitmaps[0].getColor(x, y)),
+                a1 = SkColorGetA(bitmaps[1].getColor(x, y));
+            bool isEdge = (a0 != 0 && a0 != 0xFF) || (a1 != 0 && a1 != 0xFF);
+            if (!isEdge && a0 != a1) {
+                return -1;
+            }
+            maxError = std::max(maxError, std::abs(a0 - a1));
+        }
+    }
+    return maxError;
+}
+
+static bool rrect_contains(const SkRRect& rrect, float x, float y) {
+    const SkRect& r = rrect.rect();
+    if (x < r.fLeft || x > r.fRight || y < r.fTop || y > r.fBottom) {
+        return false;
+    }
+    const bool left = x < r.centerX(),
+               top  = y < r.centerY();
+    const SkVector radii = rrect.radii(top ? (left ? SkRRect::kUpperLeft_Corner
+                                                   : SkRRect::kUpperRight_Corner)
+                                           : (left ? SkRRect::kLowerLeft_Corner
+                                                   : SkRRect::kLowerRight_Corner));
+    const float cx = left ? r.fLeft + radii.fX - x : x - (r.fRight - radii.fX),
+                cy = top  ? r.fTop  + radii.fY - y : y - (r.fBottom - radii.fY);
+    if (cx <= 0 || cy <= 0) {
+        return true;
+    }
+    return (cx / radii.fX) * (cx / radii.fX) + (cy / radii.fY) * (cy / radii.fY) <= 1;
+}
+
+// The area of each pixel inside of the rrect (or outside, for kDifference), taking 256x256
+// samples in those it doesn't cover completely or not at all.
+static std::vector<float> rrect_coverage(const SkRRect& rrect, SkClipOp op) {
+    constexpr int kSamples = 256;
+    std::vector<float> coverage(100 * 100);
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            float cov;
+            if (!SkRect::Intersects(rrect.rect(), SkRect::MakeXYWH(x, y, 1, 1))) {
+                cov = 0;
+            } else if (rrect_contains(rrect, x, y) && rrect_contains(rrect, x + 1, y) &&
+                       rrect_contains(rrect, x, y + 1) && rrect_contains(rrect, x + 1, y + 1)) {
+                cov = 1;
+            } else {
+                int count = 0;
+                for (int sy = 0; sy < kSamples; ++sy) {
+                    for (int sx = 0; sx < kSamples; ++sx) {
+                        count += rrect_contains(rrect, x + (sx + 0.5f) / kSamples,
+                                                       y + (sy + 0.5f) / kSamples);
+                    }
+                }
+                cov = count / float(kSamples * kSamples);
+            }
+            coverage[y * 100 + x] = op == SkClipOp::kDifference ? 1 - cov : cov;
+        }
+    }
+    return coverage;
+}
+
+// Draws white through the clip, which has an analytic rrect, and returns the largest difference
+// in alpha from drawing through the rest of the clip and multiplying by the rrect's coverage.
+// Like the analytic clip, that first clips to the rrect's bounds when intersecting.
+template <typename ClipProc>
+static int analytic_rrect_error(ClipProc clip, const SkRRect& devRRect, SkClipOp op,
+                                DrawProc draw) {
+    const std::vector<float> coverage = rrect_coverage(devRRect, op);
+    SkBitmap bitmaps[2];
+    for (int i = 0; i < 2; ++i) {
+        bitmaps[i].allocN32Pixels(100, 100);
+        bitmaps[i].eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bitmaps[i]);
+        if (i == 1 && op == SkClipOp::kIntersect) {
+            canvas.clipIRect(devRRect.rect().roundOut());
+        }
+        clip(&canvas, /*withRRect=*/i == 0);
+        canvas.resetMatrix();
+        draw(&canvas);
+    }
+    int maxError = 0;
+    for (int y = 0; y < 100; ++y) {
+        for (int x = 0; x < 100; ++x) {
+            int a0 = SkColorGetA(bitmaps[0].getColor(x, y)),
+                a1 = SkColorGetA(bitmaps[1].getColor(x, y));
+            int expected = (int)(a1 * coverage[y * 100 + x] + 0.5f);
+            maxError = std::max(maxError, std::abs(a0 - expected));
+        }
+    }
+    return maxError;
+}
+
+static void test_analytic_clip(skiatest::Reporter* reporter) {
+    // The analytic coverage of rrects is exact, short of rounding it and the draw's coverage to
+    // 8 bits before multiplying them.
+    constexpr int kRRectTolerance = 2;
+    const SkRRect rrect = SkRRect::MakeRectXY(SkRect::MakeLTRB(10.5f, 12.25f, 90, 80.75f), 20, 12);
+    const SkMatrix matrix = SkMatrix::Translate(3.5f, -2).preScale(0.75f, 1.125f);
+    SkRRect devRRect;
+    SkAssertResult(rrect.transform(matrix, &devRRect));
+    SkPath triangle;
+    triangle.moveTo(15, 10.5f).lineTo(85.25f, 30).lineTo(40, 90).close();
+
+    // These reach the blitters through blitRect(), blitV(), blitAntiH(), blitMask(), and a sprite
+    // blitter.
+    const DrawProc draws[] = {
+        [](SkCanvas* canvas) { canvas->drawColor(SK_ColorWHITE); },
+        [](SkCanvas* canvas) {
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas->drawRect(SkRect::MakeLTRB(5.5f, 20.25f, 95.75f, 70.5f), paint);
+        },
+        [](SkCanvas* canvas) {
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas->drawCircle(50, 50, 45, paint);
+        },
+        [](SkCanvas* canvas) {
+            SkPaint paint;
+            paint.setAntiAlias(true);
+            canvas->drawCircle(25, 20, 8, paint);
+        },
+        [](SkCanvas* canvas) {
+            SkBitmap bitmap;
+            bitmap.allocN32Pixels(90, 90);
+            bitmap.eraseColor(SK_ColorWHITE);
+            canvas->drawImage(bitmap.asImage(), 5, 5);
+        },
+        [](SkCanvas* canvas) {
+            SkPaint paint;
+            paint.setColor(SK_ColorWHITE);
+            paint.setMaskFilter(SkMaskFilter::MakeBlur(kNormal_SkBlurStyle, 0.5f));
+            canvas->drawRect(SkRect::MakeLTRB(10, 10, 90, 90), paint);
+        },
+    };
+
+    for (SkClipOp op : {SkClipOp::kIntersect, SkClipOp::kDifference}) {
+        for (DrawProc draw : draws) {
+            int error = analytic_rrect_error([&](SkCanvas* canvas, bool withRRect) {
+                if (withRRect) {
+                    canvas->clipRRect(rrect, op, true);
+                }
+            }, rrect, op, draw);
+            REPORTER_ASSERT(reporter, error <= kRRectTolerance, "rrect error %d", error);
+
+            // Under a transform, and combined with a second shape, which is not analytic.
+            error = analytic_rrect_error([&](SkCanvas* canvas, bool withRRect) {
+                if (withRRect) {
+                    canvas->setMatrix(matrix);
+                    canvas->clipRRect(rrect, op, true);
+                    canvas->resetMatrix();
+                }
+                canvas->clipPath(triangle, SkClipOp::kIntersect, true);
+            }, devRRect, op, draw);
+            REPORTER_ASSERT(reporter, error <= kRRectTolerance, "combined error %d", error);
+
+            // Polygons are always clipped by SkAAClip.
+            error = analytic_clip_error([&](SkCanvas* canvas) {
+                canvas->clipPath(triangle, op, true);
+            }, draw);
+            REPORTER_ASSERT(reporter, error == 0, "polygon error %d", error);
+        }
+    }
+
+    SkRasterClip rc(SkIRect::MakeWH(100, 100));
+    rc.op(rrect, SkMatrix::I(), SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, rc.hasAnalyticCoverage());
+    REPORTER_ASSERT(reporter, rc.getBounds() == rrect.rect().roundOut());
+    REPORTER_ASSERT(reporter, rc.clipShader());
+
+    SkRasterClip transformed(SkIRect::MakeWH(100, 100));
+    transformed.op(rrect, matrix, SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, transformed.hasAnalyticCoverage());
+
+    // Translating moves the shape along with the bounds.
+    SkRasterClip translated;
+    rc.translate(5, -5, &translated);
+    REPORTER_ASSERT(reporter, translated.hasAnalyticCoverage());
+    REPORTER_ASSERT(reporter, translated.getBounds() == rrect.rect().roundOut().makeOffset(5, -5));
+
+    rc.setRect(SkIRect::MakeWH(100, 100));
+    REPORTER_ASSERT(reporter, !rc.hasAnalyticCoverage());
+
+    rc.op(triangle, SkMatrix::I(), SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, !rc.hasAnalyticCoverage());
+}
+
+// Analytic shapes pay for their edges on every draw, so large ones keep using SkAAClip.
+static void test_analytic_clip_size(skiatest::Reporter* reporter) {
+    const SkIRect bounds = SkIRect::MakeWH(1024, 1024);
+    for (int size : {64, 256, 300, 1000}) {
+        const SkRect rect = SkRect::MakeXYWH(10.5f, 10.5f, size - 1, size - 1);
+        SkRasterClip rc(bounds);
+        rc.op(SkRRect::MakeRectXY(rect, 4, 4), SkMatrix::I(), SkClipOp::kIntersect, true);
+        REPORTER_ASSERT(reporter, rc.hasAnalyticCoverage() == (size <= 256), "%d", size);
+    }
+
+    // So do small ones with large rounded corners, which are all edge.
+    SkRasterClip rc(bounds);
+    rc.op(SkRRect::MakeRectXY(SkRect::MakeWH(100, 100), 20, 20), SkMatrix::I(),
+          SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, !rc.hasAnalyticCoverage());
+}
+
+static int count_recs(SkResourceCache* cache) {
+    int count = 0;
+    cache->visitAll([](const SkResourceCache::Rec&, void* context) { ++*(int*)context; }, &count);
+    return count;
+}
+
+static void test_clip_cache(skiatest::Reporter* reporter) {
+    SkResourceCache cache(1024 * 1024);
+    SkPath path;
+    path.moveTo(10, 10).lineTo(90, 20).lineTo(20, 90).lineTo(50, 50).close();
+    const SkMatrix matrix = SkMatrix::Scale(0.5f, 0.5f);
+    const SkIRect bounds = SkIRect::MakeWH(100, 100);
+
+    SkAAClip expected, clip;
+    SkPath devPath;
+    path.transform(matrix, &devPath);
+    expected.setPath(devPath, bounds, true);
+
+    // The second call finds the first one's clip.
+    for (int i = 0; i < 2; ++i) {
+        SkAAClipCache::SetPath(&clip, path, matrix, bounds, &cache);
+        REPORTER_ASSERT(reporter, count_recs(&cache) == 1);
+
+        SkMask mask0, mask1;
+        expected.copyToMask(&mask0);
+        clip.copyToMask(&mask1);
+        SkAutoMaskFreeImage free0(mask0.fImage);
+        SkAutoMaskFreeImage free1(mask1.fImage);
+        REPORTER_ASSERT(reporter, mask0 == mask1);
+    }
+
+    // A different matrix makes a different clip.
+    SkAAClipCache::SetPath(&clip, path, SkMatrix::I(), bounds, &cache);
+    REPORTER_ASSERT(reporter, count_recs(&cache) == 2);
+
+    // Editing the path purges its clips.
+    path.lineTo(5, 5);
+    SkAAClipCache::SetPath(&clip, path, SkMatrix::I(), bounds, &cache);
+    REPORTER_ASSERT(reporter, count_recs(&cache) == 1);
+
+    // Volatile paths are not cached.
+    path.setIsVolatile(true);
+    SkAAClipCache::SetPath(&clip, path, matrix, bounds, &cache);
+    REPORTER_ASSERT(reporter, count_recs(&cache) == 1);
+}
+
 DEF_TEST(AAClip, reporter) {
     test_empty(reporter);
     test_path_bounds(reporter);
@@ -449,4 +731,7 @@ DEF_TEST(AAClip, reporter) {
     test_really_a_rect(reporter);
     test_crbug_422693(reporter);
     test_huge(reporter);
+    test_analytic_clip(reporter);
+    test_analytic_clip_size(reporter);
+    test_clip_cache(reporter);
 }
@@ -6,9 +6,11 @@
  */
 
 #include "include/core/SkBitmap.h"
+#include "include/core/SkBlendMode.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
 #include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
@@ -19,13 +21,20 @@
 #include "include/core/SkSize.h"
 #include "include/core/SkTileMode.h"
 #include "include/core/SkTypes.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkRandom.h"
+#include "src/core/SkBlitter.h"
 #include "src/core/SkMatrixUtils.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+extern bool gSkForceRasterPipelineBlitter;
 
 ///////////////////////////////////////////////////////////////////////////////
 
@@ -263,3 +272,102 @@ DEF_TEST(DrawBitmapRect, reporter) {
 
     test_treatAsSprite(reporter);
 }
+
+// Sprites whose 8888 order doesn't match the destination's are swizzled a row at a time into the
+// same blitters used for matching sprites, so they should draw exactly the same pixels.
+DEF_TEST(DrawSprite_swizzled8888, reporter) {
+    SkRandom rand;
+    for (SkAlphaType at : {kOpaque_SkAlphaType, kPremul_SkAlphaType}) {
+        SkBitmap n32;
+        n32.allocPixels(SkImageInfo::MakeN32(37, 5, at));
+        for (int y = 0; y < n32.height(); ++y) {
+            for (int x = 0; x < n32.width(); ++x) {
+                SkColor c = rand.nextU();
+                if (at == kOpaque_SkAlphaType) {
+                    c = SkColorSetA(c, 0xFF);
+                }
+                *n32.getAddr32(x, y) = SkPreMultiplyColor(c);
+            }
+        }
+        SkBitmap swapped;
+        swapped.allocPixels(n32.info().makeColorType(kN32_SkColorType == kRGBA_8888_SkColorType
+                                                             ? kBGRA_8888_SkColorType
+                                                             : kRGBA_8888_SkColorType));
+        REPORTER_ASSERT(reporter, n32.readPixels(swapped.pixmap()));
+
+        for (SkBlendMode mode : {SkBlendMode::kSrc, SkBlendMode::kSrcOver, SkBlendMode::kXor,
+                                 SkBlendMode::kMultiply}) {
+            for (U8CPU alpha : {0xFF, 0x80}) {
+                SkBitmap expected, actual;
+                for (SkBitmap* dst : {&expected, &actual}) {
+                    dst->allocN32Pixels(48, 12);
+                    dst->eraseColor(0x80402010);
+
+                    SkPaint paint;
+                    paint.setBlendMode(mode);
+                    paint.setAlpha(alpha);
+                    SkCanvas canvas(*dst);
+                    canvas.drawImage((dst == &expected ? n32 : swapped).asImage(), 3, 2,
+                                     SkSamplingOptions(), &paint);
+                }
+                REPORTER_ASSERT(reporter, 0 == memcmp(expected.getPixels(), actual.getPixels(),
+                                                      expected.computeByteSize()),
+                                "%s alpha=%u at=%d", SkBlendMode_Name(mode), alpha, (int)at);
+            }
+        }
+    }
+}
+
+// A8 sprites drawn kSrcOver are colored by the paint with SkOpts::blit_mask_d32_a8. That rounds
+// twice, with approxMulDiv255(), so it may differ from the raster pipeline sprite blitter by 2.
+DEF_TEST(DrawSprite_A8, reporter) {
+    SkRandom rand;
+    SkBitmap mask;
+    mask.allocPixels(SkImageInfo::MakeA8(37, 5));
+    for (int y = 0; y < mask.height(); ++y) {
+        for (int x = 0; x < mask.width(); ++x) {
+            // Include fully transparent and fully opaque coverage, which take their own paths.
+            *mask.getAddr8(x, y) = x == 0 ? 0x00 : x == 1 ? 0xFF : rand.nextU() & 0xFF;
+        }
+    }
+
+    for (SkColor color : {SK_ColorBLACK, SK_ColorWHITE, SK_ColorGREEN, (SkColor)0xFF3080C0,
+                          (SkColor)0xFFC0FF01}) {
+        for (U8CPU alpha : {0xFF, 0xC0, 0x80, 0x01, 0x00}) {
+            SkBitmap expected, actual;
+            for (SkBitmap* dst : {&expected, &actual}) {
+                dst->allocN32Pixels(48, 12);
+                dst->eraseColor(0x80402010);
+
+                // Canvas draws color A8 images with a shader, so pick the sprite blitter directly,
+                // as SkDraw::drawSprite() does.
+                SkPaint paint;
+                paint.setColor(SkColorSetA(color, alpha));
+                SkSTArenaAlloc<kSkBlitterContextSize> alloc;
+                gSkForceRasterPipelineBlitter = (dst == &expected);
+                SkBlitter* blitter = SkBlitter::ChooseSprite(dst->pixmap(), paint, mask.pixmap(),
+                                                             3, 2, &alloc, nullptr);
+                gSkForceRasterPipelineBlitter = false;
+                if (!blitter) {
+                    ERRORF(reporter, "no sprite blitter");
+                    return;
+                }
+                blitter->blitRect(3, 2, mask.width(), mask.height());
+            }
+
+            int maxDiff = 0;
+            for (int y = 0; y < expected.height(); ++y) {
+                for (int x = 0; x < expected.width(); ++x) {
+                    SkPMColor e = *expected.getAddr32(x, y),
+                              a = *actual.getAddr32(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        maxDiff = std::max(maxDiff, std::abs((int)((e >> shift) & 0xFF) -
+                                                             (int)((a >> shift) & 0xFF)));
+                    }
+                }
+            }
+            REPORTER_ASSERT(reporter, maxDiff <= 2,
+                            "color=%08x alpha=%u: %d", color, alpha, maxDiff);
+        }
+    }
+}
@@ -19,14 +19,21 @@
 #include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkRefCnt.h"
+#include "include/core/SkRegion.h"
 #include "include/core/SkScalar.h"
+#include "include/core/SkShader.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
 #include "include/effects/SkDashPathEffect.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkScan.h"
 #include "tests/Test.h"
 
 #include <cstdint>
+#include <cstring>
+#include <functional>
+#include <utility>
 
 // test that we can draw an aa-rect at coordinates > 32K (bigger than fixedpoint)
 static void test_big_aa_rect(skiatest::Reporter* reporter) {
@@ -424,3 +431,97 @@ DEF_TEST(DrawPath, reporter) {
     test_big_aa_rect(reporter);
     test_halfway();
 }
+
+// Batching hairlines must not change a single pixel, even where segments overlap and the paint
+// is translucent or doesn't blend idempotently. The scribble and points touch more tiles than the
+// batcher keeps at once.
+DEF_TEST(DrawPath_batchedHairlines, reporter) {
+    constexpr int kSize = 400;
+    SkRandom rand;
+    SkPath chart, scribble;
+    chart.moveTo(-10, 100);
+    for (int i = 0; i < 2000; ++i) {
+        chart.lineTo(-10 + 220 * i / 2000.f, 100 + 90 * rand.nextSScalar1());
+    }
+    scribble.moveTo(100, 100);
+    for (int i = 0; i < 200; ++i) {
+        switch (rand.nextU() % 4) {
+            case 0: scribble.lineTo(rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize)); break;
+            case 1: scribble.quadTo(rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize),
+                                    rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize)); break;
+            case 2: scribble.close(); break;
+            case 3: scribble.moveTo(rand.nextRangeF(0, kSize), rand.nextRangeF(0, kSize)); break;
+        }
+    }
+    SkPoint points[400];
+    for (SkPoint& pt : points) {
+        pt = {rand.nextRangeF(-20, kSize + 20), rand.nextRangeF(-20, kSize + 20)};
+    }
+
+    SkRegion region;
+    region.op(SkIRect::MakeLTRB(20, 20, 120, 90), SkRegion::kUnion_Op);
+    region.op(SkIRect::MakeLTRB(60, 50, 180, 180), SkRegion::kUnion_Op);
+
+    using Draw = std::function<void(SkCanvas*, const SkPaint&)>;
+    const Draw draws[] = {
+        [&](SkCanvas* canvas, const SkPaint& paint) { canvas->drawPath(chart, paint); },
+        [&](SkCanvas* canvas, const SkPaint& paint) { canvas->drawPath(scribble, paint); },
+        [&](SkCanvas* canvas, const SkPaint& paint) {
+            canvas->drawPoints(SkCanvas::kLines_PointMode, std::size(points), points, paint);
+        },
+        [&](SkCanvas* canvas, const SkPaint& paint) {
+            canvas->drawPoints(SkCanvas::kPolygon_PointMode, std::size(points), points, paint);
+        },
+    };
+    const std::function<void(SkCanvas*)> clips[] = {
+        [](SkCanvas*) {},
+        [](SkCanvas* canvas) { canvas->clipRect(SkRect::MakeLTRB(30.5f, 40, 170, 150.5f)); },
+        [&](SkCanvas* canvas) { canvas->clipRegion(region); },
+        [](SkCanvas* canvas) {
+            canvas->clipRRect(SkRRect::MakeOval(SkRect::MakeLTRB(10, 10, 190, 170)), true);
+        },
+        [](SkCanvas* canvas) { canvas->clipShader(SkShaders::Color(0x80FFFFFF)); },
+    };
+
+    auto draw = [&](bool batched, const Draw& draw, const std::function<void(SkCanvas*)>& clip,
+                    const SkPaint& paint) {
+        const bool useBatched = gSkUseBatchedHairlines;
+        gSkUseBatchedHairlines = batched;
+        SkBitmap bm;
+        bm.allocN32Pixels(kSize, kSize);
+        bm.eraseColor(0xFF336699);
+        SkCanvas canvas(bm);
+        clip(&canvas);
+        draw(&canvas, paint);
+        gSkUseBatchedHairlines = useBatched;
+        return bm;
+    };
+
+    for (const Draw& d : draws) {
+        for (const auto& clip : clips) {
+            for (SkColor color : {SK_ColorWHITE, SkColorSetARGB(0x60, 0xFF, 0x80, 0x00)}) {
+                // Dithering keeps SrcOver off of the legacy blitters, which aren't batched.
+                for (auto [mode, dither] : {std::make_pair(SkBlendMode::kSrcOver, false),
+                                            std::make_pair(SkBlendMode::kSrcOver, true),
+                                            std::make_pair(SkBlendMode::kPlus, false)}) {
+                    for (SkPaint::Cap cap : {SkPaint::kButt_Cap, SkPaint::kRound_Cap}) {
+                        for (bool aa : {false, true}) {
+                            SkPaint paint;
+                            paint.setStyle(SkPaint::kStroke_Style);
+                            paint.setColor(color);
+                            paint.setBlendMode(mode);
+                            paint.setDither(dither);
+                            paint.setStrokeCap(cap);
+                            paint.setAntiAlias(aa);
+                            SkBitmap expected = draw(false, d, clip, paint),
+                                     actual   = draw(true,  d, clip, paint);
+                            REPORTER_ASSERT(reporter,
+                                            !memcmp(expected.getPixels(), actual.getPixels(),
+                                                    expected.computeByteSize()));
+                        }
+                    }
+                }
+            }
+        }
+    }
+}
@@ -5,17 +5,29 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkBitmap.h"
+#include "include/core/SkCanvas.h"
+#include "include/core/SkClipOp.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkMatrix.h"
+#include "include/core/SkPaint.h"
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkTypes.h"
+#include "include/private/base/SkTPin.h"
 #include "src/core/SkBlitter.h"
+#include "src/core/SkRasterClip.h"
 #include "src/core/SkScan.h"
 #include "tests/Test.h"
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
+#include <cstdlib>
+#include <cstring>
 
 struct FakeBlitter : public SkBlitter {
     FakeBlitter()
@@ -52,3 +64,184 @@ DEF_TEST(FillPathInverse, reporter) {
 
     REPORTER_ASSERT(reporter, blitter.m_blitCount == expected_lines);
 }
+
+// A rounded rect with a hole left of [12, 52) x [12, 52). It isn't convex, so it clips as an
+// SkAAClip rather than analytically.
+static SkPath aa_clip_path() {
+    SkPath path = SkPath::RRect(SkRRect::MakeRectXY({3.5f, 2.5f, 60.5f, 61.5f}, 9, 9));
+    path.addCircle(7.5f, 32.25f, 2.5f);
+    path.setFillType(SkPathFillType::kEvenOdd);
+    return path;
+}
+
+static SkBitmap draw_coverage(const SkPath& path, bool aaClip) {
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(64, 64));
+    bm.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(bm);
+    if (aaClip) {
+        // Draws through SkAAClipBlitter, which forces the scan converter to blit runs instead of
+        // a mask.
+        canvas.clipPath(aa_clip_path(), true);
+    }
+    SkPaint paint;
+    paint.setAntiAlias(true);
+    canvas.drawPath(path, paint);
+    return bm;
+}
+
+// Coverage from drawing path without anti-aliasing at 16x scale, then box filtering it.
+static SkBitmap draw_supersampled_coverage(const SkPath& path) {
+    constexpr int kScale = 16;
+    SkBitmap big;
+    big.allocPixels(SkImageInfo::MakeA8(64 * kScale, 64 * kScale));
+    big.eraseColor(SK_ColorTRANSPARENT);
+    SkCanvas canvas(big);
+    canvas.scale(kScale, kScale);
+    canvas.drawPath(path, SkPaint());
+
+    SkBitmap bm;
+    bm.allocPixels(SkImageInfo::MakeA8(64, 64));
+    for (int y = 0; y < 64; ++y) {
+        for (int x = 0; x < 64; ++x) {
+            int covered = 0;
+            for (int j = 0; j < kScale; ++j) {
+                for (int i = 0; i < kScale; ++i) {
+                    covered += *big.getAddr8(x * kScale + i, y * kScale + j) != 0;
+                }
+            }
+            *bm.getAddr8(x, y) = (covered * 255 + kScale * kScale / 2) / (kScale * kScale);
+        }
+    }
+    return bm;
+}
+
+// Accumulation AA computes the exact area of each pixel covered by the path, so it should match
+// finely supersampled coverage, except where edges cross inside a pixel and their signed areas
+// cancel. It should blit the same coverage as runs as it does as a mask.
+DEF_TEST(FillPathAccumulationAA, reporter) {
+    struct {
+        SkPath fPath;
+        bool fCrossesItself;
+    } tests[6];
+    tests[0].fPath.addCircle(31.3f, 30.8f, 25.1f);
+    tests[1].fPath.moveTo(32, 2).lineTo(50, 60).lineTo(3, 22).lineTo(61, 22).lineTo(14, 60)
+                  .close();
+    tests[1].fPath.setFillType(SkPathFillType::kEvenOdd);
+    tests[1].fCrossesItself = true;
+    tests[2].fPath.moveTo(2.2f, 60).cubicTo(10, -20, 50, 90, 62, 3.7f).quadTo(30, 40, 2.2f, 60);
+    tests[3].fPath.addRect({10.5f, 12.25f, 50.75f, 40.1f});
+    tests[3].fPath.setFillType(SkPathFillType::kInverseWinding);
+    tests[4].fPath.addOval({-20, 5, 40, 80});
+    tests[4].fPath.conicTo(70, 0, 60, 30, 0.5f);
+    tests[5].fPath.moveTo(5, 5).lineTo(59.5f, 5.3f).lineTo(5.1f, 5.6f).lineTo(59, 40).close();
+    tests[5].fCrossesItself = true;
+
+    SkRasterClip rc(SkIRect::MakeWH(64, 64));
+    rc.op(aa_clip_path(), SkMatrix::I(), SkClipOp::kIntersect, true);
+    REPORTER_ASSERT(reporter, rc.isAA() && !rc.hasAnalyticCoverage());
+
+    const bool useAccumulation = gSkUseAccumulationAA;
+    gSkUseAccumulationAA = true;
+    for (const auto& test : tests) {
+        SkBitmap expected = draw_supersampled_coverage(test.fPath),
+                 actual   = draw_coverage(test.fPath, false),
+                 clipped  = draw_coverage(test.fPath, true);
+
+        int maxDiff = 0, totalDiff = 0;
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                int diff = std::abs(*expected.getAddr8(x, y) - *actual.getAddr8(x, y));
+                maxDiff = std::max(maxDiff, diff);
+                totalDiff += diff;
+            }
+        }
+        if (!test.fCrossesItself) {
+            REPORTER_ASSERT(reporter, maxDiff <= 16, "max difference %d", maxDiff);
+        }
+        REPORTER_ASSERT(reporter, totalDiff <= 64 * 64 / 4, "total difference %d", totalDiff);
+
+        // Inside the clip's corners, the clip leaves coverage unchanged.
+        for (int y = 12; y < 52; ++y) {
+            for (int x = 12; x < 52; ++x) {
+                REPORTER_ASSERT(reporter, *clipped.getAddr8(x, y) == *actual.getAddr8(x, y));
+            }
+        }
+    }
+    gSkUseAccumulationAA = useAccumulation;
+}
+
+// Splitting a path into bands must not change its coverage, even when the clip is not a rectangle.
+// Paths that analytic AA would draw are left unbanded, so they must come out the same too.
+DEF_TEST(FillPathBandedAA, reporter) {
+    SkPath chart;
+    chart.moveTo(0, 256);
+    SkScalar y = 128;
+    for (int i = 0; i < (1 << 15); ++i) {
+        y = SkTPin(y + ((i * 7919) % 13 - 6) * 0.75f, 0.f, 256.f);
+        chart.lineTo(256.f * i / (1 << 15), y);
+    }
+    chart.lineTo(256, 256);
+    chart.close();
+
+    // A self-crossing star with steep, fractional edges that cross every band boundary.
+    SkPath star;
+    for (int i = 0; i < (1 << 14); ++i) {
+        const float angle = i * 2.399963f;
+        const SkPoint p = {128.3f + 127 * std::cos(angle), 128.7f + 127 * std::sin(angle)};
+        i ? star.lineTo(p) : star.moveTo(p);
+    }
+    star.close();
+    SkPath evenOddStar = star;
+    evenOddStar.setFillType(SkPathFillType::kEvenOdd);
+
+    // Curves, whose edges are stepped through several segments to reach a band.
+    SkPath curves;
+    curves.moveTo(3.5f, 250);
+    for (int i = 0; i < (1 << 13); ++i) {
+        const float x = 3.5f + 249.f * (i + 1) / (1 << 13);
+        curves.cubicTo(x - 0.05f, (i * 37) % 251, x - 0.02f, (i * 101) % 253, x, 3 + i % 250);
+    }
+    curves.close();
+
+    const bool useAnalytic = gSkUseAnalyticAA,
+               useBanded   = gSkUseBandedAA;
+    auto draw = [](const SkPath& path, bool banded, bool clipRRect) {
+        gSkUseBandedAA = banded;
+        SkBitmap bm;
+        bm.allocPixels(SkImageInfo::MakeA8(256, 256));
+        bm.eraseColor(SK_ColorTRANSPARENT);
+        SkCanvas canvas(bm);
+        if (clipRRect) {
+            canvas.clipRRect(SkRRect::MakeRectXY({20.5f, 30.25f, 230, 220}, 40, 30), true);
+        } else {
+            canvas.clipRect({100, 40, 180, 90}, SkClipOp::kDifference);
+        }
+        SkPaint paint;
+        paint.setAntiAlias(true);
+        canvas.drawPath(path, paint);
+        return bm;
+    };
+    const struct {
+        const char*   name;
+        const SkPath* path;
+    } kPaths[] = {{"chart", &chart}, {"star", &star}, {"evenOddStar", &evenOddStar},
+                  {"curves", &curves}};
+    for (bool analytic : {true, false}) {
+        gSkUseAnalyticAA = analytic;
+        for (const auto& [name, path] : kPaths) {
+            for (bool clipRRect : {false, true}) {
+                SkBitmap expected = draw(*path, false, clipRRect),
+                         actual   = draw(*path, true,  clipRRect);
+                int diffs = 0;
+                for (int y = 0; y < 256; ++y) {
+                    diffs += 0 != memcmp(expected.getAddr8(0, y), actual.getAddr8(0, y), 256);
+                }
+                REPORTER_ASSERT(reporter, diffs == 0, "analytic %d, %s, rrect clip %d: "
+                                "%d rows differ", analytic, name, clipRRect, diffs);
+            }
+        }
+    }
+    gSkUseAnalyticAA = useAnalytic;
+    gSkUseBandedAA   = useBanded;
+}
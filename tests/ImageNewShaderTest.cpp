@@ -8,6 +8,7 @@
 #include "include/core/SkBitmap.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkImage.h"
 #include "include/core/SkImageInfo.h"
 #include "include/core/SkMatrix.h"
@@ -22,10 +23,13 @@
 #include "include/core/SkTypes.h"
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrDirectContext.h"
+#include "src/base/SkRandom.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 #include "tools/Resources.h"
 
+#include <algorithm>
+#include <cstdlib>
 #include <cstring>
 
 class GrRecordingContext;
@@ -164,3 +168,59 @@ DEF_TEST(ImageRawShader, reporter) {
     REPORTER_ASSERT(reporter,
                     !image->makeRawShader(SkSamplingOptions{SkCubicResampler::Mitchell()}));
 }
+
+// Bicubic image shaders with a scale+translate matrix draw into untagged N32 through
+// SkBitmapProcState's bicubic shader proc, and into sRGB-tagged N32 through the raster pipeline.
+// Those should agree to within rounding.
+DEF_TEST(ImageShader_legacyBicubic, reporter) {
+    SkRandom rand;
+    SkBitmap src;
+    src.allocN32Pixels(13, 9);
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            *src.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+    sk_sp<SkImage> image = src.asImage();
+
+    const SkMatrix matrices[] = {
+        SkMatrix::Scale(3.3f, 2.7f),
+        SkMatrix::Scale(0.3f, 0.4f),
+        SkMatrix::Translate(-4.25f, 3),
+        SkMatrix::Scale(-2, 1.5f).postTranslate(40, -5),
+    };
+    for (SkTileMode tm : {SkTileMode::kClamp, SkTileMode::kRepeat, SkTileMode::kMirror}) {
+        for (SkCubicResampler cubic : {SkCubicResampler::Mitchell(),
+                                       SkCubicResampler::CatmullRom()}) {
+            for (U8CPU alpha : {0xFF, 0x80}) {
+                for (const SkMatrix& m : matrices) {
+                    SkBitmap legacy, pipeline;
+                    legacy.allocPixels(SkImageInfo::MakeN32Premul(64, 48));
+                    pipeline.allocPixels(SkImageInfo::MakeN32Premul(64, 48,
+                                                                    SkColorSpace::MakeSRGB()));
+                    for (SkBitmap* dst : {&legacy, &pipeline}) {
+                        dst->eraseColor(0xff204060);
+                        SkPaint paint;
+                        paint.setAlpha(alpha);
+                        paint.setShader(image->makeShader(tm, tm, SkSamplingOptions(cubic), &m));
+                        SkCanvas(*dst).drawRect(SkRect::MakeXYWH(1.5f, 2, 61, 44), paint);
+                    }
+
+                    int maxDiff = 0;
+                    for (int y = 0; y < legacy.height(); ++y) {
+                        for (int x = 0; x < legacy.width(); ++x) {
+                            uint32_t a = *legacy.getAddr32(x, y),
+                                     b = *pipeline.getAddr32(x, y);
+                            for (int shift = 0; shift < 32; shift += 8) {
+                                maxDiff = std::max(maxDiff, std::abs((int)((a >> shift) & 0xFF) -
+                                                                     (int)((b >> shift) & 0xFF)));
+                            }
+                        }
+                    }
+                    REPORTER_ASSERT(reporter, maxDiff <= 2, "tile mode %d, B=%g, alpha %u: %d",
+                                    (int)tm, cubic.B, alpha, maxDiff);
+                }
+            }
+        }
+    }
+}
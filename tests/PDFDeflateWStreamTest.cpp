@@ -21,6 +21,7 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 
 using namespace skia_private;
@@ -177,4 +178,61 @@ DEF_TEST(SkPDF_DeflateWStream, r) {
     REPORTER_ASSERT(r, !emptyDeflateWStream.writeText("FOO"));
 }
 
+// Writes larger than the internal buffer skip it and go straight to zlib.
+DEF_TEST(SkPDF_DeflateWStream_LargeWrite, r) {
+    SkRandom random(654321);
+    const size_t size = 100000;
+    AutoTMalloc<uint8_t> buffer(size);
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = random.nextULessThan(16);
+    }
+    SkDynamicMemoryWStream dynamicMemoryWStream;
+    {
+        SkDeflateWStream deflateWStream(&dynamicMemoryWStream, -1);
+        REPORTER_ASSERT(r, deflateWStream.write(&buffer[0], 3));
+        REPORTER_ASSERT(r, deflateWStream.write(&buffer[3], size - 3 - 5000));
+        REPORTER_ASSERT(r, deflateWStream.write(&buffer[size - 5000], 5000));
+        REPORTER_ASSERT(r, deflateWStream.bytesWritten() == size);
+    }
+    std::unique_ptr<SkStreamAsset> compressed(dynamicMemoryWStream.detachAsStream());
+    std::unique_ptr<SkStreamAsset> decompressed(stream_inflate(r, compressed.get()));
+    if (!decompressed || decompressed->getLength() != size) {
+        ERRORF(r, "Decompression failed.");
+        return;
+    }
+    AutoTMalloc<uint8_t> roundTrip(size);
+    REPORTER_ASSERT(r, decompressed->read(&roundTrip[0], size) == size);
+    REPORTER_ASSERT(r, 0 == memcmp(&buffer[0], &roundTrip[0], size));
+}
+
+DEF_TEST(SkPDF_DeflateClassifyContent, r) {
+    const size_t size = 64 * 1024;
+    AutoTMalloc<uint8_t> buffer(size);
+
+    SkRandom random(98765);
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = SkToU8(random.nextU());
+    }
+    REPORTER_ASSERT(r, SkDeflateClassifyContent(&buffer[0], size) ==
+                       SkDeflateContent::kIncompressible);
+
+    // Solid RGB pixels.
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = "\x10\x80\xF0"[i % 3];
+    }
+    REPORTER_ASSERT(r, SkDeflateClassifyContent(&buffer[0], size) ==
+                       SkDeflateContent::kRepetitive);
+
+    // Text.
+    static const char kText[] = "0 0 m 612 792 l S\nBT /F1 12 Tf 72 712 Td (Hello, World) Tj ET\n";
+    for (size_t i = 0; i < size; ++i) {
+        buffer[i] = kText[i % (sizeof(kText) - 1)];
+    }
+    REPORTER_ASSERT(r, SkDeflateClassifyContent(&buffer[0], size) ==
+                       SkDeflateContent::kGeneral);
+
+    // Too small to say anything about.
+    REPORTER_ASSERT(r, SkDeflateClassifyContent(&buffer[0], 10) == SkDeflateContent::kGeneral);
+}
+
 #endif
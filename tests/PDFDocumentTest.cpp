@@ -12,18 +12,24 @@
 #include "include/core/SkExecutor.h"
 #include "include/core/SkFont.h"
 #include "include/core/SkImage.h" // IWYU pragma: keep
+#include "include/core/SkImageInfo.h"
 #include "include/core/SkPaint.h"
+#include "include/core/SkPixmap.h"
 #include "include/core/SkRefCnt.h"
 #include "include/core/SkStream.h"
 #include "include/core/SkString.h"
 #include "include/docs/SkPDFDocument.h"
+#include "src/pdf/SkPDFResourceCache.h"
 #include "src/utils/SkOSPath.h"
 #include "tests/Test.h"
 
 #include <cstdint>
 #include <cstdio>
+#include <cstdlib>
 #include <cstring>
+#include <map>
 #include <memory>
+#include <string>
 
 static void test_empty(skiatest::Reporter* reporter) {
     SkDynamicMemoryWStream stream;
@@ -264,3 +270,155 @@ DEF_TEST(SkPDF_abort_jobs, rep) {
     doc->abort();
 }
 
+
+// Splits a PDF into its indirect objects' bodies, keyed by object number.
+static std::map<int, std::string> pdf_objects(const SkData* data) {
+    const std::string pdf(static_cast<const char*>(data->data()), data->size());
+    std::map<int, std::string> objects;
+    static constexpr char kObj[]    = " 0 obj\n",
+                          kEndObj[] = "\nendobj\n";
+    for (size_t obj = pdf.find(kObj); obj != std::string::npos; obj = pdf.find(kObj, obj + 1)) {
+        size_t start = pdf.rfind('\n', obj) + 1,
+               body  = obj + strlen(kObj),
+               end   = pdf.find(kEndObj, body);
+        if (end == std::string::npos) {
+            break;
+        }
+        objects[atoi(pdf.c_str() + start)] = pdf.substr(body, end - body);
+    }
+    return objects;
+}
+
+// Launch many more jobs than the document lets run at once, so that producers have to wait for
+// job slots. Objects land in completion order, but each one must match the serial document's.
+DEF_TEST(SkPDF_bounded_jobs, rep) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_bounded_jobs, rep);
+    constexpr int kPages = 100;
+    auto make_pdf = [](SkExecutor* executor) {
+        SkPDF::Metadata metadata;
+        metadata.fExecutor = executor;
+        SkDynamicMemoryWStream dst;
+        auto doc = SkPDF::MakeDocument(&dst, metadata);
+        for (int i = 0; i < kPages; ++i) {
+            SkBitmap b;
+            b.allocN32Pixels(64, 64);
+            b.eraseColor(SkColorSetARGB(0xFF, (uint8_t)i, 0x80, 0x40));
+            doc->beginPage(612, 792)->drawImage(b.asImage(), 0, 0);
+        }
+        doc->close();
+        return dst.detachAsData();
+    };
+    std::unique_ptr<SkExecutor> executor = SkExecutor::MakeFIFOThreadPool(2);
+    sk_sp<SkData> serial  = make_pdf(nullptr),
+                  bounded = make_pdf(executor.get());
+
+    static const char kEOF[] = "%%EOF";
+    REPORTER_ASSERT(rep, bounded->size() > strlen(kEOF));
+    REPORTER_ASSERT(rep, 0 == memcmp(bounded->bytes() + bounded->size() - strlen(kEOF),
+                                     kEOF, strlen(kEOF)));
+    REPORTER_ASSERT(rep, serial->size() == bounded->size());
+
+    const std::map<int, std::string> serialObjects  = pdf_objects(serial.get()),
+                                     boundedObjects = pdf_objects(bounded.get());
+    REPORTER_ASSERT(rep, boundedObjects == serialObjects);
+
+    int pages = 0;
+    for (const auto& [number, body] : boundedObjects) {
+        pages += body.find("/Type /Page\n") != std::string::npos;
+    }
+    REPORTER_ASSERT(rep, pages == kPages, "%d pages", pages);
+}
+
+// Documents sharing a resource cache encode each image once and still produce the same output.
+DEF_TEST(SkPDF_resource_cache, rep) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_resource_cache, rep);
+    auto make_image = []() {
+        SkBitmap b;
+        b.allocN32Pixels(64, 64);
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                *b.getAddr32(x, y) = SkPreMultiplyARGB(x * 4, y * 4, 0x80, 0x40);
+            }
+        }
+        return b.asImage();
+    };
+    auto make_pdf = [](const sk_sp<SkImage>& image, SkPDF::ResourceCache* cache) {
+        SkPDF::Metadata metadata;
+        metadata.fResourceCache = cache;
+        SkDynamicMemoryWStream dst;
+        auto doc = SkPDF::MakeDocument(&dst, metadata);
+        doc->beginPage(612, 792)->drawImage(image, 0, 0);
+        doc->close();
+        return dst.detachAsData();
+    };
+
+    sk_sp<SkImage> image = make_image();
+    sk_sp<SkData> uncached = make_pdf(image, nullptr);
+
+    sk_sp<SkPDF::ResourceCache> cache = SkPDF::ResourceCache::Make();
+    sk_sp<SkData> first = make_pdf(image, cache.get());
+    REPORTER_ASSERT(rep, cache->hitCount() == 0);
+    REPORTER_ASSERT(rep, cache->bytesUsed() > 0);
+    REPORTER_ASSERT(rep, first->equals(uncached.get()));
+
+    // Same image.
+    sk_sp<SkData> second = make_pdf(image, cache.get());
+    REPORTER_ASSERT(rep, cache->hitCount() == 1);
+    REPORTER_ASSERT(rep, second->equals(uncached.get()));
+
+    // Same content in a new image.
+    sk_sp<SkData> third = make_pdf(make_image(), cache.get());
+    REPORTER_ASSERT(rep, cache->hitCount() == 2);
+    REPORTER_ASSERT(rep, third->equals(uncached.get()));
+
+    // A cache with no room does not hold anything, but the output is unchanged.
+    sk_sp<SkPDF::ResourceCache> tiny = SkPDF::ResourceCache::Make(16);
+    sk_sp<SkData> fourth = make_pdf(image, tiny.get());
+    REPORTER_ASSERT(rep, tiny->bytesUsed() == 0);
+    REPORTER_ASSERT(rep, fourth->equals(uncached.get()));
+}
+
+// An alpha mask and a grayscale image with the same bytes are different images to the cache. (The
+// device draws alpha images as grayscale masks, so both documents end up with the same gray image.)
+DEF_TEST(SkPDF_resource_cache_color_types, rep) {
+    REQUIRE_PDF_DOCUMENT(SkPDF_resource_cache_color_types, rep);
+    auto make_image = [](SkColorType ct, SkAlphaType at) {
+        SkBitmap b;
+        b.allocPixels(SkImageInfo::Make(64, 64, ct, at));
+        for (int y = 0; y < 64; ++y) {
+            for (int x = 0; x < 64; ++x) {
+                *b.getAddr8(x, y) = (uint8_t)(x * 4 + y);
+            }
+        }
+        return b.asImage();
+    };
+    auto make_pdf = [](const sk_sp<SkImage>& image, SkPDF::ResourceCache* cache) {
+        SkPDF::Metadata metadata;
+        metadata.fResourceCache = cache;
+        SkDynamicMemoryWStream dst;
+        auto doc = SkPDF::MakeDocument(&dst, metadata);
+        doc->beginPage(612, 792)->drawImage(image, 0, 0);
+        doc->close();
+        return dst.detachAsData();
+    };
+
+    sk_sp<SkImage> alpha = make_image(kAlpha_8_SkColorType, kPremul_SkAlphaType),
+                   gray  = make_image(kGray_8_SkColorType, kOpaque_SkAlphaType);
+    sk_sp<SkData> uncachedAlpha = make_pdf(alpha, nullptr),
+                  uncachedGray  = make_pdf(gray, nullptr);
+    REPORTER_ASSERT(rep, !uncachedAlpha->equals(uncachedGray.get()));
+
+    sk_sp<SkPDF::ResourceCache> cache = SkPDF::ResourceCache::Make();
+    REPORTER_ASSERT(rep, make_pdf(alpha, cache.get())->equals(uncachedAlpha.get()));
+    REPORTER_ASSERT(rep, make_pdf(gray,  cache.get())->equals(uncachedGray.get()));
+
+    SkPixmap pixels;
+    SkAssertResult(alpha->peekPixels(&pixels));
+    auto key = [&](SkColorType ct, SkAlphaType at) {
+        return SkPDFResourceCache::MakeImageKey(pixels.addr(), pixels.computeByteSize(),
+                                                pixels.info().makeColorType(ct).makeAlphaType(at),
+                                                /*encodingQuality=*/101, SkPDF::Metadata());
+    };
+    REPORTER_ASSERT(rep, !(key(kAlpha_8_SkColorType, kPremul_SkAlphaType) ==
+                           key(kGray_8_SkColorType, kOpaque_SkAlphaType)));
+}
@@ -313,6 +313,68 @@ DEF_TEST(pathbuilder_addPath, reporter) {
     REPORTER_ASSERT(reporter, p == SkPathBuilder().addPath(p).detach());
 }
 
+DEF_TEST(pathbuilder_allocPolylineTo, reporter) {
+    const SkPoint pts[] = {{1, 2}, {3, 4}, {5, 6}, {7, 8}};
+
+    SkPathBuilder builder;
+    builder.moveTo(0, 0);
+    REPORTER_ASSERT(reporter, builder.allocPolylineTo(0) == nullptr);
+    SkPoint* dst = builder.allocPolylineTo(std::size(pts));
+    for (size_t i = 0; i < std::size(pts); ++i) {
+        dst[i] = pts[i];
+    }
+    builder.close();
+
+    auto expected = SkPathBuilder().moveTo(0, 0).polylineTo(pts, std::size(pts)).close().detach();
+    REPORTER_ASSERT(reporter, builder.detach() == expected);
+}
+
+DEF_TEST(pathbuilder_addSegments, reporter) {
+    const auto p = SkPath()
+        .moveTo(10, 10)
+        .lineTo(100, 10)
+        .quadTo(200, 100, 100, 200)
+        .close()
+        .moveTo(200, 200)
+        .cubicTo(210, 200, 210, 300, 200, 300)
+        .conicTo(150, 250, 100, 200, 1.4f);
+
+    std::vector<SkPoint> pts(p.countPoints());
+    p.getPoints(pts.data(), pts.size());
+    std::vector<uint8_t> verbs(p.countVerbs());
+    p.getVerbs(verbs.data(), verbs.size());
+    const SkScalar weights[] = {1.4f};
+
+    auto addSegments = [&](SkPathBuilder* builder) {
+        builder->addSegments(pts.data(), pts.size(), verbs.data(), verbs.size(), weights, 1);
+    };
+
+    SkPathBuilder builder;
+    addSegments(&builder);
+    REPORTER_ASSERT(reporter, builder.snapshot() == p);
+
+    // The last contour is still open, so segments added afterwards continue it.
+    builder.lineTo(0, 0).close().lineTo(5, 5);
+    SkPathBuilder expected;
+    expected.addPath(p).lineTo(0, 0).close().lineTo(5, 5);
+    REPORTER_ASSERT(reporter, builder.snapshot() == expected.snapshot());
+    REPORTER_ASSERT(reporter, SkPathPriv::LastMoveToIndex(builder.snapshot()) ==
+                              SkPathPriv::LastMoveToIndex(expected.snapshot()));
+
+    // Appending to a non-empty builder.
+    addSegments(&builder);
+    addSegments(&expected);
+    REPORTER_ASSERT(reporter, builder.detach() == expected.detach());
+
+    // A sequence made of moves only doesn't hide a following oval.
+    const SkPoint move = {1, 1};
+    const uint8_t moveVerb = (uint8_t)SkPathVerb::kMove;
+    SkPath oval = SkPathBuilder().addSegments(&move, 1, &moveVerb, 1, nullptr, 0)
+                                 .addOval(SkRect::MakeWH(10, 10))
+                                 .detach();
+    REPORTER_ASSERT(reporter, oval.isOval(nullptr));
+}
+
 /*
  *  If paths were immutable, we would not have to track this, but until that day, we need
  *  to ensure that paths are built correctly/consistently with this field, regardless of
@@ -13,6 +13,8 @@
 #include "tests/PathOpsExtendedTest.h"
 #include "tests/Test.h"
 
+#include <iterator>
+
 DEF_TEST(PathOpsBuilder, reporter) {
     SkOpBuilder builder;
     SkPath result;
@@ -364,3 +366,31 @@ SkOpBuilder builder;
     builder.add(path1, SkPathOp::kUnion_SkPathOp);
     builder.resolve(&path);
 }
+
+// A run of unions is resolved as a balanced tree rather than one op at a time; the area covered
+// should be the same either way.
+DEF_TEST(SkOpBuilderManyUnions, reporter) {
+    SkPath stars[37];
+    for (int i = 0; i < (int) std::size(stars); ++i) {
+        SkScalar cx = 20 + (i * 37 % 100),
+                 cy = 20 + (i * 61 % 100);
+        for (int p = 0; p < 10; ++p) {
+            SkScalar angle = p * (SK_ScalarPI / 5) + i;
+            SkScalar radius = p & 1 ? 6 : 15;
+            SkPoint pt = {cx + radius * SkScalarCos(angle), cy + radius * SkScalarSin(angle)};
+            p ? stars[i].lineTo(pt) : stars[i].moveTo(pt);
+        }
+        stars[i].close();
+    }
+
+    SkOpBuilder builder;
+    SkPath expected;
+    for (const SkPath& star : stars) {
+        builder.add(star, kUnion_SkPathOp);
+        REPORTER_ASSERT(reporter, Op(expected, star, kUnion_SkPathOp, &expected));
+    }
+    SkPath result;
+    REPORTER_ASSERT(reporter, builder.resolve(&result));
+    int pixelDiff = comparePaths(reporter, __FUNCTION__, expected, result);
+    REPORTER_ASSERT(reporter, pixelDiff == 0);
+}
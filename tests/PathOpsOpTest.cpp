@@ -7,6 +7,7 @@
 #include "include/core/SkPath.h"
 #include "include/core/SkPathTypes.h"
 #include "include/core/SkPoint.h"
+#include "include/core/SkRRect.h"
 #include "include/core/SkRect.h"
 #include "include/core/SkScalar.h"
 #include "include/core/SkString.h"
@@ -12553,3 +12554,81 @@ DEF_TEST(PathOpsRepOp, reporter) {
   for (int index = 0; index < 1; ++index)
     RunTestSet(reporter, repTests, std::size(repTests), nullptr, nullptr, nullptr, false);
 }
+
+DEF_TEST(PathOpsFastPaths, reporter) {
+    const SkRect rects[] = {
+        {0, 0, 10, 10}, {0, 5, 10, 20}, {5, 0, 20, 10}, {-5, -5, 15, 4}, {2, 2, 8, 8},
+        {20, 20, 30, 30}, {0, 10, 10, 15},
+    };
+    for (const SkRect& r1 : rects) {
+        for (const SkRect& r2 : rects) {
+            SkPath one = SkPath::Rect(r1);
+            SkPath two = SkPath::Rect(r2);
+            for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+                testPathOp(reporter, one, two, (SkPathOp) op, "rectFastPath");
+            }
+        }
+    }
+    const SkPath convex[] = {
+        SkPath::Oval({0, 0, 20, 20}),
+        SkPath::Oval({30, 0, 40, 50}),
+        SkPath::RRect(SkRRect::MakeRectXY({0, 25, 20, 45}, 4, 4)),
+        SkPath::Rect({5, 5, 15, 15}),
+        SkPath::Polygon({{50, 50}, {70, 52}, {60, 70}}, true),
+    };
+    for (const SkPath& one : convex) {
+        for (const SkPath& two : convex) {
+            for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+                testPathOp(reporter, one, two, (SkPathOp) op, "convexFastPath");
+            }
+        }
+    }
+    // Operands that the fast paths pass through come out as Simplify() would return them.
+    const SkPath collinear = SkPath::Polygon({{0, 0}, {5, 0}, {10, 0}, {10, 10}, {0, 12}}, true);
+    const SkPath inside = SkPath::Rect({2, 2, 8, 8});
+    const SkPath apart = SkPath::Rect({20, 0, 30, 10});
+    SkPath both = collinear;
+    both.addPath(apart);
+    const struct {
+        const SkPath& other;
+        SkPathOp      op;
+        const SkPath& passedThrough;
+    } passThroughs[] = {
+        {inside, kUnion_SkPathOp, collinear},
+        {apart, kDifference_SkPathOp, collinear},
+        {apart, kUnion_SkPathOp, both},
+    };
+    for (const auto& [other, op, passedThrough] : passThroughs) {
+        SkPath result, expected;
+        REPORTER_ASSERT(reporter, Op(collinear, other, op, &result));
+        REPORTER_ASSERT(reporter, Simplify(passedThrough, &expected));
+        REPORTER_ASSERT(reporter, result == expected);
+    }
+}
+
+DEF_TEST(PathOpsContext, reporter) {
+    SkPath one, two;
+    one.addCircle(0, 0, 20);
+    one.addCircle(15, 0, 10);
+    two.addOval({-10, -30, 10, 30});
+    two.addRect({-25, -5, 25, 5});
+    SkPathOpsContext context;
+    for (int pass = 0; pass < 2; ++pass) {
+        int allocations = context.heapAllocationCount();
+        for (int op = kDifference_SkPathOp; op <= kReverseDifference_SkPathOp; ++op) {
+            SkPath expected, result;
+            bool expectedSuccess = Op(one, two, (SkPathOp) op, &expected);
+            REPORTER_ASSERT(reporter, context.op(one, two, (SkPathOp) op, &result)
+                    == expectedSuccess);
+            REPORTER_ASSERT(reporter, result == expected);
+        }
+        SkPath expected, result;
+        REPORTER_ASSERT(reporter, Simplify(one, &expected) == context.simplify(one, &result));
+        REPORTER_ASSERT(reporter, result == expected);
+        if (pass) {
+            // The storage retained from the first pass holds the contours of the second.
+            REPORTER_ASSERT(reporter, context.heapAllocationCount() == allocations);
+        }
+    }
+    REPORTER_ASSERT(reporter, context.heapAllocationCount() > 0);
+}
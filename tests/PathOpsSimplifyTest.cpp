@@ -9450,11 +9450,39 @@ static void bug11958_c(skiatest::Reporter* reporter, const char* filename) {
     testSimplify(reporter, path, filename);
 }
 
+// Contours with enough segments are intersected with a sweep over the segment bounds.
+static void manySegments(skiatest::Reporter* reporter, const char* filename) {
+    SkPath path;
+    path.setFillType(SkPathFillType::kWinding);
+    for (int i = 0; i < 400; ++i) {
+        SkScalar angle = i * (2 * SK_ScalarPI / 400);
+        SkPoint pt = {150 + 100 * SkScalarCos(angle), 150 + 100 * SkScalarSin(angle)};
+        i ? path.lineTo(pt) : path.moveTo(pt);
+    }
+    path.close();
+    path.moveTo(60, 60);
+    for (int i = 1; i <= 100; ++i) {
+        path.lineTo(60 + 1.8f * i, 60);
+    }
+    for (int i = 1; i <= 100; ++i) {
+        path.lineTo(240, 60 + 1.8f * i);
+    }
+    for (int i = 1; i <= 100; ++i) {
+        path.lineTo(240 - 1.8f * i, 240);
+    }
+    for (int i = 1; i < 100; ++i) {
+        path.lineTo(60, 240 - 1.8f * i);
+    }
+    path.close();
+    testSimplify(reporter, path, filename);
+}
+
 static void (*skipTest)(skiatest::Reporter* , const char* filename) = nullptr;
 static void (*firstTest)(skiatest::Reporter* , const char* filename) = nullptr;
 static void (*stopTest)(skiatest::Reporter* , const char* filename) = nullptr;
 
 static TestDesc tests[] = {
+    TEST(manySegments),
     TEST(bug8290),
     TEST(bug8249),
     TEST(bug11958_a),
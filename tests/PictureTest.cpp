@@ -29,6 +29,7 @@
 #include "include/core/SkStream.h"
 #include "include/core/SkTypeface.h"
 #include "include/core/SkTypes.h"
+#include "include/utils/SkNoDrawCanvas.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkBigPicture.h"
 #include "src/core/SkPicturePriv.h"
@@ -36,6 +37,7 @@
 #include "tests/Test.h"
 
 #include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <vector>
 
@@ -945,3 +947,82 @@ DEF_TEST(Picture_nested_op_count, r) {
     check(make_pic(10, leaf1),  10,  10);
     check(make_pic(10, leaf10), 10, 100);
 }
+
+namespace {
+// Records the generation ID of every path drawn.
+class PathGenIDCanvas : public SkNoDrawCanvas {
+public:
+    PathGenIDCanvas() : SkNoDrawCanvas(100, 100) {}
+
+    std::vector<uint32_t> fGenIDs;
+
+protected:
+    void onDrawPath(const SkPath& path, const SkPaint&) override {
+        fGenIDs.push_back(path.getGenerationID());
+    }
+};
+
+SkPath make_triangle(SkScalar dx) {
+    SkPath path;
+    path.moveTo(dx, 0);
+    path.lineTo(dx + 10, 0);
+    path.conicTo(dx + 10, 10, dx, 10, 0.5f);
+    path.close();
+    return path;
+}
+
+sk_sp<SkPicture> record_triangles(bool internPaths) {
+    SkPictureRecorder rec;
+    rec.setInternPaths(internPaths);
+    SkCanvas* c = rec.beginRecording({0,0, 100,100});
+    c->drawPath(make_triangle(0), SkPaint{});
+    c->drawPath(make_triangle(0), SkPaint{});
+    c->drawPath(make_triangle(20), SkPaint{});
+    SkPath inverse = make_triangle(0);
+    inverse.setFillType(SkPathFillType::kInverseWinding);
+    c->drawPath(inverse, SkPaint{});
+    return rec.finishRecordingAsPicture();
+}
+
+std::vector<uint32_t> drawn_gen_ids(const SkPicture* pic) {
+    PathGenIDCanvas canvas;
+    pic->playback(&canvas);
+    return canvas.fGenIDs;
+}
+}  // namespace
+
+DEF_TEST(Picture_internPaths, r) {
+    std::vector<uint32_t> ids = drawn_gen_ids(record_triangles(false).get());
+    REPORTER_ASSERT(r, ids.size() == 4);
+    REPORTER_ASSERT(r, ids[0] != ids[1]);
+
+    ids = drawn_gen_ids(record_triangles(true).get());
+    REPORTER_ASSERT(r, ids.size() == 4);
+    REPORTER_ASSERT(r, ids[0] == ids[1]);
+    REPORTER_ASSERT(r, ids[0] != ids[2]);
+#if !defined(SK_BUILD_FOR_ANDROID_FRAMEWORK)
+    // The fill type is kept, but the geometry is shared.
+    REPORTER_ASSERT(r, ids[0] == ids[3]);
+#endif
+}
+
+DEF_TEST(Picture_serializeDedupesPaths, r) {
+    // Paths are written once per generation ID, so separately built copies of the same geometry
+    // are only written once if they were interned while recording.
+    sk_sp<SkData> plain = record_triangles(false)->serialize();
+    sk_sp<SkData> interned = record_triangles(true)->serialize();
+    REPORTER_ASSERT(r, plain->size() > interned->size());
+
+    sk_sp<SkPicture> pic = SkPicture::MakeFromData(interned.get());
+    REPORTER_ASSERT(r, pic);
+    std::vector<uint32_t> ids = drawn_gen_ids(pic.get());
+    REPORTER_ASSERT(r, ids.size() == 4);
+    REPORTER_ASSERT(r, ids[0] == ids[1]);
+    REPORTER_ASSERT(r, ids[0] != ids[2]);
+
+    pic = SkPicture::MakeFromData(plain.get());
+    REPORTER_ASSERT(r, pic);
+    ids = drawn_gen_ids(pic.get());
+    REPORTER_ASSERT(r, ids.size() == 4);
+    REPORTER_ASSERT(r, ids[0] != ids[1]);
+}
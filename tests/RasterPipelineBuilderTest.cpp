@@ -10,6 +10,8 @@
 #include "src/base/SkStringView.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkReadBuffer.h"
+#include "src/core/SkWriteBuffer.h"
 #include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
 #include "tests/Test.h"
 
@@ -139,10 +141,9 @@ DEF_TEST(RasterPipelineBuilderCaseOp, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x0000007B (1.723597e-43)
-    2. copy_constant                  $1 = 0xFFFFFFFF
-    3. case_op                        if ($0 == 0x0000007B) { LoopMask = true; $1 = false; }
-    4. case_op                        if ($0 == 0x0000007C) { LoopMask = true; $1 = false; }
+R"(    1. copy_2_constants               $0..1 = [0x0000007B (1.723597e-43), 0xFFFFFFFF]
+    2. case_op                        if ($0 == 0x0000007B) { LoopMask = true; $1 = false; }
+    3. case_op                        if ($0 == 0x0000007C) { LoopMask = true; $1 = false; }
 )");
 }
 
@@ -208,8 +209,7 @@ DEF_TEST(RasterPipelineBuilderPushPopTempImmediates, r) {
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
 R"(    1. copy_constant                  $2 = 0x000003E7 (1.399897e-42)
-    2. copy_constant                  $0 = 0x41580000 (13.5)
-    3. copy_constant                  $1 = 0x00000165 (5.002636e-43)
+    2. copy_2_constants               $0..1 = [0x41580000 (13.5), 0x00000165 (5.002636e-43)]
 )");
 }
 
@@ -285,19 +285,16 @@ DEF_TEST(RasterPipelineBuilderDuplicateSelectAndSwizzleSlots, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/6,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x3F800000 (1.0)
-    2. copy_slot_unmasked             $1 = $0
-    3. swizzle_3                      $1..3 = ($1..3).xxx
-    4. swizzle_4                      $3..6 = ($3..6).xxxx
-    5. swizzle_4                      $6..9 = ($6..9).xxxx
-    6. swizzle_3                      $9..11 = ($9..11).xxx
-    7. copy_4_slots_masked            $4..7 = Mask($8..11)
-    8. copy_3_slots_masked            $2..4 = Mask($5..7)
-    9. copy_slot_masked               $3 = Mask($4)
-   10. swizzle_copy_4_slots_masked    (v1..4).wzyx = Mask($0..3)
-   11. swizzle_copy_3_slots_masked    (v0..3).xyw = Mask($1..3)
-   12. swizzle_4                      $0..3 = ($0..3).wzyx
-   13. swizzle_2                      $0..1 = ($0..2).yz
+R"(    1. copy_4_constants               $0..3 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    2. copy_4_constants               $4..7 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    3. copy_4_constants               $8..11 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    4. copy_4_slots_masked            $4..7 = Mask($8..11)
+    5. copy_3_slots_masked            $2..4 = Mask($5..7)
+    6. copy_slot_masked               $3 = Mask($4)
+    7. swizzle_copy_4_slots_masked    (v1..4).wzyx = Mask($0..3)
+    8. swizzle_copy_3_slots_masked    (v0..3).xyw = Mask($1..3)
+    9. swizzle_4                      $0..3 = ($0..3).wzyx
+   10. swizzle_2                      $0..1 = ($0..2).yz
 )");
 }
 
@@ -315,16 +312,15 @@ DEF_TEST(RasterPipelineBuilderTransposeMatrix, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x3F800000 (1.0)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_4_slots_unmasked          $4..7 = $0..3
-    4. copy_4_slots_unmasked          $8..11 = $4..7
-    5. copy_4_slots_unmasked          $12..15 = $8..11
-    6. swizzle_3                      $13..15 = ($13..15).yxz
-    7. shuffle                        $8..15 = ($8..15)[2 5 0 3 6 1 4 7]
-    8. shuffle                        $1..15 = ($1..15)[3 7 11 0 4 8 12 1 5 9 13 2 6 10 14]
-    9. shuffle                        $9..15 = ($9..15)[3 0 4 1 5 2 6]
-   10. shuffle                        $5..15 = ($5..15)[2 5 8 0 3 6 9 1 4 7 10]
+R"(    1. copy_4_constants               $0..3 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    2. copy_4_constants               $4..7 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    3. copy_4_constants               $8..11 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    4. copy_4_constants               $12..15 = [0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0), 0x3F800000 (1.0)]
+    5. swizzle_3                      $13..15 = ($13..15).yxz
+    6. shuffle                        $8..15 = ($8..15)[2 5 0 3 6 1 4 7]
+    7. shuffle                        $1..15 = ($1..15)[3 7 11 0 4 8 12 1 5 9 13 2 6 10 14]
+    8. shuffle                        $9..15 = ($9..15)[3 0 4 1 5 2 6]
+    9. shuffle                        $5..15 = ($5..15)[2 5 8 0 3 6 9 1 4 7 10]
 )");
 }
 
@@ -374,21 +370,17 @@ DEF_TEST(RasterPipelineBuilderMatrixResize, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x3F800000 (1.0)
-    2. copy_constant                  $1 = 0x40000000 (2.0)
-    3. copy_constant                  $2 = 0x40400000 (3.0)
-    4. copy_constant                  $3 = 0x40800000 (4.0)
+R"(    1. copy_4_constants               $0..3 = [0x3F800000 (1.0), 0x40000000 (2.0), 0x40400000 (3.0), 0x40800000 (4.0)]
+    2. copy_2_constants               $4..5 = [0x00000000 (0.0), 0x3F800000 (1.0)]
+    3. shuffle                        $2..15 = ($2..15)[2 2 0 1 2 2 2 2 3 2 2 2 2 3]
+    4. shuffle                        $2..3 = ($2..3)[2 3]
     5. zero_slot_unmasked             $4 = 0
-    6. copy_constant                  $5 = 0x3F800000 (1.0)
-    7. shuffle                        $2..15 = ($2..15)[2 2 0 1 2 2 2 2 3 2 2 2 2 3]
-    8. shuffle                        $2..3 = ($2..3)[2 3]
-    9. zero_slot_unmasked             $4 = 0
-   10. shuffle                        $2..7 = ($2..7)[2 2 0 1 2 2]
-   11. zero_slot_unmasked             $8 = 0
-   12. shuffle                        $2..7 = ($2..7)[2 3 6 6 6 6]
-   13. zero_slot_unmasked             $8 = 0
-   14. copy_constant                  $9 = 0x3F800000 (1.0)
-   15. shuffle                        $2..8 = ($2..8)[6 0 1 6 2 3 7]
+    6. shuffle                        $2..7 = ($2..7)[2 2 0 1 2 2]
+    7. zero_slot_unmasked             $8 = 0
+    8. shuffle                        $2..7 = ($2..7)[2 3 6 6 6 6]
+    9. zero_slot_unmasked             $8 = 0
+   10. copy_constant                  $9 = 0x3F800000 (1.0)
+   11. shuffle                        $2..8 = ($2..8)[6 0 1 6 2 3 7]
 )");
 }
 
@@ -522,25 +514,24 @@ DEF_TEST(RasterPipelineBuilderBinaryFloatOps, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x41200000 (10.0)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_4_slots_unmasked          $4..7 = $0..3
-    4. copy_4_slots_unmasked          $8..11 = $4..7
-    5. copy_4_slots_unmasked          $12..15 = $8..11
-    6. copy_4_slots_unmasked          $16..19 = $12..15
-    7. copy_4_slots_unmasked          $20..23 = $16..19
-    8. copy_4_slots_unmasked          $24..27 = $20..23
-    9. swizzle_4                      $27..30 = ($27..30).xxxx
-   10. add_float                      $29 += $30
-   11. sub_2_floats                   $26..27 -= $28..29
-   12. mul_3_floats                   $22..24 *= $25..27
-   13. div_4_floats                   $17..20 /= $21..24
-   14. max_3_floats                   $15..17 = max($15..17, $18..20)
-   15. min_2_floats                   $14..15 = min($14..15, $16..17)
-   16. cmplt_n_floats                 $6..10 = lessThan($6..10, $11..15)
-   17. cmple_4_floats                 $3..6 = lessThanEqual($3..6, $7..10)
-   18. cmpeq_3_floats                 $1..3 = equal($1..3, $4..6)
-   19. cmpne_2_floats                 $0..1 = notEqual($0..1, $2..3)
+R"(    1. copy_4_constants               $0..3 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    2. copy_4_constants               $4..7 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    3. copy_4_constants               $8..11 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    4. copy_4_constants               $12..15 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    5. copy_4_constants               $16..19 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    6. copy_4_constants               $20..23 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    7. copy_4_constants               $24..27 = [0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0), 0x41200000 (10.0)]
+    8. copy_2_constants               $28..29 = [0x41200000 (10.0), 0x41200000 (10.0)]
+    9. add_imm_float                  $29 += 0x41200000 (10.0)
+   10. sub_2_floats                   $26..27 -= $28..29
+   11. mul_3_floats                   $22..24 *= $25..27
+   12. div_4_floats                   $17..20 /= $21..24
+   13. max_3_floats                   $15..17 = max($15..17, $18..20)
+   14. min_2_floats                   $14..15 = min($14..15, $16..17)
+   15. cmplt_n_floats                 $6..10 = lessThan($6..10, $11..15)
+   16. cmple_4_floats                 $3..6 = lessThanEqual($3..6, $7..10)
+   17. cmpeq_3_floats                 $1..3 = equal($1..3, $4..6)
+   18. cmpne_2_floats                 $0..1 = notEqual($0..1, $2..3)
 )");
 }
 
@@ -567,31 +558,29 @@ DEF_TEST(RasterPipelineBuilderBinaryIntOps, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x0000007B (1.723597e-43)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_4_slots_unmasked          $4..7 = $0..3
-    4. copy_4_slots_unmasked          $8..11 = $4..7
-    5. copy_4_slots_unmasked          $12..15 = $8..11
-    6. copy_4_slots_unmasked          $16..19 = $12..15
-    7. copy_4_slots_unmasked          $20..23 = $16..19
-    8. copy_4_slots_unmasked          $24..27 = $20..23
-    9. copy_4_slots_unmasked          $28..31 = $24..27
-   10. copy_4_slots_unmasked          $32..35 = $28..31
-   11. copy_4_slots_unmasked          $36..39 = $32..35
-   12. copy_slot_unmasked             $40 = $39
-   13. bitwise_and_int                $39 &= $40
-   14. bitwise_xor_2_ints             $36..37 ^= $38..39
-   15. bitwise_or_3_ints              $32..34 |= $35..37
-   16. add_2_ints                     $31..32 += $33..34
-   17. sub_3_ints                     $27..29 -= $30..32
-   18. mul_4_ints                     $22..25 *= $26..29
-   19. div_n_ints                     $16..20 /= $21..25
-   20. max_4_ints                     $13..16 = max($13..16, $17..20)
-   21. min_3_ints                     $11..13 = min($11..13, $14..16)
-   22. cmplt_int                      $12 = lessThan($12, $13)
-   23. cmple_2_ints                   $9..10 = lessThanEqual($9..10, $11..12)
-   24. cmpeq_3_ints                   $5..7 = equal($5..7, $8..10)
-   25. cmpne_4_ints                   $0..3 = notEqual($0..3, $4..7)
+R"(    1. copy_4_constants               $0..3 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    2. copy_4_constants               $4..7 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    3. copy_4_constants               $8..11 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    4. copy_4_constants               $12..15 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    5. copy_4_constants               $16..19 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    6. copy_4_constants               $20..23 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    7. copy_4_constants               $24..27 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    8. copy_4_constants               $28..31 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+    9. copy_4_constants               $32..35 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+   10. copy_4_constants               $36..39 = [0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43), 0x0000007B (1.723597e-43)]
+   11. bitwise_and_imm_int            $39 &= 0x0000007B
+   12. bitwise_xor_2_ints             $36..37 ^= $38..39
+   13. bitwise_or_3_ints              $32..34 |= $35..37
+   14. add_2_ints                     $31..32 += $33..34
+   15. sub_3_ints                     $27..29 -= $30..32
+   16. mul_4_ints                     $22..25 *= $26..29
+   17. div_n_ints                     $16..20 /= $21..25
+   18. max_4_ints                     $13..16 = max($13..16, $17..20)
+   19. min_3_ints                     $11..13 = min($11..13, $14..16)
+   20. cmplt_int                      $12 = lessThan($12, $13)
+   21. cmple_2_ints                   $9..10 = lessThanEqual($9..10, $11..12)
+   22. cmpeq_3_ints                   $5..7 = equal($5..7, $8..10)
+   23. cmpne_4_ints                   $0..3 = notEqual($0..3, $4..7)
 )");
 }
 
@@ -610,18 +599,17 @@ DEF_TEST(RasterPipelineBuilderBinaryUIntOps, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x000001C8 (6.389921e-43)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_4_slots_unmasked          $4..7 = $0..3
-    4. copy_4_slots_unmasked          $8..11 = $4..7
-    5. copy_4_slots_unmasked          $12..15 = $8..11
-    6. copy_4_slots_unmasked          $16..19 = $12..15
-    7. swizzle_3                      $19..21 = ($19..21).xxx
-    8. div_n_uints                    $10..15 /= $16..21
-    9. cmplt_n_uints                  $6..10 = lessThan($6..10, $11..15)
-   10. cmple_4_uints                  $3..6 = lessThanEqual($3..6, $7..10)
-   11. max_3_uints                    $1..3 = max($1..3, $4..6)
-   12. min_2_uints                    $0..1 = min($0..1, $2..3)
+R"(    1. copy_4_constants               $0..3 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    2. copy_4_constants               $4..7 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    3. copy_4_constants               $8..11 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    4. copy_4_constants               $12..15 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    5. copy_4_constants               $16..19 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    6. copy_2_constants               $20..21 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    7. div_n_uints                    $10..15 /= $16..21
+    8. cmplt_n_uints                  $6..10 = lessThan($6..10, $11..15)
+    9. cmple_4_uints                  $3..6 = lessThanEqual($3..6, $7..10)
+   10. max_3_uints                    $1..3 = max($1..3, $4..6)
+   11. min_2_uints                    $0..1 = min($0..1, $2..3)
 )");
 }
 
@@ -648,30 +636,29 @@ DEF_TEST(RasterPipelineBuilderUnaryOps, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x000001C8 (6.389921e-43)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_slot_unmasked             $4 = $3
-    4. cast_to_float_from_int         $4 = IntToFloat($4)
-    5. cast_to_float_from_2_uints     $3..4 = UintToFloat($3..4)
-    6. cast_to_int_from_3_floats      $2..4 = FloatToInt($2..4)
-    7. cast_to_uint_from_4_floats     $1..4 = FloatToUint($1..4)
-    8. bitwise_not_4_ints             $0..3 = ~$0..3
-    9. bitwise_not_int                $4 = ~$4
-   10. cos_float                      $1 = cos($1)
-   11. cos_float                      $2 = cos($2)
-   12. cos_float                      $3 = cos($3)
-   13. cos_float                      $4 = cos($4)
-   14. tan_float                      $2 = tan($2)
-   15. tan_float                      $3 = tan($3)
-   16. tan_float                      $4 = tan($4)
-   17. sin_float                      $3 = sin($3)
-   18. sin_float                      $4 = sin($4)
-   19. sqrt_float                     $4 = sqrt($4)
-   20. abs_2_floats                   $3..4 = abs($3..4)
-   21. abs_3_ints                     $2..4 = abs($2..4)
-   22. floor_4_floats                 $1..4 = floor($1..4)
-   23. ceil_4_floats                  $0..3 = ceil($0..3)
-   24. ceil_float                     $4 = ceil($4)
+R"(    1. copy_4_constants               $0..3 = [0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43), 0x000001C8 (6.389921e-43)]
+    2. copy_constant                  $4 = 0x000001C8 (6.389921e-43)
+    3. cast_to_float_from_int         $4 = IntToFloat($4)
+    4. cast_to_float_from_2_uints     $3..4 = UintToFloat($3..4)
+    5. cast_to_int_from_3_floats      $2..4 = FloatToInt($2..4)
+    6. cast_to_uint_from_4_floats     $1..4 = FloatToUint($1..4)
+    7. bitwise_not_4_ints             $0..3 = ~$0..3
+    8. bitwise_not_int                $4 = ~$4
+    9. cos_float                      $1 = cos($1)
+   10. cos_float                      $2 = cos($2)
+   11. cos_float                      $3 = cos($3)
+   12. cos_float                      $4 = cos($4)
+   13. tan_float                      $2 = tan($2)
+   14. tan_float                      $3 = tan($3)
+   15. tan_float                      $4 = tan($4)
+   16. sin_float                      $3 = sin($3)
+   17. sin_float                      $4 = sin($4)
+   18. sqrt_float                     $4 = sqrt($4)
+   19. abs_2_floats                   $3..4 = abs($3..4)
+   20. abs_3_ints                     $2..4 = abs($2..4)
+   21. floor_4_floats                 $1..4 = floor($1..4)
+   22. ceil_4_floats                  $0..3 = ceil($0..3)
+   23. ceil_float                     $4 = ceil($4)
 )");
 }
 
@@ -733,11 +720,10 @@ DEF_TEST(RasterPipelineBuilderTernaryFloatOps, r) {
     std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/0,
                                                                 /*numUniformSlots=*/0);
     check(r, *program,
-R"(    1. copy_constant                  $0 = 0x3F400000 (0.75)
-    2. swizzle_4                      $0..3 = ($0..3).xxxx
-    3. copy_4_slots_unmasked          $4..7 = $0..3
-    4. copy_slot_unmasked             $8 = $7
-    5. mix_3_floats                   $0..2 = mix($3..5, $6..8, $0..2)
+R"(    1. copy_4_constants               $0..3 = [0x3F400000 (0.75), 0x3F400000 (0.75), 0x3F400000 (0.75), 0x3F400000 (0.75)]
+    2. copy_4_constants               $4..7 = [0x3F400000 (0.75), 0x3F400000 (0.75), 0x3F400000 (0.75), 0x3F400000 (0.75)]
+    3. copy_constant                  $8 = 0x3F400000 (0.75)
+    4. mix_3_floats                   $0..2 = mix($3..5, $6..8, $0..2)
 )");
 }
 
@@ -762,3 +748,73 @@ DEF_TEST(RasterPipelineBuilderAutomaticStackRewinding, r) {
     REPORTER_ASSERT(r, skstd::contains(as_string_view(dump), "stack_rewind"));
 #endif
 }
+
+DEF_TEST(RasterPipelineBuilderDeserializeValidatesInstructions, r) {
+    using BuilderOp = SkSL::RP::BuilderOp;
+
+    // Create a very simple nonsense program that uses slots, uniforms, labels, stacks and a child.
+    SkSL::RP::Builder builder;
+    int label = builder.nextLabelID();
+    builder.push_uniform(two_slots_at(0));       // push into 0~1
+    builder.jump(label);
+    builder.unary_op(BuilderOp::abs_int, 2);     // perform work so the program isn't eliminated
+    builder.label(label);
+    builder.pop_slots_unmasked(two_slots_at(1)); // balance stack
+    builder.invoke_shader(0);
+    std::unique_ptr<SkSL::RP::Program> program = builder.finish(/*numValueSlots=*/3,
+                                                                /*numUniformSlots=*/2);
+
+    SkBinaryWriteBuffer writeBuffer;
+    program->serialize(writeBuffer);
+    sk_sp<SkData> data = writeBuffer.snapshotAsData();
+    std::vector<int32_t> ints(data->size() / sizeof(int32_t));
+    memcpy(ints.data(), data->data(), data->size());
+
+    auto deserialize = [&](const std::vector<int32_t>& blob, int numUniformSlots,
+                           int numChildren) {
+        SkReadBuffer readBuffer(blob.data(), blob.size() * sizeof(int32_t));
+        return SkSL::RP::Program::Deserialize(readBuffer, numUniformSlots, numChildren);
+    };
+    // Returns a copy of the program with one field of the first `op` instruction replaced.
+    // The fields are op, slotA, slotB, slotC, immA, immB, immC, after a four-int header.
+    auto corrupt = [&](BuilderOp op, int field, int32_t value) {
+        std::vector<int32_t> blob = ints;
+        for (size_t index = 4; index + 7 <= blob.size(); index += 7) {
+            if (blob[index] == (int)op) {
+                blob[index + field] = value;
+                return blob;
+            }
+        }
+        ERRORF(r, "no %d instruction in the program", (int)op);
+        return blob;
+    };
+
+    // An intact program comes back unchanged.
+    std::unique_ptr<SkSL::RP::Program> copy = deserialize(ints, 2, 1);
+    REPORTER_ASSERT(r, copy);
+    if (copy) {
+        REPORTER_ASSERT(r, get_program_dump(*copy)->equals(get_program_dump(*program).get()));
+    }
+
+    // The uniform and child counts must match the effect that runs it.
+    REPORTER_ASSERT(r, !deserialize(ints, 1, 1));
+    REPORTER_ASSERT(r, !deserialize(ints, 2, 0));
+
+    // Slots must lie inside the buffer that each op reads.
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::push_uniform, 1, 1), 2, 1));
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::push_uniform, 4, 3), 2, 1));
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::copy_stack_to_slots_unmasked, 1, 2), 2, 1));
+
+    // Ops can't pop more than their stack holds, and the stacks must balance.
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::abs_int, 4, 3), 2, 1));
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::discard_stack, 4, 1), 2, 1));
+
+    // Branches must land on a label that the program defines.
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::jump, 4, 1), 2, 1));
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::label, 4, -1), 2, 1));
+
+    // Children must exist, and every op must have a stage.
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::invoke_shader, 4, 1), 2, 1));
+    REPORTER_ASSERT(r, !deserialize(corrupt(BuilderOp::invoke_shader, 0,
+                                            (int)BuilderOp::unsupported), 2, 1));
+}
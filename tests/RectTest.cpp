@@ -17,11 +17,14 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkSurface.h"
 #include "include/core/SkTypes.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkRectPriv.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <climits>
 #include <initializer_list>
+#include <iterator>
 
 static bool has_green_pixels(const SkBitmap& bm) {
     for (int j = 0; j < bm.height(); ++j) {
@@ -151,6 +154,38 @@ DEF_TEST(Rect_setbounds, reporter) {
     }
 }
 
+// setBoundsCheck scans long arrays in wider blocks; check every length and position around them.
+DEF_TEST(Rect_setbounds_long, reporter) {
+    SkRandom rand;
+    SkPoint pts[40];
+    for (SkPoint& pt : pts) {
+        pt = {rand.nextRangeF(-100, 100), rand.nextRangeF(-100, 100)};
+    }
+
+    for (int n = 1; n <= (int)std::size(pts); ++n) {
+        SkRect expected = SkRect::MakeLTRB(pts[0].fX, pts[0].fY, pts[0].fX, pts[0].fY);
+        for (int i = 1; i < n; ++i) {
+            expected.setLTRB(std::min(expected.fLeft, pts[i].fX),
+                             std::min(expected.fTop, pts[i].fY),
+                             std::max(expected.fRight, pts[i].fX),
+                             std::max(expected.fBottom, pts[i].fY));
+        }
+        SkRect r;
+        REPORTER_ASSERT(reporter, r.setBoundsCheck(pts, n));
+        REPORTER_ASSERT(reporter, r == expected);
+
+        for (int i = 0; i < n; ++i) {
+            for (SkScalar bad : {SK_ScalarInfinity, SK_ScalarNaN}) {
+                SkPoint saved = pts[i];
+                pts[i].fY = bad;
+                REPORTER_ASSERT(reporter, !r.setBoundsCheck(pts, n));
+                REPORTER_ASSERT(reporter, r.isEmpty());
+                pts[i] = saved;
+            }
+        }
+    }
+}
+
 static float make_big_value(skiatest::Reporter* reporter) {
     // need to make a big value, one that will cause rect.width() to overflow to inf.
     // however, the windows compiler wants about this if it can see the big value inlined.
@@ -19,9 +19,11 @@
 #include "src/base/SkRandom.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 
 static void Union(SkRegion* rgn, const SkIRect& rect) {
     rgn->op(rect, SkRegion::kUnion_Op);
@@ -527,3 +529,124 @@ DEF_TEST(region_empty_iter, reporter) {
     REPORTER_ASSERT(reporter, !left);
     REPORTER_ASSERT(reporter, !right);
 }
+
+// Builds a region with many spans and many intervals per span, along with its coverage.
+static void make_striped_region(SkRandom& rand, int size, SkRegion* rgn, bool coverage[]) {
+    rgn->setEmpty();
+    memset(coverage, 0, size * size * sizeof(bool));
+    for (int y = 0; y < size; y += 1 + rand.nextU() % 3) {
+        int h = 1 + rand.nextU() % 3;
+        for (int x = rand.nextU() % 4; x < size; x += 2 + rand.nextU() % 4) {
+            int w = 1 + rand.nextU() % 2;
+            SkIRect r = SkIRect::MakeXYWH(x, y, w, h);
+            if (!r.intersect(SkIRect::MakeWH(size, size))) {
+                continue;
+            }
+            rgn->op(r, SkRegion::kUnion_Op);
+            for (int yy = r.fTop; yy < r.fBottom; ++yy) {
+                for (int xx = r.fLeft; xx < r.fRight; ++xx) {
+                    coverage[yy * size + xx] = true;
+                }
+            }
+        }
+    }
+}
+
+static bool slow_contains(const bool coverage[], int size, const SkIRect& r) {
+    for (int y = r.fTop; y < r.fBottom; ++y) {
+        for (int x = r.fLeft; x < r.fRight; ++x) {
+            if (x < 0 || y < 0 || x >= size || y >= size || !coverage[y * size + x]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+static bool slow_intersects(const bool coverage[], int size, const SkIRect& r) {
+    for (int y = std::max(r.fTop, 0); y < std::min(r.fBottom, size); ++y) {
+        for (int x = std::max(r.fLeft, 0); x < std::min(r.fRight, size); ++x) {
+            if (coverage[y * size + x]) {
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+static void check_lookups(skiatest::Reporter* reporter, SkRandom& rand, const SkRegion& rgn,
+                          const bool coverage[], int size, int dx, int dy) {
+    for (int y = -1; y <= size; ++y) {
+        for (int x = -1; x <= size; ++x) {
+            bool expected = slow_contains(coverage, size, SkIRect::MakeXYWH(x, y, 1, 1));
+            REPORTER_ASSERT(reporter, rgn.contains(x + dx, y + dy) == expected, "%d %d", x, y);
+        }
+    }
+    for (int i = 0; i < 1000; ++i) {
+        SkIRect r = SkIRect::MakeXYWH(rand.nextRangeU(0, size), rand.nextRangeU(0, size),
+                                      1 + rand.nextU() % 5, 1 + rand.nextU() % 5);
+        REPORTER_ASSERT(reporter, rgn.contains(r.makeOffset(dx, dy)) ==
+                                  slow_contains(coverage, size, r));
+        REPORTER_ASSERT(reporter, rgn.intersects(r.makeOffset(dx, dy)) ==
+                                  slow_intersects(coverage, size, r));
+    }
+}
+
+// Regions with many spans binary search for scanlines; make sure every way of building or
+// copying one finds the same pixels.
+DEF_TEST(Region_manySpans, reporter) {
+    constexpr int kSize = 96;
+    bool coverageA[kSize * kSize], coverageB[kSize * kSize];
+    SkRandom rand;
+    for (int i = 0; i < 4; ++i) {
+        SkRegion a, b;
+        make_striped_region(rand, kSize, &a, coverageA);
+        make_striped_region(rand, kSize, &b, coverageB);
+        check_lookups(reporter, rand, a, coverageA, kSize, 0, 0);
+
+        // Copy on write.
+        SkRegion shared(a);
+        shared.translate(3, -5);
+        check_lookups(reporter, rand, shared, coverageA, kSize, 3, -5);
+        check_lookups(reporter, rand, a, coverageA, kSize, 0, 0);
+
+        SkRegion translated;
+        a.translate(-7, 2, &translated);
+        check_lookups(reporter, rand, translated, coverageA, kSize, -7, 2);
+
+        const size_t bytes = a.writeToMemory(nullptr);
+        SkAutoMalloc storage(bytes);
+        a.writeToMemory(storage.get());
+        SkRegion read;
+        REPORTER_ASSERT(reporter, read.readFromMemory(storage.get(), bytes));
+        check_lookups(reporter, rand, read, coverageA, kSize, 0, 0);
+
+        // Ops, whose spans are often covered by only one of the operands.
+        b.op(SkIRect::MakeWH(kSize, kSize / 2), SkRegion::kIntersect_Op);
+        b.translate(0, kSize / 2);
+        for (SkRegion::Op op : {SkRegion::kDifference_Op, SkRegion::kIntersect_Op,
+                                SkRegion::kUnion_Op, SkRegion::kXOR_Op,
+                                SkRegion::kReverseDifference_Op}) {
+            SkRegion result;
+            result.op(a, b, op);
+            bool coverage[kSize * kSize];
+            for (int y = 0; y < kSize; ++y) {
+                for (int x = 0; x < kSize; ++x) {
+                    bool inA = coverageA[y * kSize + x];
+                    bool inB = y >= kSize / 2 && coverageB[(y - kSize / 2) * kSize + x];
+                    bool covered;
+                    switch (op) {
+                        case SkRegion::kDifference_Op:        covered = inA && !inB; break;
+                        case SkRegion::kIntersect_Op:         covered = inA && inB;  break;
+                        case SkRegion::kUnion_Op:             covered = inA || inB;  break;
+                        case SkRegion::kXOR_Op:               covered = inA != inB;  break;
+                        case SkRegion::kReverseDifference_Op: covered = !inA && inB; break;
+                        default: SkUNREACHABLE;
+                    }
+                    coverage[y * kSize + x] = covered;
+                }
+            }
+            check_lookups(reporter, rand, result, coverage, kSize, 0, 0);
+        }
+    }
+}
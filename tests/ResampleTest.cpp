@@ -0,0 +1,210 @@
+/*
+ * Copyright 2023 Google LLC
+ *
+ * Use of this source code is governed by a BSD-style license that can be
+ * found in the LICENSE file.
+ */
+
+#include "include/core/SkBitmap.h"
+#include "include/core/SkColor.h"
+#include "include/core/SkColorSpace.h"
+#include "include/core/SkExecutor.h"
+#include "include/core/SkImage.h"
+#include "include/core/SkImageInfo.h"
+#include "include/core/SkPixmap.h"
+#include "include/core/SkRect.h"
+#include "include/core/SkRefCnt.h"
+#include "include/core/SkTypes.h"
+#include "src/base/SkRandom.h"
+#include "src/core/SkResample.h"
+#include "tests/Test.h"
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <utility>
+
+using Filter = SkResample::Filter;
+
+static constexpr Filter kFilters[] = {Filter::kMitchell, Filter::kCatmullRom, Filter::kLanczos3};
+
+static SkBitmap random_bitmap(int w, int h) {
+    SkRandom rand;
+    SkBitmap bm;
+    bm.allocN32Pixels(w, h);
+    for (int y = 0; y < h; ++y) {
+        for (int x = 0; x < w; ++x) {
+            *bm.getAddr32(x, y) = SkPreMultiplyColor(rand.nextU());
+        }
+    }
+    return bm;
+}
+
+DEF_TEST(Resample_constant, r) {
+    SkBitmap src;
+    src.allocN32Pixels(37, 23);
+    src.eraseColor(0x80336699);
+
+    for (Filter filter : kFilters) {
+        for (auto [w, h] : {std::make_pair(5, 3), std::make_pair(37, 23), std::make_pair(90, 71)}) {
+            SkBitmap dst;
+            dst.allocN32Pixels(w, h);
+            REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), dst.pixmap(), {filter}));
+
+            const SkPMColor expected = *src.getAddr32(0, 0);
+            for (int y = 0; y < h; ++y) {
+                for (int x = 0; x < w; ++x) {
+                    SkPMColor c = *dst.getAddr32(x, y);
+                    for (int shift = 0; shift < 32; shift += 8) {
+                        int diff = (int)((c >> shift) & 0xFF) - (int)((expected >> shift) & 0xFF);
+                        REPORTER_ASSERT(r, std::abs(diff) <= 1,
+                                        "filter %d, %dx%d: %08x vs %08x at (%d,%d)",
+                                        (int)filter, w, h, c, expected, x, y);
+                    }
+                }
+            }
+        }
+    }
+}
+
+// Catmull-Rom and Lanczos interpolate, so they leave the pixels alone without any scaling.
+DEF_TEST(Resample_identity, r) {
+    SkBitmap src = random_bitmap(31, 17);
+    for (Filter filter : {Filter::kCatmullRom, Filter::kLanczos3}) {
+        SkBitmap dst;
+        dst.allocPixels(src.info());
+        REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), dst.pixmap(), {filter}));
+        REPORTER_ASSERT(r, 0 == memcmp(src.getPixels(), dst.getPixels(), src.computeByteSize()),
+                        "filter %d", (int)filter);
+    }
+}
+
+// Large downscales average boxes of pixels before filtering. Like the filters, that reproduces a
+// linear ramp, so the boxes must line up with the source pixels they cover.
+DEF_TEST(Resample_reduce, r) {
+    SkBitmap src;
+    src.allocN32Pixels(1000, 8);
+    for (int y = 0; y < src.height(); ++y) {
+        for (int x = 0; x < src.width(); ++x) {
+            const U8CPU v = (U8CPU)(x * 255 / 999);
+            *src.getAddr32(x, y) = SkPreMultiplyColor(SkColorSetRGB(v, v, v));
+        }
+    }
+
+    for (Filter filter : kFilters) {
+        for (int w : {250, 100, 37}) {
+            SkBitmap dst;
+            dst.allocN32Pixels(w, 1);
+            REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), dst.pixmap(), {filter}));
+
+            // Away from the edges, where the filter is cut off, each pixel is the ramp's value
+            // at its center.
+            const float scale = 1000.0f / w;
+            for (int x = 3; x < w - 3; ++x) {
+                const float center = (x + 0.5f) * scale - 0.5f;
+                const int expected = (int)(center * 255 / 999),
+                          actual   = SkColorGetG(dst.getColor(x, 0));
+                REPORTER_ASSERT(r, std::abs(actual - expected) <= 1,
+                                "filter %d, width %d: %d vs %d at %d",
+                                (int)filter, w, actual, expected, x);
+            }
+        }
+    }
+}
+
+// Raster images rescale cubic downscales with SkResample.
+DEF_TEST(Resample_rescaleAndReadPixels, r) {
+    SkBitmap src = random_bitmap(300, 200);
+    sk_sp<SkImage> image = src.asImage();
+    const SkIRect subset = SkIRect::MakeXYWH(10, 20, 250, 170);
+
+    SkBitmap expected;
+    expected.allocN32Pixels(61, 43);
+    SkPixmap srcSubset;
+    REPORTER_ASSERT(r, src.pixmap().extractSubset(&srcSubset, subset));
+    REPORTER_ASSERT(r, SkResample::Scale(srcSubset, expected.pixmap()));
+
+    struct Context {
+        skiatest::Reporter* fReporter;
+        const SkBitmap*     fExpected;
+        bool                fCalled = false;
+    } context{r, &expected};
+    image->asyncRescaleAndReadPixels(
+            expected.info(), subset, SkImage::RescaleGamma::kSrc,
+            SkImage::RescaleMode::kRepeatedCubic,
+            [](void* c, std::unique_ptr<const SkImage::AsyncReadResult> result) {
+                auto context = static_cast<Context*>(c);
+                context->fCalled = true;
+                skiatest::Reporter* r = context->fReporter;
+                if (!result) {
+                    ERRORF(r, "rescale failed");
+                    return;
+                }
+                const SkBitmap& expected = *context->fExpected;
+                for (int y = 0; y < expected.height(); ++y) {
+                    const void* row = static_cast<const char*>(result->data(0)) +
+                                      y * result->rowBytes(0);
+                    REPORTER_ASSERT(r, 0 == memcmp(row, expected.getAddr32(0, y),
+                                                   expected.width() * sizeof(uint32_t)),
+                                    "row %d", y);
+                }
+            },
+            &context);
+    REPORTER_ASSERT(r, context.fCalled);
+}
+
+// Bands of rows are independent, so running them on a thread pool can't change the results.
+DEF_TEST(Resample_threads, r) {
+    std::unique_ptr<SkExecutor> pool = SkExecutor::MakeFIFOThreadPool(4);
+
+    SkBitmap src = random_bitmap(300, 200);
+    for (Filter filter : kFilters) {
+        for (auto [w, h] : {std::make_pair(97, 61), std::make_pair(700, 450)}) {
+            SkBitmap serial, threaded;
+            serial.allocN32Pixels(w, h);
+            threaded.allocN32Pixels(w, h);
+
+            SkResample::Options options;
+            options.fFilter = filter;
+            REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), serial.pixmap(), options));
+            options.fExecutor = pool.get();
+            REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), threaded.pixmap(), options));
+
+            REPORTER_ASSERT(r, 0 == memcmp(serial.getPixels(), threaded.getPixels(),
+                                           serial.computeByteSize()),
+                            "filter %d, %dx%d", (int)filter, w, h);
+        }
+    }
+}
+
+DEF_TEST(Resample_linear, r) {
+    // Averaging black and white gives 50% gray: 0x80 in sRGB, or 0xBC once encoded from linear.
+    SkBitmap src;
+    src.allocPixels(SkImageInfo::MakeN32Premul(2, 1, SkColorSpace::MakeSRGB()));
+    *src.getAddr32(0, 0) = SkPreMultiplyColor(SK_ColorBLACK);
+    *src.getAddr32(1, 0) = SkPreMultiplyColor(SK_ColorWHITE);
+
+    for (bool linear : {false, true}) {
+        SkBitmap dst;
+        dst.allocPixels(src.info().makeWH(1, 1));
+
+        SkResample::Options options;
+        options.fFilter = Filter::kMitchell;
+        options.fLinear = linear;
+        REPORTER_ASSERT(r, SkResample::Scale(src.pixmap(), dst.pixmap(), options));
+
+        int expected = linear ? 0xBC : 0x80;
+        int actual = SkColorGetG(dst.getColor(0, 0));
+        REPORTER_ASSERT(r, std::abs(actual - expected) <= 1,
+                        "linear %d: %02x vs %02x", linear, actual, expected);
+    }
+}
+
+DEF_TEST(Resample_invalid, r) {
+    SkBitmap src = random_bitmap(4, 4);
+    SkPixmap empty;
+    REPORTER_ASSERT(r, !SkResample::Scale(src.pixmap(), empty));
+    REPORTER_ASSERT(r, !SkResample::Scale(empty, src.pixmap()));
+}
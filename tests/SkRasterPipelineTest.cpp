@@ -5,16 +5,25 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkData.h"
+#include "include/core/SkStream.h"
 #include "include/private/base/SkTo.h"
 #include "src/base/SkHalf.h"
 #include "src/base/SkUtils.h"
 #include "src/core/SkOpts.h"
 #include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineProfiler.h"
 #include "src/gpu/Swizzle.h"
+#include "src/utils/SkJSON.h"
+#include "src/utils/SkJSONWriter.h"
 #include "tests/Test.h"
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <functional>
 #include <numeric>
+#include <vector>
 
 DEF_TEST(SkRasterPipeline, r) {
     // Build and run a simple pipeline to exercise SkRasterPipeline,
@@ -2336,6 +2345,27 @@ DEF_TEST(SkRasterPipeline_lowp_clamp01, r) {
     p.run(0,0,1,1);
 }
 
+DEF_TEST(SkRasterPipeline_highpReason, r) {
+    uint32_t rgba = 0xff00ff00;
+    SkRasterPipeline_MemoryCtx ptr = { &rgba, 0 };
+
+    SkRasterPipeline_<256> p;
+    p.append(SkRasterPipelineOp::load_8888, &ptr);
+    p.append(SkRasterPipelineOp::swap_rb);
+    p.append(SkRasterPipelineOp::store_8888, &ptr);
+    if (!SkOpts::just_return_lowp) {
+        // Without any lowp stages, every pipeline runs in highp.
+        REPORTER_ASSERT(r, !strcmp(p.highpReason(), "no lowp stages in this build"));
+        return;
+    }
+    REPORTER_ASSERT(r, !p.highpReason());
+
+    // The first op with no lowp stage is the one we blame.
+    p.append(SkRasterPipelineOp::unpremul);
+    p.append(SkRasterPipelineOp::unpremul_polar);
+    REPORTER_ASSERT(r, !strcmp(p.highpReason(), "unpremul"));
+}
+
 // Helper struct that can be used to scrape stack addresses at different points in a pipeline
 class StackCheckerCtx : SkRasterPipeline_CallbackCtx {
 public:
@@ -2442,3 +2472,84 @@ DEF_TEST(SkRasterPipeline_stack_rewind, r) {
         stack.validate(r);
     }
 }
+
+DEF_TEST(SkRasterPipeline_Profile, r) {
+    // Allocate space for 4 slots.
+    alignas(64) float slots[4 * SkRasterPipeline_kMaxStride_highp] = {};
+    const int N = SkOpts::raster_pipeline_highp_stride;
+
+    alignas(64) static constexpr float kColorDarkRed[4] = {0.5f, 0.0f, 0.0f, 0.75f};
+    alignas(64) static constexpr float kColorGreen[4]   = {0.0f, 1.0f, 0.0f, 1.0f};
+    const int offset = 2;
+
+    // Profile a program which jumps over an append_constant_color op. The jump must also skip the
+    // profile stage in front of that op.
+    SkRasterPipelineProfiler::SetEnabled(true);
+    SkArenaAlloc alloc(/*firstHeapAllocation=*/256);
+    SkRasterPipeline p(&alloc);
+    p.append_constant_color(&alloc, kColorGreen);      // assign green
+    p.append(SkRasterPipelineOp::jump, &offset);       // jump over the dark-red color assignment
+    p.append_constant_color(&alloc, kColorDarkRed);    // (not executed)
+    p.append(SkRasterPipelineOp::store_src, slots);    // store the result so we can check it
+    p.run(0,0,1,1);
+    SkRasterPipelineProfiler::SetEnabled(false);
+
+    // Verify that the slots contain green.
+    float* destPtr = &slots[0];
+    for (int checkSlot = 0; checkSlot < 4; ++checkSlot) {
+        for (int checkLane = 0; checkLane < N; ++checkLane) {
+            REPORTER_ASSERT(r, *destPtr == kColorGreen[checkSlot]);
+            ++destPtr;
+        }
+    }
+
+    // Find our pipeline in the profile. Other tests may run the same one concurrently, so we only
+    // check that every stage but the skipped one has run equally often.
+    SkDynamicMemoryWStream stream;
+    {
+        SkJSONWriter writer(&stream);
+        SkRasterPipelineProfiler::Dump(&writer);
+    }
+    sk_sp<SkData> json = stream.detachAsData();
+    skjson::DOM dom(static_cast<const char*>(json->data()), json->size());
+    const skjson::ObjectValue* profile = dom.root();
+    const skjson::ArrayValue* pipelines = nullptr;
+    if (profile) {
+        pipelines = (*profile)["pipelines"];
+    }
+    if (!pipelines) {
+        ERRORF(r, "profile has no pipelines");
+        return;
+    }
+
+    static constexpr const char* kExpectedOps[] = {"uniform_color", "jump",
+                                                   "uniform_color", "store_src"};
+    bool found = false;
+    for (const skjson::Value& value : *pipelines) {
+        const skjson::ObjectValue* pipeline = value;
+        if (!pipeline) {
+            continue;
+        }
+        const skjson::ArrayValue* stages = (*pipeline)["stages"];
+        if (!stages || stages->size() != std::size(kExpectedOps)) {
+            continue;
+        }
+        bool matches = true;
+        double counts[std::size(kExpectedOps)];
+        for (size_t i = 0; i < std::size(kExpectedOps); ++i) {
+            const skjson::ObjectValue& stage = (*stages)[i].as<skjson::ObjectValue>();
+            const skjson::StringValue* op = stage["op"];
+            const skjson::NumberValue* count = stage["count"];
+            matches = matches && op && count && op->str() == kExpectedOps[i];
+            counts[i] = count ? **count : 0;
+        }
+        if (matches) {
+            found = true;
+            REPORTER_ASSERT(r, counts[0] >= 1);
+            REPORTER_ASSERT(r, counts[1] == counts[0]);
+            REPORTER_ASSERT(r, counts[2] == 0);
+            REPORTER_ASSERT(r, counts[3] == counts[0]);
+        }
+    }
+    REPORTER_ASSERT(r, found);
+}
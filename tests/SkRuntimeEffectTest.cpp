@@ -6,12 +6,14 @@
  */
 
 #include "include/core/SkAlphaType.h"
+#include "include/core/SkBitmap.h"
 #include "include/core/SkBlendMode.h"
 #include "include/core/SkBlender.h"
 #include "include/core/SkCanvas.h"
 #include "include/core/SkCapabilities.h"
 #include "include/core/SkColor.h"
 #include "include/core/SkColorFilter.h"
+#include "include/core/SkColorSpace.h"
 #include "include/core/SkColorType.h"
 #include "include/core/SkData.h"
 #include "include/core/SkImageInfo.h"
@@ -32,13 +34,18 @@
 #include "include/gpu/GpuTypes.h"
 #include "include/gpu/GrDirectContext.h"
 #include "include/private/SkColorData.h"
+#include "include/private/SkSLProgramKind.h"
 #include "include/private/SkSLSampleUsage.h"
 #include "include/private/SkSLString.h"
 #include "include/private/base/SkTArray.h"
 #include "include/sksl/SkSLDebugTrace.h"
 #include "include/sksl/SkSLVersion.h"
+#include "src/base/SkArenaAlloc.h"
 #include "src/base/SkTLazy.h"
 #include "src/core/SkColorSpacePriv.h"
+#include "src/core/SkRasterPipeline.h"
+#include "src/core/SkRasterPipelineOpContexts.h"
+#include "src/core/SkRasterPipelineOpList.h"
 #include "src/core/SkRuntimeEffectPriv.h"
 #include "src/gpu/KeyBuilder.h"
 #include "src/gpu/SkBackingFit.h"
@@ -50,17 +57,25 @@
 #include "src/gpu/ganesh/GrPixmap.h"
 #include "src/gpu/ganesh/SurfaceFillContext.h"
 #include "src/gpu/ganesh/effects/GrSkSLFP.h"
+#include "src/sksl/SkSLCompiler.h"
+#include "src/sksl/SkSLUtil.h"
+#include "src/sksl/codegen/SkSLRasterPipelineBuilder.h"
+#include "src/sksl/codegen/SkSLRasterPipelineCodeGenerator.h"
+#include "src/sksl/ir/SkSLFunctionDeclaration.h"
+#include "src/sksl/ir/SkSLProgram.h"
 #include "tests/CtsEnforcement.h"
 #include "tests/Test.h"
 
 #include <array>
 #include <cstdint>
+#include <cstring>
 #include <functional>
 #include <initializer_list>
 #include <memory>
 #include <string>
 #include <thread>
 #include <utility>
+#include <vector>
 
 class GrRecordingContext;
 struct GrContextOptions;
@@ -1228,6 +1243,292 @@ DEF_TEST(SkRuntimeEffectThreaded, r) {
     }
 }
 
+DEF_TEST(SkSLModuleLoaderThreaded, r) {
+    // Threads loading different modules (and the modules they share) at the same time should all
+    // get the same Module for each program kind.
+    static constexpr SkSL::ProgramKind kKinds[] = {
+            SkSL::ProgramKind::kRuntimeShader,
+            SkSL::ProgramKind::kPrivateRuntimeShader,
+            SkSL::ProgramKind::kFragment,
+            SkSL::ProgramKind::kVertex,
+            SkSL::ProgramKind::kCompute,
+    };
+    const SkSL::Module* modules[16] = {};
+
+    std::thread threads[16];
+    for (int i = 0; i < 16; ++i) {
+        threads[i] = std::thread([&modules, i]() {
+            SkSL::Compiler compiler(SkSL::ShaderCapsFactory::Standalone());
+            modules[i] = compiler.moduleForProgramKind(kKinds[i % std::size(kKinds)]);
+        });
+    }
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (int i = 0; i < 16; ++i) {
+        REPORTER_ASSERT(r, modules[i]);
+        REPORTER_ASSERT(r, modules[i] == modules[i % std::size(kKinds)]);
+    }
+}
+
+DEF_TEST(SkRuntimeEffectPersistentCache, r) {
+    class MemoryCache : public SkRuntimeEffect::PersistentCache {
+    public:
+        sk_sp<SkData> load(const SkData& key) override {
+            fLoadCount++;
+            for (const auto& [k, data] : fEntries) {
+                if (k->equals(&key)) {
+                    return data;
+                }
+            }
+            return nullptr;
+        }
+        void store(const SkData& key, const SkData& data) override {
+            fStoreCount++;
+            fEntries.push_back({SkData::MakeWithCopy(key.data(), key.size()),
+                                SkData::MakeWithCopy(data.data(), data.size())});
+        }
+
+        std::vector<std::pair<sk_sp<SkData>, sk_sp<SkData>>> fEntries;
+        int fLoadCount = 0;
+        int fStoreCount = 0;
+    };
+
+    static constexpr char kSource[] = R"(
+        layout(color) uniform half4 color;
+        uniform float scale[2];
+        uniform shader child;
+        half4 main(float2 p) { return color * child.eval(p * scale[0] + scale[1]).a; }
+    )";
+
+    MemoryCache cache;
+    SkRuntimeEffect::SetPersistentCache(&cache);
+    sk_sp<SkRuntimeEffect> compiled = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    sk_sp<SkRuntimeEffect> loaded = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    // Different options must not share an entry.
+    sk_sp<SkRuntimeEffect> es3 =
+            SkRuntimeEffect::MakeForShader(SkString(kSource), SkRuntimeEffectPriv::ES3Options())
+                    .effect;
+
+    REPORTER_ASSERT(r, compiled && loaded && es3);
+    REPORTER_ASSERT(r, cache.fLoadCount == 3);
+    REPORTER_ASSERT(r, cache.fStoreCount == 2);
+
+    // The loaded effect reflects the same uniforms and children.
+    REPORTER_ASSERT(r, loaded->source() == compiled->source());
+    REPORTER_ASSERT(r, loaded->allowShader() && !loaded->allowColorFilter());
+    REPORTER_ASSERT(r, loaded->uniformSize() == compiled->uniformSize());
+    REPORTER_ASSERT(r, loaded->uniforms().size() == compiled->uniforms().size());
+    for (size_t i = 0; i < loaded->uniforms().size(); ++i) {
+        const SkRuntimeEffect::Uniform& a = compiled->uniforms()[i];
+        const SkRuntimeEffect::Uniform& b = loaded->uniforms()[i];
+        REPORTER_ASSERT(r, a.name == b.name && a.offset == b.offset && a.type == b.type &&
+                           a.count == b.count && a.flags == b.flags);
+    }
+    REPORTER_ASSERT(r, loaded->children().size() == 1);
+    REPORTER_ASSERT(r, loaded->findChild("child"));
+    REPORTER_ASSERT(r, loaded->findChild("child")->type == SkRuntimeEffect::ChildType::kShader);
+
+    // ... and draws the same.
+    struct {
+        SkColor4f color = {1, 0.5f, 0.25f, 1};
+        float scale[2] = {0.5f, 0.25f};
+    } uniforms;
+    SkBitmap bitmaps[2];
+    for (int i = 0; i < 2; ++i) {
+        sk_sp<SkRuntimeEffect> effect = i ? loaded : compiled;
+        SkRuntimeEffect::ChildPtr children[] = {SkShaders::Color(0x80FFFFFF)};
+        SkPaint paint;
+        paint.setShader(effect->makeShader(SkData::MakeWithCopy(&uniforms, sizeof(uniforms)),
+                                           children));
+        bitmaps[i].allocN32Pixels(4, 4);
+        SkCanvas(bitmaps[i]).drawPaint(paint);
+    }
+    REPORTER_ASSERT(r, !memcmp(bitmaps[0].getPixels(), bitmaps[1].getPixels(),
+                               bitmaps[0].computeByteSize()));
+    REPORTER_ASSERT(r, *bitmaps[1].getAddr32(0, 0) != 0);
+
+    // Data that doesn't match the source is ignored, and replaced.
+    cache.fEntries[0].second = SkData::MakeSubset(cache.fEntries[0].second.get(), 0, 16);
+    sk_sp<SkRuntimeEffect> recompiled = SkRuntimeEffect::MakeForShader(SkString(kSource)).effect;
+    REPORTER_ASSERT(r, recompiled);
+    REPORTER_ASSERT(r, cache.fStoreCount == 3);
+
+    SkRuntimeEffect::SetPersistentCache(nullptr);
+    REPORTER_ASSERT(r, SkRuntimeEffect::MakeForShader(SkString(kSource)).effect);
+    REPORTER_ASSERT(r, cache.fLoadCount == 4);
+}
+
+DEF_TEST(SkRuntimeEffectSpecializeUniforms, r) {
+    static constexpr char kShader[] = R"(
+        layout(color) uniform half4 color;
+        uniform float a, b;
+        uniform int mode;
+        uniform float2x2 m;
+        uniform float weights[2];
+        uniform shader child;
+        half4 main(float2 p) {
+            p = m * p;
+            half4 c = child.eval(p);
+            if (mode == 1) {
+                c = c * color;
+            } else if (mode == 2) {
+                c = c.bgra * a + b;
+            }
+            return c * weights[0] + weights[1] * half(p.x > a);
+        }
+    )";
+    static constexpr char kColorFilter[] = R"(
+        uniform half k;
+        uniform half3 tint;
+        half4 main(half4 c) { return half4(mix(c.rgb, tint, k), c.a); }
+    )";
+
+    SkRuntimeEffect::Options options;
+    options.specializeUniforms = true;
+    sk_sp<SkRuntimeEffect> shader = SkRuntimeEffect::MakeForShader(SkString(kShader)).effect;
+    sk_sp<SkRuntimeEffect> specializedShader =
+            SkRuntimeEffect::MakeForShader(SkString(kShader), options).effect;
+    sk_sp<SkRuntimeEffect> colorFilter =
+            SkRuntimeEffect::MakeForColorFilter(SkString(kColorFilter)).effect;
+    sk_sp<SkRuntimeEffect> specializedColorFilter =
+            SkRuntimeEffect::MakeForColorFilter(SkString(kColorFilter), options).effect;
+    REPORTER_ASSERT(r, shader && specializedShader && colorFilter && specializedColorFilter);
+
+    struct {
+        SkColor4f color;
+        float a, b;
+        int mode;
+        float m[4];
+        float weights[2];
+    } shaderUniforms = {{1, 0.5f, 0.25f, 1}, 3, 0.125f, 0, {1, 0, 0, 1}, {1, 0}};
+    struct {
+        float k;
+        float tint[3];
+    } colorFilterUniforms = {0.5f, {0, 1, 0}};
+
+    // Draw each set of values twice, with more sets than an effect keeps programs for, so that
+    // programs are both reused and evicted.
+    for (int i = 0; i < 24; ++i) {
+        const int values = i / 2;
+        shaderUniforms.mode = values % 3;
+        shaderUniforms.a = values * 0.75f;
+        shaderUniforms.m[1] = -shaderUniforms.a / 8;
+        shaderUniforms.weights[1] = values * 0.01f;
+        colorFilterUniforms.k = values / 12.0f;
+
+        // The layout(color) uniform is converted to a tagged destination's color space before
+        // it's folded.
+        const sk_sp<SkColorSpace> dstCS = (i % 4 < 2) ? nullptr : SkColorSpace::MakeRGB(
+                SkNamedTransferFn::kSRGB, SkNamedGamut::kRec2020);
+        SkBitmap bitmaps[2];
+        for (int specialized = 0; specialized < 2; ++specialized) {
+            SkRuntimeEffect::ChildPtr children[] = {SkShaders::Color(0xC080FF40)};
+            SkPaint paint;
+            paint.setShader((specialized ? specializedShader : shader)
+                    ->makeShader(SkData::MakeWithCopy(&shaderUniforms, sizeof(shaderUniforms)),
+                                 children));
+            paint.setColorFilter((specialized ? specializedColorFilter : colorFilter)
+                    ->makeColorFilter(SkData::MakeWithCopy(&colorFilterUniforms,
+                                                           sizeof(colorFilterUniforms))));
+            bitmaps[specialized].allocPixels(SkImageInfo::MakeN32Premul(8, 8, dstCS));
+            SkCanvas(bitmaps[specialized]).drawPaint(paint);
+        }
+        REPORTER_ASSERT(r, !memcmp(bitmaps[0].getPixels(), bitmaps[1].getPixels(),
+                                   bitmaps[0].computeByteSize()), "draw %d", i);
+    }
+}
+
+// Drawing only uses raster pipeline programs when SkSL in raster pipeline is enabled, so this runs
+// the programs directly. Specialized ones are compiled either way.
+DEF_TEST(SkRuntimeEffectSpecializedRPProgram, r) {
+    static constexpr char kColorFilter[] = R"(
+        layout(color) uniform half4 color;
+        uniform int mode;
+        uniform half k;
+        uniform half weights[2];
+        half4 main(half4 c) {
+            if (mode == 1) {
+                c = mix(c, color, k);
+            } else if (mode == 2) {
+                c = c.bgra * color.a;
+            }
+            return c * weights[0] + weights[1];
+        }
+    )";
+    SkRuntimeEffect::Options options;
+    options.specializeUniforms = true;
+    sk_sp<SkRuntimeEffect> effect =
+            SkRuntimeEffect::MakeForColorFilter(SkString(kColorFilter), options).effect;
+    REPORTER_ASSERT(r, effect);
+    const SkSL::Program& program = SkRuntimeEffectPriv::Program(*effect);
+    std::unique_ptr<SkSL::RP::Program> baseProgram =
+            SkSL::MakeRasterPipelineProgram(program, *program.getFunction("main")->definition());
+    REPORTER_ASSERT(r, baseProgram);
+
+    // Filters `color` with the program, and returns the number of stages that took.
+    auto run = [](const SkSL::RP::Program& program,
+                  SkSpan<const float> uniforms,
+                  SkColor4f* color) {
+        SkArenaAlloc alloc(/*firstHeapAllocation=*/1000);
+        SkRasterPipeline pipeline(&alloc);
+        pipeline.append_constant_color(&alloc, *color);
+        program.appendStages(&pipeline, &alloc, /*callbacks=*/nullptr, uniforms);
+        const int stages = pipeline.getNumStages();
+
+        float out[4 * SkRasterPipeline_kMaxStride_highp] = {};
+        SkRasterPipeline_MemoryCtx outCtx{/*pixels=*/out, /*stride=*/0};
+        pipeline.append(SkRasterPipelineOp::store_f32, &outCtx);
+        pipeline.run(0, 0, 1, 1);
+        *color = {out[0], out[1], out[2], out[3]};
+        return stages;
+    };
+
+    struct {
+        SkColor4f color;
+        int mode;
+        float k;
+        float weights[2];
+    } uniforms = {{1, 0.5f, 0.25f, 0.75f}, 0, 0.375f, {0.875f, 0.0625f}};
+    const sk_sp<SkColorSpace> dstCSs[] = {
+            nullptr, SkColorSpace::MakeRGB(SkNamedTransferFn::kSRGB, SkNamedGamut::kRec2020)};
+    for (const sk_sp<SkColorSpace>& dstCS : dstCSs) {
+        for (int mode = 0; mode < 3; ++mode) {
+            uniforms.mode = mode;
+            sk_sp<const SkData> data = SkRuntimeEffectPriv::TransformUniforms(
+                    effect->uniforms(), SkData::MakeWithCopy(&uniforms, sizeof(uniforms)),
+                    dstCS.get());
+
+            SkArenaAlloc alloc(/*firstHeapAllocation=*/256);
+            SkSpan<const float> specializedUniforms;
+            const SkSL::RP::Program* specialized =
+                    SkRuntimeEffectPriv::RPProgram(*effect, data, &alloc, &specializedUniforms);
+            if (!specialized) {
+                ERRORF(r, "mode %d was not specialized", mode);
+                continue;
+            }
+            // Only the array is still a uniform.
+            REPORTER_ASSERT(r, specializedUniforms.size() == 2);
+
+            SkColor4f expected = {0.25f, 0.5f, 0.75f, 1},
+                      actual   = expected;
+            const int baseStages = run(*baseProgram,
+                                       SkSpan(static_cast<const float*>(data->data()),
+                                              data->size() / sizeof(float)),
+                                       &expected);
+            const int specializedStages = run(*specialized, specializedUniforms, &actual);
+            REPORTER_ASSERT(r, specializedStages < baseStages,
+                            "mode %d: %d stages, unspecialized %d",
+                            mode, specializedStages, baseStages);
+            for (int c = 0; c < 4; ++c) {
+                REPORTER_ASSERT(r, SkScalarNearlyEqual(actual[c], expected[c], 1e-5f),
+                                "mode %d: %g, expected %g", mode, actual[c], expected[c]);
+            }
+        }
+    }
+}
+
 DEF_TEST(SkRuntimeEffectAllowsPrivateAccess, r) {
     SkRuntimeEffect::Options defaultOptions;
     SkRuntimeEffect::Options optionsWithAccess;
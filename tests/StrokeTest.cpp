@@ -13,12 +13,15 @@
 #include "include/core/SkScalar.h"
 #include "include/core/SkStrokeRec.h"
 #include "include/private/base/SkFloatBits.h"
+#include "src/base/SkRandom.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkStroke.h"
 #include "tests/Test.h"
 
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 static bool equal(const SkRect& a, const SkRect& b) {
     return  SkScalarNearlyEqual(a.left(), b.left()) &&
@@ -192,3 +195,73 @@ DEF_TEST(Stroke, reporter) {
     test_strokerec_equality(reporter);
     test_big_stroke(reporter);
 }
+
+// Paths made only of lines go through SkPolylineStroker, which should build exactly the path that
+// SkPathStroker does.
+DEF_TEST(Stroke_polyline, reporter) {
+    SkRandom rand;
+    auto make_polyline = [&rand](int contours, bool close) {
+        SkPath path;
+        for (int c = 0; c < contours; ++c) {
+            path.moveTo(rand.nextRangeF(0, 100), rand.nextRangeF(0, 100));
+            int count = rand.nextRangeU(0, 12);
+            for (int i = 0; i < count; ++i) {
+                SkPoint last;
+                path.getLastPt(&last);
+                switch (rand.nextU() % 6) {
+                    case 0:  // repeated point
+                        path.lineTo(last);
+                        break;
+                    case 1:  // line too short to have a normal
+                        path.lineTo(last.fX + 1e-7f, last.fY);
+                        break;
+                    case 2:  // turn back on itself
+                        path.lineTo(2 * last.fX - 10, last.fY);
+                        path.lineTo(last);
+                        break;
+                    default:
+                        path.lineTo(rand.nextRangeF(0, 100), rand.nextRangeF(0, 100));
+                        break;
+                }
+            }
+            if (close) {
+                path.close();
+            }
+        }
+        return path;
+    };
+
+    std::vector<SkPath> paths;
+    for (int i = 0; i < 50; ++i) {
+        paths.push_back(make_polyline(1 + i % 3, i & 1));
+    }
+    // A point, a closed point, a trailing move, and a convex polygon.
+    paths.push_back(SkPath().moveTo(5, 5).lineTo(5, 5));
+    paths.push_back(SkPath().moveTo(5, 5).close());
+    paths.push_back(SkPath().moveTo(5, 5).lineTo(20, 30).moveTo(40, 40));
+    paths.push_back(SkPath::Polygon({{0, 0}, {50, 0}, {60, 30}, {10, 40}}, true));
+
+    for (const SkPath& path : paths) {
+        for (int cap = 0; cap < SkPaint::kCapCount; ++cap) {
+            for (int join = 0; join < SkPaint::kJoinCount; ++join) {
+                for (bool doFill : {false, true}) {
+                    SkStroke stroke;
+                    stroke.setWidth(rand.nextRangeF(0.5f, 20));
+                    stroke.setCap((SkPaint::Cap)cap);
+                    stroke.setJoin((SkPaint::Join)join);
+                    stroke.setMiterLimit(rand.nextRangeF(0.5f, 8));
+                    stroke.setDoFill(doFill);
+                    stroke.setResScale(rand.nextRangeF(0.5f, 4));
+
+                    SkPath fast, general;
+                    stroke.strokePath(path, &fast);
+                    stroke.setUsePolylineStroker(false);
+                    stroke.strokePath(path, &general);
+                    REPORTER_ASSERT(reporter, fast == general,
+                                    "cap %d join %d fill %d", cap, join, doFill);
+                    REPORTER_ASSERT(reporter, fast.isVolatile() == general.isVolatile());
+                }
+            }
+        }
+    }
+}
@@ -31,6 +31,7 @@
 #include "src/base/SkArenaAlloc.h"
 #include "src/base/SkRandom.h"
 #include "src/core/SkPathPriv.h"
+#include "src/core/SkResourceCache.h"
 #include "src/gpu/SkBackingFit.h"
 #include "src/gpu/ganesh/GrColorInfo.h"
 #include "src/gpu/ganesh/GrEagerVertexAllocator.h"
@@ -45,6 +46,7 @@
 #include "src/gpu/ganesh/geometry/GrInnerFanTriangulator.h"
 #include "src/gpu/ganesh/geometry/GrStyledShape.h"
 #include "src/gpu/ganesh/geometry/GrTriangulator.h"
+#include "src/gpu/ganesh/geometry/GrTriangulatorCache.h"
 #include "src/gpu/ganesh/ops/TriangulatingPathRenderer.h"
 #include "src/shaders/SkShaderBase.h"
 #include "tests/CtsEnforcement.h"
@@ -53,6 +55,7 @@
 
 #include <cmath>
 #include <cstddef>
+#include <cstring>
 #include <initializer_list>
 #include <map>
 #include <memory>
@@ -1356,4 +1359,41 @@ DEF_TEST(TriangulatorBugs, r) {
     test_crbug_1262444(r);
 }
 
+DEF_TEST(TriangulatorCache, r) {
+    SkResourceCache cache(1 << 20);
+    SkPath path;
+    path.moveTo(0, 0);
+    path.cubicTo(100, 0, 0, 100, 100, 100);
+    path.quadTo(50, 150, 0, 100);
+    path.lineTo(30, 40);
+    path.close();
+    const SkRect clipBounds = SkRect::MakeEmpty();
+
+    SimplerVertexAllocator triangulated, cached;
+    bool isLinear;
+    int count = GrTriangulatorCache::PathToTriangles(path, 0.25f, clipBounds, &triangulated,
+                                                     &isLinear, &cache);
+    REPORTER_ASSERT(r, count > 0);
+    REPORTER_ASSERT(r, !isLinear);
+
+    // A copy of the path shares its generation ID, and a tolerance in the same bucket is served
+    // by the same triangles. A much coarser tolerance is not.
+    {
+        SkPath copy = path;
+        REPORTER_ASSERT(r, GrTriangulatorCache::Find(copy, 0.3f, clipBounds, &cached, &isLinear,
+                                                     &cache) == count);
+        REPORTER_ASSERT(r, !memcmp(triangulated.fVertexData.get(), cached.fVertexData.get(),
+                                   count * sizeof(SkPoint)));
+        REPORTER_ASSERT(r, !GrTriangulatorCache::Find(copy, 4.0f, clipBounds, &cached, &isLinear,
+                                                      &cache));
+    }
+
+    // Editing the path purges its triangles.
+    REPORTER_ASSERT(r, cache.getTotalBytesUsed() > 0);
+    path.lineTo(5, 5);
+    REPORTER_ASSERT(r, !GrTriangulatorCache::Find(path, 0.25f, clipBounds, &cached, &isLinear,
+                                                  &cache));
+    REPORTER_ASSERT(r, cache.getTotalBytesUsed() == 0);
+}
+
 #endif // SK_ENABLE_OPTIMIZE_SIZE
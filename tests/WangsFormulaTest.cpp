@@ -13,6 +13,9 @@
 #include "src/base/SkRandom.h"
 #include "src/base/SkVx.h"
 #include "src/core/SkGeometry.h"
+#include "src/gpu/BufferWriter.h"
+#include "src/gpu/tessellate/LinearTolerances.h"
+#include "src/gpu/tessellate/PatchWriter.h"
 #include "src/gpu/tessellate/Tessellation.h"
 #include "src/gpu/tessellate/WangsFormula.h"
 #include "tests/Test.h"
@@ -22,6 +25,7 @@
 #include <functional>
 #include <limits>
 #include <string>
+#include <vector>
 
 namespace skgpu::tess {
 
@@ -322,6 +326,103 @@ DEF_TEST(wangs_formula_vectorXforms, r) {
     });
 }
 
+// Ensure the batch versions of cubic_p4 and quadratic_p4 match evaluating one curve at a time.
+DEF_TEST(wangs_formula_batch, r) {
+    auto check_batch = [&](const std::vector<float>& batch, const std::vector<float>& expected) {
+        for (size_t i = 0; i < expected.size(); ++i) {
+            REPORTER_ASSERT(r, batch[i] == expected[i] ||
+                               std::abs(batch[i] - expected[i]) <= 1e-5f * expected[i]);
+        }
+    };
+
+    SkRandom rand;
+    for_random_matrices(&rand, [&](const SkMatrix& m) {
+        wangs_formula::VectorXform xform(m);
+        // for_random_beziers generates 41 curves: several full batches plus a remainder.
+        std::vector<SkPoint> cubics, quads;
+        for_random_beziers(4, &rand, [&](const SkPoint pts[]) {
+            cubics.insert(cubics.end(), pts, pts + 4);
+        });
+        for_random_beziers(3, &rand, [&](const SkPoint pts[]) {
+            quads.insert(quads.end(), pts, pts + 3);
+        });
+
+        int cubicCount = cubics.size() / 4;
+        std::vector<float> batch(cubicCount), expected(cubicCount);
+        wangs_formula::cubic_p4(kPrecision, cubics.data(), cubicCount, batch.data(), xform);
+        for (int i = 0; i < cubicCount; ++i) {
+            expected[i] = wangs_formula::cubic_p4(kPrecision, cubics.data() + i*4, xform);
+        }
+        check_batch(batch, expected);
+
+        int quadCount = quads.size() / 3;
+        batch.resize(quadCount);
+        expected.resize(quadCount);
+        wangs_formula::quadratic_p4(kPrecision, quads.data(), quadCount, batch.data(), xform);
+        for (int i = 0; i < quadCount; ++i) {
+            expected[i] = wangs_formula::quadratic_p4(kPrecision, quads.data() + i*3, xform);
+        }
+        check_batch(batch, expected);
+    });
+}
+
+// Appends each patch to a vector of bytes.
+class VectorPatchAllocator {
+public:
+    VectorPatchAllocator(size_t stride, std::vector<char>* patches)
+            : fStride(stride), fPatches(patches) {}
+
+    VertexWriter append(const LinearTolerances&) {
+        size_t offset = fPatches->size();
+        fPatches->resize(offset + fStride);
+        return VertexWriter(fPatches->data() + offset, fStride);
+    }
+
+private:
+    size_t             fStride;
+    std::vector<char>* fPatches;
+};
+
+// Ensure PatchWriter writes the same patches for a batch of curves as for one curve at a time.
+DEF_TEST(wangs_formula_batch_patches, r) {
+    using Writer = PatchWriter<VectorPatchAllocator, AddTrianglesWhenChopping, DiscardFlatCurves>;
+
+    SkRandom rand;
+    for_random_matrices(&rand, [&](const SkMatrix& m) {
+        std::vector<SkPoint> cubics, quads;
+        for (int i = 0; i < 3; ++i) {
+            for_random_beziers(4, &rand, [&](const SkPoint pts[]) {
+                cubics.insert(cubics.end(), pts, pts + 4);
+            }, 12);
+            for_random_beziers(3, &rand, [&](const SkPoint pts[]) {
+                quads.insert(quads.end(), pts, pts + 3);
+            }, 12);
+        }
+        const int cubicCount = cubics.size() / 4,
+                  quadCount = quads.size() / 3;
+
+        std::vector<char> batched, expected;
+        {
+            Writer writer(PatchAttribs::kNone, &batched);
+            writer.setShaderTransform(wangs_formula::VectorXform{m});
+            writer.writeCubics(cubics.data(), cubicCount);
+            writer.writeQuadratics(quads.data(), quadCount);
+        }
+        {
+            Writer writer(PatchAttribs::kNone, &expected);
+            writer.setShaderTransform(wangs_formula::VectorXform{m});
+            for (int i = 0; i < cubicCount; ++i) {
+                writer.writeCubic(cubics.data() + i*4);
+            }
+            for (int i = 0; i < quadCount; ++i) {
+                writer.writeQuadratic(quads.data() + i*3);
+            }
+        }
+        REPORTER_ASSERT(r, !expected.empty());
+        REPORTER_ASSERT(r, batched == expected);
+    });
+}
+
 DEF_TEST(wangs_formula_worst_case_cubic, r) {
     {
         SkPoint worstP[] = {{0,0}, {100,100}, {0,0}, {0,0}};
@@ -42,7 +42,8 @@ bool CollectImages(CommandLineFlags::StringArray dir, SkTArray<SkString>* output
 void SetCtxOptions(struct GrContextOptions*);
 
 /**
- *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA.
+ *  Enable, disable, or force analytic anti-aliasing using --analyticAA and --forceAnalyticAA,
+ *  and opt into accumulation and banded anti-aliasing with --accumulationAA and --bandedAA.
  */
 void SetAnalyticAA();
 
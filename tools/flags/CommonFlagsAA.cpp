@@ -11,10 +11,17 @@ static DEFINE_bool(forceAnalyticAA, false,
             "Force analytic anti-aliasing even if the path is complicated: "
             "whether it's concave or convex, we consider a path complicated"
             "if its number of points is comparable to its resolution.");
+static DEFINE_bool(accumulationAA, false,
+            "If true, use accumulation anti-aliasing for paths whose bounds are small enough.");
+static DEFINE_bool(bandedAA, false,
+            "If true, anti-aliased paths with many points may be scan converted in bands "
+            "on the default executor (see --threads).");
 
 void SetAnalyticAA() {
     gSkUseAnalyticAA   = FLAGS_analyticAA;
     gSkForceAnalyticAA = FLAGS_forceAnalyticAA;
+    gSkUseAccumulationAA = FLAGS_accumulationAA;
+    gSkUseBandedAA = FLAGS_bandedAA;
 }
 
 }
@@ -5,12 +5,16 @@
  * found in the LICENSE file.
  */
 
+#include "include/core/SkPath.h"
 #include "include/core/SkPicture.h"
 #include "include/core/SkStream.h"
 #include "include/private/base/SkTo.h"
+#include "include/utils/SkNoDrawCanvas.h"
 #include "src/core/SkFontDescriptor.h"
+#include "src/core/SkPathRefInterner.h"
 #include "src/core/SkPictureData.h"
 #include "src/core/SkPicturePriv.h"
+#include "src/core/SkTHash.h"
 #include "tools/flags/CommandLineFlags.h"
 
 static DEFINE_string2(input, i, "", "skp on which to report");
@@ -19,6 +23,7 @@ static DEFINE_bool2(cullRect, c, true, "cullRect");
 static DEFINE_bool2(flags, f, true, "flags");
 static DEFINE_bool2(tags, t, true, "tags");
 static DEFINE_bool2(quiet, q, false, "quiet");
+static DEFINE_bool2(paths, p, false, "count paths and how many have the same geometry");
 
 // This tool can print simple information about an SKP but its main use
 // is just to check if an SKP has been truncated during the recording
@@ -31,6 +36,47 @@ static const int kInvalidTag = 3;
 static const int kMissingInput = 4;
 static const int kIOError = 5;
 
+// Counts the paths an SKP draws or clips to, and how many of them share storage or geometry.
+class PathCounter final : public SkNoDrawCanvas {
+public:
+    explicit PathCounter(const SkIRect& bounds) : SkNoDrawCanvas(bounds) {}
+
+    void report() const {
+        SkDebugf("Paths: %d used, %d generation IDs, %d distinct geometries\n",
+                 fPathCount, fGenIDs.count(), fInterner.uniqueCount());
+    }
+
+protected:
+    void onDrawPath(const SkPath& path, const SkPaint&) override { this->count(path); }
+    void onDrawShadowRec(const SkPath& path, const SkDrawShadowRec&) override {
+        this->count(path);
+    }
+    void onClipPath(const SkPath& path, SkClipOp, ClipEdgeStyle) override { this->count(path); }
+
+private:
+    void count(const SkPath& path) {
+        fPathCount++;
+        fGenIDs.add(path.getGenerationID());
+        fInterner.intern(path);
+    }
+
+    int fPathCount = 0;
+    SkTHashSet<uint32_t> fGenIDs;
+    SkPathRefInterner fInterner;
+};
+
+static void report_paths(const char* path) {
+    SkFILEStream stream(path);
+    sk_sp<SkPicture> picture = SkPicture::MakeFromStream(&stream);
+    if (!picture) {
+        SkDebugf("Couldn't read picture\n");
+        return;
+    }
+    PathCounter counter(picture->cullRect().roundOut());
+    picture->playback(&counter);
+    counter.report();
+}
+
 int main(int argc, char** argv) {
     CommandLineFlags::SetUsage("Prints information about an skp file");
     CommandLineFlags::Parse(argc, argv);
@@ -66,6 +112,9 @@ int main(int argc, char** argv) {
                  info.fCullRect.fLeft, info.fCullRect.fTop,
                  info.fCullRect.fRight, info.fCullRect.fBottom);
     }
+    if (FLAGS_paths && !FLAGS_quiet) {
+        report_paths(FLAGS_input[0]);
+    }
 
     bool hasData;
     if (!stream.readBool(&hasData)) { return kTruncatedFile; }
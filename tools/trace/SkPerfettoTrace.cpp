@@ -141,6 +141,8 @@ SkEventTracer::Handle SkPerfettoTrace::addTraceEvent(char phase,
         }
     } else if (TRACE_EVENT_PHASE_END == phase) {
         TRACE_EVENT_END(category);
+    } else if (TRACE_EVENT_PHASE_COUNTER == phase) {
+        this->triggerCounters(categoryEnabledFlag, name, numArgs, argNames, argTypes, argValues);
     }
 
     if (TRACE_EVENT_PHASE_INSTANT == phase) {
@@ -350,3 +352,30 @@ void SkPerfettoTrace::newTracingSection(const char* name) {
     }
     this->openNewTracingSession(name);
 }
+
+void SkPerfettoTrace::triggerCounters(const uint8_t* categoryEnabledFlag, const char* counterName,
+                                      int numArgs, const char** argNames, const uint8_t* argTypes,
+                                      const uint64_t* argValues) {
+    perfetto::DynamicCategory category{ this->getCategoryGroupName(categoryEnabledFlag) };
+    for (int i = 0; i < numArgs; ++i) {
+        skia_private::TraceValueUnion value;
+        value.as_uint = argValues[i];
+
+        double counterValue;
+        switch (argTypes[i]) {
+            case TRACE_VALUE_TYPE_BOOL:   counterValue = value.as_bool;   break;
+            case TRACE_VALUE_TYPE_UINT:   counterValue = value.as_uint;   break;
+            case TRACE_VALUE_TYPE_INT:    counterValue = value.as_int;    break;
+            case TRACE_VALUE_TYPE_DOUBLE: counterValue = value.as_double; break;
+            default:                      continue;
+        }
+
+        // Like the Android framework's Perfetto shim, multi-part counters get a track per part.
+        std::string trackName = counterName;
+        if (numArgs > 1) {
+            trackName = trackName + "-" + argNames[i];
+        }
+        TRACE_COUNTER(category, perfetto::CounterTrack(perfetto::DynamicString{trackName}),
+                      counterValue);
+    }
+}
@@ -71,6 +71,11 @@ private:
     void triggerTraceEvent(const uint8_t* categoryEnabledFlag, const char* eventName,
                            const char* arg1Name, const uint8_t& arg1Type, const uint64_t& arg1Val,
                            const char* arg2Name, const uint8_t& arg2Type, const uint64_t& arg2Val);
+
+    /** Records each of a counter event's arguments on its own Perfetto counter track. */
+    void triggerCounters(const uint8_t* categoryEnabledFlag, const char* counterName, int numArgs,
+                         const char** argNames, const uint8_t* argTypes,
+                         const uint64_t* argValues);
 };
 
 #endif